@@ -42,6 +42,9 @@ ifneq ($(HB_LINKING_RTL),)
 else
    ifeq ($(BUILD_SHARED),yes)
       SYSLIBS += pthread
+   else ifneq ($(filter hbcplr,$(LIBS)),)
+      # parallel compilation in harbour executable
+      SYSLIBS += pthread
    endif
 endif
 
@@ -107,15 +107,35 @@ static void do_charonly( int iSwitch )
 
       pcRet = ( char * ) hb_xgrab( sStrLen );
 
-      for( pcSub = pcString; pcSub < pcString + sStrLen + 1 - iShift; pcSub += iShift )
+      if( iShift == 1 )
       {
-         const char * pc = ct_at_exact_forward( pcOnlySet, sOnlySetLen, pcSub, iShift, NULL );
-         HB_BOOL fBool = ( pc != NULL && ( ( pc - pcOnlySet ) % iShift ) == 0 );
-         if( fBool ? iSwitch == DO_CHARONLY_CHARONLY || iSwitch == DO_CHARONLY_WORDONLY
-                   : iSwitch == DO_CHARONLY_CHARREM  || iSwitch == DO_CHARONLY_WORDREM )
+         /* character set lookup table */
+         HB_BOOL afSet[ UCHAR_MAX + 1 ];
+         HB_BOOL fOnly = iSwitch == DO_CHARONLY_CHARONLY;
+         HB_SIZE sPos;
+
+         memset( afSet, 0, sizeof( afSet ) );
+         for( sPos = 0; sPos < sOnlySetLen; ++sPos )
+            afSet[ ( HB_UCHAR ) pcOnlySet[ sPos ] ] = HB_TRUE;
+
+         for( sPos = 0; sPos < sStrLen; ++sPos )
          {
-            for( pc = pcSub; pc < pcSub + iShift; pc++ )
-               pcRet[ sRetStrLen++ ] = *pc;
+            if( afSet[ ( HB_UCHAR ) pcString[ sPos ] ] == fOnly )
+               pcRet[ sRetStrLen++ ] = pcString[ sPos ];
+         }
+      }
+      else
+      {
+         for( pcSub = pcString; pcSub < pcString + sStrLen + 1 - iShift; pcSub += iShift )
+         {
+            const char * pc = ct_at_exact_forward( pcOnlySet, sOnlySetLen, pcSub, iShift, NULL );
+            HB_BOOL fBool = ( pc != NULL && ( ( pc - pcOnlySet ) % iShift ) == 0 );
+            if( fBool ? iSwitch == DO_CHARONLY_CHARONLY || iSwitch == DO_CHARONLY_WORDONLY
+                      : iSwitch == DO_CHARONLY_CHARREM  || iSwitch == DO_CHARONLY_WORDREM )
+            {
+               for( pc = pcSub; pc < pcSub + iShift; pc++ )
+                  pcRet[ sRetStrLen++ ] = *pc;
+            }
          }
       }
 
@@ -83,37 +83,38 @@ HB_FUNC( NUMAT )
       }
 
       nCounter = 0;
-      pcSubStr = pcString;
-      sSubStrLen = sStrLen;
 
-      do
+      if( iAtLike == CT_SETATLIKE_EXACT )
       {
-         switch( iAtLike )
-         {
-            case CT_SETATLIKE_EXACT:
-               pc = ct_at_exact_forward( pcSubStr, sSubStrLen, pcStringToMatch,
-                                         sStrToMatchLen, &sMatchStrLen );
-               break;
+         /* count matches directly with hb_strAt() */
+         HB_SIZE nPos = 0, nAt, nStep = iMultiPass ? 1 : sStrToMatchLen;
 
-            case CT_SETATLIKE_WILDCARD:
-               pc = ct_at_wildcard_forward( pcSubStr, sSubStrLen,
-                                            pcStringToMatch, sStrToMatchLen,
-                                            cAtLike, &sMatchStrLen );
-               break;
+         while( ( nAt = hb_strAt( pcStringToMatch, sStrToMatchLen,
+                                  pcString + nPos, sStrLen - nPos ) ) != 0 )
+         {
+            nCounter++;
+            nPos += nAt - 1 + nStep;
+         }
+      }
+      else if( iAtLike == CT_SETATLIKE_WILDCARD )
+      {
+         pcSubStr = pcString;
+         sSubStrLen = sStrLen;
 
-            default:
-               pc = NULL;
+         while( ( pc = ct_at_wildcard_forward( pcSubStr, sSubStrLen,
+                                               pcStringToMatch, sStrToMatchLen,
+                                               cAtLike, &sMatchStrLen ) ) != NULL )
+         {
+            nCounter++;
+            if( iMultiPass )
+               pcSubStr = pc + 1;
+            else
+               pcSubStr = pc + sMatchStrLen;
+            sSubStrLen = sStrLen - ( pcSubStr - pcString );
          }
-         nCounter++;
-         if( iMultiPass )
-            pcSubStr = pc + 1;
-         else
-            pcSubStr = pc + sMatchStrLen;
-         sSubStrLen = sStrLen - ( pcSubStr - pcString );
       }
-      while( pc != NULL );
 
-      hb_retns( nCounter - 1 );
+      hb_retns( nCounter );
    }
    else
    {
@@ -51,7 +51,10 @@
 #include "hbapiitm.h"
 #include "hbapierr.h"
 #include "hbapifs.h"
+#include "hbapirdd.h"
+#include "hbset.h"
 #include "hbapistr.h"
+#include "hbdate.h"
 #include "hbstack.h"
 
 /* FIXME: verify the exact SQLITE3 version */
@@ -62,6 +65,8 @@
 
 #define HB_SQLITE3_DB                       6000001
 
+#define HB_SQLITE3_STMT_CACHE               16
+
 #define HB_ERR_MEMSTRU_NOT_MEM_BLOCK        4001
 #define HB_ERR_MEMSTRU_WRONG_MEMSTRU_BLOCK  4002
 #define HB_ERR_MEMSTRU_DESTROYED            4003
@@ -83,6 +88,13 @@ static int  hook_commit( void * );
 static void hook_rollback( void * );
 static void func( sqlite3_context *, int, sqlite3_value ** );
 
+typedef struct
+{
+   char *         szSQL;
+   HB_SIZE        nSQL;
+   sqlite3_stmt * pStmt;
+} HB_SQLITE3_STMT, * PHB_SQLITE3_STMT;
+
 typedef struct
 {
    sqlite3 * db;
@@ -92,6 +104,9 @@ typedef struct
    PHB_ITEM  cbHookCommit;
    PHB_ITEM  cbHookRollback;
    PHB_ITEM  cbFunc;
+   PHB_SQLITE3_STMT pStmtCache;     /* prepared statements, most recently used first */
+   int       iStmtCount;
+   int       iStmtCacheSize;
 } HB_SQLITE3, * PHB_SQLITE3;
 
 typedef struct
@@ -102,6 +117,90 @@ typedef struct
 
 typedef sqlite3_stmt * psqlite3_stmt;
 
+/**
+   Prepared statements cache
+ */
+
+static void hb_sqlite3_stmtCacheTrim( HB_SQLITE3 * pHbSqlite3, int iSize )
+{
+   while( pHbSqlite3->iStmtCount > iSize )
+   {
+      PHB_SQLITE3_STMT pEntry = &pHbSqlite3->pStmtCache[ --pHbSqlite3->iStmtCount ];
+
+      sqlite3_finalize( pEntry->pStmt );
+      hb_xfree( pEntry->szSQL );
+   }
+}
+
+static void hb_sqlite3_stmtCacheSize( HB_SQLITE3 * pHbSqlite3, int iSize )
+{
+   hb_sqlite3_stmtCacheTrim( pHbSqlite3, iSize );
+   if( pHbSqlite3->pStmtCache )
+   {
+      if( iSize > 0 )
+         pHbSqlite3->pStmtCache = ( PHB_SQLITE3_STMT )
+            hb_xrealloc( pHbSqlite3->pStmtCache, iSize * sizeof( HB_SQLITE3_STMT ) );
+      else
+      {
+         hb_xfree( pHbSqlite3->pStmtCache );
+         pHbSqlite3->pStmtCache = NULL;
+      }
+   }
+   pHbSqlite3->iStmtCacheSize = iSize;
+}
+
+/* returned statement is owned by cache and cannot be finalized by caller,
+   it is valid until the next cache lookup evicts it */
+static psqlite3_stmt hb_sqlite3_stmtCacheGet( HB_SQLITE3 * pHbSqlite3, const char * pszSQL, HB_SIZE nSQL )
+{
+   HB_SQLITE3_STMT entry;
+   const char *    pszTail;
+   int             i;
+
+   for( i = 0; i < pHbSqlite3->iStmtCount; i++ )
+   {
+      if( pHbSqlite3->pStmtCache[ i ].nSQL == nSQL &&
+          memcmp( pHbSqlite3->pStmtCache[ i ].szSQL, pszSQL, nSQL ) == 0 )
+      {
+         entry = pHbSqlite3->pStmtCache[ i ];
+         memmove( pHbSqlite3->pStmtCache + 1, pHbSqlite3->pStmtCache, i * sizeof( HB_SQLITE3_STMT ) );
+         pHbSqlite3->pStmtCache[ 0 ] = entry;
+
+         sqlite3_reset( entry.pStmt );
+         sqlite3_clear_bindings( entry.pStmt );
+         return entry.pStmt;
+      }
+   }
+
+   if( pHbSqlite3->iStmtCacheSize <= 0 )
+      return NULL;
+
+#if SQLITE_VERSION_NUMBER >= 3020000
+   if( sqlite3_prepare_v3( pHbSqlite3->db, pszSQL, ( int ) nSQL, SQLITE_PREPARE_PERSISTENT, &entry.pStmt, &pszTail ) != SQLITE_OK )
+#else
+   if( sqlite3_prepare_v2( pHbSqlite3->db, pszSQL, ( int ) nSQL, &entry.pStmt, &pszTail ) != SQLITE_OK )
+#endif
+   {
+      sqlite3_finalize( entry.pStmt );
+      return NULL;
+   }
+
+   if( ! pHbSqlite3->pStmtCache )
+      pHbSqlite3->pStmtCache = ( PHB_SQLITE3_STMT )
+         hb_xgrab( pHbSqlite3->iStmtCacheSize * sizeof( HB_SQLITE3_STMT ) );
+   hb_sqlite3_stmtCacheTrim( pHbSqlite3, pHbSqlite3->iStmtCacheSize - 1 );
+
+   memmove( pHbSqlite3->pStmtCache + 1, pHbSqlite3->pStmtCache, pHbSqlite3->iStmtCount * sizeof( HB_SQLITE3_STMT ) );
+   entry.szSQL = ( char * ) hb_xgrab( nSQL + 1 );
+   memcpy( entry.szSQL, pszSQL, nSQL );
+   entry.szSQL[ nSQL ] = '\0';
+   entry.nSQL = nSQL;
+   pHbSqlite3->pStmtCache[ 0 ] = entry;
+   pHbSqlite3->iStmtCount++;
+
+   return entry.pStmt;
+}
+
 /**
    destructor, it's executed automatically
  */
@@ -112,6 +211,8 @@ static HB_GARBAGE_FUNC( hb_sqlite3_destructor )
 
    if( pStructHolder && pStructHolder->hbsqlite3 )
    {
+      hb_sqlite3_stmtCacheSize( pStructHolder->hbsqlite3, 0 );
+
       if( pStructHolder->hbsqlite3->db )
       {
          sqlite3_close( pStructHolder->hbsqlite3->db );
@@ -718,6 +819,7 @@ HB_FUNC( SQLITE3_OPEN )
 
          hbsqlite3 = ( HB_SQLITE3 * ) hb_xgrabz( sizeof( HB_SQLITE3 ) );
          hbsqlite3->db = db;
+         hbsqlite3->iStmtCacheSize = HB_SQLITE3_STMT_CACHE;
          hb_sqlite3_ret( hbsqlite3, HB_SQLITE3_DB );
       }
       else
@@ -751,6 +853,7 @@ HB_FUNC( SQLITE3_OPEN_V2 )
 
       hbsqlite3 = ( HB_SQLITE3 * ) hb_xgrabz( sizeof( HB_SQLITE3 ) );
       hbsqlite3->db = db;
+      hbsqlite3->iStmtCacheSize = HB_SQLITE3_STMT_CACHE;
       hb_sqlite3_ret( hbsqlite3, HB_SQLITE3_DB );
    }
    else
@@ -1479,6 +1582,818 @@ HB_FUNC( SQLITE3_GET_TABLE )
       hb_errRT_BASE_SubstR( EG_ARG, 0, NULL, HB_ERR_FUNCNAME, HB_ERR_ARGS_BASEPARAMS );
 }
 
+/**
+   Prepared statements cache, batch binding and bulk fetch
+ */
+
+static int hb_sqlite3_bind_item( psqlite3_stmt pStmt, int iParam, PHB_ITEM pItem )
+{
+   switch( hb_itemType( pItem ) )
+   {
+      case HB_IT_NIL:
+         return sqlite3_bind_null( pStmt, iParam );
+
+      case HB_IT_LOGICAL:
+         return sqlite3_bind_int( pStmt, iParam, hb_itemGetL( pItem ) ? 1 : 0 );
+
+      case HB_IT_INTEGER:
+      case HB_IT_LONG:
+#if HB_VMLONG_MAX == INT32_MAX || defined( HB_LONG_LONG_OFF )
+         return sqlite3_bind_int( pStmt, iParam, hb_itemGetNI( pItem ) );
+#else
+         return sqlite3_bind_int64( pStmt, iParam, hb_itemGetNInt( pItem ) );
+#endif
+
+      case HB_IT_DOUBLE:
+         return sqlite3_bind_double( pStmt, iParam, hb_itemGetND( pItem ) );
+
+      case HB_IT_STRING:
+      case HB_IT_MEMO:
+      {
+         void *       hText;
+         HB_SIZE      nText;
+         const char * pszText = hb_itemGetStrUTF8( pItem, &hText, &nText );
+         int          rc = sqlite3_bind_text( pStmt, iParam, pszText, ( int ) nText, SQLITE_TRANSIENT );
+
+         hb_strfree( hText );
+         return rc;
+      }
+
+      case HB_IT_DATE:
+      case HB_IT_TIMESTAMP:
+      {
+         char szDateTime[ 24 ];
+         long lJulian, lMilliSec;
+
+         hb_itemGetTDT( pItem, &lJulian, &lMilliSec );
+         if( lJulian == 0 && lMilliSec == 0 )
+            return sqlite3_bind_null( pStmt, iParam );
+
+         hb_timeStampStr( szDateTime, lJulian, lMilliSec );
+         return sqlite3_bind_text( pStmt, iParam, szDateTime,
+                                   HB_IS_TIMESTAMP( pItem ) ? 23 : 10, SQLITE_TRANSIENT );
+      }
+   }
+
+   return SQLITE_MISMATCH;
+}
+
+static void hb_sqlite3_column_item( psqlite3_stmt pStmt, int iCol, PHB_ITEM pItem )
+{
+   switch( sqlite3_column_type( pStmt, iCol ) )
+   {
+      case SQLITE_TEXT:
+         hb_itemPutStrLenUTF8( pItem, ( const char * ) sqlite3_column_text( pStmt, iCol ),
+                               sqlite3_column_bytes( pStmt, iCol ) );
+         break;
+
+      case SQLITE_FLOAT:
+         hb_itemPutNDDec( pItem, sqlite3_column_double( pStmt, iCol ), HB_DEFAULT_DECIMALS );
+         break;
+
+      case SQLITE_INTEGER:
+#if HB_VMLONG_MAX == INT32_MAX || defined( HB_LONG_LONG_OFF )
+         hb_itemPutNI( pItem, sqlite3_column_int( pStmt, iCol ) );
+#else
+         hb_itemPutNInt( pItem, sqlite3_column_int64( pStmt, iCol ) );
+#endif
+         break;
+
+      case SQLITE_BLOB:
+         hb_itemPutCL( pItem, ( const char * ) sqlite3_column_blob( pStmt, iCol ),
+                       sqlite3_column_bytes( pStmt, iCol ) );
+         break;
+
+      default:
+         hb_itemClear( pItem );
+         break;
+   }
+}
+
+/**
+   Prepare statement using per connection cache keyed by SQL text
+
+   hb_sqlite3_prepare_cached( db, cSQLTEXT ) --> pStmt or NIL if error occurs
+
+   Returned statement is reset and has no bindings. It is owned by
+   the cache and must not be finalized by caller.
+ */
+
+HB_FUNC( HB_SQLITE3_PREPARE_CACHED )
+{
+   HB_SQLITE3 * pHbSqlite3 = ( HB_SQLITE3 * ) hb_sqlite3_param( 1, HB_SQLITE3_DB, HB_TRUE );
+
+   if( pHbSqlite3 && pHbSqlite3->db && HB_ISCHAR( 2 ) )
+   {
+      void *       hSQLText;
+      HB_SIZE      nSQLText;
+      const char * pszSQLText = hb_parstr_utf8( 2, &hSQLText, &nSQLText );
+
+      hb_retptr( hb_sqlite3_stmtCacheGet( pHbSqlite3, pszSQLText, nSQLText ) );
+
+      hb_strfree( hSQLText );
+   }
+   else
+      hb_errRT_BASE_SubstR( EG_ARG, 0, NULL, HB_ERR_FUNCNAME, HB_ERR_ARGS_BASEPARAMS );
+}
+
+/**
+   Get/Set maximum number of statements kept in prepared statements cache,
+   0 disables the cache and finalizes cached statements
+
+   hb_sqlite3_stmt_cache( db, [nSize] ) --> nOldSize
+ */
+
+HB_FUNC( HB_SQLITE3_STMT_CACHE )
+{
+   HB_SQLITE3 * pHbSqlite3 = ( HB_SQLITE3 * ) hb_sqlite3_param( 1, HB_SQLITE3_DB, HB_TRUE );
+
+   if( pHbSqlite3 && pHbSqlite3->db )
+   {
+      hb_retni( pHbSqlite3->iStmtCacheSize );
+
+      if( HB_ISNUM( 2 ) )
+      {
+         int iSize = hb_parni( 2 );
+
+         hb_sqlite3_stmtCacheSize( pHbSqlite3, iSize > 0 ? iSize : 0 );
+      }
+   }
+   else
+      hb_errRT_BASE_SubstR( EG_ARG, 0, NULL, HB_ERR_FUNCNAME, HB_ERR_ARGS_BASEPARAMS );
+}
+
+/**
+   Execute statement for each row of parameters
+
+   hb_sqlite3_exec_batch( db, cSQLTEXT, aRows, [lTransaction = .T.], [@nRows] )
+   --> nResultCode
+
+   aRows is an array of arrays with values bound to statement parameters.
+   When connection is in autocommit mode all rows are executed inside
+   single transaction which is rolled back on error. nRows is set to
+   number of successfully executed rows.
+ */
+
+HB_FUNC( HB_SQLITE3_EXEC_BATCH )
+{
+   HB_SQLITE3 * pHbSqlite3 = ( HB_SQLITE3 * ) hb_sqlite3_param( 1, HB_SQLITE3_DB, HB_TRUE );
+   PHB_ITEM     pRows = hb_param( 3, HB_IT_ARRAY );
+
+   if( pHbSqlite3 && pHbSqlite3->db && HB_ISCHAR( 2 ) && pRows )
+   {
+      void *        hSQLText;
+      HB_SIZE       nSQLText, nRows = hb_arrayLen( pRows ), nRow = 0;
+      const char *  pszSQLText = hb_parstr_utf8( 2, &hSQLText, &nSQLText );
+      HB_BOOL       fTrans = hb_parldef( 4, HB_TRUE ) && sqlite3_get_autocommit( pHbSqlite3->db );
+      HB_BOOL       fCached = pHbSqlite3->iStmtCacheSize > 0;
+      psqlite3_stmt pStmt;
+      int           rc = SQLITE_OK;
+
+      if( fTrans )
+         rc = sqlite3_exec( pHbSqlite3->db, "BEGIN", NULL, NULL, NULL );
+
+      if( rc == SQLITE_OK )
+      {
+         if( fCached )
+         {
+            pStmt = hb_sqlite3_stmtCacheGet( pHbSqlite3, pszSQLText, nSQLText );
+            if( pStmt == NULL )
+               rc = sqlite3_errcode( pHbSqlite3->db );
+         }
+         else
+         {
+            const char * pszTail;
+
+            rc = sqlite3_prepare_v2( pHbSqlite3->db, pszSQLText, ( int ) nSQLText, &pStmt, &pszTail );
+         }
+         if( rc == SQLITE_OK && pStmt == NULL )
+            rc = SQLITE_MISUSE;  /* empty statement */
+
+         if( rc == SQLITE_OK )
+         {
+            int iParams = sqlite3_bind_parameter_count( pStmt );
+
+            while( nRow < nRows )
+            {
+               PHB_ITEM pRow = hb_arrayGetItemPtr( pRows, nRow + 1 );
+               int      iParam = 0;
+
+               if( HB_IS_ARRAY( pRow ) )
+               {
+                  int iLen = ( int ) hb_arrayLen( pRow );
+
+                  if( iLen > iParams )
+                     iLen = iParams;
+                  while( iParam < iLen && rc == SQLITE_OK )
+                  {
+                     ++iParam;
+                     rc = hb_sqlite3_bind_item( pStmt, iParam, hb_arrayGetItemPtr( pRow, iParam ) );
+                  }
+               }
+               else if( iParams > 0 )
+                  rc = hb_sqlite3_bind_item( pStmt, ++iParam, pRow );
+
+               while( rc == SQLITE_OK && iParam < iParams )
+                  rc = sqlite3_bind_null( pStmt, ++iParam );
+
+               if( rc == SQLITE_OK )
+               {
+                  rc = sqlite3_step( pStmt );
+                  if( rc == SQLITE_DONE || rc == SQLITE_ROW )
+                     rc = SQLITE_OK;
+               }
+               sqlite3_reset( pStmt );
+
+               if( rc != SQLITE_OK )
+                  break;
+               ++nRow;
+            }
+
+            if( fCached )
+               sqlite3_clear_bindings( pStmt );
+            else
+               sqlite3_finalize( pStmt );
+         }
+
+         if( fTrans )
+         {
+            if( rc == SQLITE_OK )
+               rc = sqlite3_exec( pHbSqlite3->db, "COMMIT", NULL, NULL, NULL );
+            if( rc != SQLITE_OK )
+            {
+               sqlite3_exec( pHbSqlite3->db, "ROLLBACK", NULL, NULL, NULL );
+               nRow = 0;
+            }
+         }
+      }
+
+      hb_strfree( hSQLText );
+
+      hb_storns( nRow, 5 );
+      hb_retni( rc );
+   }
+   else
+      hb_errRT_BASE_SubstR( EG_ARG, 0, NULL, HB_ERR_FUNCNAME, HB_ERR_ARGS_BASEPARAMS );
+}
+
+/**
+   Fetch next rows of statement result
+
+   hb_sqlite3_fetch_rows( pStmt, [nRows = 0], [@nResultCode] ) --> aRows
+
+   Returns array of rows, each row is an array of column values.
+   nRows = 0 fetches all remaining rows. nResultCode is set to
+   SQLITE_DONE when there are no more rows, SQLITE_ROW when nRows
+   limit was reached or error code.
+ */
+
+HB_FUNC( HB_SQLITE3_FETCH_ROWS )
+{
+   psqlite3_stmt pStmt = ( psqlite3_stmt ) hb_parptr( 1 );
+
+   if( pStmt )
+   {
+      HB_SIZE  nLimit = hb_parns( 2 ), nRow = 0;
+      int      iCols = sqlite3_column_count( pStmt );
+      int      rc = SQLITE_ROW;
+      PHB_ITEM pResult = hb_itemArrayNew( nLimit > 0 && nLimit <= 0x10000 ? nLimit : 0 );
+
+      while( nLimit == 0 || nRow < nLimit )
+      {
+         PHB_ITEM pRow;
+         int      iCol;
+
+         rc = sqlite3_step( pStmt );
+         if( rc != SQLITE_ROW )
+            break;
+
+         if( ++nRow > hb_arrayLen( pResult ) )
+            hb_arraySize( pResult, nRow + ( nRow >> 1 ) );
+         pRow = hb_arrayGetItemPtr( pResult, nRow );
+         hb_arrayNew( pRow, iCols );
+         for( iCol = 0; iCol < iCols; iCol++ )
+            hb_sqlite3_column_item( pStmt, iCol, hb_arrayGetItemPtr( pRow, iCol + 1 ) );
+      }
+      hb_arraySize( pResult, nRow );
+
+      hb_storni( rc, 3 );
+      hb_itemReturnRelease( pResult );
+   }
+   else
+      hb_errRT_BASE_SubstR( EG_ARG, 0, NULL, HB_ERR_FUNCNAME, HB_ERR_ARGS_BASEPARAMS );
+}
+
+/**
+   Bulk transfer between work area and table
+ */
+
+static const char * hb_sqlite3_fieldDecl( LPFIELD pField )
+{
+   switch( pField->uiType )
+   {
+      case HB_FT_STRING:
+      case HB_FT_VARLENGTH:
+      case HB_FT_MEMO:
+         return ( pField->uiFlags & HB_FF_BINARY ) ? "BLOB" : "TEXT";
+      case HB_FT_IMAGE:
+      case HB_FT_BLOB:
+      case HB_FT_OLE:
+         return "BLOB";
+      case HB_FT_LOGICAL:
+         return "BOOLEAN";
+      case HB_FT_DATE:
+         return "DATE";
+      case HB_FT_TIME:
+      case HB_FT_TIMESTAMP:
+      case HB_FT_MODTIME:
+         return "DATETIME";
+      case HB_FT_LONG:
+      case HB_FT_INTEGER:
+      case HB_FT_AUTOINC:
+      case HB_FT_ROWVER:
+         return pField->uiDec > 0 ? "REAL" : "INTEGER";
+      case HB_FT_FLOAT:
+      case HB_FT_DOUBLE:
+      case HB_FT_CURRENCY:
+      case HB_FT_CURDOUBLE:
+         return "REAL";
+   }
+   return "";
+}
+
+static int hb_sqlite3_bind_field( psqlite3_stmt pStmt, int iParam, LPFIELD pField, PHB_ITEM pItem )
+{
+   if( HB_IS_STRING( pItem ) )
+   {
+      const char * pszValue = hb_itemGetCPtr( pItem );
+      HB_SIZE      nLen = hb_itemGetCLen( pItem );
+
+      if( pField->uiFlags & HB_FF_BINARY )
+         return sqlite3_bind_blob( pStmt, iParam, pszValue, ( int ) nLen, SQLITE_TRANSIENT );
+
+      if( pField->uiType == HB_FT_STRING )
+      {
+         nLen = hb_strRTrimLen( pszValue, nLen, HB_FALSE );
+         if( nLen < hb_itemGetCLen( pItem ) )
+            hb_itemPutCL( pItem, pszValue, nLen );
+      }
+   }
+   return hb_sqlite3_bind_item( pStmt, iParam, pItem );
+}
+
+static HB_ERRCODE hb_sqlite3_column_field( psqlite3_stmt pStmt, int iCol, LPFIELD pField, PHB_ITEM pItem )
+{
+   int iType = sqlite3_column_type( pStmt, iCol );
+
+   if( iType == SQLITE_NULL )
+      return HB_FAILURE;
+
+   switch( pField->uiType )
+   {
+      case HB_FT_LOGICAL:
+         if( iType == SQLITE_TEXT )
+         {
+            const char * pszValue = ( const char * ) sqlite3_column_text( pStmt, iCol );
+
+            hb_itemPutL( pItem, *pszValue == 'T' || *pszValue == 't' ||
+                                *pszValue == 'Y' || *pszValue == 'y' ||
+                                ( *pszValue >= '1' && *pszValue <= '9' ) );
+         }
+         else
+            hb_itemPutL( pItem, sqlite3_column_double( pStmt, iCol ) != 0 );
+         break;
+
+      case HB_FT_DATE:
+      case HB_FT_TIME:
+      case HB_FT_TIMESTAMP:
+      case HB_FT_MODTIME:
+      {
+         long lDate, lTime;
+
+         if( iType != SQLITE_TEXT ||
+             ! hb_timeStampStrGetDT( ( const char * ) sqlite3_column_text( pStmt, iCol ), &lDate, &lTime ) )
+            return HB_FAILURE;
+         if( pField->uiType == HB_FT_DATE )
+            hb_itemPutDL( pItem, lDate );
+         else
+            hb_itemPutTDT( pItem, lDate, lTime );
+         break;
+      }
+
+      case HB_FT_LONG:
+      case HB_FT_FLOAT:
+      case HB_FT_INTEGER:
+      case HB_FT_DOUBLE:
+      case HB_FT_CURRENCY:
+      case HB_FT_CURDOUBLE:
+      case HB_FT_AUTOINC:
+      case HB_FT_ROWVER:
+         if( iType == SQLITE_INTEGER )
+            hb_itemPutNInt( pItem, sqlite3_column_int64( pStmt, iCol ) );
+         else
+            hb_itemPutND( pItem, sqlite3_column_double( pStmt, iCol ) );
+         break;
+
+      case HB_FT_STRING:
+      case HB_FT_VARLENGTH:
+      case HB_FT_MEMO:
+      case HB_FT_IMAGE:
+      case HB_FT_BLOB:
+      case HB_FT_OLE:
+         if( iType == SQLITE_BLOB || ( pField->uiFlags & HB_FF_BINARY ) ||
+             pField->uiType == HB_FT_IMAGE || pField->uiType == HB_FT_BLOB ||
+             pField->uiType == HB_FT_OLE )
+            hb_itemPutCL( pItem, ( const char * ) sqlite3_column_blob( pStmt, iCol ),
+                          sqlite3_column_bytes( pStmt, iCol ) );
+         else
+            hb_itemPutStrLenUTF8( pItem, ( const char * ) sqlite3_column_text( pStmt, iCol ),
+                                  sqlite3_column_bytes( pStmt, iCol ) );
+         break;
+
+      default:
+         hb_sqlite3_column_item( pStmt, iCol, pItem );
+         break;
+   }
+
+   return HB_SUCCESS;
+}
+
+static void hb_sqlite3_quoteName( char * szBuffer, HB_SIZE nSize, HB_SIZE * pnLen, const char * szName )
+{
+   HB_SIZE nLen = *pnLen;
+
+   if( nLen < nSize )
+      szBuffer[ nLen++ ] = '"';
+   while( *szName && nLen < nSize )
+   {
+      if( *szName == '"' && nLen + 1 < nSize )
+         szBuffer[ nLen++ ] = '"';
+      szBuffer[ nLen++ ] = *szName++;
+   }
+   if( nLen < nSize )
+      szBuffer[ nLen++ ] = '"';
+   *pnLen = nLen;
+}
+
+/* returns array with full paths of all open order bags */
+static PHB_ITEM hb_sqlite3_orderBags( AREAP pArea )
+{
+   PHB_ITEM    pBags = hb_itemArrayNew( 0 );
+   DBORDERINFO pInfo;
+   int         iCount, i;
+
+   memset( &pInfo, 0, sizeof( pInfo ) );
+   pInfo.itmResult = hb_itemPutNI( NULL, 0 );
+   SELF_ORDINFO( pArea, DBOI_ORDERCOUNT, &pInfo );
+   iCount = hb_itemGetNI( pInfo.itmResult );
+
+   pInfo.itmOrder = hb_itemNew( NULL );
+   for( i = 1; i <= iCount; i++ )
+   {
+      hb_itemPutNI( pInfo.itmOrder, i );
+      hb_itemPutC( pInfo.itmResult, NULL );
+      if( SELF_ORDINFO( pArea, DBOI_FULLPATH, &pInfo ) == HB_SUCCESS &&
+          hb_itemGetCLen( pInfo.itmResult ) > 0 )
+      {
+         HB_SIZE nPos = hb_arrayLen( pBags );
+
+         while( nPos > 0 && strcmp( hb_arrayGetCPtr( pBags, nPos ),
+                                    hb_itemGetCPtr( pInfo.itmResult ) ) != 0 )
+            --nPos;
+         if( nPos == 0 )
+            hb_arrayAdd( pBags, pInfo.itmResult );
+      }
+   }
+   hb_itemRelease( pInfo.itmOrder );
+   hb_itemRelease( pInfo.itmResult );
+
+   return pBags;
+}
+
+/**
+   Export records of current work area to table
+
+   hb_sqlite3_dbExport( db, cTable, [lCreate = .T.], [nBatch = 10000], [@nRows] )
+   --> nResultCode
+
+   Records are read from the top of active order respecting filter and
+   SET DELETED. When lCreate is .T. the table is created if it does not
+   exist yet with column affinities matching field types. Rows are
+   inserted by single prepared statement and committed every nBatch rows,
+   on error only the current batch is rolled back.
+ */
+
+HB_FUNC( HB_SQLITE3_DBEXPORT )
+{
+   HB_SQLITE3 * pHbSqlite3 = ( HB_SQLITE3 * ) hb_sqlite3_param( 1, HB_SQLITE3_DB, HB_TRUE );
+   AREAP        pArea = ( AREAP ) hb_rddGetCurrentWorkAreaPointer();
+
+   if( ! pArea )
+      hb_errRT_DBCMD( EG_NOTABLE, EDBCMD_NOTABLE, NULL, HB_ERR_FUNCNAME );
+   else if( pHbSqlite3 && pHbSqlite3->db && HB_ISCHAR( 2 ) )
+   {
+      HB_USHORT     uiFields = 0, uiField;
+      HB_SIZE       nSize, nCreate = 0, nInsert = 0, nRows = 0, nCommitted = 0;
+      HB_SIZE       nBatch = hb_parnsdef( 4, 10000 );
+      HB_BOOL       fTrans = sqlite3_get_autocommit( pHbSqlite3->db ) != 0;
+      char *        szCreate, * szInsert, * szName;
+      void *        hTable;
+      const char *  szTable = hb_parstr_utf8( 2, &hTable, NULL );
+      psqlite3_stmt pStmt = NULL;
+      int           rc;
+
+      if( hb_parnsdef( 4, 10000 ) <= 0 )
+         nBatch = HB_SIZE_MAX;
+
+      SELF_FIELDCOUNT( pArea, &uiFields );
+
+      szName = ( char * ) hb_xgrab( pArea->uiMaxFieldNameLength + 1 );
+      nSize = strlen( szTable ) * 2 + 64 + ( HB_SIZE ) uiFields * ( pArea->uiMaxFieldNameLength * 2 + 16 );
+      szCreate = ( char * ) hb_xgrab( nSize + 1 );
+      szInsert = ( char * ) hb_xgrab( nSize + 1 );
+
+      hb_strncpy( szCreate, "CREATE TABLE IF NOT EXISTS ", nSize );
+      nCreate = strlen( szCreate );
+      hb_sqlite3_quoteName( szCreate, nSize, &nCreate, szTable );
+      hb_strncpy( szInsert, "INSERT INTO ", nSize );
+      nInsert = strlen( szInsert );
+      hb_sqlite3_quoteName( szInsert, nSize, &nInsert, szTable );
+      szCreate[ nCreate++ ] = '(';
+      szInsert[ nInsert++ ] = '(';
+      for( uiField = 1; uiField <= uiFields; uiField++ )
+      {
+         const char * szDecl = hb_sqlite3_fieldDecl( pArea->lpFields + uiField - 1 );
+
+         SELF_FIELDNAME( pArea, uiField, szName );
+         if( uiField > 1 )
+         {
+            szCreate[ nCreate++ ] = ',';
+            szInsert[ nInsert++ ] = ',';
+         }
+         hb_sqlite3_quoteName( szCreate, nSize, &nCreate, szName );
+         hb_sqlite3_quoteName( szInsert, nSize, &nInsert, szName );
+         if( *szDecl )
+         {
+            szCreate[ nCreate++ ] = ' ';
+            hb_strncpy( szCreate + nCreate, szDecl, nSize - nCreate );
+            nCreate += strlen( szDecl );
+         }
+      }
+      szCreate[ nCreate++ ] = ')';
+      szCreate[ nCreate ] = '\0';
+      hb_strncpy( szInsert + nInsert, ") VALUES(", nSize - nInsert );
+      nInsert += 9;
+      for( uiField = 1; uiField <= uiFields; uiField++ )
+      {
+         if( uiField > 1 )
+            szInsert[ nInsert++ ] = ',';
+         szInsert[ nInsert++ ] = '?';
+      }
+      szInsert[ nInsert++ ] = ')';
+      szInsert[ nInsert ] = '\0';
+
+      rc = uiFields == 0 ? SQLITE_MISUSE : SQLITE_OK;
+      if( rc == SQLITE_OK && hb_parldef( 3, HB_TRUE ) )
+         rc = sqlite3_exec( pHbSqlite3->db, szCreate, NULL, NULL, NULL );
+      if( rc == SQLITE_OK )
+      {
+         const char * pszTail;
+
+         rc = sqlite3_prepare_v2( pHbSqlite3->db, szInsert, ( int ) nInsert, &pStmt, &pszTail );
+      }
+      if( rc == SQLITE_OK && fTrans )
+         rc = sqlite3_exec( pHbSqlite3->db, "BEGIN", NULL, NULL, NULL );
+
+      if( rc == SQLITE_OK && SELF_GOTOP( pArea ) == HB_SUCCESS )
+      {
+         PHB_ITEM pItem = hb_itemNew( NULL );
+         HB_BOOL  fEof = HB_FALSE;
+
+         while( SELF_EOF( pArea, &fEof ) == HB_SUCCESS && ! fEof )
+         {
+            for( uiField = 1; uiField <= uiFields && rc == SQLITE_OK; uiField++ )
+            {
+               if( SELF_GETVALUE( pArea, uiField, pItem ) != HB_SUCCESS )
+                  rc = SQLITE_ABORT;
+               else
+                  rc = hb_sqlite3_bind_field( pStmt, uiField, pArea->lpFields + uiField - 1, pItem );
+            }
+            if( rc == SQLITE_OK )
+            {
+               rc = sqlite3_step( pStmt );
+               if( rc == SQLITE_DONE )
+                  rc = SQLITE_OK;
+            }
+            sqlite3_reset( pStmt );
+            if( rc != SQLITE_OK )
+               break;
+
+            if( ++nRows % nBatch == 0 && fTrans )
+            {
+               rc = sqlite3_exec( pHbSqlite3->db, "COMMIT", NULL, NULL, NULL );
+               if( rc == SQLITE_OK )
+               {
+                  nCommitted = nRows;
+                  rc = sqlite3_exec( pHbSqlite3->db, "BEGIN", NULL, NULL, NULL );
+               }
+               if( rc != SQLITE_OK )
+                  break;
+            }
+            if( SELF_SKIP( pArea, 1 ) != HB_SUCCESS )
+            {
+               rc = SQLITE_ABORT;
+               break;
+            }
+         }
+         hb_itemRelease( pItem );
+
+         if( fTrans )
+         {
+            if( rc == SQLITE_OK )
+               rc = sqlite3_exec( pHbSqlite3->db, "COMMIT", NULL, NULL, NULL );
+            if( rc != SQLITE_OK )
+            {
+               if( ! sqlite3_get_autocommit( pHbSqlite3->db ) )
+                  sqlite3_exec( pHbSqlite3->db, "ROLLBACK", NULL, NULL, NULL );
+               /* only rows of already committed batches are stored */
+               nRows = nCommitted;
+            }
+         }
+      }
+      sqlite3_finalize( pStmt );
+
+      hb_xfree( szCreate );
+      hb_xfree( szInsert );
+      hb_xfree( szName );
+      hb_strfree( hTable );
+
+      hb_storns( nRows, 5 );
+      hb_retni( rc );
+   }
+   else
+      hb_errRT_BASE_SubstR( EG_ARG, 0, NULL, HB_ERR_FUNCNAME, HB_ERR_ARGS_BASEPARAMS );
+}
+
+/**
+   Append rows of query result to current work area
+
+   hb_sqlite3_dbImport( db, cSQLTEXT, [lDeferIndex = .F.], [@nRows] )
+   --> nResultCode
+
+   Result columns are assigned to fields with the same name, other
+   columns are ignored. Shared tables are locked for the whole import.
+   When lDeferIndex is .T. and the table is open in exclusive mode, open
+   order bags are detached during import and reopened and reindexed at
+   the end, otherwise indexes are updated for each appended record.
+ */
+
+HB_FUNC( HB_SQLITE3_DBIMPORT )
+{
+   HB_SQLITE3 * pHbSqlite3 = ( HB_SQLITE3 * ) hb_sqlite3_param( 1, HB_SQLITE3_DB, HB_TRUE );
+   AREAP        pArea = ( AREAP ) hb_rddGetCurrentWorkAreaPointer();
+
+   if( ! pArea )
+      hb_errRT_DBCMD( EG_NOTABLE, EDBCMD_NOTABLE, NULL, HB_ERR_FUNCNAME );
+   else if( pHbSqlite3 && pHbSqlite3->db && HB_ISCHAR( 2 ) )
+   {
+      void *        hSQLText;
+      HB_SIZE       nSQLText, nRows = 0;
+      const char *  pszSQLText = hb_parstr_utf8( 2, &hSQLText, &nSQLText );
+      const char *  pszTail;
+      psqlite3_stmt pStmt = NULL;
+      int           rc;
+
+      rc = sqlite3_prepare_v2( pHbSqlite3->db, pszSQLText, ( int ) nSQLText, &pStmt, &pszTail );
+      if( rc == SQLITE_OK && pStmt == NULL )
+         rc = SQLITE_MISUSE;  /* empty statement */
+
+      if( rc == SQLITE_OK )
+      {
+         int         iCols = sqlite3_column_count( pStmt ), iCol;
+         HB_USHORT * puiFields = ( HB_USHORT * ) hb_xgrabz( ( iCols + 1 ) * sizeof( HB_USHORT ) );
+         PHB_ITEM    pItem = hb_itemNew( NULL ), pBags = NULL, pFocus = NULL;
+         DBORDERINFO pOrderInfo;
+         DBLOCKINFO  dbLockInfo;
+         HB_BOOL     fShared, fLocked = HB_FALSE;
+         HB_ERRCODE  errCode = HB_SUCCESS;
+
+         for( iCol = 0; iCol < iCols; iCol++ )
+            puiFields[ iCol ] = ( HB_USHORT ) hb_rddFieldIndex( pArea, sqlite3_column_name( pStmt, iCol ) );
+
+         /* DBI_SHARED sets share mode when logical value is passed */
+         fShared = SELF_INFO( pArea, DBI_SHARED, pItem ) == HB_SUCCESS && hb_itemGetL( pItem );
+
+         memset( &pOrderInfo, 0, sizeof( pOrderInfo ) );
+         /* reindexing needs exclusive access */
+         if( hb_parl( 3 ) && ! fShared )
+         {
+            pBags = hb_sqlite3_orderBags( pArea );
+            if( hb_arrayLen( pBags ) > 0 )
+            {
+               pFocus = hb_itemPutC( NULL, NULL );
+               pOrderInfo.itmResult = pFocus;
+               SELF_ORDLSTFOCUS( pArea, &pOrderInfo );
+               pOrderInfo.itmResult = NULL;
+               /* with AUTOPEN disabled also structural bag is closed */
+               if( hb_setGetAutOpen() )
+               {
+                  hb_setSetItem( HB_SET_AUTOPEN, hb_itemPutL( pItem, HB_FALSE ) );
+                  errCode = SELF_ORDLSTCLEAR( pArea );
+                  hb_setSetItem( HB_SET_AUTOPEN, hb_itemPutL( pItem, HB_TRUE ) );
+               }
+               else
+                  errCode = SELF_ORDLSTCLEAR( pArea );
+            }
+         }
+
+         /* lock whole table instead of appended records */
+         memset( &dbLockInfo, 0, sizeof( dbLockInfo ) );
+         dbLockInfo.itmRecID = pItem;
+         dbLockInfo.uiMethod = DBLM_FILE;
+         if( errCode == HB_SUCCESS && fShared &&
+             SELF_INFO( pArea, DBI_ISFLOCK, pItem ) == HB_SUCCESS && ! hb_itemGetL( pItem ) )
+         {
+            errCode = SELF_LOCK( pArea, &dbLockInfo );
+            fLocked = errCode == HB_SUCCESS && dbLockInfo.fResult;
+            if( ! fLocked )
+               rc = SQLITE_LOCKED;
+         }
+
+         while( rc == SQLITE_OK && errCode == HB_SUCCESS )
+         {
+            rc = sqlite3_step( pStmt );
+            if( rc != SQLITE_ROW )
+            {
+               if( rc == SQLITE_DONE )
+                  rc = SQLITE_OK;
+               break;
+            }
+            rc = SQLITE_OK;
+            errCode = SELF_APPEND( pArea, HB_FALSE );
+            for( iCol = 0; iCol < iCols && errCode == HB_SUCCESS; iCol++ )
+            {
+               HB_USHORT uiField = puiFields[ iCol ];
+
+               if( uiField && hb_sqlite3_column_field( pStmt, iCol, pArea->lpFields + uiField - 1, pItem ) == HB_SUCCESS )
+                  errCode = SELF_PUTVALUE( pArea, uiField, pItem );
+            }
+            if( errCode == HB_SUCCESS )
+               ++nRows;
+         }
+         if( errCode != HB_SUCCESS && rc == SQLITE_OK )
+            rc = SQLITE_ABORT;
+
+         SELF_GOCOLD( pArea );
+         if( fLocked )
+            SELF_UNLOCK( pArea, NULL );
+
+         if( pFocus )
+         {
+            PHB_ITEM pOpen = hb_sqlite3_orderBags( pArea );
+            HB_SIZE  nBag, nOpen;
+
+            for( nBag = 1; nBag <= hb_arrayLen( pBags ); nBag++ )
+            {
+               const char * szBag = hb_arrayGetCPtr( pBags, nBag );
+
+               for( nOpen = hb_arrayLen( pOpen ); nOpen > 0; --nOpen )
+               {
+                  if( strcmp( hb_arrayGetCPtr( pOpen, nOpen ), szBag ) == 0 )
+                     break;
+               }
+               if( nOpen == 0 )
+               {
+                  pOrderInfo.atomBagName = hb_arrayGetItemPtr( pBags, nBag );
+                  SELF_ORDLSTADD( pArea, &pOrderInfo );
+               }
+            }
+            pOrderInfo.atomBagName = NULL;
+            if( hb_arrayLen( pOpen ) < hb_arrayLen( pBags ) )
+               SELF_ORDLSTREBUILD( pArea );
+            hb_itemRelease( pOpen );
+
+            pOrderInfo.itmOrder = pFocus;
+            SELF_ORDLSTFOCUS( pArea, &pOrderInfo );
+            hb_itemRelease( pFocus );
+         }
+         if( pBags )
+            hb_itemRelease( pBags );
+
+         hb_itemRelease( pItem );
+         hb_xfree( puiFields );
+      }
+      sqlite3_finalize( pStmt );
+
+      hb_strfree( hSQLText );
+
+      hb_storns( nRows, 4 );
+      hb_retni( rc );
+   }
+   else
+      hb_errRT_BASE_SubstR( EG_ARG, 0, NULL, HB_ERR_FUNCNAME, HB_ERR_ARGS_BASEPARAMS );
+}
+
 /**
    Extract Metadata About A Column Of A Table
    based on
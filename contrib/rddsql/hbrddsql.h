@@ -65,6 +65,13 @@
 #define SQLDD_FLAG_CACHED    2
 
 
+typedef struct _SQLROWBLOCK
+{
+   HB_FOFFSET nOffset;                       /* position in temporary file */
+   HB_SIZE    nSize;                         /* 0 - block is not written or it was changed */
+} SQLROWBLOCK, * PSQLROWBLOCK;
+
+
 typedef struct _SQLBASEAREA
 {
    AREA area;
@@ -86,6 +93,16 @@ typedef struct _SQLBASEAREA
    void **   pRow;                           /* array of native pointers or cached PHB_ITEM */
    HB_BYTE * pRowFlags;
 
+   HB_ULONG ulRowWindow;                     /* Rows kept in memory, 0 - whole query is cached */
+   HB_ULONG ulRowBase;                       /* Record number preceding pRow[ 1 ] */
+   HB_ULONG ulRowCount;                      /* Rows in pRow buffer */
+   HB_BOOL  fRowSpill;                       /* Save rows out of window in temporary file */
+
+   PHB_FILE     pSpillFile;                  /* temporary file for rows out of window */
+   char *       szSpillFile;
+   PSQLROWBLOCK pSpillBlock;                 /* array of rows blocks stored in temporary file */
+   HB_ULONG     ulSpillBlocks;               /* Size of pSpillBlock buffer */
+
    void *  pRecord;                          /* current record */
    HB_BYTE bRecordFlags;
 
@@ -229,12 +246,19 @@ typedef struct _SDDNODE
 #define ESQLDD_CONNALLOC     1912
 #define ESQLDD_ENVALLOC      1913
 #define ESQLDD_EXECUTE       1914
+#define ESQLDD_NOTCACHED     1915
+#define ESQLDD_TEMPFILE      1916
 
 HB_EXTERN_BEGIN
 
 extern HB_EXPORT int hb_sddRegister( PSDDNODE pSdd );
 extern HB_EXPORT void hb_rddsqlSetError( HB_ERRCODE errCode, const char * szError, const char * szQuery, PHB_ITEM pItem, unsigned long ulAffectedRows );
 
+/* row buffer for SDDs fetching query result from cursor */
+extern HB_EXPORT void hb_rddsqlRowsetInit( SQLBASEAREAP pArea, PHB_ITEM pItemEof );
+extern HB_EXPORT HB_ERRCODE hb_rddsqlRowsetAdd( SQLBASEAREAP pArea, PHB_ITEM pRow );
+extern HB_EXPORT HB_ERRCODE hb_rddsqlRowsetGoTo( SQLBASEAREAP pArea, HB_ULONG ulRecNo );
+
 HB_EXTERN_END
 
 #endif
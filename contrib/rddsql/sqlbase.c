@@ -49,6 +49,7 @@
 #include "hbvm.h"
 #include "hbset.h"
 #include "hbrddsql.h"
+#include "hbserial.ch"
 #include "rddsys.ch"
 
 #include "hbtrace.h"
@@ -70,6 +71,9 @@ static char *        s_szQuery        = NULL;
 static PHB_ITEM      s_pItemNewID     = NULL;
 static unsigned long s_ulAffectedRows = 0;
 
+static HB_ULONG s_ulRowsetSize  = 0;
+static HB_BOOL  s_fRowsetSpill  = HB_FALSE;
+
 static RDDFUNCS sqlbaseSuper;
 
 
@@ -263,6 +267,301 @@ int hb_sddRegister( PSDDNODE pSdd )
 }
 
 
+/* --- Rowset --- */
+
+/* By default all rows fetched by SDD are cached in pRow buffer. If
+   RDDI_ROWSETSIZE is set then the buffer keeps at most two blocks of
+   ulRowWindow rows. When it is full the older block is released or,
+   if RDDI_ROWSETSPILL is set, saved in temporary file and loaded back
+   when the record is accessed again. */
+
+static void sqlbaseRowsetChanged( SQLBASEAREAP pArea, HB_ULONG ulRecNo )
+{
+   HB_ULONG ulBlock = ( ulRecNo - 1 ) / pArea->ulRowWindow;
+
+   if( ulBlock < pArea->ulSpillBlocks )
+      pArea->pSpillBlock[ ulBlock ].nSize = 0;
+}
+
+
+static HB_ERRCODE sqlbaseRowsetSave( SQLBASEAREAP pArea, HB_ULONG ulIndex, HB_ULONG ulRows )
+{
+   HB_ULONG ulBlock = ( pArea->ulRowBase + ulIndex - 1 ) / pArea->ulRowWindow;
+   PSQLROWBLOCK pBlock;
+   PHB_ITEM     pRows;
+   char *       pBuffer;
+   HB_SIZE      nSize;
+   HB_ULONG     ul;
+
+   /* block was loaded from temporary file and it is not changed */
+   if( ulBlock < pArea->ulSpillBlocks && pArea->pSpillBlock[ ulBlock ].nSize != 0 )
+      return HB_SUCCESS;
+
+   if( ! pArea->pSpillFile )
+   {
+      char szName[ HB_PATH_MAX ];
+
+      pArea->pSpillFile = hb_fileCreateTemp( NULL, NULL, FC_NORMAL, szName );
+      if( ! pArea->pSpillFile )
+      {
+         hb_errRT_SQLBASE( EG_CREATE, ESQLDD_TEMPFILE, "Cannot create temporary file", szName );
+         return HB_FAILURE;
+      }
+      pArea->szSpillFile = hb_strdup( szName );
+   }
+
+   if( ulBlock >= pArea->ulSpillBlocks )
+   {
+      HB_ULONG ulSize = ulBlock + SQLDD_ROWSET_RESIZE;
+
+      pArea->pSpillBlock = ( PSQLROWBLOCK ) hb_xrealloc( pArea->pSpillBlock, ulSize * sizeof( SQLROWBLOCK ) );
+      memset( pArea->pSpillBlock + pArea->ulSpillBlocks, 0, ( ulSize - pArea->ulSpillBlocks ) * sizeof( SQLROWBLOCK ) );
+      pArea->ulSpillBlocks = ulSize;
+   }
+
+   /* { cFlags, aRow1, aRow2, ... } */
+   pRows = hb_itemArrayNew( ulRows + 1 );
+   hb_arraySetCL( pRows, 1, ( const char * ) pArea->pRowFlags + ulIndex, ulRows );
+   for( ul = 0; ul < ulRows; ul++ )
+   {
+      if( pArea->pRowFlags[ ulIndex + ul ] & SQLDD_FLAG_CACHED )
+         hb_arraySet( pRows, ul + 2, ( PHB_ITEM ) pArea->pRow[ ulIndex + ul ] );
+   }
+   pBuffer = hb_itemSerialize( pRows, HB_SERIALIZE_NUMSIZE | HB_SERIALIZE_IGNOREREF, &nSize );
+   hb_itemRelease( pRows );
+
+   pBlock = pArea->pSpillBlock + ulBlock;
+   pBlock->nOffset = hb_fileSize( pArea->pSpillFile );
+   if( hb_fileWriteAt( pArea->pSpillFile, pBuffer, nSize, pBlock->nOffset ) != nSize )
+   {
+      hb_xfree( pBuffer );
+      hb_errRT_SQLBASE( EG_WRITE, ESQLDD_TEMPFILE, "Cannot write temporary file", pArea->szSpillFile );
+      return HB_FAILURE;
+   }
+   pBlock->nSize = nSize;
+   hb_xfree( pBuffer );
+
+   return HB_SUCCESS;
+}
+
+
+/* remove ulRows first rows from the buffer */
+static HB_ERRCODE sqlbaseRowsetDrop( SQLBASEAREAP pArea, HB_ULONG ulRows )
+{
+   HB_ERRCODE errCode = HB_SUCCESS;
+   HB_ULONG   ulIndex;
+
+   if( pArea->fRowSpill )
+   {
+      for( ulIndex = 1; ulIndex <= ulRows && errCode == HB_SUCCESS; ulIndex += pArea->ulRowWindow )
+         errCode = sqlbaseRowsetSave( pArea, ulIndex, HB_MIN( pArea->ulRowWindow, ulRows - ulIndex + 1 ) );
+   }
+
+   for( ulIndex = 1; ulIndex <= ulRows; ulIndex++ )
+   {
+      if( pArea->pRowFlags[ ulIndex ] & SQLDD_FLAG_CACHED )
+         hb_itemRelease( ( PHB_ITEM ) pArea->pRow[ ulIndex ] );
+   }
+
+   pArea->ulRowCount -= ulRows;
+   pArea->ulRowBase  += ulRows;
+   if( pArea->ulRowCount )
+   {
+      memmove( pArea->pRow + 1, pArea->pRow + 1 + ulRows, pArea->ulRowCount * sizeof( void * ) );
+      memmove( pArea->pRowFlags + 1, pArea->pRowFlags + 1 + ulRows, pArea->ulRowCount * sizeof( HB_BYTE ) );
+   }
+   return errCode;
+}
+
+
+/* replace the buffer with the block containing ulRecNo */
+static HB_ERRCODE sqlbaseRowsetLoad( SQLBASEAREAP pArea, HB_ULONG ulRecNo )
+{
+   HB_ULONG ulBlock = ( ulRecNo - 1 ) / pArea->ulRowWindow;
+
+   if( sqlbaseRowsetDrop( pArea, pArea->ulRowCount ) != HB_SUCCESS )
+      return HB_FAILURE;
+
+   pArea->ulRowBase = ulBlock * pArea->ulRowWindow;
+   if( pArea->ulRowBase < pArea->ulRecCount )
+   {
+      PSQLROWBLOCK pBlock;
+      PHB_ITEM     pRows = NULL;
+
+      if( ulBlock >= pArea->ulSpillBlocks || pArea->pSpillBlock[ ulBlock ].nSize == 0 )
+      {
+         hb_errRT_SQLBASE( EG_READ, ESQLDD_NOTCACHED, "Record is not cached", NULL );
+         return HB_FAILURE;
+      }
+
+      pBlock = pArea->pSpillBlock + ulBlock;
+      {
+         char * pBuffer = ( char * ) hb_xgrab( pBlock->nSize );
+
+         if( hb_fileReadAt( pArea->pSpillFile, pBuffer, pBlock->nSize, pBlock->nOffset ) == pBlock->nSize )
+         {
+            const char * pData = pBuffer;
+            HB_SIZE      nSize = pBlock->nSize;
+
+            pRows = hb_itemDeserialize( &pData, &nSize );
+         }
+         hb_xfree( pBuffer );
+      }
+
+      if( pRows && HB_IS_ARRAY( pRows ) && hb_arrayGetCLen( pRows, 1 ) == hb_arrayLen( pRows ) - 1 )
+      {
+         HB_ULONG ulRows = ( HB_ULONG ) hb_arrayLen( pRows ) - 1, ul;
+
+         memcpy( pArea->pRowFlags + 1, hb_arrayGetCPtr( pRows, 1 ), ulRows );
+         for( ul = 1; ul <= ulRows; ul++ )
+         {
+            if( pArea->pRowFlags[ ul ] & SQLDD_FLAG_CACHED )
+               pArea->pRow[ ul ] = hb_itemNew( hb_arrayGetItemPtr( pRows, ul + 1 ) );
+            else
+               pArea->pRow[ ul ] = NULL;
+         }
+         pArea->ulRowCount = ulRows;
+         hb_itemRelease( pRows );
+      }
+      else
+      {
+         if( pRows )
+            hb_itemRelease( pRows );
+         hb_errRT_SQLBASE( EG_READ, ESQLDD_TEMPFILE, "Cannot read temporary file", pArea->szSpillFile );
+         return HB_FAILURE;
+      }
+   }
+   return HB_SUCCESS;
+}
+
+
+static void sqlbaseRowsetFree( SQLBASEAREAP pArea )
+{
+   if( pArea->pRow )
+   {
+      HB_ULONG ulIndex, ulCount;
+
+      ulCount = pArea->ulRowWindow ? pArea->ulRowCount : pArea->ulRecCount;
+      for( ulIndex = 0; ulIndex <= ulCount; ulIndex++ )
+      {
+         if( pArea->pRowFlags[ ulIndex ] & SQLDD_FLAG_CACHED )
+            hb_itemRelease( ( PHB_ITEM ) pArea->pRow[ ulIndex ] );
+      }
+      hb_xfree( pArea->pRow );
+      hb_xfree( pArea->pRowFlags );
+      pArea->pRow      = NULL;
+      pArea->pRowFlags = NULL;
+   }
+
+   if( pArea->pSpillFile )
+   {
+      hb_fileClose( pArea->pSpillFile );
+      pArea->pSpillFile = NULL;
+   }
+   if( pArea->szSpillFile )
+   {
+      hb_fileDelete( pArea->szSpillFile );
+      hb_xfree( pArea->szSpillFile );
+      pArea->szSpillFile = NULL;
+   }
+   if( pArea->pSpillBlock )
+   {
+      hb_xfree( pArea->pSpillBlock );
+      pArea->pSpillBlock   = NULL;
+      pArea->ulSpillBlocks = 0;
+   }
+}
+
+
+void hb_rddsqlRowsetInit( SQLBASEAREAP pArea, PHB_ITEM pItemEof )
+{
+   pArea->ulRowWindow = s_ulRowsetSize;
+   pArea->fRowSpill   = s_fRowsetSpill;
+   pArea->ulRowBase   = 0;
+   pArea->ulRowCount  = 0;
+   pArea->ulRecCount  = 0;
+   pArea->ulRecMax    = pArea->ulRowWindow ? pArea->ulRowWindow * 2 + 1 : SQLDD_ROWSET_INIT;
+
+   pArea->pRow      = ( void ** ) hb_xgrab( pArea->ulRecMax * sizeof( void * ) );
+   pArea->pRowFlags = ( HB_BYTE * ) hb_xgrab( pArea->ulRecMax * sizeof( HB_BYTE ) );
+
+   pArea->pRow[ 0 ]      = pItemEof;
+   pArea->pRowFlags[ 0 ] = SQLDD_FLAG_CACHED;
+}
+
+
+/* add new record at the end of query, pRow can be NULL for appended record.
+   pRow is always owned by the row buffer, on failure it is released. */
+HB_ERRCODE hb_rddsqlRowsetAdd( SQLBASEAREAP pArea, PHB_ITEM pRow )
+{
+   HB_ULONG ulIndex;
+
+   if( pArea->ulRowWindow )
+   {
+      HB_ERRCODE errCode = HB_SUCCESS;
+
+      if( pArea->ulRowBase + pArea->ulRowCount != pArea->ulRecCount )
+         errCode = sqlbaseRowsetLoad( pArea, pArea->ulRecCount + 1 );
+      else if( pArea->ulRowCount >= pArea->ulRowWindow * 2 )
+         errCode = sqlbaseRowsetDrop( pArea, pArea->ulRowWindow );
+
+      if( errCode != HB_SUCCESS )
+      {
+         if( pRow )
+            hb_itemRelease( pRow );
+         return errCode;
+      }
+
+      sqlbaseRowsetChanged( pArea, pArea->ulRecCount + 1 );
+      ulIndex = ++pArea->ulRowCount;
+   }
+   else
+   {
+      if( pArea->ulRecCount + 1 >= pArea->ulRecMax )
+      {
+         pArea->pRow      = ( void ** ) hb_xrealloc( pArea->pRow, ( pArea->ulRecMax + SQLDD_ROWSET_RESIZE ) * sizeof( void * ) );
+         pArea->pRowFlags = ( HB_BYTE * ) hb_xrealloc( pArea->pRowFlags, ( pArea->ulRecMax + SQLDD_ROWSET_RESIZE ) * sizeof( HB_BYTE ) );
+         pArea->ulRecMax += SQLDD_ROWSET_RESIZE;
+      }
+      ulIndex = pArea->ulRecCount + 1;
+   }
+
+   pArea->ulRecCount++;
+   pArea->pRow[ ulIndex ]      = pRow;
+   pArea->pRowFlags[ ulIndex ] = pRow ? SQLDD_FLAG_CACHED : 0;
+
+   return HB_SUCCESS;
+}
+
+
+HB_ERRCODE hb_rddsqlRowsetGoTo( SQLBASEAREAP pArea, HB_ULONG ulRecNo )
+{
+   HB_ERRCODE errCode = HB_SUCCESS;
+   HB_ULONG   ulIndex = ulRecNo > pArea->ulRecCount ? 0 : ulRecNo;
+
+   if( ulIndex && pArea->ulRowWindow )
+   {
+      if( ulRecNo <= pArea->ulRowBase || ulRecNo > pArea->ulRowBase + pArea->ulRowCount )
+      {
+         if( pArea->fRowSpill )
+            errCode = sqlbaseRowsetLoad( pArea, ulRecNo );
+         else
+         {
+            hb_errRT_SQLBASE( EG_UNSUPPORTED, ESQLDD_NOTCACHED, "Record is not cached", NULL );
+            errCode = HB_FAILURE;
+         }
+      }
+      ulIndex = errCode == HB_SUCCESS ? ulIndex - pArea->ulRowBase : 0;
+   }
+
+   pArea->pRecord      = pArea->pRow[ ulIndex ];
+   pArea->bRecordFlags = pArea->pRowFlags[ ulIndex ];
+   pArea->fPositioned  = ulIndex != 0;
+
+   return errCode;
+}
+
+
 /* --- RDD METHODS --- */
 
 static HB_ERRCODE sqlbaseGoBottom( SQLBASEAREAP pArea )
@@ -419,15 +718,10 @@ static HB_ERRCODE sqlbaseAppend( SQLBASEAREAP pArea, HB_BOOL bUnLockAll )
    if( ! pArea->fRecordChanged && SELF_GOHOT( &pArea->area ) == HB_FAILURE )
       return HB_FAILURE;
 
-   if( pArea->ulRecCount + 1 >= pArea->ulRecMax )
-   {
-      pArea->pRow      = ( void ** ) hb_xrealloc( pArea->pRow, ( pArea->ulRecMax + SQLDD_ROWSET_RESIZE ) * sizeof( void * ) );
-      pArea->pRowFlags = ( HB_BYTE * ) hb_xrealloc( pArea->pRowFlags, ( pArea->ulRecMax + SQLDD_ROWSET_RESIZE ) * sizeof( HB_BYTE ) );
-      pArea->ulRecMax += SQLDD_ROWSET_RESIZE;
-   }
+   if( hb_rddsqlRowsetAdd( pArea, NULL ) != HB_SUCCESS )
+      return HB_FAILURE;
 
    pArea->fAppend = pArea->fPositioned = HB_TRUE;
-   pArea->ulRecCount++;
    pArea->ulRecNo   = pArea->ulRecCount;
    pArea->area.fBof = pArea->area.fEof = pArea->area.fFound = HB_FALSE;
    return HB_SUCCESS;
@@ -485,10 +779,17 @@ static HB_ERRCODE sqlbaseGoCold( SQLBASEAREAP pArea )
 {
    if( pArea->fRecordChanged )
    {
-      if( ! pArea->fAppend && pArea->pRowFlags[ pArea->ulRecNo ] & SQLDD_FLAG_CACHED )
-         hb_itemRelease( ( PHB_ITEM ) ( pArea->pRow[ pArea->ulRecNo ] ) );
-      pArea->pRow[ pArea->ulRecNo ]      = pArea->pRecord;
-      pArea->pRowFlags[ pArea->ulRecNo ] = pArea->bRecordFlags;
+      HB_ULONG ulIndex = pArea->ulRecNo;
+
+      if( pArea->ulRowWindow )
+      {
+         sqlbaseRowsetChanged( pArea, ulIndex );
+         ulIndex -= pArea->ulRowBase;
+      }
+      if( ! pArea->fAppend && pArea->pRowFlags[ ulIndex ] & SQLDD_FLAG_CACHED )
+         hb_itemRelease( ( PHB_ITEM ) ( pArea->pRow[ ulIndex ] ) );
+      pArea->pRow[ ulIndex ]      = pArea->pRecord;
+      pArea->pRowFlags[ ulIndex ] = pArea->bRecordFlags;
       pArea->fRecordChanged = HB_FALSE;
       pArea->fAppend        = HB_FALSE;
    }
@@ -610,20 +911,7 @@ static HB_ERRCODE sqlbaseClose( SQLBASEAREAP pArea )
    if( pArea->pSDD )
       pArea->pSDD->Close( pArea );
 
-   if( pArea->pRow )
-   {
-      HB_ULONG ulIndex;
-
-      for( ulIndex = 0; ulIndex <= pArea->ulRecCount; ulIndex++ )
-      {
-         if( pArea->pRowFlags[ ulIndex ] & SQLDD_FLAG_CACHED )
-            hb_itemRelease( ( PHB_ITEM ) pArea->pRow[ ulIndex ] );
-      }
-      hb_xfree( pArea->pRow );
-      hb_xfree( pArea->pRowFlags );
-      pArea->pRow      = NULL;
-      pArea->pRowFlags = NULL;
-   }
+   sqlbaseRowsetFree( pArea );
 
    if( pArea->szQuery )
    {
@@ -1076,6 +1364,29 @@ static HB_ERRCODE sqlbaseRddInfo( LPRDDNODE pRDD, HB_USHORT uiIndex, HB_ULONG ul
          hb_itemPutNInt( pItem, s_ulAffectedRows );
          return HB_SUCCESS;
 
+      case RDDI_ROWSETSIZE:
+      {
+         HB_ULONG ulRowsetSize = s_ulRowsetSize;
+
+         if( hb_itemType( pItem ) & HB_IT_NUMERIC )
+         {
+            HB_MAXINT nSize = hb_itemGetNInt( pItem );
+            s_ulRowsetSize = nSize > 0 ? ( HB_ULONG ) nSize : 0;
+         }
+         hb_itemPutNInt( pItem, ulRowsetSize );
+         return HB_SUCCESS;
+      }
+
+      case RDDI_ROWSETSPILL:
+      {
+         HB_BOOL fRowsetSpill = s_fRowsetSpill;
+
+         if( hb_itemType( pItem ) & HB_IT_LOGICAL )
+            s_fRowsetSpill = hb_itemGetL( pItem );
+         hb_itemPutL( pItem, fRowsetSpill );
+         return HB_SUCCESS;
+      }
+
 #if 0
       default:
          return SUPER_RDDINFO( pRDD, uiIndex, ulConnect, pItem );
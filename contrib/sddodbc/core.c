@@ -659,14 +659,7 @@ static HB_ERRCODE odbcOpen( SQLBASEAREAP pArea )
       return HB_FAILURE;
    }
 
-   pArea->ulRecCount = 0;
-   pArea->ulRecMax   = SQLDD_ROWSET_INIT;
-
-   pArea->pRow = ( void ** ) hb_xgrab( SQLDD_ROWSET_INIT * sizeof( void * ) );
-   pArea->pRowFlags = ( HB_BYTE * ) hb_xgrab( SQLDD_ROWSET_INIT * sizeof( HB_BYTE ) );
-
-   pArea->pRow[ 0 ]      = pItemEof;
-   pArea->pRowFlags[ 0 ] = SQLDD_FLAG_CACHED;
+   hb_rddsqlRowsetInit( pArea, pItemEof );
 
    pSDDData->hStmt = hStmt;
    return HB_SUCCESS;
@@ -856,29 +849,9 @@ static HB_ERRCODE odbcGoTo( SQLBASEAREAP pArea, HB_ULONG ulRecNo )
       if( pItem )
          hb_itemRelease( pItem );
 
-      if( pArea->ulRecCount + 1 >= pArea->ulRecMax )
-      {
-         pArea->pRow      = ( void ** ) hb_xrealloc( pArea->pRow, ( pArea->ulRecMax + SQLDD_ROWSET_RESIZE ) * sizeof( void * ) );
-         pArea->pRowFlags = ( HB_BYTE * ) hb_xrealloc( pArea->pRowFlags, ( pArea->ulRecMax + SQLDD_ROWSET_RESIZE ) * sizeof( HB_BYTE ) );
-         pArea->ulRecMax += SQLDD_ROWSET_RESIZE;
-      }
-
-      pArea->ulRecCount++;
-      pArea->pRow[ pArea->ulRecCount ]      = pArray;
-      pArea->pRowFlags[ pArea->ulRecCount ] = SQLDD_FLAG_CACHED;
+      if( hb_rddsqlRowsetAdd( pArea, pArray ) != HB_SUCCESS )
+         return HB_FAILURE;
    }
 
-   if( ulRecNo == 0 || ulRecNo > pArea->ulRecCount )
-   {
-      pArea->pRecord      = pArea->pRow[ 0 ];
-      pArea->bRecordFlags = pArea->pRowFlags[ 0 ];
-      pArea->fPositioned  = HB_FALSE;
-   }
-   else
-   {
-      pArea->pRecord      = pArea->pRow[ ulRecNo ];
-      pArea->bRecordFlags = pArea->pRowFlags[ ulRecNo ];
-      pArea->fPositioned  = HB_TRUE;
-   }
-   return HB_SUCCESS;
+   return hb_rddsqlRowsetGoTo( pArea, ulRecNo );
 }
@@ -247,7 +247,7 @@ static HB_ERRCODE sqlite3Disconnect( SQLDDCONNECTION * pConnection )
 {
    HB_ERRCODE errCode;
 
-   errCode = sqlite3_close( ( ( SDDCONN * ) pConnection->pSDDConn )->pDb ) ? HB_SUCCESS : HB_FAILURE;
+   errCode = sqlite3_close( ( ( SDDCONN * ) pConnection->pSDDConn )->pDb ) == SQLITE_OK ? HB_SUCCESS : HB_FAILURE;
    hb_xfree( pConnection->pSDDConn );
    return errCode;
 }
@@ -406,14 +406,7 @@ static HB_ERRCODE sqlite3Open( SQLBASEAREAP pArea )
       return HB_FAILURE;
    }
 
-   pArea->ulRecCount = 0;
-   pArea->ulRecMax   = SQLDD_ROWSET_INIT;
-
-   pArea->pRow = ( void ** ) hb_xgrab( SQLDD_ROWSET_INIT * sizeof( void * ) );
-   pArea->pRowFlags = ( HB_BYTE * ) hb_xgrab( SQLDD_ROWSET_INIT * sizeof( HB_BYTE ) );
-
-   pArea->pRow[ 0 ]      = pItemEof;
-   pArea->pRowFlags[ 0 ] = SQLDD_FLAG_CACHED;
+   hb_rddsqlRowsetInit( pArea, pItemEof );
 
    pSDDData->pStmt = st;
    return HB_SUCCESS;
@@ -496,16 +489,8 @@ static HB_ERRCODE sqlite3GoTo( SQLBASEAREAP pArea, HB_ULONG ulRecNo )
             hb_itemRelease( pItem );
          }
       }
-      if( pArea->ulRecCount + 1 >= pArea->ulRecMax )
-      {
-         pArea->pRow      = ( void ** ) hb_xrealloc( pArea->pRow, ( pArea->ulRecMax + SQLDD_ROWSET_RESIZE ) * sizeof( void * ) );
-         pArea->pRowFlags = ( HB_BYTE * ) hb_xrealloc( pArea->pRowFlags, ( pArea->ulRecMax + SQLDD_ROWSET_RESIZE ) * sizeof( HB_BYTE ) );
-         pArea->ulRecMax += SQLDD_ROWSET_RESIZE;
-      }
-
-      pArea->ulRecCount++;
-      pArea->pRow[ pArea->ulRecCount ]      = pArray;
-      pArea->pRowFlags[ pArea->ulRecCount ] = SQLDD_FLAG_CACHED;
+      if( hb_rddsqlRowsetAdd( pArea, pArray ) != HB_SUCCESS )
+         return HB_FAILURE;
 
       if( sqlite3_step( st ) != SQLITE_ROW )
       {
@@ -514,17 +499,5 @@ static HB_ERRCODE sqlite3GoTo( SQLBASEAREAP pArea, HB_ULONG ulRecNo )
       }
    }
 
-   if( ulRecNo == 0 || ulRecNo > pArea->ulRecCount )
-   {
-      pArea->pRecord      = pArea->pRow[ 0 ];
-      pArea->bRecordFlags = pArea->pRowFlags[ 0 ];
-      pArea->fPositioned  = HB_FALSE;
-   }
-   else
-   {
-      pArea->pRecord      = pArea->pRow[ ulRecNo ];
-      pArea->bRecordFlags = pArea->pRowFlags[ ulRecNo ];
-      pArea->fPositioned  = HB_TRUE;
-   }
-   return HB_SUCCESS;
+   return hb_rddsqlRowsetGoTo( pArea, ulRecNo );
 }
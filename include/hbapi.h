@@ -422,6 +422,9 @@ typedef struct _HB_BASEARRAY
    HB_SIZE     nAllocated;   /* number of allocated items */
    HB_USHORT   uiClass;      /* offset to the classes base if it is an object */
    HB_USHORT   uiPrevCls;    /* for fixing after access super */
+   HB_BOOL     fShared;      /* items can be shared with copy-on-write clones or frozen */
+   HB_BOOL     fFrozen;      /* array is frozen by hb_itemFreeze() */
+   HB_BOOL     fShareOwner;  /* nested items of shared items belong to this array */
 } HB_BASEARRAY, * PHB_BASEARRAY;
 
 #ifndef _HB_HASH_INTERNAL_
@@ -485,6 +488,18 @@ typedef unsigned int HB_ERRCODE;
 extern HB_SYMB hb_symEval;
 #endif
 
+/* memory usage counters, see hb_xmemstat() */
+typedef struct
+{
+   HB_ISIZ  nBlocks;       /* number of allocated and not released memory blocks */
+   HB_ISIZ  nBytes;        /* size of allocated and not released memory blocks */
+   HB_SIZE  nAllocs;       /* total number of allocations */
+   HB_SIZE  nFrees;        /* total number of releases */
+   HB_SIZE  nAllocBytes;   /* total size of allocated memory */
+} HB_MEMSTAT, * PHB_MEMSTAT;
+
+typedef void ( * PHB_MEMSTAT_FUNC )( void * cargo, HB_MAXINT nThreadNo, const HB_MEMSTAT * pStat );
+
 extern HB_EXPORT void     hb_xinit( void );                           /* Initialize fixed memory subsystem */
 extern HB_EXPORT void     hb_xexit( void );                           /* Deinitialize fixed memory subsystem */
 extern HB_EXPORT void *   hb_xalloc( HB_SIZE nSize );                 /* allocates memory, returns NULL on failure */
@@ -497,6 +512,8 @@ extern HB_EXPORT HB_SIZE  hb_xquery( int iMode );                     /* Query d
 extern HB_EXPORT HB_BOOL  hb_xtraced( void );
 extern HB_EXPORT void     hb_xsetfilename( const char * szValue );
 extern HB_EXPORT void     hb_xsetinfo( const char * szValue );
+extern HB_EXPORT void     hb_xmemstat( PHB_MEMSTAT pStat );           /* process wide memory usage counters */
+extern HB_EXPORT void     hb_xmemstatThreads( PHB_MEMSTAT_FUNC pFunc, void * cargo ); /* memory usage counters of running HVM threads */
 #ifdef _HB_API_INTERNAL_
 extern void hb_xinit_thread( void );
 extern void hb_xexit_thread( void );
@@ -615,6 +632,34 @@ extern void       hb_vmIsStaticRef( void ); /* hvm.c - mark all static variables
 extern void       hb_gcReleaseAll( void ); /* release all memory blocks unconditionally */
 
 extern HB_COUNTER hb_gcRefCount( void * pAlloc );  /* return number of references */
+extern HB_BOOL    hb_gcFreezeVisit( void * pBlock ); /* mark block as being frozen, returns HB_FALSE if it was already visited or frozen */
+extern HB_BOOL    hb_gcFreezeLeave( void * pBlock, HB_BOOL fCommit ); /* finish freezing of visited block, returns HB_FALSE if it was not visited */
+extern void       hb_gcFreezeMem( void * pMem ); /* keep memory block used by frozen items until HVM exit */
+
+/* item counters collected by hb_gcMemSnapshot() */
+typedef struct
+{
+   HB_SIZE     nCount;        /* number of items */
+   HB_SIZE     nBytes;        /* memory used by items, shared buffers are split between owners */
+} HB_MEMCOUNT, * PHB_MEMCOUNT;
+
+typedef struct
+{
+   HB_MEMCOUNT strings;       /* string buffers stored in arrays, objects and hashes */
+   HB_MEMCOUNT arrays;        /* arrays which are not objects */
+   HB_MEMCOUNT objects;       /* objects of all classes */
+   HB_MEMCOUNT hashes;        /* hash arrays */
+   HB_MEMCOUNT blocks;        /* codeblocks */
+   HB_MEMCOUNT other;         /* other GC blocks: pointers, memvars, threads, mutexes, ... */
+   PHB_MEMCOUNT pClasses;     /* objects indexed by class handle */
+   HB_SIZE     nClasses;      /* number of entries in pClasses */
+} HB_MEMSNAPSHOT, * PHB_MEMSNAPSHOT;
+
+extern HB_BOOL    hb_gcMemSnapshot( PHB_MEMSNAPSHOT pSnap ); /* count all GC blocks by type and class */
+extern HB_BOOL    hb_arrayMemStat( void * pBlock, const HB_GC_FUNCS * pFuncs, PHB_MEMSNAPSHOT pSnap ); /* arrays.c - account array GC block */
+extern HB_BOOL    hb_hashMemStat( void * pBlock, const HB_GC_FUNCS * pFuncs, PHB_MEMSNAPSHOT pSnap ); /* hashes.c - account hash GC block */
+extern HB_BOOL    hb_codeblockMemStat( void * pBlock, const HB_GC_FUNCS * pFuncs, PHB_MEMSNAPSHOT pSnap ); /* codebloc.c - account codeblock GC block */
+extern void       hb_itemMemStat( PHB_ITEM pItem, HB_COUNTER nShare, PHB_MEMSNAPSHOT pSnap ); /* itemapi.c - account string buffer */
 
 #if 0
 #define hb_gcRefInc( p )      hb_xRefInc( HB_GC_PTR( p ) )
@@ -857,6 +902,8 @@ extern HB_EXPORT HB_BOOL      hb_arrayEval( PHB_ITEM pArray, PHB_ITEM bBlock, HB
 extern HB_EXPORT HB_BOOL      hb_arrayCopy( PHB_ITEM pSrcArray, PHB_ITEM pDstArray, HB_SIZE * pnStart, HB_SIZE * pnCount, HB_SIZE * pnTarget ); /* copy items from one array to another */
 extern HB_EXPORT PHB_ITEM     hb_arrayClone( PHB_ITEM pArray ); /* returns a duplicate of an existing array, including all nested items */
 extern HB_EXPORT PHB_ITEM     hb_arrayCloneTo( PHB_ITEM pDest, PHB_ITEM pArray ); /* returns a duplicate of an existing array, including all nested items */
+extern HB_EXPORT PHB_ITEM     hb_arrayCloneCOW( PHB_ITEM pArray ); /* returns a copy-on-write duplicate of an existing array, items are copied on first write */
+extern HB_EXPORT PHB_ITEM     hb_arrayCloneCOWTo( PHB_ITEM pDest, PHB_ITEM pArray ); /* returns a copy-on-write duplicate of an existing array, items are copied on first write */
 extern HB_EXPORT HB_BOOL      hb_arraySort( PHB_ITEM pArray, HB_SIZE * pnStart, HB_SIZE * pnCount, PHB_ITEM pBlock ); /* sorts an array item */
 extern HB_EXPORT PHB_ITEM     hb_arrayFromStack( HB_USHORT uiLen ); /* Creates and returns an Array of n Elements from the Eval Stack - Does NOT pop the items. */
 extern HB_EXPORT PHB_ITEM     hb_arrayFromParams( int iLevel ); /* Creates and returns an Array of Generic Parameters for a given call level */
@@ -873,6 +920,30 @@ extern void hb_nestedCloneInit( PHB_NESTED_CLONED pClonedList, void * pValue, PH
 extern void hb_nestedCloneFree( PHB_NESTED_CLONED pClonedList );
 extern void hb_nestedCloneDo( PHB_ITEM pDstItem, PHB_ITEM pSrcItem, PHB_NESTED_CLONED pClonedList );
 extern void hb_hashCloneBody( PHB_ITEM pDest, PHB_ITEM pHash, PHB_NESTED_CLONED pClonedList );
+extern void hb_nestedCloneCOW( PHB_ITEM pDstItem, PHB_ITEM pSrcItem );
+extern void hb_nestedCloneCOWShared( PHB_ITEM pItem );
+extern void hb_arrayUnshare( PHB_BASEARRAY pBaseArray );
+extern HB_BOOL hb_arrayWritable( PHB_BASEARRAY pBaseArray );
+extern HB_BOOL hb_nestedFreeze( PHB_ITEM pItem, int iMode );
+extern HB_BOOL hb_hashFreezeItems( PHB_ITEM pHash, int iMode );
+
+/* hb_nestedFreeze() modes */
+#define HB_FREEZE_CHECK       0
+#define HB_FREEZE_COMMIT      1
+#define HB_FREEZE_ROLLBACK    2
+
+/* copy-on-write arrays: make items private before they are modified
+ * or before nested array or hash item is extracted, frozen arrays
+ * cannot be modified and HB_ARRAY_WRITABLE() generates RT error for them
+ */
+#define HB_ARRAY_UNSHARE( b ) \
+            do { if( ( b )->fShared ) hb_arrayUnshare( b ); } while( 0 )
+#define HB_ARRAY_WRITABLE( b ) \
+            ( ! ( b )->fShared || hb_arrayWritable( b ) )
+#define HB_ARRAY_UNSHARE_GET( b, n ) \
+            do { if( ( b )->fShared && ( HB_IS_ARRAY( ( b )->pItems + ( n ) ) || \
+                                         HB_IS_HASH( ( b )->pItems + ( n ) ) ) ) \
+                    hb_arrayUnshare( b ); } while( 0 )
 #endif
 
 /* COMPATIBILITY */
@@ -890,6 +961,8 @@ extern HB_EXPORT HB_BOOL   hb_hashAllocNewPair( PHB_ITEM pHash, PHB_ITEM * pKeyP
 extern HB_EXPORT void      hb_hashSort( PHB_ITEM pHash );
 extern HB_EXPORT PHB_ITEM  hb_hashClone( PHB_ITEM pHash );
 extern HB_EXPORT PHB_ITEM  hb_hashCloneTo( PHB_ITEM pDest, PHB_ITEM pHash );
+extern HB_EXPORT PHB_ITEM  hb_hashCloneCOW( PHB_ITEM pHash );
+extern HB_EXPORT PHB_ITEM  hb_hashCloneCOWTo( PHB_ITEM pDest, PHB_ITEM pHash );
 extern HB_EXPORT void      hb_hashJoin( PHB_ITEM pDest, PHB_ITEM pSource, int iType );
 extern HB_EXPORT HB_BOOL   hb_hashScan( PHB_ITEM pHash, PHB_ITEM pKey, HB_SIZE * pnPos );
 extern HB_EXPORT HB_BOOL   hb_hashScanSoft( PHB_ITEM pHash, PHB_ITEM pKey, HB_SIZE * pnPos );
@@ -905,6 +978,7 @@ extern HB_EXPORT void *    hb_hashId( PHB_ITEM pHash ); /* retrieves the hash un
 
 /* these hb_hashGet*() functions are dangerous, be sure that base HASH value will not be changed */
 extern HB_EXPORT PHB_ITEM  hb_hashGetItemPtr( PHB_ITEM pHash, PHB_ITEM pKey, int iFlags );
+extern HB_EXPORT PHB_ITEM  hb_hashGetItemReadPtr( PHB_ITEM pHash, PHB_ITEM pKey, int iFlags ); /* as above but returned item cannot be modified */
 extern HB_EXPORT PHB_ITEM  hb_hashGetItemRefPtr( PHB_ITEM pHash, PHB_ITEM pKey );
 extern HB_EXPORT PHB_ITEM  hb_hashGetCItemPtr( PHB_ITEM pHash, const char * pszKey );
 extern HB_EXPORT HB_SIZE   hb_hashGetCItemPos( PHB_ITEM pHash, const char * pszKey );
@@ -1094,6 +1168,7 @@ extern           void       hb_memvarCreateFromItem( PHB_ITEM pMemvar, int iScop
 extern           int        hb_memvarScope( const char * szVarName, HB_SIZE nLength ); /* retrieve scope of a dynamic variable symbol */
 extern           PHB_ITEM   hb_memvarDetachLocal( PHB_ITEM pLocal ); /* Detach a local variable from the eval stack */
 extern HB_EXPORT PHB_ITEM   hb_memvarGetValueBySym( PHB_DYNS pDynSym );
+extern HB_EXPORT PHB_DYNS   hb_memvarHandle( const char * szVarName, HB_SIZE nLength ); /* return dynamic symbol usable as memvar handle, created if not exists */
 extern HB_EXPORT PHB_ITEM   hb_memvarSaveInArray( int iScope, HB_BOOL fCopy ); /* create array with visible memvar references or copies respecting given memvars scope */
 extern           void       hb_memvarRestoreFromArray( PHB_ITEM pArray );
 
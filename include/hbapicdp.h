@@ -100,6 +100,9 @@ typedef HB_CDP_FLAGS_FUNC( ( * PHB_CDP_FLAGS_FUNC ) );
 #define HB_CDP_CMP_FUNC( func ) int func( _PHB_CODEPAGE cdp, const char * szFirst, HB_SIZE nLenFirst, const char * szSecond, HB_SIZE nLenSecond, HB_BOOL fExact )
 typedef HB_CDP_CMP_FUNC( ( * PHB_CDP_CMP_FUNC ) );
 
+#define HB_CDP_SORTKEY_FUNC( func ) HB_SIZE func( _PHB_CODEPAGE cdp, const char * pSrc, HB_SIZE nLen, char * pKey )
+typedef HB_CDP_SORTKEY_FUNC( ( * PHB_CDP_SORTKEY_FUNC ) );
+
 
 typedef struct _HB_UNITABLE
 {
@@ -139,6 +142,7 @@ typedef struct _HB_CODEPAGE
    PHB_CDP_FLAGS_FUNC      wcharFlags;
    PHB_CDP_CMP_FUNC        wcharCmp;
    PHB_CDP_CMP_FUNC        wcharCmpI;
+   PHB_CDP_SORTKEY_FUNC    wcharSortKey;
    int                     nMulti;
    int                     nMultiUC;
    PHB_MULTICHAR           multi;
@@ -445,6 +449,8 @@ extern HB_EXPORT HB_BOOL      hb_cdpIsUpper( PHB_CODEPAGE cdp, int iChar );
 extern HB_EXPORT int          hb_cdpcmp( const char * szFirst, HB_SIZE nLenFirst, const char * szSecond, HB_SIZE nLenSecond, PHB_CODEPAGE cdp, HB_BOOL fExact );
 extern HB_EXPORT int          hb_cdpicmp( const char * szFirst, HB_SIZE nLenFirst, const char * szSecond, HB_SIZE nLenSecond, PHB_CODEPAGE cdp, HB_BOOL fExact );
 extern HB_EXPORT const HB_UCHAR * hb_cdpGetSortTab( PHB_CODEPAGE cdp );
+extern HB_EXPORT HB_SIZE      hb_cdpSortKeyLen( PHB_CODEPAGE cdp, HB_SIZE nLen );
+extern HB_EXPORT HB_SIZE      hb_cdpSortKey( PHB_CODEPAGE cdp, const char * pSrc, HB_SIZE nLen, char * pKey );
 
 extern HB_EXPORT char *       hb_cdpDup( const char *, PHB_CODEPAGE, PHB_CODEPAGE );
 extern HB_EXPORT char *       hb_cdpDupn( const char *, HB_SIZE, PHB_CODEPAGE, PHB_CODEPAGE );
@@ -475,6 +481,7 @@ extern HB_EXPORT HB_WCHAR     hb_cdpGetWC( PHB_CODEPAGE cdp, HB_UCHAR ch, HB_WCH
 extern HB_EXPORT HB_BOOL      hb_cdpGetFromUTF8( PHB_CODEPAGE cdp, HB_UCHAR ch, int * n, HB_WCHAR * pwc );
 
 extern HB_EXPORT HB_SIZE      hb_cdpUTF8StringLength( const char * pSrc, HB_SIZE nLen );
+extern HB_EXPORT HB_BOOL      hb_cdpUTF8Validate( const char * pSrc, HB_SIZE nLen, HB_SIZE * pnChars );
 extern HB_EXPORT HB_SIZE      hb_cdpUTF8StringAt( const char * szNeedle, HB_SIZE nLenN, const char * szHaystack, HB_SIZE nLenH, HB_SIZE nStart, HB_SIZE nEnd, HB_BOOL fReverse );
 extern HB_EXPORT HB_WCHAR     hb_cdpUTF8StringPeek( const char * pSrc, HB_SIZE nLen, HB_SIZE nPos );
 extern HB_EXPORT char *       hb_cdpUTF8StringSubstr( const char * pSrc, HB_SIZE nLen, HB_SIZE nFrom, HB_SIZE nCount, HB_SIZE * pnDest );
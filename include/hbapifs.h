@@ -474,6 +474,11 @@ extern HB_EXPORT PHB_FILE     hb_fileItemGet( PHB_ITEM pItem );
 extern HB_EXPORT PHB_ITEM     hb_fileItemPut( PHB_ITEM pItem, PHB_FILE pFile );
 extern HB_EXPORT void         hb_fileItemClear( PHB_ITEM pItem );
 
+/* item serialization in stream format to/from file */
+struct _HB_CODEPAGE;
+extern HB_EXPORT HB_BOOL      hb_itemSerializeFile( PHB_ITEM pItem, int iFlags, struct _HB_CODEPAGE * cdpIn, struct _HB_CODEPAGE * cdpOut, PHB_FILE pFile );
+extern HB_EXPORT PHB_ITEM     hb_itemDeserializeFile( PHB_FILE pFile, struct _HB_CODEPAGE * cdpIn, struct _HB_CODEPAGE * cdpOut );
+
 #define HB_FILE_ERR_UNSUPPORTED  ( ( HB_ERRCODE ) FS_ERROR )
 
 /* wrapper to fopen() which calls hb_fsNameConv() */
@@ -167,12 +167,15 @@ extern HB_EXPORT PHB_ITEM     hb_itemUnRef     ( PHB_ITEM pItem ); /* de-referen
 extern HB_EXPORT PHB_ITEM     hb_itemUnRefOnce ( PHB_ITEM pItem ); /* de-references passed variable, one step*/
 extern HB_EXPORT PHB_ITEM     hb_itemUnRefRefer( PHB_ITEM pItem ); /* de-references passed variable, leaving the last reference */
 extern HB_EXPORT PHB_ITEM     hb_itemUnRefWrite( PHB_ITEM pItem, PHB_ITEM pSource ); /* de-references passed variable for writing */
+extern HB_EXPORT PHB_ITEM     hb_itemUnRefUpdate( PHB_ITEM pItem ); /* de-references passed variable for in-place modification */
 extern HB_EXPORT PHB_ITEM     hb_itemUnShare   ( PHB_ITEM pItem ); /* un-share given string item */
 extern HB_EXPORT PHB_ITEM     hb_itemUnShareString( PHB_ITEM pItem ); /* un-share given string item - the pItem have to be valid unrefed string item */
 extern HB_EXPORT PHB_ITEM     hb_itemReSizeString( PHB_ITEM pItem, HB_SIZE nSize ); /* Resize string buffer of given string item - the pItem have to be valid unrefed string item */
 extern HB_EXPORT HB_BOOL      hb_itemGetWriteCL( PHB_ITEM pItem, char ** pszValue, HB_SIZE * pnLen );
 extern HB_EXPORT PHB_ITEM     hb_itemClone     ( PHB_ITEM pItem ); /* clone the given item */
 extern HB_EXPORT void         hb_itemCloneTo   ( PHB_ITEM pDest, PHB_ITEM pSource ); /* clone the given item */
+extern HB_EXPORT HB_BOOL      hb_itemFreeze    ( PHB_ITEM pItem ); /* make array or hash and all nested items immutable */
+extern HB_EXPORT HB_BOOL      hb_itemIsFrozen  ( PHB_ITEM pItem ); /* check if item is frozen array or hash */
 extern HB_EXPORT char *       hb_itemStr       ( PHB_ITEM pNumber, PHB_ITEM pWidth, PHB_ITEM pDec ); /* convert a number to a string */
 extern HB_EXPORT char *       hb_itemString    ( PHB_ITEM pItem, HB_SIZE * nLen, HB_BOOL * bFreeReq );  /* Convert any scalar to a string */
 extern HB_EXPORT HB_BOOL      hb_itemStrBuf    ( char *szResult, PHB_ITEM pNumber, int iSize, int iDec ); /* convert a number to a string */
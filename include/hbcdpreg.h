@@ -82,6 +82,9 @@ HB_CALL_ON_STARTUP_BEGIN( HB_MACRONAME_JOIN( _hb_codepage_Init_, HB_CP_ID ) )
          #define HB_CP_CMPI_FUNC    NULL
       #endif
    #endif
+   #ifndef HB_CP_SORTKEY_FUNC
+      #define HB_CP_SORTKEY_FUNC    NULL
+   #endif
 
    #if defined( HB_CP_CHARIDX )
       #define HB_CP_TP_CHARIDX   HB_CDP_TYPE_CHARIDX
@@ -121,6 +124,7 @@ HB_CALL_ON_STARTUP_BEGIN( HB_MACRONAME_JOIN( _hb_codepage_Init_, HB_CP_ID ) )
       HB_CP_FLAGS_FUNC,
       HB_CP_CMP_FUNC,
       HB_CP_CMPI_FUNC,
+      HB_CP_SORTKEY_FUNC,
       0,
       0,
       NULL,
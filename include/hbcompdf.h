@@ -824,6 +824,7 @@ typedef struct _HB_COMP
    int               iTraceInclude;       /* trace included files and generate dependencies list */
    int               iSyntaxCheckOnly;    /* syntax check only */
    int               iErrorFmt;           /* error message formatting mode (default: Clipper) */
+   int               iJobs;               /* number of parallel compilation threads (-jobs=<n>) */
 
    HB_BOOL           fQuiet;              /* be quiet during compilation (-q) */
    HB_BOOL           fGauge;              /* hide line counter gauge (-ql) */
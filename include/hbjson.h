@@ -52,10 +52,17 @@
 
 HB_EXTERN_BEGIN
 
+/* stream callbacks: return number of bytes read/written,
+   0 means end of input or write error */
+typedef HB_SIZE ( * PHB_JSON_READ_FUNC )( void * cargo, void * buffer, HB_SIZE nSize );
+typedef HB_SIZE ( * PHB_JSON_WRITE_FUNC )( void * cargo, const void * buffer, HB_SIZE nSize );
+
 extern HB_EXPORT char *  hb_jsonEncode( PHB_ITEM pValue, HB_SIZE * pnLen, int iIndent );
 extern HB_EXPORT char *  hb_jsonEncodeCP( PHB_ITEM pValue, HB_SIZE * pnLen, int iIndent, PHB_CODEPAGE cdp );
 extern HB_EXPORT HB_SIZE hb_jsonDecode( const char * szSource, PHB_ITEM pValue );
 extern HB_EXPORT HB_SIZE hb_jsonDecodeCP( const char * szSource, PHB_ITEM pValue, PHB_CODEPAGE cdp );
+extern HB_EXPORT HB_BOOL hb_jsonEncodeStream( PHB_ITEM pValue, PHB_JSON_WRITE_FUNC pWrite, void * cargo, int iIndent, PHB_CODEPAGE cdp );
+extern HB_EXPORT HB_SIZE hb_jsonDecodeStream( PHB_JSON_READ_FUNC pRead, void * cargo, PHB_ITEM pValue, PHB_CODEPAGE cdp );
 
 HB_EXTERN_END
 
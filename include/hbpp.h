@@ -552,6 +552,27 @@ typedef struct _HB_PP_FILE
 }
 HB_PP_FILE, * PHB_PP_FILE;
 
+typedef struct _HB_PP_INCCACHE
+{
+   struct _HB_PP_INCCACHE * pNext;  /* next cached file */
+   struct _HB_PP_INCCACHE * pBase;  /* cached file included before this one or NULL */
+   char *         szFileName;       /* resolved name of included file */
+   PHB_MEM_BUFFER pIncFiles;        /* names of files included by this one */
+   PHB_PP_RULE    pDefinitions;     /* #define rules, the oldest one first */
+   PHB_PP_RULE    pTranslations;    /* #[x]translate rules, the oldest one first */
+   PHB_PP_RULE    pCommands;        /* #[x]command rules, the oldest one first */
+   int            iLines;           /* number of lines in included files */
+
+   /* used when rules are recorded */
+   HB_BOOL        fValid;           /* included file can be cached */
+   int            iFiles;           /* number of open files */
+   int            iCondCount;       /* number of nested #if[n]def directive */
+   PHB_PP_RULE    pDefStart;        /* last #define rule before recording */
+   PHB_PP_RULE    pTransStart;      /* last #[x]translate rule before recording */
+   PHB_PP_RULE    pCmdStart;        /* last #[x]command rule before recording */
+}
+HB_PP_INCCACHE, * PHB_PP_INCCACHE;
+
 typedef struct
 {
    /* common for all included files */
@@ -621,6 +642,12 @@ typedef struct
    PHB_PP_FILE pFile;               /* currently preprocessed file structure */
    int       iFiles;                /* number of open files */
 
+   HB_BOOL   fIncCache;             /* cache rules defined by included files */
+   HB_BOOL   fIncKnown;             /* PP rules are in known state */
+   PHB_PP_INCCACHE pIncCache;       /* cached included files */
+   PHB_PP_INCCACHE pIncBase;        /* last cached file used in current state */
+   PHB_PP_INCCACHE pIncRec;         /* included file being recorded */
+
    void *   cargo;                  /* parameter passed to user functions */
    PHB_PP_OPEN_FUNC   pOpenFunc;    /* function to open files */
    PHB_PP_CLOSE_FUNC  pCloseFunc;   /* function to close files */
@@ -655,6 +682,7 @@ extern HB_EXPORT void    hb_pp_init( PHB_PP_STATE pState, HB_BOOL fQuiet,
                    PHB_PP_SWITCH_FUNC pSwitchFunc );
 extern HB_EXPORT void    hb_pp_initDynDefines( PHB_PP_STATE pState, HB_BOOL fArchDefs );
 extern HB_EXPORT void    hb_pp_setIncFunc( PHB_PP_STATE pState, PHB_PP_INC_FUNC pIncFunc );
+extern HB_EXPORT void    hb_pp_setIncCache( PHB_PP_STATE pState, HB_BOOL fIncCache );
 extern HB_EXPORT void    hb_pp_readRules( PHB_PP_STATE pState, const char * szRulesFile );
 extern HB_EXPORT void    hb_pp_setStdRules( PHB_PP_STATE pState );
 extern HB_EXPORT void    hb_pp_setStdBase( PHB_PP_STATE pState );
@@ -415,6 +415,8 @@ typedef struct
    PHB_FILE   pTempFile;      /* handle to temporary file */
    char *     szTempFileName; /* temporary file name */
    int        keyLen;         /* key length */
+   int        sortLen;        /* collation sort key length, 0 if not used */
+   int        itemLen;        /* size of key pool item: key, record, sort key */
    HB_BYTE    bTrl;           /* filler char for shorter keys */
    HB_BOOL    fUnique;        /* HB_TRUE if index is unique */
    HB_BOOL    fReindex;       /* HB_TRUE if reindexing is in process */
@@ -71,6 +71,7 @@
 typedef struct
 {
    HB_BOOL     fFree;
+   HB_BOOL     fCached;
    int         iFlags;
    int         iEFlags;
 #if defined( HB_HAS_PCRE2 )
@@ -115,6 +116,10 @@ typedef int  ( * HB_REG_EXEC )( PHB_REGEX, const char *, HB_SIZE, int, HB_REGMAT
 
 extern void hb_regexInit( HB_REG_FREE pFree, HB_REG_COMP pComp, HB_REG_EXEC pExec );
 extern HB_BOOL hb_regexIs( PHB_ITEM pItem );
+#if defined( HB_HAS_PCRE2 )
+extern HB_REGMATCH * hb_regexMatchDataGet( void );
+extern void hb_regexMatchDataPut( HB_REGMATCH * aMatches );
+#endif
 
 #ifndef REG_EXTENDED
 #define REG_EXTENDED  0x00
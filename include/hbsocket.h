@@ -93,6 +93,7 @@ extern HB_EXPORT int          hb_socketListen( HB_SOCKET sd, int iBacklog );
 extern HB_EXPORT HB_SOCKET    hb_socketAccept( HB_SOCKET sd, void ** pSockAddr, unsigned * puiLen, HB_MAXINT timeout );
 extern HB_EXPORT int          hb_socketConnect( HB_SOCKET sd, const void * pSockAddr, unsigned uiLen, HB_MAXINT timeout );
 extern HB_EXPORT long         hb_socketSend( HB_SOCKET sd, const void * data, long len, int flags, HB_MAXINT timeout );
+extern HB_EXPORT long         hb_socketSendFile( HB_SOCKET sd, HB_FHANDLE hFile, HB_FOFFSET nOffset, long len, HB_MAXINT timeout );
 extern HB_EXPORT long         hb_socketSendTo( HB_SOCKET sd, const void * data, long len, int flags, const void * pSockAddr, unsigned uiSockLen, HB_MAXINT timeout );
 extern HB_EXPORT long         hb_socketRecv( HB_SOCKET sd, void * data, long len, int flags, HB_MAXINT timeout );
 extern HB_EXPORT long         hb_socketRecvFrom( HB_SOCKET sd, void * data, long len, int flags, void ** pSockAddr, unsigned * puiSockLen, HB_MAXINT timeout );
@@ -115,6 +116,24 @@ extern HB_EXPORT int          hb_socketSelect( PHB_ITEM pArrayRD, HB_BOOL fSetRD
                                                PHB_ITEM pArrayEX, HB_BOOL fSetEX,
                                                HB_MAXINT timeout, HB_SOCKET_FUNC pFunc );
 
+/* persistent socket event multiplexer (epoll() if available) */
+struct _HB_SOCKET_POLL;
+typedef struct _HB_SOCKET_POLL * PHB_SOCKET_POLL;
+
+typedef struct
+{
+   HB_SOCKET sd;
+   int       events;  /* HB_SOCKET_POLL_* */
+}
+HB_SOCKET_POLLFD, * PHB_SOCKET_POLLFD;
+
+extern HB_EXPORT PHB_SOCKET_POLL hb_socketPollNew( void );
+extern HB_EXPORT void            hb_socketPollFree( PHB_SOCKET_POLL pPoll );
+extern HB_EXPORT int             hb_socketPollAdd( PHB_SOCKET_POLL pPoll, HB_SOCKET sd, int iEvents );
+extern HB_EXPORT int             hb_socketPollMod( PHB_SOCKET_POLL pPoll, HB_SOCKET sd, int iEvents );
+extern HB_EXPORT int             hb_socketPollDel( PHB_SOCKET_POLL pPoll, HB_SOCKET sd );
+extern HB_EXPORT int             hb_socketPollWait( PHB_SOCKET_POLL pPoll, PHB_SOCKET_POLLFD pEvents, int iMax, HB_MAXINT timeout );
+
 /* Harbour level socket item API functions */
 extern HB_EXPORT HB_SOCKET hb_socketParam( int iParam );
 extern HB_EXPORT HB_SOCKET hb_socketItemGet( PHB_ITEM pItem );
@@ -172,6 +172,7 @@ typedef struct
    void *     pDebugInfo;     /* internal debugger structure */
 #if defined( HB_MT_VM )
    int        iUnlocked;      /* counter for nested hb_vmUnlock() calls */
+   int        iProfTick;      /* last served sampling profiler request */
    PHB_DYN_HANDLES pDynH;     /* dynamic symbol handles */
    int        iDynH;          /* number of dynamic symbol handles */
    void *     pStackLst;      /* this stack entry in stack linked list */
@@ -179,6 +180,8 @@ typedef struct
    HB_TRACEINFO traceInfo;    /* MT safe buffer for HB_TRACE data */
    char *     pDirBuffer;     /* MT safe buffer for hb_fsCurDir() results */
    void *     allocator;      /* memory manager global struct pointer */
+   PHB_MEMSTAT pMemStat;      /* active memory usage counters or NULL */
+   HB_MEMSTAT memStat;        /* memory usage counters of this thread */
 #endif
 } HB_STACK, * PHB_STACK;
 
@@ -366,7 +369,10 @@ extern void        hb_stackUpdateAllocator( void *, PHB_ALLOCUPDT_FUNC, int );
    extern int              hb_stackUnlock( void );
    extern int              hb_stackLock( void );
    extern int              hb_stackLockCount( void );
+   extern int *            hb_stackProfTick( void );
    extern void *           hb_stackAllocator( void );
+   extern PHB_MEMSTAT      hb_stackMemStat( void );
+   extern const HB_MEMSTAT * hb_stackIdMemStat( void * pStackId );
 #endif
 
 #endif /* _HB_API_INTERNAL_ */
@@ -410,11 +416,15 @@ extern void        hb_stackUpdateAllocator( void *, PHB_ALLOCUPDT_FUNC, int );
 #  define hb_stackList()            ( hb_stack.pStackLst )
 #  define hb_stackListSet( p )      do { hb_stack.pStackLst = ( p ); } while( 0 )
 #  define hb_stackDynHandlesCount() ( hb_stack.iDynH )
+#  define hb_stackGetDynHandle( p ) ( ( int ) ( p )->uiSymNum <= hb_stack.iDynH ? \
+                                      &hb_stack.pDynH[ ( p )->uiSymNum - 1 ] : \
+                                      hb_stackGetDynHandle( p ) )
 #  define hb_stackQuitState( )      ( hb_stack.uiQuitState != 0 )
 #  define hb_stackSetQuitState( n ) do { hb_stack.uiQuitState = ( n ); } while( 0 )
 #  define hb_stackUnlock()          ( ++hb_stack.iUnlocked )
 #  define hb_stackLock()            ( --hb_stack.iUnlocked )
 #  define hb_stackLockCount()       ( hb_stack.iUnlocked )
+#  define hb_stackProfTick()        ( &hb_stack.iProfTick )
 #endif
 
 #define hb_stackAllocItem( )        ( ( ++hb_stack.pPos == hb_stack.pEnd ? \
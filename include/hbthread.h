@@ -395,6 +395,7 @@ extern HB_EXPORT HB_BOOL  hb_threadMutexLock( PHB_ITEM pItem );
 extern HB_EXPORT HB_BOOL  hb_threadMutexTimedLock( PHB_ITEM pItem, HB_ULONG ulMilliSec );
 extern HB_EXPORT HB_BOOL  hb_threadMutexUnlock( PHB_ITEM pItem );
 extern HB_EXPORT void     hb_threadMutexNotify( PHB_ITEM pItem, PHB_ITEM pNotifier, HB_BOOL fWaiting );
+extern HB_EXPORT HB_BOOL  hb_threadMutexTimedNotify( PHB_ITEM pItem, PHB_ITEM pNotifier, HB_ULONG ulMilliSec );
 extern HB_EXPORT PHB_ITEM hb_threadMutexSubscribe( PHB_ITEM pItem, HB_BOOL fClear );
 extern HB_EXPORT PHB_ITEM hb_threadMutexTimedSubscribe( PHB_ITEM pItem, HB_ULONG ulMilliSec, HB_BOOL fClear );
 
@@ -438,6 +439,7 @@ extern PHB_ITEM        hb_threadStart( HB_ULONG ulAttr, PHB_CARGO_FUNC pFunc, vo
 
 extern void    hb_threadMutexUnlockAll( void );
 extern void    hb_threadMutexUnsubscribeAll( void );
+extern void    hb_threadPoolWakeAll( void );
 extern void    hb_threadMutexSyncSignal( PHB_ITEM pItemMtx );
 extern HB_BOOL hb_threadMutexSyncWait( PHB_ITEM pItemMtx, HB_ULONG ulMilliSec, PHB_ITEM pItemSync );
 
@@ -106,6 +106,7 @@ extern HB_EXPORT PHB_SYMB hb_vmProcessDynLibSymbols( PHB_SYMB pSymbols, HB_USHOR
    extern HB_BOOL       hb_vmMsgReference( PHB_ITEM pObject, PHB_DYNS pMessage, PHB_DYNS pAccMsg ); /* create extended message reference */
 
    extern void          hb_vmUpdateAllocator( PHB_ALLOCUPDT_FUNC pFunc, int iCount );
+   extern void          hb_vmMemStat( PHB_MEMSTAT_FUNC pFunc, void * cargo );
 
    extern void          hb_vmEval( HB_USHORT uiParams );
 #endif
@@ -179,6 +180,9 @@ extern HB_EXPORT void     hb_vmUnlock( void ); /* unlock VM, allow GC execution
 #ifdef _HB_API_INTERNAL_
 extern HB_EXPORT HB_BOOL  hb_vmSuspendThreads( HB_BOOL fWait ); /* (try to) stop all threads except current one */
 extern HB_EXPORT void     hb_vmResumeThreads( void ); /* unblock execution of threads stopped by hb_vmSuspendThreads() */
+extern void               hb_vmSampleRequest( void ); /* request call stack sample from all running threads */
+extern void               hb_vmSampleCancel( void ); /* drop pending call stack sample request */
+extern void               hb_profSampleThread( void ); /* register call stack sample of current thread */
 #endif
 extern HB_EXPORT HB_BOOL  hb_vmThreadRegister( void * ); /* Register new thread without local thread HVM stack */
 extern HB_EXPORT void     hb_vmThreadRelease( void * ); /* Remove registered thread which does not have local thread HVM stack yet */
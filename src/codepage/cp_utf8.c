@@ -248,6 +248,33 @@ static HB_CDP_CMP_FUNC( UTF8_cmpi )
    return iRet;
 }
 
+static HB_CDP_SORTKEY_FUNC( UTF8_sortkey )
+{
+#ifdef HB_UTF8EX_SORT
+
+   HB_UCHAR * pDst = ( HB_UCHAR * ) pKey;
+   HB_SIZE nPos = 0;
+   HB_WCHAR wc;
+
+   while( HB_CDPCHAR_GET( cdp, pSrc, nLen, &nPos, &wc ) )
+   {
+      HB_USHORT us = s_uniSort[ wc ];
+      *pDst++ = ( HB_UCHAR ) ( us >> 8 );
+      *pDst++ = ( HB_UCHAR ) us;
+   }
+
+   return pDst - ( HB_UCHAR * ) pKey;
+
+#else
+
+   HB_SYMBOL_UNUSED( cdp );
+
+   memcpy( pKey, pSrc, nLen );
+
+   return nLen;
+#endif
+}
+
 
 static void hb_cp_init( PHB_CODEPAGE cdp )
 {
@@ -298,6 +325,7 @@ static void hb_cp_init( PHB_CODEPAGE cdp )
 
 #define HB_CP_CMP_FUNC        UTF8_cmp
 #define HB_CP_CMPI_FUNC       UTF8_cmpi
+#define HB_CP_SORTKEY_FUNC    UTF8_sortkey
 
 #define s_flags               NULL
 #define s_upper               NULL
@@ -48,6 +48,33 @@
 #include "hbapi.h"
 #include "hbmath.h"
 
+/* SSE2 is part of x86_64 architecture and can be used unconditionally,
+   AVX2 kernels are selected at runtime when CPU supports them.
+   Define HB_NO_SIMD to build portable code only. */
+#if ! defined( HB_NO_SIMD )
+#  if defined( __SSE2__ ) || defined( _M_X64 ) || defined( _M_AMD64 ) || \
+      ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#     define HB_STR_SSE2
+#     include <emmintrin.h>
+/* GCC and Clang for Windows do not align stack for AVX variables */
+#     if defined( _WIN32 )
+#     elif defined( __clang__ ) && defined( __has_attribute ) && defined( __has_builtin )
+#        if __has_attribute( target ) && __has_builtin( __builtin_cpu_supports )
+#           define HB_STR_AVX2
+#        endif
+#     elif defined( __GNUC__ ) && ! defined( __clang__ ) && \
+           ( __GNUC__ > 4 || ( __GNUC__ == 4 && __GNUC_MINOR__ >= 9 ) )
+#        define HB_STR_AVX2
+#     endif
+#     if defined( HB_STR_AVX2 )
+#        include <immintrin.h>
+#     endif
+#  endif
+#endif
+
+/* machine word with all bytes set to given value */
+#define HB_WORD_BYTES( c )    ( ( ( HB_SIZE ) -1 / 0xFF ) * ( HB_UCHAR ) ( c ) )
+
 const char * const hb_szAscii[ 256 ] = {
    "\x00", "\x01", "\x02", "\x03", "\x04", "\x05", "\x06", "\x07", "\x08", "\x09", "\x0A", "\x0B", "\x0C", "\x0D", "\x0E", "\x0F",
    "\x10", "\x11", "\x12", "\x13", "\x14", "\x15", "\x16", "\x17", "\x18", "\x19", "\x1A", "\x1B", "\x1C", "\x1D", "\x1E", "\x1F",
@@ -67,28 +94,159 @@ const char * const hb_szAscii[ 256 ] = {
    "\xF0", "\xF1", "\xF2", "\xF3", "\xF4", "\xF5", "\xF6", "\xF7", "\xF8", "\xF9", "\xFA", "\xFB", "\xFC", "\xFD", "\xFE", "\xFF"
 };
 
+/* number of trailing zero bits in non zero mask */
+static int hb_strMaskBit( HB_U32 uiMask )
+{
+#if defined( __GNUC__ ) || defined( __clang__ )
+   return __builtin_ctz( uiMask );
+#else
+   int iBit = 0;
+
+   while( ( uiMask & 1 ) == 0 )
+   {
+      uiMask >>= 1;
+      ++iBit;
+   }
+   return iBit;
+#endif
+}
+
+/* when pattern with repeated characters causes too many false
+   candidates switch to Turbo Boyer-Moore search */
+#define HB_STRAT_MAXFAIL      64
+#define HB_STRAT_BMLEN        16
+
+static HB_SIZE hb_strAtBM( const char * szSub, HB_SIZE nSubLen,
+                           const char * szText, HB_SIZE nLen, HB_SIZE nPos )
+{
+   HB_SIZE nAt = ( HB_SIZE ) hb_strAtTBM( szSub, ( HB_ISIZ ) nSubLen,
+                                          szText + nPos, ( HB_ISIZ ) ( nLen - nPos ) );
+
+   return nAt ? nAt + nPos : 0;
+}
+
+/* memchr() based search, libc implementations of memchr() are usually
+   well optimized for given platform */
+static HB_SIZE hb_strAtMem( const char * szSub, HB_SIZE nSubLen,
+                            const char * szText, HB_SIZE nLen, HB_SIZE nPos )
+{
+   const char * pEnd = szText + nLen - nSubLen + 1;
+   const char * ptr = szText + nPos;
+   HB_SIZE nFail = 0;
+
+   while( ptr < pEnd &&
+          ( ptr = ( const char * ) memchr( ptr, ( HB_UCHAR ) *szSub, pEnd - ptr ) ) != NULL )
+   {
+      if( memcmp( ptr + 1, szSub + 1, nSubLen - 1 ) == 0 )
+         return ptr - szText + 1;
+      if( ++nFail > HB_STRAT_MAXFAIL && nSubLen >= HB_STRAT_BMLEN )
+         return hb_strAtBM( szSub, nSubLen, szText, nLen, ptr - szText + 1 );
+      ++ptr;
+   }
+
+   return 0;
+}
+
+#if defined( HB_STR_SSE2 )
+/* compare first and last character of pattern with 16 positions at once,
+   only positions where both match are verified */
+static HB_SIZE hb_strAtSSE2( const char * szSub, HB_SIZE nSubLen,
+                             const char * szText, HB_SIZE nLen )
+{
+   const __m128i vFirst = _mm_set1_epi8( szSub[ 0 ] );
+   const __m128i vLast  = _mm_set1_epi8( szSub[ nSubLen - 1 ] );
+   HB_SIZE nMax = nLen - nSubLen + 1, nPos = 0, nFail = 0;
+
+   while( nPos + 16 <= nMax )
+   {
+      __m128i vBlk1 = _mm_loadu_si128( ( const __m128i * ) ( szText + nPos ) );
+      __m128i vBlk2 = _mm_loadu_si128( ( const __m128i * ) ( szText + nPos + nSubLen - 1 ) );
+      HB_U32 uiMask = ( HB_U32 ) _mm_movemask_epi8(
+                         _mm_and_si128( _mm_cmpeq_epi8( vBlk1, vFirst ),
+                                        _mm_cmpeq_epi8( vBlk2, vLast ) ) );
+      while( uiMask )
+      {
+         int iBit = hb_strMaskBit( uiMask );
+
+         if( memcmp( szText + nPos + iBit + 1, szSub + 1, nSubLen - 2 ) == 0 )
+            return nPos + iBit + 1;
+         if( ++nFail > HB_STRAT_MAXFAIL && nSubLen >= HB_STRAT_BMLEN )
+            return hb_strAtBM( szSub, nSubLen, szText, nLen, nPos + iBit + 1 );
+         uiMask &= uiMask - 1;
+      }
+      nPos += 16;
+   }
+
+   return nPos < nMax ? hb_strAtMem( szSub, nSubLen, szText, nLen, nPos ) : 0;
+}
+#endif
+
+#if defined( HB_STR_AVX2 )
+__attribute__( ( target( "avx2" ) ) )
+static HB_SIZE hb_strAtAVX2( const char * szSub, HB_SIZE nSubLen,
+                             const char * szText, HB_SIZE nLen )
+{
+   const __m256i vFirst = _mm256_set1_epi8( szSub[ 0 ] );
+   const __m256i vLast  = _mm256_set1_epi8( szSub[ nSubLen - 1 ] );
+   HB_SIZE nMax = nLen - nSubLen + 1, nPos = 0, nFail = 0;
+
+   while( nPos + 32 <= nMax )
+   {
+      __m256i vBlk1 = _mm256_loadu_si256( ( const __m256i * ) ( szText + nPos ) );
+      __m256i vBlk2 = _mm256_loadu_si256( ( const __m256i * ) ( szText + nPos + nSubLen - 1 ) );
+      HB_U32 uiMask = ( HB_U32 ) _mm256_movemask_epi8(
+                         _mm256_and_si256( _mm256_cmpeq_epi8( vBlk1, vFirst ),
+                                           _mm256_cmpeq_epi8( vBlk2, vLast ) ) );
+      while( uiMask )
+      {
+         int iBit = hb_strMaskBit( uiMask );
+
+         if( memcmp( szText + nPos + iBit + 1, szSub + 1, nSubLen - 2 ) == 0 )
+            return nPos + iBit + 1;
+         if( ++nFail > HB_STRAT_MAXFAIL && nSubLen >= HB_STRAT_BMLEN )
+            return hb_strAtBM( szSub, nSubLen, szText, nLen, nPos + iBit + 1 );
+         uiMask &= uiMask - 1;
+      }
+      nPos += 32;
+   }
+
+   return nPos < nMax ? hb_strAtMem( szSub, nSubLen, szText, nLen, nPos ) : 0;
+}
+
+static int s_iAVX2 = -1;
+
+static HB_BOOL hb_strHasAVX2( void )
+{
+   /* benign race, all threads set the same value */
+   if( s_iAVX2 < 0 )
+   {
+      __builtin_cpu_init();
+      s_iAVX2 = __builtin_cpu_supports( "avx2" ) ? 1 : 0;
+   }
+   return s_iAVX2 != 0;
+}
+#endif
+
 HB_SIZE hb_strAt( const char * szSub, HB_SIZE nSubLen, const char * szText, HB_SIZE nLen )
 {
    HB_TRACE( HB_TR_DEBUG, ( "hb_strAt(%s, %" HB_PFS "u, %s, %" HB_PFS "u)", szSub, nSubLen, szText, nLen ) );
 
    if( nSubLen > 0 && nLen >= nSubLen )
    {
-      HB_SIZE nPos = 0;
-      nLen -= nSubLen;
-      do
+      if( nSubLen == 1 )
       {
-         if( szText[ nPos ] == *szSub )
-         {
-            HB_SIZE nSubPos = nSubLen;
-            do
-            {
-               if( --nSubPos == 0 )
-                  return nPos + 1;
-            }
-            while( szText[ nPos + nSubPos ] == szSub[ nSubPos ] );
-         }
+         const char * ptr = ( const char * ) memchr( szText, ( HB_UCHAR ) *szSub, nLen );
+         return ptr ? ptr - szText + 1 : 0;
       }
-      while( nPos++ < nLen );
+#if defined( HB_STR_AVX2 )
+      if( nLen - nSubLen >= 64 && hb_strHasAVX2() )
+         return hb_strAtAVX2( szSub, nSubLen, szText, nLen );
+#endif
+#if defined( HB_STR_SSE2 )
+      if( nLen - nSubLen >= 16 )
+         return hb_strAtSSE2( szSub, nSubLen, szText, nLen );
+#endif
+      return hb_strAtMem( szSub, nSubLen, szText, nLen, 0 );
    }
 
    return 0;
@@ -121,10 +279,86 @@ HB_SIZE hb_strAtI( const char * szSub, HB_SIZE nSubLen, const char * szText, HB_
    return 0;
 }
 
+/* trims from the left, and returns a new pointer to szText */
+/* also returns the new length in lLen */
+const char * hb_strLTrim( const char * szText, HB_SIZE * nLen )
+{
+   HB_TRACE( HB_TR_DEBUG, ( "hb_strLTrim(%s, %p)", szText, ( void * ) nLen ) );
+
+   /* skip blocks of spaces at once */
+   while( *nLen >= sizeof( HB_SIZE ) )
+   {
+      HB_SIZE nWord;
+
+      memcpy( &nWord, szText, sizeof( HB_SIZE ) );
+      if( nWord != HB_WORD_BYTES( ' ' ) )
+         break;
+      szText += sizeof( HB_SIZE );
+      *nLen -= sizeof( HB_SIZE );
+   }
+
+   while( *nLen && HB_ISSPACE( *szText ) )
+   {
+      szText++;
+      ( *nLen )--;
+   }
+
+   return szText;
+}
+
+/* return length of szText ignoring trailing white space (or true spaces) */
+HB_SIZE hb_strRTrimLen( const char * szText, HB_SIZE nLen, HB_BOOL bAnySpace )
+{
+   HB_TRACE( HB_TR_DEBUG, ( "hb_strRTrimLen(%s, %lu. %d)", szText, nLen, ( int ) bAnySpace ) );
+
+   /* skip blocks of spaces at once, it's common case for
+      space padded strings like DBF fields */
+#if defined( HB_STR_SSE2 )
+   if( nLen >= 16 )
+   {
+      const __m128i vSpace = _mm_set1_epi8( ' ' );
+
+      do
+      {
+         __m128i vBlk = _mm_loadu_si128( ( const __m128i * ) ( szText + nLen - 16 ) );
+
+         if( _mm_movemask_epi8( _mm_cmpeq_epi8( vBlk, vSpace ) ) != 0xFFFF )
+            break;
+         nLen -= 16;
+      }
+      while( nLen >= 16 );
+   }
+#else
+   while( nLen >= sizeof( HB_SIZE ) )
+   {
+      HB_SIZE nWord;
+
+      memcpy( &nWord, szText + nLen - sizeof( HB_SIZE ), sizeof( HB_SIZE ) );
+      if( nWord != HB_WORD_BYTES( ' ' ) )
+         break;
+      nLen -= sizeof( HB_SIZE );
+   }
+#endif
+
+   if( bAnySpace )
+   {
+      while( nLen && HB_ISSPACE( szText[ nLen - 1 ] ) )
+         nLen--;
+   }
+   else
+   {
+      while( nLen && szText[ nLen - 1 ] == ' ' )
+         nLen--;
+   }
+
+   return nLen;
+}
+
 HB_BOOL hb_strEmpty( const char * szText, HB_SIZE nLen )
 {
    HB_TRACE( HB_TR_DEBUG, ( "hb_strEmpty(%s, %" HB_PFS "u)", szText, nLen ) );
 
+   nLen = hb_strRTrimLen( szText, nLen, HB_FALSE );
    while( nLen-- )
    {
       char c = szText[ nLen ];
@@ -279,10 +513,21 @@ int hb_strnicmp( const char * s1, const char * s2, HB_SIZE count )
 
    HB_TRACE( HB_TR_DEBUG, ( "hb_strnicmp(%.*s, %.*s, %" HB_PFS "u)", ( int ) count, s1, ( int ) count, s2, count ) );
 
+   /* NOTE: strings can be shorter than count so they cannot be
+            compared in blocks without checking for terminator first */
    for( nCount = 0; nCount < count; nCount++ )
    {
-      unsigned char c1 = ( char ) HB_TOUPPER( ( unsigned char ) s1[ nCount ] );
-      unsigned char c2 = ( char ) HB_TOUPPER( ( unsigned char ) s2[ nCount ] );
+      unsigned char c1 = ( unsigned char ) s1[ nCount ];
+      unsigned char c2 = ( unsigned char ) s2[ nCount ];
+
+      if( c1 == c2 )
+      {
+         if( ! c1 )
+            break;
+         continue;
+      }
+      c1 = ( unsigned char ) HB_TOUPPER( c1 );
+      c2 = ( unsigned char ) HB_TOUPPER( c2 );
 
       if( c1 != c2 )
       {
@@ -50,7 +50,7 @@
 
 #include "hbapi.h"
 
-#define ASIZE  UCHAR_MAX
+#define ASIZE  ( UCHAR_MAX + 1 )
 
 static void preBmBc( const char * needle, HB_ISIZ m, HB_ISIZ bmBc[] )
 {
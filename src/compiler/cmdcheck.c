@@ -461,11 +461,29 @@ static const char * hb_compChkParseSwitch( HB_COMP_DECL, const char * szSwitch,
             break;
 
          case 'J':
-            ++szSwPtr;
-            HB_COMP_PARAM->fI18n = HB_TRUE;
-            if( *szSwPtr )
-               szSwPtr = hb_compChkOptionFName( szSwPtr, &HB_COMP_PARAM->pI18nFileName, fEnv );
+         {
+            char *szOption = hb_compChkOptionDup( szSwPtr );
+
+            if( strncmp( szOption, "JOBS=", 5 ) == 0 &&
+                HB_ISDIGIT( szOption[ 5 ] ) )
+            {
+               int iJobs = 0;
+
+               szSwPtr += 5;
+               while( HB_ISDIGIT( *szSwPtr ) )
+                  iJobs = iJobs * 10 + ( *szSwPtr++ - '0' );
+               HB_COMP_PARAM->iJobs = iJobs;
+            }
+            else
+            {
+               ++szSwPtr;
+               HB_COMP_PARAM->fI18n = HB_TRUE;
+               if( *szSwPtr )
+                  szSwPtr = hb_compChkOptionFName( szSwPtr, &HB_COMP_PARAM->pI18nFileName, fEnv );
+            }
+            hb_xfree( szOption );
             break;
+         }
 
          case 'K':
             ++szSwPtr;
@@ -34,16 +34,238 @@
 #include "hbcomp.h"
 #include "hbset.h"
 
+/* parallel compilation (-jobs=<n>) is supported only by standalone
+   compiler which does not use HVM memory manager */
+#if ! defined( HB_FM_STATISTICS ) && ! defined( __WATCOMC__ ) && \
+    ( defined( HB_OS_LINUX ) || defined( HB_OS_DARWIN ) || \
+      ( defined( HB_OS_WIN ) && ! defined( HB_OS_WIN_CE ) ) )
+#  define HB_COMP_PARALLEL
+#  include "hbthread.h"
+#endif
+
 static int hb_compCompile( HB_COMP_DECL, const char * szPrg, const char * szBuffer, int iStartLine );
 static HB_BOOL hb_compRegisterFunc( HB_COMP_DECL, PHB_HFUNC pFunc, HB_BOOL fError );
 
 /* ************************************************************************* */
 
-int hb_compMainExt( int argc, const char * const argv[],
-                    HB_BYTE ** pBufPtr, HB_SIZE * pnSize,
-                    const char * szSource, int iStartLine,
-                    void * cargo, PHB_PP_OPEN_FUNC pOpenFunc,
-                                  PHB_PP_MSG_FUNC pMsgFunc )
+#if defined( HB_COMP_PARALLEL )
+
+#define HB_COMP_JOBS_MAX      64
+
+typedef struct
+{
+   HB_RAWCRITICAL_T     mutex;
+   PHB_COMP             pComp;         /* main compiler context used for output */
+   int                  argc;
+   const char * const * argv;
+   int                  iNext;         /* next command-line argument to check */
+   int                  iStatus;
+   HB_BOOL              fStop;
+}
+HB_COMP_JOBS, * PHB_COMP_JOBS;
+
+typedef struct
+{
+   PHB_COMP_JOBS  pJobs;
+   PHB_COMP       pComp;
+   char *         pOut;                /* buffered messages */
+   HB_SIZE        nOutLen;
+   HB_SIZE        nOutSize;
+#if defined( HB_PTHREAD_API )
+   pthread_t      th_id;
+#else
+   HANDLE         th_h;
+#endif
+   HB_BOOL        fStarted;
+}
+HB_COMP_JOB, * PHB_COMP_JOB;
+
+static void hb_compJobOutNone( void * cargo, const char * szMessage )
+{
+   HB_SYMBOL_UNUSED( cargo );
+   HB_SYMBOL_UNUSED( szMessage );
+}
+
+/* messages are buffered and shown when whole file is compiled
+   so output from different threads is not mixed */
+static void hb_compJobOut( PHB_COMP_JOB pJob, char cType, const char * szMessage )
+{
+   HB_SIZE nLen = strlen( szMessage ) + 2;
+
+   if( pJob->nOutLen + nLen > pJob->nOutSize )
+   {
+      pJob->nOutSize += HB_MAX( nLen, 1024 );
+      if( pJob->pOut )
+         pJob->pOut = ( char * ) hb_xrealloc( pJob->pOut, pJob->nOutSize );
+      else
+         pJob->pOut = ( char * ) hb_xgrab( pJob->nOutSize );
+   }
+   pJob->pOut[ pJob->nOutLen++ ] = cType;
+   memcpy( pJob->pOut + pJob->nOutLen, szMessage, nLen - 1 );
+   pJob->nOutLen += nLen - 1;
+}
+
+static void hb_compJobOutStd( void * cargo, const char * szMessage )
+{
+   hb_compJobOut( ( PHB_COMP_JOB ) ( ( PHB_COMP ) cargo )->cargo, 'O', szMessage );
+}
+
+static void hb_compJobOutErr( void * cargo, const char * szMessage )
+{
+   hb_compJobOut( ( PHB_COMP_JOB ) ( ( PHB_COMP ) cargo )->cargo, 'E', szMessage );
+}
+
+/* must be called with locked mutex */
+static void hb_compJobFlush( HB_COMP_DECL, PHB_COMP_JOB pJob )
+{
+   HB_SIZE nPos = 0;
+
+   while( nPos < pJob->nOutLen )
+   {
+      const char * szMessage = pJob->pOut + nPos + 1;
+
+      if( pJob->pOut[ nPos ] == 'E' )
+         hb_compOutErr( HB_COMP_PARAM, szMessage );
+      else
+         hb_compOutStd( HB_COMP_PARAM, szMessage );
+      nPos += strlen( szMessage ) + 2;
+   }
+   pJob->nOutLen = 0;
+}
+
+static HB_THREAD_STARTFUNC( hb_compJobThread )
+{
+   PHB_COMP_JOB pJob = ( PHB_COMP_JOB ) Cargo;
+   PHB_COMP_JOBS pJobs = pJob->pJobs;
+
+   for( ;; )
+   {
+      const char * szPrg = NULL;
+      int iStatus;
+
+      HB_CRITICAL_LOCK( pJobs->mutex );
+      while( ! pJobs->fStop && pJobs->iNext < pJobs->argc )
+      {
+         const char * szArg = pJobs->argv[ pJobs->iNext++ ];
+         if( ! HB_ISOPTSEP( szArg[ 0 ] ) )
+         {
+            szPrg = szArg;
+            break;
+         }
+      }
+      HB_CRITICAL_UNLOCK( pJobs->mutex );
+
+      if( szPrg == NULL )
+         break;
+
+      iStatus = hb_compCompile( pJob->pComp, szPrg, NULL, 0 );
+
+      HB_CRITICAL_LOCK( pJobs->mutex );
+      hb_compJobFlush( pJobs->pComp, pJob );
+      if( iStatus != EXIT_SUCCESS || pJob->pComp->fExit )
+      {
+         if( iStatus != EXIT_SUCCESS )
+            pJobs->iStatus = iStatus;
+         pJobs->fStop = HB_TRUE;
+      }
+      HB_CRITICAL_UNLOCK( pJobs->mutex );
+   }
+
+   HB_THREAD_RAWEND
+}
+
+static int hb_compCompileJobs( HB_COMP_DECL, int argc, const char * const argv[] )
+{
+   HB_COMP_JOBS jobs;
+   PHB_COMP_JOB pJobList;
+   int iJobs = HB_MIN( HB_COMP_PARAM->iJobs, HB_COMP_JOBS_MAX ), i;
+
+   memset( &jobs, 0, sizeof( jobs ) );
+   HB_CRITICAL_INIT( jobs.mutex );
+   jobs.pComp = HB_COMP_PARAM;
+   jobs.argc = argc;
+   jobs.argv = argv;
+   jobs.iNext = 1;
+   jobs.iStatus = EXIT_SUCCESS;
+
+   /* compiler contexts are initialized in main thread using
+      the same settings as in main context */
+   pJobList = ( PHB_COMP_JOB ) hb_xgrabz( iJobs * sizeof( HB_COMP_JOB ) );
+   for( i = 0; i < iJobs; ++i )
+   {
+      PHB_COMP_JOB pJob = &pJobList[ i ];
+      PHB_COMP pComp = hb_comp_new();
+
+      pJob->pJobs = &jobs;
+      pJob->pComp = pComp;
+      pComp->cargo = pJob;
+      pComp->outStdFunc = pComp->outErrFunc = hb_compJobOutNone;
+      hb_compChkEnvironment( pComp );
+      hb_compChkCommandLine( pComp, argc, argv );
+      pComp->fLogo = HB_FALSE;
+      pComp->fGauge = HB_FALSE;
+      if( pComp->fINCLUDE )
+         hb_compChkAddIncPaths( pComp );
+      hb_compInitPP( pComp, NULL );
+      hb_compIdentifierOpen( pComp );
+      hb_pp_setIncCache( pComp->pLex->pPP, HB_TRUE );
+      pComp->outStdFunc = hb_compJobOutStd;
+      pComp->outErrFunc = hb_compJobOutErr;
+   }
+
+   /* the first job is executed by current thread */
+   for( i = 1; i < iJobs; ++i )
+   {
+      PHB_COMP_JOB pJob = &pJobList[ i ];
+#if defined( HB_PTHREAD_API )
+      pJob->fStarted = pthread_create( &pJob->th_id, NULL, hb_compJobThread, pJob ) == 0;
+#else
+      HB_THREAD_ID th_id;
+#  if defined( HB_THREAD_RAWWINAPI )
+      pJob->th_h = CreateThread( NULL, 0, hb_compJobThread, pJob, 0, &th_id );
+#  else
+      pJob->th_h = ( HANDLE ) _beginthreadex( NULL, 0, hb_compJobThread, pJob, 0, &th_id );
+#  endif
+      pJob->fStarted = pJob->th_h != 0;
+#endif
+   }
+   hb_compJobThread( &pJobList[ 0 ] );
+
+   for( i = 0; i < iJobs; ++i )
+   {
+      PHB_COMP_JOB pJob = &pJobList[ i ];
+
+      if( pJob->fStarted )
+      {
+#if defined( HB_PTHREAD_API )
+         pthread_join( pJob->th_id, NULL );
+#else
+         WaitForSingleObject( pJob->th_h, INFINITE );
+         CloseHandle( pJob->th_h );
+#endif
+      }
+      HB_COMP_PARAM->iErrorCount += pJob->pComp->iErrorCount;
+      if( pJob->pComp->fExit )
+         HB_COMP_PARAM->fExit = HB_TRUE;
+      if( pJob->pOut )
+         hb_xfree( pJob->pOut );
+      hb_comp_free( pJob->pComp );
+   }
+   hb_xfree( pJobList );
+
+   HB_CRITICAL_DESTROY( jobs.mutex );
+
+   return jobs.iStatus;
+}
+
+#endif /* HB_COMP_PARALLEL */
+
+static int hb_compMainRun( int argc, const char * const argv[],
+                           HB_BYTE ** pBufPtr, HB_SIZE * pnSize,
+                           const char * szSource, int iStartLine,
+                           void * cargo, PHB_PP_OPEN_FUNC pOpenFunc,
+                                         PHB_PP_MSG_FUNC pMsgFunc,
+                           HB_BOOL fJobs )
 {
    HB_COMP_DECL;
    int iStatus = EXIT_SUCCESS, iFileCount = 0;
@@ -126,17 +348,41 @@ int hb_compMainExt( int argc, const char * const argv[],
    }
    else
    {
-      int i;
-      /* Process all files passed via the command-line. */
-      for( i = 1; i < argc && ! HB_COMP_PARAM->fExit; i++ )
+      int i, iFiles = 0;
+
+      for( i = 1; i < argc; i++ )
       {
-         HB_TRACE( HB_TR_DEBUG, ( "main LOOP(%i,%s)", i, argv[ i ] ) );
          if( ! HB_ISOPTSEP( argv[ i ][ 0 ] ) )
+            iFiles++;
+      }
+#if defined( HB_COMP_PARALLEL )
+      if( fJobs && iFiles > 1 && HB_COMP_PARAM->iJobs > 1 &&
+          ! HB_COMP_PARAM->fExit && ! HB_COMP_PARAM->fI18n && ! pBufPtr )
+      {
+         /* Compile files passed via the command-line in parallel threads. */
+         iFileCount = iFiles;
+         iStatus = hb_compCompileJobs( HB_COMP_PARAM, argc, argv );
+      }
+      else
+#else
+      HB_SYMBOL_UNUSED( fJobs );
+#endif
+      {
+         /* reuse rules defined by header files included by many modules */
+         if( iFiles > 1 && HB_COMP_PARAM->pLex->pPP )
+            hb_pp_setIncCache( HB_COMP_PARAM->pLex->pPP, HB_TRUE );
+
+         /* Process all files passed via the command-line. */
+         for( i = 1; i < argc && ! HB_COMP_PARAM->fExit; i++ )
          {
-            iFileCount++;
-            iStatus = hb_compCompile( HB_COMP_PARAM, argv[ i ], NULL, 0 );
-            if( iStatus != EXIT_SUCCESS )
-               break;
+            HB_TRACE( HB_TR_DEBUG, ( "main LOOP(%i,%s)", i, argv[ i ] ) );
+            if( ! HB_ISOPTSEP( argv[ i ][ 0 ] ) )
+            {
+               iFileCount++;
+               iStatus = hb_compCompile( HB_COMP_PARAM, argv[ i ], NULL, 0 );
+               if( iStatus != EXIT_SUCCESS )
+                  break;
+            }
          }
       }
    }
@@ -173,9 +419,21 @@ int hb_compMainExt( int argc, const char * const argv[],
    return iStatus;
 }
 
+int hb_compMainExt( int argc, const char * const argv[],
+                    HB_BYTE ** pBufPtr, HB_SIZE * pnSize,
+                    const char * szSource, int iStartLine,
+                    void * cargo, PHB_PP_OPEN_FUNC pOpenFunc,
+                                  PHB_PP_MSG_FUNC pMsgFunc )
+{
+   /* compiler called from HVM cannot create native threads because
+      they do not have HVM stack necessary for memory manager */
+   return hb_compMainRun( argc, argv, pBufPtr, pnSize, szSource, iStartLine,
+                          cargo, pOpenFunc, pMsgFunc, HB_FALSE );
+}
+
 int hb_compMain( int argc, const char * const argv[] )
 {
-   return hb_compMainExt( argc, argv, NULL, NULL, NULL, 0, NULL, NULL, NULL );
+   return hb_compMainRun( argc, argv, NULL, NULL, NULL, 0, NULL, NULL, NULL, HB_TRUE );
 }
 
 static int hb_compReadClpFile( HB_COMP_DECL, const char * szClpFile )
@@ -72,6 +72,7 @@ void hb_compPrintUsage( HB_COMP_DECL, const char * szSelf )
       "\n          -i<path>         #include file search path",
       "\n          -i[-|+]          disable/enable support for INCLUDE envvar",
       "\n          -j[<file>]       generate i18n gettext file (.pot)",
+      "\n          -jobs=<n>        compile multiple .prg files using <n> threads",
       "\n          -k               compilation mode (type -k? for more data)",
       "\n          -l               suppress line number information",
       "\n          -m               compile module only",
@@ -215,6 +215,10 @@ static void hb_pp_error( PHB_PP_STATE pState, char type, int iError, const char
 {
    const char * const * szMsgTable = type == 'W' ? s_pp_szWarnings : s_pp_szErrors;
 
+   /* files which generate messages are not cached */
+   if( pState->pIncRec )
+      pState->pIncRec->fValid = HB_FALSE;
+
    if( pState->pErrorFunc )
    {
       ( pState->pErrorFunc )( pState->cargo, szMsgTable, type, iError, szParam, NULL );
@@ -1867,6 +1871,224 @@ static void hb_pp_ruleListSetId( PHB_PP_STATE pState, PHB_PP_RULE pRule, HB_BYTE
    }
 }
 
+/*
+ * cache for rules defined by included files
+ *
+ * When the same header file is included in many compiled .prg files
+ * then it's parsed only once. Rules defined by such file are recorded
+ * and later only copied to PP context. The cache is used only when
+ * #include directive is executed in known PP context state, i.e. with
+ * standard rules only or with the rules from other cached files
+ * included in the same order and when the included file does not
+ * generate any output tokens, messages or changes in other rules or
+ * PP/compiler switches.
+ */
+
+static PHB_PP_TOKEN hb_pp_tokenListClone( PHB_PP_TOKEN pToken )
+{
+   PHB_PP_TOKEN pList = NULL, * pListPtr = &pList;
+
+   while( pToken )
+   {
+      *pListPtr = hb_pp_tokenClone( pToken );
+      ( *pListPtr )->type &= ~HB_PP_TOKEN_PREDEFINED;
+      if( HB_PP_TOKEN_TYPE( pToken->type ) == HB_PP_MMARKER_RESTRICT ||
+          HB_PP_TOKEN_TYPE( pToken->type ) == HB_PP_MMARKER_OPTIONAL ||
+          HB_PP_TOKEN_TYPE( pToken->type ) == HB_PP_RMARKER_OPTIONAL )
+         ( *pListPtr )->pMTokens = hb_pp_tokenListClone( pToken->pMTokens );
+      else
+         ( *pListPtr )->pMTokens = NULL;
+      pListPtr = &( *pListPtr )->pNext;
+      pToken = pToken->pNext;
+   }
+
+   return pList;
+}
+
+static PHB_PP_RULE hb_pp_ruleClone( PHB_PP_RULE pSource )
+{
+   PHB_PP_MARKER pMarkers = NULL;
+
+   if( pSource->markers > 0 )
+   {
+      HB_USHORT marker;
+
+      pMarkers = ( PHB_PP_MARKER ) hb_xgrabz( pSource->markers * sizeof( HB_PP_MARKER ) );
+      for( marker = 0; marker < pSource->markers; ++marker )
+         pMarkers[ marker ].canrepeat = pSource->pMarkers[ marker ].canrepeat;
+   }
+
+   return hb_pp_ruleNew( hb_pp_tokenListClone( pSource->pMatch ),
+                         hb_pp_tokenListClone( pSource->pResult ),
+                         pSource->mode & ~HB_PP_STD_RULE,
+                         pSource->markers, pMarkers );
+}
+
+/* copy rules added to the list after pStop in reverse order,
+   so the oldest one is the first one in returned list */
+static PHB_PP_RULE hb_pp_ruleListCloneRev( PHB_PP_RULE pRule, PHB_PP_RULE pStop )
+{
+   PHB_PP_RULE pList = NULL;
+
+   while( pRule && pRule != pStop )
+   {
+      PHB_PP_RULE pCopy = hb_pp_ruleClone( pRule );
+      pCopy->pPrev = pList;
+      pList = pCopy;
+      pRule = pRule->pPrev;
+   }
+
+   return pList;
+}
+
+/* add copies of cached rules to the rule list */
+static int hb_pp_ruleListAddCached( PHB_PP_STATE pState, PHB_PP_RULE * pRulePtr,
+                                    PHB_PP_RULE pRule, HB_BYTE id )
+{
+   int iRules = 0;
+
+   while( pRule )
+   {
+      PHB_PP_RULE pCopy = hb_pp_ruleClone( pRule );
+      pCopy->pPrev = *pRulePtr;
+      *pRulePtr = pCopy;
+      hb_pp_ruleSetId( pState, pCopy->pMatch, id );
+      pRule = pRule->pPrev;
+      ++iRules;
+   }
+
+   return iRules;
+}
+
+static void hb_pp_incCacheFreeItem( PHB_PP_INCCACHE pCache )
+{
+   hb_xfree( pCache->szFileName );
+   hb_membufFree( pCache->pIncFiles );
+   hb_pp_ruleListFree( &pCache->pDefinitions );
+   hb_pp_ruleListFree( &pCache->pTranslations );
+   hb_pp_ruleListFree( &pCache->pCommands );
+   hb_xfree( pCache );
+}
+
+static void hb_pp_incCacheFree( PHB_PP_STATE pState )
+{
+   if( pState->pIncRec )
+   {
+      hb_pp_incCacheFreeItem( pState->pIncRec );
+      pState->pIncRec = NULL;
+   }
+   while( pState->pIncCache )
+   {
+      PHB_PP_INCCACHE pCache = pState->pIncCache;
+      pState->pIncCache = pCache->pNext;
+      hb_pp_incCacheFreeItem( pCache );
+   }
+   pState->pIncBase = NULL;
+   pState->fIncKnown = HB_FALSE;
+}
+
+/* rules or PP settings changed outside included file being recorded,
+   if fStdRule is set then also standard rules were modified so
+   existing cache entries cannot be used anymore */
+static void hb_pp_incCacheChanged( PHB_PP_STATE pState, HB_BOOL fStdRule )
+{
+   if( pState->pIncRec )
+      pState->pIncRec->fValid = HB_FALSE;
+   else
+      pState->fIncKnown = HB_FALSE;
+
+   if( fStdRule && pState->pIncCache )
+   {
+      PHB_PP_INCCACHE pRec = pState->pIncRec;
+
+      pState->pIncRec = NULL;
+      hb_pp_incCacheFree( pState );
+      pState->pIncRec = pRec;
+   }
+}
+
+/* try to use cached rules for included file,
+   returns HB_TRUE if file does not have to be processed */
+static HB_BOOL hb_pp_incCacheGet( PHB_PP_STATE pState, const char * szFileName )
+{
+   PHB_PP_INCCACHE pCache = pState->pIncCache;
+
+   while( pCache )
+   {
+      if( pCache->pBase == pState->pIncBase &&
+          strcmp( pCache->szFileName, szFileName ) == 0 )
+      {
+         if( pState->pIncFunc )
+         {
+            const char * pName = hb_membufPtr( pCache->pIncFiles );
+            HB_SIZE nLen = hb_membufLen( pCache->pIncFiles );
+
+            while( nLen > 0 )
+            {
+               HB_SIZE n = strlen( pName ) + 1;
+               ( pState->pIncFunc )( pState->cargo, pName );
+               pName += n;
+               nLen -= n;
+            }
+         }
+         pState->iDefinitions += hb_pp_ruleListAddCached( pState, &pState->pDefinitions,
+                                                          pCache->pDefinitions, HB_PP_DEFINE );
+         pState->iTranslations += hb_pp_ruleListAddCached( pState, &pState->pTranslations,
+                                                           pCache->pTranslations, HB_PP_TRANSLATE );
+         pState->iCommands += hb_pp_ruleListAddCached( pState, &pState->pCommands,
+                                                       pCache->pCommands, HB_PP_COMMAND );
+         pState->iLineTot += pCache->iLines;
+         pState->pIncBase = pCache;
+         return HB_TRUE;
+      }
+      pCache = pCache->pNext;
+   }
+
+   return HB_FALSE;
+}
+
+/* start recording rules defined by included file */
+static void hb_pp_incCacheStart( PHB_PP_STATE pState, const char * szFileName )
+{
+   PHB_PP_INCCACHE pRec = ( PHB_PP_INCCACHE ) hb_xgrabz( sizeof( HB_PP_INCCACHE ) );
+
+   pRec->pBase = pState->pIncBase;
+   pRec->szFileName = hb_strdup( szFileName );
+   pRec->pIncFiles = hb_membufNew();
+   pRec->fValid = HB_TRUE;
+   pRec->iFiles = pState->iFiles;
+   pRec->iCondCount = pState->iCondCount;
+   pRec->iLines = pState->iLineTot;
+   pRec->pDefStart = pState->pDefinitions;
+   pRec->pTransStart = pState->pTranslations;
+   pRec->pCmdStart = pState->pCommands;
+   pState->pIncRec = pRec;
+}
+
+/* recorded file has been closed, store its rules in the cache */
+static void hb_pp_incCacheEnd( PHB_PP_STATE pState )
+{
+   PHB_PP_INCCACHE pRec = pState->pIncRec;
+
+   pState->pIncRec = NULL;
+   if( pRec->fValid && pRec->iCondCount == pState->iCondCount )
+   {
+      pRec->pDefinitions = hb_pp_ruleListCloneRev( pState->pDefinitions, pRec->pDefStart );
+      pRec->pTranslations = hb_pp_ruleListCloneRev( pState->pTranslations, pRec->pTransStart );
+      pRec->pCommands = hb_pp_ruleListCloneRev( pState->pCommands, pRec->pCmdStart );
+      pRec->iLines = pState->iLineTot - pRec->iLines;
+      pRec->pDefStart = pRec->pTransStart = pRec->pCmdStart = NULL;
+      pRec->pNext = pState->pIncCache;
+      pState->pIncCache = pRec;
+      pState->pIncBase = pRec;
+   }
+   else
+   {
+      hb_pp_incCacheFreeItem( pRec );
+      pState->fIncKnown = HB_FALSE;
+   }
+}
+
 static PHB_PP_RULE hb_pp_defineFind( PHB_PP_STATE pState, PHB_PP_TOKEN pToken )
 {
    PHB_PP_RULE pRule = pState->pDefinitions;
@@ -1898,11 +2120,14 @@ static void hb_pp_defineAdd( PHB_PP_STATE pState, HB_USHORT mode,
       pRule->pResult = pResult;
       pRule->pMarkers = pMarkers;
       pRule->markers = markers;
+      hb_pp_incCacheChanged( pState, ( pRule->mode & HB_PP_STD_RULE ) != 0 );
       pRule->mode = mode;
       hb_pp_error( pState, 'W', HB_PP_WARN_DEFINE_REDEF, pMatch->value );
    }
    else
    {
+      if( ! pState->pIncRec )
+         pState->fIncKnown = HB_FALSE;
       pRule = hb_pp_ruleNew( pMatch, pResult, mode, markers, pMarkers );
       pRule->pPrev = pState->pDefinitions;
       pState->pDefinitions = pRule;
@@ -1920,6 +2145,7 @@ static void hb_pp_defineDel( PHB_PP_STATE pState, PHB_PP_TOKEN pToken )
       pRule = *pRulePtr;
       if( hb_pp_tokenEqual( pToken, pRule->pMatch, HB_PP_CMP_CASE ) )
       {
+         hb_pp_incCacheChanged( pState, ( pRule->mode & HB_PP_STD_RULE ) != 0 );
          *pRulePtr = pRule->pPrev;
          hb_pp_ruleFree( pRule );
          pState->iDefinitions--;
@@ -2041,6 +2267,11 @@ static PHB_PP_FILE hb_pp_FileNew( PHB_PP_STATE pState, const char * szFileName,
 
       if( pState->pIncFunc )
          ( pState->pIncFunc )( pState->cargo, szFileName );
+      if( pState->pIncRec )
+      {
+         /* register nested files in cached one */
+         hb_membufAddData( pState->pIncRec->pIncFiles, szFileName, strlen( szFileName ) + 1 );
+      }
    }
 
    pFile = ( PHB_PP_FILE ) hb_xgrabz( sizeof( HB_PP_FILE ) );
@@ -2154,6 +2385,8 @@ static void hb_pp_stateFree( PHB_PP_STATE pState )
    if( pState->iOperators > 0 )
       hb_pp_operatorsFree( pState->pOperators, pState->iOperators );
 
+   hb_pp_incCacheFree( pState );
+
    hb_pp_ruleListFree( &pState->pDefinitions );
    hb_pp_ruleListFree( &pState->pTranslations );
    hb_pp_ruleListFree( &pState->pCommands );
@@ -3390,6 +3623,7 @@ static void hb_pp_directiveDel( PHB_PP_STATE pState, PHB_PP_TOKEN pMatch,
          }
          if( u == markers && hb_pp_patternCompare( pRule->pMatch, pMatch ) )
          {
+            hb_pp_incCacheChanged( pState, ( pRule->mode & HB_PP_STD_RULE ) != 0 );
             *pRulePtr = pRule->pPrev;
             hb_pp_ruleFree( pRule );
             if( fCommand )
@@ -3597,6 +3831,8 @@ static void hb_pp_directiveNew( PHB_PP_STATE pState, PHB_PP_TOKEN pToken,
          else
          {
             PHB_PP_RULE pRule;
+            if( ! pState->pIncRec )
+               pState->fIncKnown = HB_FALSE;
             pRule = hb_pp_ruleNew( pMatch, pResult, mode, usPCount, pMarkers );
             if( fCommand )
             {
@@ -5138,6 +5374,17 @@ static void hb_pp_includeFile( PHB_PP_STATE pState, const char * szFileName, HB_
       HB_BOOL fNested = HB_FALSE;
       PHB_PP_FILE pFile = hb_pp_FileNew( pState, szFileName, fSysFile, &fNested,
                                          NULL, HB_TRUE, pState->pOpenFunc, HB_FALSE );
+      if( pFile && pState->fIncKnown && ! pState->pIncRec &&
+          ! pState->fWritePreprocesed && ! pState->fWriteTrace )
+      {
+         if( hb_pp_incCacheGet( pState, pFile->szFileName ) )
+         {
+            hb_pp_FileFree( pState, pFile, pState->pCloseFunc );
+            pState->pFile->fGenLineInfo = HB_TRUE;
+            return;
+         }
+         hb_pp_incCacheStart( pState, pFile->szFileName );
+      }
       if( pFile )
       {
 #if defined( HB_PP_STRICT_LINEINFO_TOKEN )
@@ -5182,6 +5429,9 @@ static void hb_pp_includeClose( PHB_PP_STATE pState )
       pState->pFile->fGenLineInfo = HB_TRUE;
 
    hb_pp_FileFree( pState, pFile, pState->pCloseFunc );
+
+   if( pState->pIncRec && pState->iFiles <= pState->pIncRec->iFiles )
+      hb_pp_incCacheEnd( pState );
 }
 
 static void hb_pp_preprocessToken( PHB_PP_STATE pState )
@@ -5283,6 +5533,7 @@ static void hb_pp_preprocessToken( PHB_PP_STATE pState )
             mode to allow control by programmer some PP issues */
          else if( hb_pp_tokenValueCmp( pToken, "PRAGMA", HB_PP_CMP_DBASE ) )
          {
+            hb_pp_incCacheChanged( pState, HB_FALSE );
             hb_pp_pragmaNew( pState, pToken->pNext );
          }
          else if( pState->iCondCompile )
@@ -5324,6 +5575,7 @@ static void hb_pp_preprocessToken( PHB_PP_STATE pState )
          }
          else if( hb_pp_tokenValueCmp( pToken, "STDOUT", HB_PP_CMP_DBASE ) )
          {
+            hb_pp_incCacheChanged( pState, HB_FALSE );
             hb_pp_disp( pState, hb_pp_tokenListStr( pToken->pNext, NULL, HB_FALSE,
                                                     pState->pBuffer, HB_FALSE, HB_TRUE ) );
          }
@@ -5426,6 +5678,8 @@ static void hb_pp_preprocessToken( PHB_PP_STATE pState )
       {
          HB_BOOL fDirective = HB_FALSE;
 
+         if( pState->pIncRec )
+            pState->pIncRec->fValid = HB_FALSE;
          pState->iCycle = 0;
          while( ! HB_PP_TOKEN_ISEOC( pState->pFile->pTokenList ) &&
                 pState->iCycle <= pState->iMaxCycles )
@@ -5591,6 +5845,17 @@ void hb_pp_setIncFunc( PHB_PP_STATE pState, PHB_PP_INC_FUNC pIncFunc )
    pState->pIncFunc = pIncFunc;
 }
 
+/*
+ * enable/disable caching rules defined by included files,
+ * used when many .prg files are compiled by the same PP context
+ */
+void hb_pp_setIncCache( PHB_PP_STATE pState, HB_BOOL fIncCache )
+{
+   pState->fIncCache = fIncCache;
+   if( ! fIncCache )
+      hb_pp_incCacheFree( pState );
+}
+
 /*
  * reset PP context, used for multiple .prg file compilation
  * with DO ... or *.clp files
@@ -5626,6 +5891,14 @@ void hb_pp_reset( PHB_PP_STATE pState )
    hb_pp_ruleListNonStdFree( &pState->pDefinitions );
    hb_pp_ruleListNonStdFree( &pState->pTranslations );
    hb_pp_ruleListNonStdFree( &pState->pCommands );
+
+   if( pState->pIncRec )
+   {
+      hb_pp_incCacheFreeItem( pState->pIncRec );
+      pState->pIncRec = NULL;
+   }
+   pState->pIncBase = NULL;
+   pState->fIncKnown = pState->fIncCache;
 }
 
 /*
@@ -5651,6 +5924,9 @@ void hb_pp_addSearchPath( PHB_PP_STATE pState, const char * szPath, HB_BOOL fRep
 void hb_pp_setStdBase( PHB_PP_STATE pState )
 {
    pState->fError = HB_FALSE;
+   /* rules from cached files were defined for different base */
+   hb_pp_incCacheFree( pState );
+   pState->fIncKnown = pState->fIncCache;
    hb_pp_ruleListSetStd( pState->pDefinitions );
    hb_pp_ruleListSetStd( pState->pTranslations );
    hb_pp_ruleListSetStd( pState->pCommands );
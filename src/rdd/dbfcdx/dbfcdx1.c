@@ -8916,11 +8916,27 @@ static HB_ERRCODE hb_cdxRddInfo( LPRDDNODE pRDD, HB_USHORT uiIndex, HB_ULONG ulC
 
 /* ######################################################################### */
 
+/*
+ * compare two key pool items, precalculated collation sort keys
+ * are used instead of hb_cdpcmp() if they exist
+ */
+static int hb_cdxSortValCompare( LPCDXSORTINFO pSort, HB_BYTE * pKey1, HB_BYTE * pKey2 )
+{
+   if( pSort->sortLen )
+   {
+      int i = memcmp( pKey1 + pSort->keyLen + 4, pKey2 + pSort->keyLen + 4,
+                      pSort->sortLen );
+      return i < 0 ? -1 : ( i > 0 ? 1 : 0 );
+   }
+   return hb_cdxValCompare( pSort->pTag, pKey1, pSort->keyLen,
+                            pKey2, pSort->keyLen, CDX_CMP_EXACT );
+}
+
 static int hb_cdxQuickSortCompare( LPCDXSORTINFO pSort, HB_BYTE * pKey1, HB_BYTE * pKey2 )
 {
    int i, iLen = pSort->keyLen;
 
-   i = hb_cdxValCompare( pSort->pTag, pKey1, iLen, pKey2, iLen, CDX_CMP_EXACT );
+   i = hb_cdxSortValCompare( pSort, pKey1, pKey2 );
 
    if( i == 0 )
    {
@@ -8934,7 +8950,7 @@ static HB_BOOL hb_cdxQSort( LPCDXSORTINFO pSort, HB_BYTE * pSrc, HB_BYTE * pBuf,
 {
    if( lKeys > 1 )
    {
-      int iLen = pSort->keyLen + 4;
+      int iLen = pSort->itemLen;
       HB_LONG l1, l2;
       HB_BYTE * pPtr1, * pPtr2, * pDst;
       HB_BOOL f1, f2;
@@ -8990,7 +9006,7 @@ static HB_BOOL hb_cdxQSort( LPCDXSORTINFO pSort, HB_BYTE * pSrc, HB_BYTE * pBuf,
 
 static void hb_cdxSortSortPage( LPCDXSORTINFO pSort )
 {
-   HB_SIZE nSize = ( HB_SIZE ) pSort->ulKeys * ( pSort->keyLen + 4 );
+   HB_SIZE nSize = ( HB_SIZE ) pSort->ulKeys * pSort->itemLen;
 
 #ifdef HB_CDX_DBGTIME
    cdxTimeIdxBld -= hb_cdxGetTime();
@@ -9110,7 +9126,7 @@ static void hb_cdxSortAddNodeKey( LPCDXSORTINFO pSort, int iLevel, HB_BYTE * pKe
 
 static void hb_cdxSortWritePage( LPCDXSORTINFO pSort )
 {
-   HB_SIZE nSize = ( HB_SIZE ) pSort->ulKeys * ( pSort->keyLen + 4 );
+   HB_SIZE nSize = ( HB_SIZE ) pSort->ulKeys * pSort->itemLen;
 
    hb_cdxSortSortPage( pSort );
 
@@ -9139,7 +9155,7 @@ static void hb_cdxSortGetPageKey( LPCDXSORTINFO pSort, HB_ULONG ulPage,
    if( pSort->pSwapPage[ ulPage ].ulKeyBuf == 0 )
    {
       HB_ULONG ulKeys = HB_MIN( pSort->ulPgKeys, pSort->pSwapPage[ ulPage ].ulKeys );
-      HB_SIZE nSize = ( HB_SIZE ) ulKeys * ( iLen + 4 );
+      HB_SIZE nSize = ( HB_SIZE ) ulKeys * pSort->itemLen;
 
       if( hb_fileReadAt( pSort->pTempFile, pSort->pSwapPage[ ulPage ].pKeyPool,
                          nSize, pSort->pSwapPage[ ulPage ].nOffset ) != nSize )
@@ -9148,7 +9164,7 @@ static void hb_cdxSortGetPageKey( LPCDXSORTINFO pSort, HB_ULONG ulPage,
       pSort->pSwapPage[ ulPage ].ulKeyBuf = ulKeys;
       pSort->pSwapPage[ ulPage ].ulCurKey = 0;
    }
-   *pKeyVal = &pSort->pSwapPage[ ulPage ].pKeyPool[ pSort->pSwapPage[ ulPage ].ulCurKey * ( iLen + 4 ) ];
+   *pKeyVal = &pSort->pSwapPage[ ulPage ].pKeyPool[ pSort->pSwapPage[ ulPage ].ulCurKey * pSort->itemLen ];
    *pulRec = HB_GET_LE_UINT32( *pKeyVal + iLen );
 }
 
@@ -9182,8 +9198,8 @@ static void hb_cdxSortOrderPages( LPCDXSORTINFO pSort )
 
             m = ( l + r ) >> 1;
             ulPage = pSort->pSortedPages[ m ];
-            pTmp = &pSort->pSwapPage[ ulPage ].pKeyPool[ pSort->pSwapPage[ ulPage ].ulCurKey * ( iLen + 4 ) ];
-            i = hb_cdxValCompare( pSort->pTag, pKey, iLen, pTmp, iLen, CDX_CMP_EXACT );
+            pTmp = &pSort->pSwapPage[ ulPage ].pKeyPool[ pSort->pSwapPage[ ulPage ].ulCurKey * pSort->itemLen ];
+            i = hb_cdxSortValCompare( pSort, pKey, pTmp );
             if( i == 0 )
                i = ( ulRec < HB_GET_LE_UINT32( &pTmp[ iLen ] ) ) ? -1 : 1;
             if( i > 0 )
@@ -9230,8 +9246,8 @@ static HB_BOOL hb_cdxSortKeyGet( LPCDXSORTINFO pSort, HB_BYTE ** pKeyVal, HB_ULO
 
          m = ( l + r ) >> 1;
          ulPage = pSort->pSortedPages[ m ];
-         pTmp = &pSort->pSwapPage[ ulPage ].pKeyPool[ pSort->pSwapPage[ ulPage ].ulCurKey * ( iLen + 4 ) ];
-         i = hb_cdxValCompare( pSort->pTag, pKey, iLen, pTmp, iLen, CDX_CMP_EXACT );
+         pTmp = &pSort->pSwapPage[ ulPage ].pKeyPool[ pSort->pSwapPage[ ulPage ].ulCurKey * pSort->itemLen ];
+         i = hb_cdxSortValCompare( pSort, pKey, pTmp );
          if( i == 0 )
             i = ( ulRec < HB_GET_LE_UINT32( &pTmp[ iLen ] ) ) ? -1 : 1;
 
@@ -9282,7 +9298,7 @@ static HB_BOOL hb_cdxSortKeyGet( LPCDXSORTINFO pSort, HB_BYTE ** pKeyVal, HB_ULO
             i = 1;
          else
          {
-            i = hb_cdxValCompare( pSort->pTag, pKey, iLen, pTmp, iLen, CDX_CMP_EXACT );
+            i = hb_cdxSortValCompare( pSort, pKey, pTmp );
             if( i == 0 )
                i = ( ulRec < ulRecTmp ) ? -1 : 1;
          }
@@ -9317,7 +9333,7 @@ static void hb_cdxSortKeyAdd( LPCDXSORTINFO pSort, HB_ULONG ulRec, const HB_BYTE
 
    if( pSort->ulKeys >= pSort->ulPgKeys )
       hb_cdxSortWritePage( pSort );
-   pDst = &pSort->pKeyPool[ pSort->ulKeys * ( iLen + 4 ) ];
+   pDst = &pSort->pKeyPool[ pSort->ulKeys * pSort->itemLen ];
 
    if( pSort->pTag->IgnoreCase )
    {
@@ -9336,6 +9352,13 @@ static void hb_cdxSortKeyAdd( LPCDXSORTINFO pSort, HB_ULONG ulRec, const HB_BYTE
       memcpy( pDst, pKeyVal, iLen );
 
    HB_PUT_LE_UINT32( &pDst[ iLen ], ulRec );
+   if( pSort->sortLen )
+   {
+      HB_SIZE nLen = hb_cdpSortKey( pSort->pTag->pIndex->pArea->dbfarea.area.cdPage,
+                                    ( const char * ) pDst, iLen,
+                                    ( char * ) &pDst[ iLen + 4 ] );
+      memset( &pDst[ iLen + 4 + nLen ], 0, pSort->sortLen - nLen );
+   }
    pSort->ulKeys++;
    pSort->ulTotKeys++;
 }
@@ -9352,8 +9375,15 @@ static LPCDXSORTINFO hb_cdxSortNew( LPCDXTAG pTag, HB_ULONG ulRecCount )
 
    pSort = ( LPCDXSORTINFO ) hb_xgrab( sizeof( CDXSORTINFO ) );
    memset( pSort, 0, sizeof( CDXSORTINFO ) );
+   /* single byte collations are compared nearly as fast as memcmp()
+      so sort keys which enlarge key pool are used only for custom
+      (i.e. multibyte) ones */
+   if( pTag->uiType == 'C' && pTag->pIndex->pArea->fSortCDP &&
+       HB_CDP_ISCUSTOM( pTag->pIndex->pArea->dbfarea.area.cdPage ) )
+      pSort->sortLen = ( int ) hb_cdpSortKeyLen( pTag->pIndex->pArea->dbfarea.area.cdPage, iLen );
+   pSort->itemLen = iLen + 4 + pSort->sortLen;
    ulMax = ulMin = ( HB_ULONG ) ceil( sqrt( ( double ) ulRecCount ) );
-   ulSize = ( 1L << 20 ) / ( iLen + 4 );
+   ulSize = ( 1L << 20 ) / pSort->itemLen;
    while( ulMax < ulSize )
       ulMax <<= 1;
    if( ulMax > ulRecCount )
@@ -9361,7 +9391,7 @@ static LPCDXSORTINFO hb_cdxSortNew( LPCDXTAG pTag, HB_ULONG ulRecCount )
 
    do
    {
-      ulSize = ulMax * ( iLen + 4 );
+      ulSize = ulMax * pSort->itemLen;
       pBuf = ( HB_BYTE * ) hb_xalloc( ulSize << 2 );
       if( pBuf )
       {
@@ -9394,7 +9424,7 @@ static LPCDXSORTINFO hb_cdxSortNew( LPCDXTAG pTag, HB_ULONG ulRecCount )
        * take many hours, Druzus.
        */
       ulMax = ulMin;
-      pBuf = ( HB_BYTE * ) hb_xgrab( ( ulMax << 1 ) * ( iLen + 4 ) );
+      pBuf = ( HB_BYTE * ) hb_xgrab( ( ulMax << 1 ) * pSort->itemLen );
    }
 
    pSort->pTag = pTag;
@@ -9448,7 +9478,7 @@ static void hb_cdxSortOut( LPCDXSORTINFO pSort )
    /*
    printf( "\r\npSort->ulMaxKey=%ld, pSort->ulPages=%ld, pSort->ulPgKeys=%ld, size=%ld\r\n",
            pSort->ulMaxKey, pSort->ulPages, pSort->ulPgKeys,
-           pSort->ulMaxKey * ( pSort->keyLen + 4 ) ); fflush(stdout);
+           pSort->ulMaxKey * pSort->itemLen ); fflush(stdout);
    */
    if( pSort->ulPages > 1 )
    {
@@ -9460,7 +9490,7 @@ static void hb_cdxSortOut( LPCDXSORTINFO pSort )
          pSort->pSwapPage[ ulPage ].ulKeyBuf = 0;
          pSort->pSwapPage[ ulPage ].ulCurKey = 0;
          pSort->pSwapPage[ ulPage ].pKeyPool = pBuf;
-         pBuf += pSort->ulPgKeys * ( pSort->keyLen + 4 );
+         pBuf += pSort->ulPgKeys * pSort->itemLen;
       }
    }
    else
@@ -4651,11 +4651,27 @@ static HB_ULONG hb_ntxOrdScopeEval( LPTAGINFO pTag,
 /* create index: hb_ntxTagCreate() */
 /* ************************************************************************* */
 
+/*
+ * compare two key pool items, precalculated collation sort keys
+ * are used instead of hb_cdpcmp() if they exist
+ */
+static int hb_ntxSortValCompare( LPNTXSORTINFO pSort, HB_BYTE * pKey1, HB_BYTE * pKey2 )
+{
+   if( pSort->sortLen )
+   {
+      int i = memcmp( pKey1 + pSort->keyLen + 4, pKey2 + pSort->keyLen + 4,
+                      pSort->sortLen );
+      return i < 0 ? -1 : ( i > 0 ? 1 : 0 );
+   }
+   return hb_ntxValCompare( pSort->pTag, ( const char * ) pKey1, pSort->keyLen,
+                            ( const char * ) pKey2, pSort->keyLen, HB_TRUE );
+}
+
 static int hb_ntxQuickSortCompare( LPNTXSORTINFO pSort, HB_BYTE * pKey1, HB_BYTE * pKey2 )
 {
    int iLen = pSort->keyLen, i;
 
-   i = hb_ntxValCompare( pSort->pTag, ( const char * ) pKey1, iLen, ( const char * ) pKey2, iLen, HB_TRUE );
+   i = hb_ntxSortValCompare( pSort, pKey1, pKey2 );
    if( i == 0 )
    {
       if( pSort->pTag->fSortRec )
@@ -4673,7 +4689,7 @@ static HB_BOOL hb_ntxQSort( LPNTXSORTINFO pSort, HB_BYTE * pSrc, HB_BYTE * pBuf,
 {
    if( lKeys > 1 )
    {
-      int iLen = pSort->keyLen + 4;
+      int iLen = pSort->itemLen;
       HB_LONG l1, l2;
       HB_BYTE * pPtr1, * pPtr2, * pDst;
       HB_BOOL f1, f2;
@@ -4729,7 +4745,7 @@ static HB_BOOL hb_ntxQSort( LPNTXSORTINFO pSort, HB_BYTE * pSrc, HB_BYTE * pBuf,
 
 static void hb_ntxSortSortPage( LPNTXSORTINFO pSort )
 {
-   HB_SIZE nSize = ( HB_SIZE ) pSort->ulKeys * ( pSort->keyLen + 4 );
+   HB_SIZE nSize = ( HB_SIZE ) pSort->ulKeys * pSort->itemLen;
 
    if( ! hb_ntxQSort( pSort, pSort->pKeyPool, &pSort->pKeyPool[ nSize ], pSort->ulKeys ) )
       pSort->pStartKey = &pSort->pKeyPool[ nSize ];
@@ -4820,7 +4836,7 @@ static void hb_ntxSortAddNodeKey( LPNTXSORTINFO pSort, HB_BYTE * pKeyVal, HB_ULO
 
 static void hb_ntxSortWritePage( LPNTXSORTINFO pSort )
 {
-   HB_SIZE nSize = ( HB_SIZE ) pSort->ulKeys * ( pSort->keyLen + 4 );
+   HB_SIZE nSize = ( HB_SIZE ) pSort->ulKeys * pSort->itemLen;
 
    hb_ntxSortSortPage( pSort );
 
@@ -4858,7 +4874,7 @@ static void hb_ntxSortGetPageKey( LPNTXSORTINFO pSort, HB_ULONG ulPage,
    if( pSort->pSwapPage[ ulPage ].ulKeyBuf == 0 )
    {
       HB_ULONG ulKeys = HB_MIN( pSort->ulPgKeys, pSort->pSwapPage[ ulPage ].ulKeys );
-      HB_SIZE nSize = ( HB_SIZE ) ulKeys * ( iLen + 4 );
+      HB_SIZE nSize = ( HB_SIZE ) ulKeys * pSort->itemLen;
 
       if( pSort->pTempFile != NULL &&
           hb_fileReadAt( pSort->pTempFile, pSort->pSwapPage[ ulPage ].pKeyPool,
@@ -4871,7 +4887,7 @@ static void hb_ntxSortGetPageKey( LPNTXSORTINFO pSort, HB_ULONG ulPage,
       pSort->pSwapPage[ ulPage ].ulKeyBuf = ulKeys;
       pSort->pSwapPage[ ulPage ].ulCurKey = 0;
    }
-   *pKeyVal = &pSort->pSwapPage[ ulPage ].pKeyPool[ pSort->pSwapPage[ ulPage ].ulCurKey * ( iLen + 4 ) ];
+   *pKeyVal = &pSort->pSwapPage[ ulPage ].pKeyPool[ pSort->pSwapPage[ ulPage ].ulCurKey * pSort->itemLen ];
    *pulRec = HB_GET_LE_UINT32( *pKeyVal + iLen );
 }
 
@@ -4904,8 +4920,8 @@ static void hb_ntxSortOrderPages( LPNTXSORTINFO pSort )
 
             m = ( l + r ) >> 1;
             ulPage = pSort->pSortedPages[ m ];
-            pTmp = &pSort->pSwapPage[ ulPage ].pKeyPool[ pSort->pSwapPage[ ulPage ].ulCurKey * ( iLen + 4 ) ];
-            i = hb_ntxValCompare( pSort->pTag, ( const char * ) pKey, iLen, ( const char * ) pTmp, iLen, HB_TRUE );
+            pTmp = &pSort->pSwapPage[ ulPage ].pKeyPool[ pSort->pSwapPage[ ulPage ].ulCurKey * pSort->itemLen ];
+            i = hb_ntxSortValCompare( pSort, pKey, pTmp );
             if( i == 0 )
             {
                if( pSort->pTag->fSortRec )
@@ -4958,8 +4974,8 @@ static HB_BOOL hb_ntxSortKeyGet( LPNTXSORTINFO pSort, HB_BYTE ** pKeyVal, HB_ULO
 
          m = ( l + r ) >> 1;
          ulPg = pSort->pSortedPages[ m ];
-         pTmp = &pSort->pSwapPage[ ulPg ].pKeyPool[ pSort->pSwapPage[ ulPg ].ulCurKey * ( iLen + 4 ) ];
-         i = hb_ntxValCompare( pSort->pTag, ( const char * ) pKey, iLen, ( const char * ) pTmp, iLen, HB_TRUE );
+         pTmp = &pSort->pSwapPage[ ulPg ].pKeyPool[ pSort->pSwapPage[ ulPg ].ulCurKey * pSort->itemLen ];
+         i = hb_ntxSortValCompare( pSort, pKey, pTmp );
          if( i == 0 )
          {
             if( pSort->pTag->fSortRec )
@@ -5011,7 +5027,7 @@ static void hb_ntxSortKeyAdd( LPNTXSORTINFO pSort, HB_ULONG ulRec, const char *
    {
       hb_ntxSortWritePage( pSort );
    }
-   pDst = &pSort->pKeyPool[ pSort->ulKeys * ( iLen + 4 ) ];
+   pDst = &pSort->pKeyPool[ pSort->ulKeys * pSort->itemLen ];
 
    if( iLen > iKeyLen )
    {
@@ -5023,6 +5039,13 @@ static void hb_ntxSortKeyAdd( LPNTXSORTINFO pSort, HB_ULONG ulRec, const char *
       memcpy( pDst, pKeyVal, iLen );
    }
    HB_PUT_LE_UINT32( &pDst[ iLen ], ulRec );
+   if( pSort->sortLen )
+   {
+      HB_SIZE nLen = hb_cdpSortKey( pSort->pTag->pIndex->pArea->dbfarea.area.cdPage,
+                                    ( const char * ) pDst, iLen,
+                                    ( char * ) &pDst[ iLen + 4 ] );
+      memset( &pDst[ iLen + 4 + nLen ], 0, pSort->sortLen - nLen );
+   }
    pSort->ulKeys++;
    pSort->ulTotKeys++;
 }
@@ -5039,8 +5062,20 @@ static LPNTXSORTINFO hb_ntxSortNew( LPTAGINFO pTag, HB_ULONG ulRecCount )
 
    pSort = ( LPNTXSORTINFO ) hb_xgrabz( sizeof( NTXSORTINFO ) );
 
+   /* single byte collations are compared nearly as fast as memcmp()
+      so sort keys which enlarge key pool are used only for custom
+      (i.e. multibyte) ones */
+   if( pTag->KeyType == 'C' )
+   {
+      PHB_CODEPAGE cdp = pTag->pIndex->pArea->dbfarea.area.cdPage;
+
+      if( HB_CDP_ISCUSTOM( cdp ) && ! HB_CDP_ISBINSORT( cdp ) )
+         pSort->sortLen = ( int ) hb_cdpSortKeyLen( cdp, iLen );
+   }
+   pSort->itemLen = iLen + 4 + pSort->sortLen;
+
    ulMin = ( HB_ULONG ) ceil( sqrt( ( double ) ulRecCount ) );
-   ulMax = ( ( HB_ULONG ) ceil( sqrt( ( double ) ulRecCount / ( iLen + 4 ) ) ) ) << 7;
+   ulMax = ( ( HB_ULONG ) ceil( sqrt( ( double ) ulRecCount / pSort->itemLen ) ) ) << 7;
    /*
     * this effectively increase allocated memory buffer for very large files
     * moving the maximum to: 270'566'400 for 4'294'967'295 records and 256
@@ -5048,7 +5083,7 @@ static LPNTXSORTINFO hb_ntxSortNew( LPTAGINFO pTag, HB_ULONG ulRecCount )
     * if you want to force smaller buffer I wrote below then add here:
     * ulMax = ulMin;
     */
-   ulSize = ( 1L << 20 ) / ( iLen + 4 );
+   ulSize = ( 1L << 20 ) / pSort->itemLen;
    while( ulMax < ulSize )
       ulMax <<= 1;
    if( ulMax > ulRecCount )
@@ -5056,7 +5091,7 @@ static LPNTXSORTINFO hb_ntxSortNew( LPTAGINFO pTag, HB_ULONG ulRecCount )
 
    do
    {
-      ulSize = ulMax * ( iLen + 4 );
+      ulSize = ulMax * pSort->itemLen;
       pBuf = ( HB_BYTE * ) hb_xalloc( ulSize << 2 );
       if( pBuf )
       {
@@ -5091,7 +5126,7 @@ static LPNTXSORTINFO hb_ntxSortNew( LPTAGINFO pTag, HB_ULONG ulRecCount )
        * take many hours, Druzus.
        */
       ulMax = ulMin;
-      pBuf = ( HB_BYTE * ) hb_xgrab( ( ulMax << 1 ) * ( iLen + 4 ) );
+      pBuf = ( HB_BYTE * ) hb_xgrab( ( ulMax << 1 ) * pSort->itemLen );
    }
 
    pSort->pTag = pTag;
@@ -5169,7 +5204,7 @@ static void hb_ntxSortOut( LPNTXSORTINFO pSort )
          pSort->pSwapPage[ ulPage ].ulKeyBuf = 0;
          pSort->pSwapPage[ ulPage ].ulCurKey = 0;
          pSort->pSwapPage[ ulPage ].pKeyPool = pBuf;
-         pBuf += pSort->ulPgKeys * ( pSort->keyLen + 4 );
+         pBuf += pSort->ulPgKeys * pSort->itemLen;
       }
    }
    else
@@ -59,6 +59,29 @@ static HB_CRITICAL_NEW( s_cdpMtx );
 
 #define NUMBER_OF_CHARS  256
 
+/* SSE2 is part of x86_64 architecture and can be used unconditionally.
+   Define HB_NO_SIMD to build portable code only. */
+#if ! defined( HB_NO_SIMD )
+#  if defined( __SSE2__ ) || defined( _M_X64 ) || defined( _M_AMD64 ) || \
+      ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#     define HB_CDP_SSE2
+#     include <emmintrin.h>
+#  endif
+#endif
+
+/* direct translation table for pair of single byte codepages,
+   NULL unicode table means UTF-8 */
+typedef struct _HB_CDP_TRANS
+{
+   PHB_UNITABLE            uniIn;
+   PHB_UNITABLE            uniOut;
+   HB_BOOL                 fAscii;     /* 7-bit characters are not changed */
+   HB_UCHAR                trans[ NUMBER_OF_CHARS ];
+   struct _HB_CDP_TRANS *  next;
+} HB_CDP_TRANS, * PHB_CDP_TRANS;
+
+static PHB_CDP_TRANS s_cdpTrans = NULL;
+
 #define HB_MAX_CTRL_CODE      0x266B
 
 static const HB_WCHAR s_uniCtrls[ 32 ] =
@@ -115,6 +138,7 @@ static HB_CDP_LEN_FUNC( hb_cdpStd_len );
 
 static HB_CDP_CMP_FUNC( hb_cdpBin_cmp );
 static HB_CDP_CMP_FUNC( hb_cdpBin_cmpi );
+static HB_CDP_SORTKEY_FUNC( hb_cdpBin_sortkey );
 
 static HB_CDP_GET_FUNC( hb_cdpUTF8_get );
 static HB_CDP_PUT_FUNC( hb_cdpUTF8_put );
@@ -130,7 +154,7 @@ static HB_CODEPAGE s_utf8_codepage =
      NULL, NULL, NULL, NULL, NULL, 0,
      HB_CDP_TYPE_CUSTOM | HB_CDP_TYPE_UTF8 | HB_CDP_TYPE_BINSORT,
      hb_cdpUTF8_get, hb_cdpUTF8_put, hb_cdpUTF8_len,
-     NULL, NULL, NULL, hb_cdpBin_cmp, hb_cdpBin_cmpi,
+     NULL, NULL, NULL, hb_cdpBin_cmp, hb_cdpBin_cmpi, hb_cdpBin_sortkey,
      0, 0, NULL, NULL, NULL };
 
 HB_CODEPAGE_ANNOUNCE( UTF8 )
@@ -140,7 +164,7 @@ static HB_CODEPAGE s_en_codepage =
      NULL, NULL, NULL, NULL, NULL, 0,
      HB_CDP_TYPE_BINSORT,
      hb_cdpStd_get, hb_cdpStd_put, hb_cdpStd_len,
-     NULL, NULL, NULL, hb_cdpBin_cmp, hb_cdpBin_cmpi,
+     NULL, NULL, NULL, hb_cdpBin_cmp, hb_cdpBin_cmpi, hb_cdpBin_sortkey,
      0, 0, NULL, NULL, &s_utf8_codepage };
 
 HB_CODEPAGE_ANNOUNCE( EN )
@@ -187,6 +211,86 @@ void hb_cdpBuildTransTable( PHB_UNITABLE uniTable )
    HB_CDP_UNLOCK();
 }
 
+/* returns translation table for given pair of unicode tables,
+   tables are created on first use and kept until hb_cdpReleaseAll() */
+static PHB_CDP_TRANS hb_cdpTransGet( PHB_UNITABLE uniIn, PHB_UNITABLE uniOut )
+{
+   PHB_CDP_TRANS pTrans;
+
+   for( pTrans = s_cdpTrans; pTrans; pTrans = pTrans->next )
+   {
+      if( pTrans->uniIn == uniIn && pTrans->uniOut == uniOut )
+         return pTrans;
+   }
+
+   if( uniOut && uniOut->uniTrans == NULL )
+      hb_cdpBuildTransTable( uniOut );
+
+   HB_CDP_LOCK();
+   for( pTrans = s_cdpTrans; pTrans; pTrans = pTrans->next )
+   {
+      if( pTrans->uniIn == uniIn && pTrans->uniOut == uniOut )
+         break;
+   }
+   if( pTrans == NULL )
+   {
+      int i;
+
+      pTrans = ( PHB_CDP_TRANS ) hb_xgrab( sizeof( HB_CDP_TRANS ) );
+      pTrans->uniIn = uniIn;
+      pTrans->uniOut = uniOut;
+      pTrans->fAscii = HB_TRUE;
+      for( i = 0; i < NUMBER_OF_CHARS; ++i )
+      {
+         HB_WCHAR wc = uniIn ? uniIn->uniCodes[ i ] : ( HB_WCHAR ) i;
+         HB_UCHAR uc = ( HB_UCHAR ) i;
+
+         if( uniOut == NULL )
+         {
+            /* only 7-bit characters can be copied to UTF-8 */
+            if( i < 0x80 && wc != 0 && wc != i )
+               pTrans->fAscii = HB_FALSE;
+         }
+         else if( wc && wc <= uniOut->wcMax && uniOut->uniTrans[ wc ] )
+            uc = uniOut->uniTrans[ wc ];
+         pTrans->trans[ i ] = uc;
+         if( i < 0x80 && uc != i )
+            pTrans->fAscii = HB_FALSE;
+      }
+      pTrans->next = s_cdpTrans;
+      s_cdpTrans = pTrans;
+   }
+   HB_CDP_UNLOCK();
+
+   return pTrans;
+}
+
+/* returns number of leading 7-bit characters */
+static HB_SIZE hb_cdpAsciiLen( const char * pSrc, HB_SIZE nLen )
+{
+   HB_SIZE nPos = 0;
+
+#if defined( HB_CDP_SSE2 )
+   while( nPos + 16 <= nLen )
+   {
+      if( _mm_movemask_epi8( _mm_loadu_si128( ( const __m128i * ) ( pSrc + nPos ) ) ) )
+         break;
+      nPos += 16;
+   }
+#else
+   while( nPos + 4 <= nLen )
+   {
+      if( ( HB_GET_UINT32( pSrc + nPos ) & 0x80808080 ) != 0 )
+         break;
+      nPos += 4;
+   }
+#endif
+   while( nPos < nLen && ( HB_UCHAR ) pSrc[ nPos ] < 0x80 )
+      ++nPos;
+
+   return nPos;
+}
+
 /*
  * standard conversion functions
  */
@@ -379,6 +483,52 @@ static int hb_cdpStd_cmpi( PHB_CODEPAGE cdp,
    return iRet;
 }
 
+/* sort keys are compared by memcmp() and the shorter key is smaller when
+   it is a prefix of the longer one. They give the same ordering as
+   hb_cdpcmp( ..., HB_FALSE ) and for equal length strings also the same
+   equality */
+static HB_SIZE hb_cdpBin_sortkey( PHB_CODEPAGE cdp,
+                                  const char * pSrc, HB_SIZE nLen, char * pKey )
+{
+   HB_SYMBOL_UNUSED( cdp );
+
+   memcpy( pKey, pSrc, nLen );
+
+   return nLen;
+}
+
+static HB_SIZE hb_cdpStd_sortkey( PHB_CODEPAGE cdp,
+                                  const char * pSrc, HB_SIZE nLen, char * pKey )
+{
+   HB_UCHAR * pDst = ( HB_UCHAR * ) pKey;
+   HB_SIZE nPos;
+
+   /* primary weights, 0 and 1 are escaped to keep 0 as
+      terminator which is smaller than any weight */
+   for( nPos = 0; nPos < nLen; ++nPos )
+   {
+      HB_UCHAR uc = cdp->sort[ ( HB_UCHAR ) pSrc[ nPos ] ];
+
+      if( uc < 2 )
+      {
+         *pDst++ = 1;
+         *pDst++ = uc + 1;
+      }
+      else
+         *pDst++ = uc;
+   }
+   /* accented characters are significant only for
+      strings with the same primary weights */
+   if( cdp->acc )
+   {
+      *pDst++ = 0;
+      for( nPos = 0; nPos < nLen; ++nPos )
+         *pDst++ = cdp->acc[ ( HB_UCHAR ) pSrc[ nPos ] ];
+   }
+
+   return pDst - ( HB_UCHAR * ) pKey;
+}
+
 
 static HB_BOOL hb_cdpUTF8_get( PHB_CODEPAGE cdp,
                                const char * pSrc, HB_SIZE nLen,
@@ -1004,6 +1154,19 @@ const HB_UCHAR * hb_cdpGetSortTab( PHB_CODEPAGE cdp )
             cdp->wcharCmp == NULL ) ? cdp->sort : NULL;
 }
 
+/* size of buffer for sort key of nLen bytes long string or 0
+   if codepage does not support sort keys */
+HB_SIZE hb_cdpSortKeyLen( PHB_CODEPAGE cdp, HB_SIZE nLen )
+{
+   return cdp->wcharSortKey ? ( nLen << 1 ) + nLen + 1 : 0;
+}
+
+HB_SIZE hb_cdpSortKey( PHB_CODEPAGE cdp, const char * pSrc, HB_SIZE nLen,
+                       char * pKey )
+{
+   return cdp->wcharSortKey ? cdp->wcharSortKey( cdp, pSrc, nLen, pKey ) : 0;
+}
+
 int hb_cdpcmp( const char * szFirst, HB_SIZE nLenFirst,
                const char * szSecond, HB_SIZE nLenSecond,
                PHB_CODEPAGE cdp, HB_BOOL fExact )
@@ -1117,6 +1280,13 @@ HB_SIZE hb_cdpUTF8StringLength( const char * pSrc, HB_SIZE nLen )
 
    for( nPos = nDst = 0; nPos < nLen; )
    {
+      if( n == 0 && ( HB_UCHAR ) pSrc[ nPos ] < 0x80 )
+      {
+         HB_SIZE nAscii = hb_cdpAsciiLen( pSrc + nPos, nLen - nPos );
+         nPos += nAscii;
+         nDst += nAscii;
+         continue;
+      }
       if( hb_cdpUTF8ToU16NextChar( ( HB_UCHAR ) pSrc[ nPos ], &n, &wc ) )
          ++nPos;
       if( n == 0 )
@@ -1128,6 +1298,45 @@ HB_SIZE hb_cdpUTF8StringLength( const char * pSrc, HB_SIZE nLen )
    return nDst;
 }
 
+/* returns HB_TRUE if given string is well formed UTF-8 sequence
+   and sets number of characters in it */
+HB_BOOL hb_cdpUTF8Validate( const char * pSrc, HB_SIZE nLen, HB_SIZE * pnChars )
+{
+   HB_SIZE nPos = 0, nChars = 0;
+
+   while( nPos < nLen )
+   {
+      HB_UCHAR uc = ( HB_UCHAR ) pSrc[ nPos ];
+
+      if( uc < 0x80 )
+      {
+         HB_SIZE nAscii = hb_cdpAsciiLen( pSrc + nPos, nLen - nPos );
+         nPos += nAscii;
+         nChars += nAscii;
+      }
+      else
+      {
+         int i;
+
+         for( i = 0; ( uc << ( i + 1 ) ) & 0x80; )
+            ++i;
+         if( i == 0 || ( HB_SIZE ) i >= nLen - nPos )
+            break;
+         while( i && ( ( HB_UCHAR ) pSrc[ ++nPos ] & 0xc0 ) == 0x80 )
+            --i;
+         if( i != 0 )
+            break;
+         ++nPos;
+         ++nChars;
+      }
+   }
+
+   if( pnChars )
+      *pnChars = nChars;
+
+   return nPos == nLen;
+}
+
 HB_SIZE hb_cdpUTF8StringAt( const char * szNeedle, HB_SIZE nLenN,
                             const char * szHaystack, HB_SIZE nLenH,
                             HB_SIZE nStart, HB_SIZE nEnd, HB_BOOL fReverse )
@@ -1346,11 +1555,27 @@ HB_SIZE hb_cdpStrAsUTF8Len( PHB_CODEPAGE cdp,
    else
    {
       const HB_WCHAR * uniCodes = cdp->uniTable->uniCodes;
+      HB_BOOL fAscii = hb_cdpTransGet( cdp->uniTable, NULL )->fAscii;
+
       for( nPosS = nPosD = 0; nPosS < nSrc; ++nPosS )
       {
          HB_UCHAR uc = ( HB_UCHAR ) pSrc[ nPosS ];
-         HB_WCHAR wc = uniCodes[ uc ];
+         HB_WCHAR wc;
 
+         if( fAscii && uc < 0x80 )
+         {
+            HB_SIZE nAscii = hb_cdpAsciiLen( pSrc + nPosS, nSrc - nPosS );
+
+            if( nMax && nPosD + nAscii > nMax )
+            {
+               nPosD = nMax;
+               break;
+            }
+            nPosD += nAscii;
+            nPosS += nAscii - 1;
+            continue;
+         }
+         wc = uniCodes[ uc ];
          if( wc == 0 )
             wc = uc;
          n = hb_cdpUTF8CharSize( wc );
@@ -1397,11 +1622,24 @@ HB_SIZE hb_cdpStrToUTF8( PHB_CODEPAGE cdp,
    else
    {
       const HB_WCHAR * uniCodes = cdp->uniTable->uniCodes;
+      HB_BOOL fAscii = hb_cdpTransGet( cdp->uniTable, NULL )->fAscii;
+
       for( nPosS = nPosD = 0; nPosS < nSrc && nPosD < nDst; ++nPosS )
       {
          HB_UCHAR uc = ( HB_UCHAR ) pSrc[ nPosS ];
-         HB_WCHAR wc = uniCodes[ uc ];
+         HB_WCHAR wc;
 
+         if( fAscii && uc < 0x80 )
+         {
+            u = hb_cdpAsciiLen( pSrc + nPosS, nSrc - nPosS );
+            if( u > nDst - nPosD )
+               u = nDst - nPosD;
+            memcpy( &pDst[ nPosD ], &pSrc[ nPosS ], u );
+            nPosD += u;
+            nPosS += u - 1;
+            continue;
+         }
+         wc = uniCodes[ uc ];
          if( wc == 0 )
             wc = uc;
          u = hb_cdpUTF8CharSize( wc );
@@ -1511,6 +1749,16 @@ HB_SIZE hb_cdpUTF8AsStrLen( PHB_CODEPAGE cdp, const char * pSrc, HB_SIZE nSrc,
    {
       for( nPosS = nPosD = 0; nPosS < nSrc; )
       {
+         if( n == 0 && ( HB_UCHAR ) pSrc[ nPosS ] < 0x80 )
+         {
+            HB_SIZE nAscii = hb_cdpAsciiLen( pSrc + nPosS, nSrc - nPosS );
+
+            nPosS += nAscii;
+            nPosD += nAscii;
+            if( nMax && nPosD >= nMax )
+               return nMax;
+            continue;
+         }
          if( hb_cdpUTF8ToU16NextChar( ( HB_UCHAR ) pSrc[ nPosS ], &n, &wc ) )
             ++nPosS;
 
@@ -1533,6 +1781,7 @@ HB_SIZE hb_cdpUTF8ToStr( PHB_CODEPAGE cdp,
    HB_UCHAR * uniTrans;
    HB_WCHAR wcMax, wc = 0;
    HB_SIZE nPosS, nPosD;
+   HB_BOOL fAscii;
    int n = 0;
 
    if( HB_CDP_ISUTF8( cdp ) )
@@ -1560,13 +1809,23 @@ HB_SIZE hb_cdpUTF8ToStr( PHB_CODEPAGE cdp,
    }
    else
    {
-      if( cdp->uniTable->uniTrans == NULL )
-         hb_cdpBuildTransTable( cdp->uniTable );
+      fAscii = hb_cdpTransGet( NULL, cdp->uniTable )->fAscii;
       uniTrans = cdp->uniTable->uniTrans;
       wcMax = cdp->uniTable->wcMax;
 
       for( nPosS = nPosD = 0; nPosS < nSrc && nPosD < nDst; )
       {
+         if( fAscii && n == 0 && ( HB_UCHAR ) pSrc[ nPosS ] < 0x80 )
+         {
+            HB_SIZE nAscii = hb_cdpAsciiLen( pSrc + nPosS, nSrc - nPosS );
+
+            if( nAscii > nDst - nPosD )
+               nAscii = nDst - nPosD;
+            memcpy( &pDst[ nPosD ], &pSrc[ nPosS ], nAscii );
+            nPosS += nAscii;
+            nPosD += nAscii;
+            continue;
+         }
          if( hb_cdpUTF8ToU16NextChar( ( HB_UCHAR ) pSrc[ nPosS ], &n, &wc ) )
             ++nPosS;
 
@@ -2060,23 +2319,24 @@ HB_SIZE hb_cdpTransTo( const char * pSrc, HB_SIZE nSrc,
       }
       else
       {
-         HB_UCHAR * uniTrans;
-         HB_WCHAR wcMax;
-
-         if( cdpOut->uniTable->uniTrans == NULL )
-            hb_cdpBuildTransTable( cdpOut->uniTable );
-         uniTrans = cdpOut->uniTable->uniTrans;
-         wcMax = cdpOut->uniTable->wcMax;
+         PHB_CDP_TRANS pTrans = hb_cdpTransGet( cdpIn->uniTable, cdpOut->uniTable );
+         const HB_UCHAR * trans = pTrans->trans;
 
          if( nSrc > nDst )
             nSrc = nDst;
          for( nSize = 0; nSize < nSrc; ++nSize )
          {
             HB_UCHAR uc = ( HB_UCHAR ) pSrc[ nSize ];
-            HB_WCHAR wc = cdpIn->uniTable->uniCodes[ uc ];
-            if( wc && wc <= wcMax && uniTrans[ wc ] )
-               uc = uniTrans[ wc ];
-            pDst[ nSize ] = uc;
+
+            if( uc < 0x80 && pTrans->fAscii )
+            {
+               HB_SIZE nAscii = hb_cdpAsciiLen( pSrc + nSize, nSrc - nSize );
+
+               memcpy( &pDst[ nSize ], &pSrc[ nSize ], nAscii );
+               nSize += nAscii - 1;
+            }
+            else
+               pDst[ nSize ] = trans[ uc ];
          }
       }
    }
@@ -2116,22 +2376,7 @@ int hb_cdpTranslateChar( int iChar, PHB_CODEPAGE cdpIn, PHB_CODEPAGE cdpOut )
          }
       }
       else
-      {
-         wc = cdpIn->uniTable->uniCodes[ iChar ];
-
-         if( wc )
-         {
-            if( cdpOut->uniTable->uniTrans == NULL )
-               hb_cdpBuildTransTable( cdpOut->uniTable );
-
-            if( wc <= cdpOut->uniTable->wcMax )
-            {
-               wc = cdpOut->uniTable->uniTrans[ wc ];
-               if( wc )
-                  iChar = wc;
-            }
-         }
-      }
+         iChar = hb_cdpTransGet( cdpIn->uniTable, cdpOut->uniTable )->trans[ iChar ];
    }
 
    return iChar;
@@ -3080,6 +3325,7 @@ static PHB_CODEPAGE hb_buildCodePage( const char * id, const char * info,
    {
       cdp->wcharCmp = hb_cdpBin_cmp;
       cdp->wcharCmpI = hb_cdpBin_cmpi;
+      cdp->wcharSortKey = hb_cdpBin_sortkey;
       cdp->type |= HB_CDP_TYPE_BINSORT;
    }
    else if( cdp->nMulti )
@@ -3091,6 +3337,7 @@ static PHB_CODEPAGE hb_buildCodePage( const char * id, const char * info,
    {
       cdp->wcharCmp = hb_cdpStd_cmp;
       cdp->wcharCmpI = hb_cdpStd_cmpi;
+      cdp->wcharSortKey = hb_cdpStd_sortkey;
    }
 
    return cdp;
@@ -3160,8 +3407,13 @@ HB_BOOL hb_cdpRegisterRaw( PHB_CODEPAGE cdp )
          cdp->wcharLen = hb_cdpStd_len;
       }
       if( cdp->wcharCmp == NULL )
+      {
          cdp->wcharCmp = cdp->sort == NULL ? hb_cdpBin_cmp :
                          ( cdp->nMulti ? hb_cdpMulti_cmp : hb_cdpStd_cmp );
+         if( cdp->wcharSortKey == NULL )
+            cdp->wcharSortKey = cdp->sort == NULL ? hb_cdpBin_sortkey :
+                                ( cdp->nMulti ? NULL : hb_cdpStd_sortkey );
+      }
       if( cdp->wcharCmpI == NULL )
          cdp->wcharCmpI = cdp->sort == NULL ? hb_cdpBin_cmpi :
                           ( cdp->nMulti ? hb_cdpMulti_cmpi : hb_cdpStd_cmpi );
@@ -3212,6 +3464,12 @@ void hb_cdpReleaseAll( void )
       if( buffer )
          hb_xfree( buffer );
    }
+   while( s_cdpTrans )
+   {
+      PHB_CDP_TRANS pTrans = s_cdpTrans;
+      s_cdpTrans = pTrans->next;
+      hb_xfree( pTrans );
+   }
    if( s_rev_ctrl != NULL )
    {
       hb_xfree( s_rev_ctrl );
@@ -137,6 +137,9 @@ static HB_GT_FUNCS SuperTable;
 
 #define STDIN_BUFLEN       128
 
+#define OUTBUF_SIZE        16384
+#define OUTBUF_MAXSIZE     262144
+
 #define ESC_DELAY          25
 
 #define IS_EVTFDSTAT( x )  ( ( x ) >= 0x01 && ( x ) <= 0x03 )
@@ -341,6 +344,7 @@ typedef struct _HB_GTTRM
    int        iOutBufSize;
    int        iOutBufIndex;
    char *     pOutBuf;
+   HB_BOOL    fOutBufHold;
 
    int        terminal_type;
    int        terminal_ext;
@@ -568,6 +572,20 @@ static void hb_gt_trm_termFlush( PHB_GTTRM pTerm )
    }
 }
 
+/* during screen refresh the output buffer is enlarged instead of being
+ * flushed so the whole update is sent to terminal in single write
+ */
+static void hb_gt_trm_termFull( PHB_GTTRM pTerm )
+{
+   if( pTerm->fOutBufHold && pTerm->iOutBufSize < OUTBUF_MAXSIZE )
+   {
+      pTerm->iOutBufSize <<= 1;
+      pTerm->pOutBuf = ( char * ) hb_xrealloc( pTerm->pOutBuf, pTerm->iOutBufSize );
+   }
+   else
+      hb_gt_trm_termFlush( pTerm );
+}
+
 static void hb_gt_trm_termOut( PHB_GTTRM pTerm, const char * pStr, int iLen )
 {
    if( pTerm->iOutBufSize )
@@ -576,7 +594,7 @@ static void hb_gt_trm_termOut( PHB_GTTRM pTerm, const char * pStr, int iLen )
       {
          int i;
          if( pTerm->iOutBufSize == pTerm->iOutBufIndex )
-            hb_gt_trm_termFlush( pTerm );
+            hb_gt_trm_termFull( pTerm );
          i = pTerm->iOutBufSize - pTerm->iOutBufIndex;
          if( i > iLen )
             i = iLen;
@@ -613,8 +631,8 @@ static void hb_gt_trm_termOutTrans( PHB_GTTRM pTerm, const char * pStr, int iLen
             int i = ( pTerm->iOutBufSize - pTerm->iOutBufIndex ) >> 2;
             if( i < 4 )
             {
-               hb_gt_trm_termFlush( pTerm );
-               i = pTerm->iOutBufSize >> 2;
+               hb_gt_trm_termFull( pTerm );
+               i = ( pTerm->iOutBufSize - pTerm->iOutBufIndex ) >> 2;
             }
             if( i > iLen )
                i = iLen;
@@ -3160,7 +3178,7 @@ static void hb_gt_trm_SetTerm( PHB_GTTRM pTerm )
    if( pTerm->iOutBufSize == 0 )
    {
       pTerm->iOutBufIndex = 0;
-      pTerm->iOutBufSize = 16384;
+      pTerm->iOutBufSize = OUTBUF_SIZE;
       pTerm->pOutBuf = ( char * ) hb_xgrab( pTerm->iOutBufSize );
    }
    pTerm->mouse_type    = MOUSE_NONE;
@@ -3670,15 +3688,17 @@ static HB_BOOL hb_gt_trm_Resume( PHB_GT pGT )
 static void hb_gt_trm_Scroll( PHB_GT pGT, int iTop, int iLeft, int iBottom, int iRight,
                               int iColor, HB_USHORT usChar, int iRows, int iCols )
 {
+   PHB_GTTRM pTerm;
+   int iHeight, iWidth;
+
    HB_TRACE( HB_TR_DEBUG, ( "hb_gt_trm_Scroll(%p,%d,%d,%d,%d,%d,%d,%d,%d)", ( void * ) pGT, iTop, iLeft, iBottom, iRight, iColor, usChar, iRows, iCols ) );
 
+   pTerm = HB_GTTRM_GET( pGT );
+   HB_GTSELF_GETSIZE( pGT, &iHeight, &iWidth );
+
    /* Provide some basic scroll support for full screen */
    if( iCols == 0 && iRows > 0 && iTop == 0 && iLeft == 0 )
    {
-      PHB_GTTRM pTerm = HB_GTTRM_GET( pGT );
-      int iHeight, iWidth;
-
-      HB_GTSELF_GETSIZE( pGT, &iHeight, &iWidth );
       if( iBottom >= iHeight - 1 && iRight >= iWidth - 1 &&
           pTerm->iRow == iHeight - 1 )
       {
@@ -3698,6 +3718,57 @@ static void hb_gt_trm_Scroll( PHB_GT pGT, int iTop, int iLeft, int iBottom, int
       }
    }
 
+   /* Scroll full width regions using terminal scrolling margins so
+    * moved lines do not have to be redrawn. Internal screen buffer and
+    * the copy of terminal contents are moved together. */
+   if( iCols == 0 && iRows != 0 && iLeft <= 0 && iRight >= iWidth - 1 &&
+       iHeight == pTerm->iHeight && iWidth == pTerm->iWidth &&
+       ( pTerm->terminal_type == TERM_XTERM ||
+         pTerm->terminal_type == TERM_LINUX ) )
+   {
+      if( iTop < 0 )
+         iTop = 0;
+      if( iBottom >= iHeight )
+         iBottom = iHeight - 1;
+      if( ( iRows > 0 ? iRows : -iRows ) <= iBottom - iTop )
+      {
+         char buff[ 32 ];
+         int iCount = iRows > 0 ? iRows : -iRows;
+
+         pTerm->SetAttributes( pTerm, iColor & pTerm->iAttrMask );
+         hb_snprintf( buff, sizeof( buff ), "\x1B[%d;%dr", iTop + 1, iBottom + 1 );
+         hb_gt_trm_termOut( pTerm, buff, strlen( buff ) );
+         /* DECSTBM moves cursor to home position */
+         pTerm->iRow = pTerm->iCol = 0;
+         if( pTerm->terminal_type == TERM_XTERM )
+         {
+            hb_snprintf( buff, sizeof( buff ), "\x1B[%d%c", iCount, iRows > 0 ? 'S' : 'T' );
+            hb_gt_trm_termOut( pTerm, buff, strlen( buff ) );
+         }
+         else
+         {
+            /* Linux console does not support SU/SD, use IND/RI */
+            pTerm->SetCursorPos( pTerm, iRows > 0 ? iBottom : iTop, 0 );
+            do
+            {
+               hb_gt_trm_termOut( pTerm, iRows > 0 ? "\n" : "\x1BM", iRows > 0 ? 1 : 2 );
+            }
+            while( --iCount > 0 );
+         }
+         hb_gt_trm_termOut( pTerm, "\x1B[r", 3 );
+         pTerm->iRow = pTerm->iCol = 0;
+
+         HB_GTSELF_SCROLLAREA( pGT, iTop, iLeft, iBottom, iRight, iColor, usChar, iRows, 0 );
+         /* vacated lines were erased by terminal but copy of terminal
+          * contents still keeps old ones, force their redrawing */
+         if( iRows > 0 )
+            HB_GTSELF_EXPOSEAREA( pGT, iBottom - iRows + 1, 0, iBottom, iWidth - 1 );
+         else
+            HB_GTSELF_EXPOSEAREA( pGT, iTop, 0, iTop - iRows - 1, iWidth - 1 );
+         return;
+      }
+   }
+
    HB_GTSUPER_SCROLL( pGT, iTop, iLeft, iBottom, iRight, iColor, usChar, iRows, iCols );
 }
 
@@ -3783,6 +3854,7 @@ static void hb_gt_trm_Redraw( PHB_GT pGT, int iRow, int iCol, int iSize )
    PHB_GTTRM pTerm;
    HB_BYTE bAttr;
    HB_USHORT usChar;
+   HB_BOOL fBlank = HB_FALSE;
    int iLen, iChars, iAttribute, iColor;
 
    HB_TRACE( HB_TR_DEBUG, ( "hb_gt_trm_Redraw(%p,%d,%d,%d)", ( void * ) pGT, iRow, iCol, iSize ) );
@@ -3823,14 +3895,28 @@ static void hb_gt_trm_Redraw( PHB_GT pGT, int iRow, int iCol, int iSize )
       }
 
       if( iLen == 0 )
+      {
          iAttribute = iColor;
+         fBlank = HB_TRUE;
+      }
       else if( iColor != iAttribute )
       {
-         hb_gt_trm_PutStr( pTerm, iRow, iCol, iAttribute, pTerm->pLineBuf, iLen, iChars );
-         iCol += iChars;
-         iLen = iChars = 0;
-         iAttribute = iColor;
+         /* blanks differing only in foreground color do not break
+          * attribute runs so they do not need new SGR sequences */
+         if( ( ( iColor ^ iAttribute ) & ~0x0F ) != 0 ||
+             ( usChar != ' ' && ! fBlank ) )
+         {
+            hb_gt_trm_PutStr( pTerm, iRow, iCol, iAttribute, pTerm->pLineBuf, iLen, iChars );
+            iCol += iChars;
+            iLen = iChars = 0;
+            iAttribute = iColor;
+            fBlank = HB_TRUE;
+         }
+         else if( usChar != ' ' )
+            iAttribute = iColor;
       }
+      if( usChar != ' ' )
+         fBlank = HB_FALSE;
       if( pTerm->fUTF8 )
          iLen += hb_cdpU16CharToUTF8( pTerm->pLineBuf + iLen, usChar );
       else
@@ -3855,14 +3941,28 @@ static void hb_gt_trm_Redraw( PHB_GT pGT, int iRow, int iCol, int iSize )
             usChar = pTerm->chrattr[ usChar ] & HB_GTTRM_ATTR_CHAR;
       }
       if( iLen == 0 )
+      {
          iAttribute = iColor;
+         fBlank = HB_TRUE;
+      }
       else if( iColor != iAttribute )
       {
-         hb_gt_trm_PutStr( pTerm, iRow, iCol, iAttribute, pTerm->pLineBuf, iLen, iChars );
-         iCol += iChars;
-         iLen = iChars = 0;
-         iAttribute = iColor;
+         /* blanks differing only in foreground color do not break
+          * attribute runs so they do not need new SGR sequences */
+         if( ( ( iColor ^ iAttribute ) & ~0x0F ) != 0 ||
+             ( usChar != ' ' && ! fBlank ) )
+         {
+            hb_gt_trm_PutStr( pTerm, iRow, iCol, iAttribute, pTerm->pLineBuf, iLen, iChars );
+            iCol += iChars;
+            iLen = iChars = 0;
+            iAttribute = iColor;
+            fBlank = HB_TRUE;
+         }
+         else if( usChar != ' ' )
+            iAttribute = iColor;
       }
+      if( usChar != ' ' )
+         fBlank = HB_FALSE;
       pTerm->pLineBuf[ iLen++ ] = ( char ) usChar;
       ++iChars;
 #endif
@@ -3894,6 +3994,7 @@ static void hb_gt_trm_Refresh( PHB_GT pGT )
       pTerm->nLineBufSize = nLineBufSize;
    }
 
+   pTerm->fOutBufHold = HB_TRUE;
    HB_GTSUPER_REFRESH( pGT );
 
    HB_GTSELF_GETSCRCURSOR( pGT, &iRow, &iCol, &iStyle );
@@ -3906,6 +4007,7 @@ static void hb_gt_trm_Refresh( PHB_GT pGT )
          iStyle = SC_NONE;
    }
    pTerm->SetCursorStyle( pTerm, iStyle );
+   pTerm->fOutBufHold = HB_FALSE;
    hb_gt_trm_termFlush( pTerm );
    disp_mousecursor( pTerm );
 }
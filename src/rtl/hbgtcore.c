@@ -1485,6 +1485,10 @@ static void hb_gt_def_ScrollArea( PHB_GT pGT, int iTop, int iLeft, int iBottom,
             {
                int i;
 
+               /* moved cells carry not yet displayed changes */
+               if( pGT->pLines[ iRowPos + iRows ] )
+                  pGT->pLines[ iRowPos ] = HB_TRUE;
+
                lIndex = ( long ) iRowPos * iWidth + iColNew;
                if( lOffset < 0 )
                {
@@ -2591,7 +2595,13 @@ static void hb_gt_def_RedrawDiff( PHB_GT pGT )
          if( pGT->pLines[ i ] )
          {
             lIndex = ( long ) i * pGT->iWidth;
-            for( l = 0; l < pGT->iWidth; ++l, ++lIndex )
+            /* rows rewritten with unchanged contents are skipped at once */
+            if( memcmp( pGT->prevBuffer + lIndex, pGT->screenBuffer + lIndex,
+                        pGT->iWidth * sizeof( HB_SCREENCELL ) ) == 0 )
+               l = pGT->iWidth;
+            else
+               l = 0;
+            for( ; l < pGT->iWidth; ++l, ++lIndex )
             {
                if( pGT->prevBuffer[ lIndex ].uiValue !=
                    pGT->screenBuffer[ lIndex ].uiValue )
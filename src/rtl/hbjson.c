@@ -47,8 +47,23 @@
 #include "hbapi.h"
 #include "hbapiitm.h"
 #include "hbapistr.h"
+#include "hbapierr.h"
+#include "hbapifs.h"
+#include "hbsocket.h"
+#include "hbvm.h"
 #include "hbset.h"
 #include "hbjson.h"
+#include "hbjson.ch"
+
+/* SSE2 is part of x86_64 architecture and can be used unconditionally.
+   Define HB_NO_SIMD to build portable code only. */
+#if ! defined( HB_NO_SIMD )
+#  if defined( __SSE2__ ) || defined( _M_X64 ) || defined( _M_AMD64 ) || \
+      ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#     define HB_JSON_SSE2
+#     include <emmintrin.h>
+#  endif
+#endif
 
 /*
    The application/json Media Type for JavaScript Object Notation (JSON)
@@ -71,10 +86,40 @@
               to use the remaining part of the buffer for some other
               purposes. Returns 0 on error.
 
+        HB_BOOL hb_jsonEncodeStream( PHB_ITEM pValue,
+                                     PHB_JSON_WRITE_FUNC pWrite, void * cargo,
+                                     int iIndent, PHB_CODEPAGE cdp );
+           encodes pValue passing output to pWrite() in fixed size
+           blocks, returns HB_FALSE if pWrite() reported an error.
+
+        HB_SIZE hb_jsonDecodeStream( PHB_JSON_READ_FUNC pRead, void * cargo,
+                                     PHB_ITEM pValue, PHB_CODEPAGE cdp );
+           decodes JSON value reading source by pRead() in fixed size
+           blocks, returns number of bytes decoded or 0 on error.
+           Data read ahead after decoded value is lost.
+
       Harbour level functions:
         hb_jsonEncode( xValue [, lHuman = .F. | nIndent = 0 ] ) --> cJSON
         hb_jsonDecode( cJSON ) --> xValue
         hb_jsonDecode( cJSON, @xValue ) --> nLengthDecoded
+        hb_jsonEncodeStream( xValue, xTarget [, lHuman = .F. | nIndent = 0 ] ) --> lSuccess
+        hb_jsonDecodeStream( xSource, [ @xValue ], [ bEvent ], [ nDepth ] ) --> nLengthDecoded
+
+           xTarget and xSource can be file handle, hb_vfOpen() file,
+           socket or codeblock. xSource can be also JSON string.
+           Target codeblock receives blocks of encoded data and should
+           return .F. on error. Source codeblock receives requested
+           size and should return next chunk of data or empty string
+           at the end of input.
+
+           When bEvent is given, decoded values are not collected in
+           xValue but passed to Eval( bEvent, nEvent, xValue ) with
+           nEvent being one of HB_JSON_EV_* values from hbjson.ch.
+           Arrays and objects nested deeper then nDepth (default:
+           unlimited) are not split into events but materialized and
+           passed as single HB_JSON_EV_VALUE event, i.e. nDepth = 1
+           calls bEvent once for each item of top level array.
+           bEvent may return .F. to stop decoding.
 
       Note:
         - JSON encode functions are safe for recursive arrays and hashes.
@@ -101,20 +146,113 @@ typedef struct
    int     iIndent;
    int     iEolLen;
    const char * szEol;
+   PHB_JSON_WRITE_FUNC pWrite;
+   void *  cargo;
+   HB_BOOL fError;
 } HB_JSON_ENCODE_CTX, * PHB_JSON_ENCODE_CTX;
 
+typedef struct
+{
+   const char * pPos;         /* current position */
+   const char * pEnd;         /* end of available data */
+   const char * pStart;       /* beginning of available data */
+   HB_SIZE      nRead;        /* number of bytes before pStart */
+   char *       pBuffer;      /* stream buffer */
+   HB_SIZE      nSize;
+   PHB_JSON_READ_FUNC pRead;  /* NULL when no more data can be read */
+   void *       cargo;
+   char *       pStr;         /* string decoding buffer */
+   HB_SIZE      nStrLen;
+   HB_SIZE      nStrAlloc;
+   PHB_CODEPAGE cdp;
+   PHB_ITEM     pEvent;       /* event codeblock */
+   PHB_ITEM     pEventId;
+   int          iDepth;
+   HB_BOOL      fStop;
+} HB_JSON_DECODE_CTX, * PHB_JSON_DECODE_CTX;
+
+
+#define INDENT_SIZE        2
+#define HB_JSON_BUFSIZE    0x10000
+
+/* length of leading part of string which does not need escaping,
+   used by encoder and decoder */
+static HB_SIZE _hb_jsonPlainLen( const char * szString, HB_SIZE nLen )
+{
+   HB_SIZE nPos = 0;
+
+#if defined( HB_JSON_SSE2 )
+   if( nLen >= 16 )
+   {
+      const __m128i vQuote = _mm_set1_epi8( '\"' );
+      const __m128i vBSlash = _mm_set1_epi8( '\\' );
+      const __m128i vCtrl = _mm_set1_epi8( 0x1F );
 
-#define INDENT_SIZE  2
+      do
+      {
+         __m128i v = _mm_loadu_si128( ( const __m128i * ) ( szString + nPos ) );
+         int iMask = _mm_movemask_epi8(
+                        _mm_or_si128( _mm_or_si128( _mm_cmpeq_epi8( v, vQuote ),
+                                                    _mm_cmpeq_epi8( v, vBSlash ) ),
+                                      _mm_cmpeq_epi8( _mm_max_epu8( v, vCtrl ), vCtrl ) ) );
+         if( iMask )
+         {
+            while( ( iMask & 1 ) == 0 )
+            {
+               iMask >>= 1;
+               ++nPos;
+            }
+            return nPos;
+         }
+         nPos += 16;
+      }
+      while( nPos + 16 <= nLen );
+   }
+#endif
+   while( nPos < nLen )
+   {
+      unsigned char uch = ( unsigned char ) szString[ nPos ];
+
+      if( uch < ' ' || uch == '\\' || uch == '\"' )
+         break;
+      ++nPos;
+   }
+   return nPos;
+}
+
+static void _hb_jsonCtxFlush( PHB_JSON_ENCODE_CTX pCtx )
+{
+   HB_SIZE nLen = pCtx->pHead - pCtx->pBuffer;
+
+   if( nLen > 0 && ! pCtx->fError &&
+       pCtx->pWrite( pCtx->cargo, pCtx->pBuffer, nLen ) != nLen )
+      pCtx->fError = HB_TRUE;
+   pCtx->pHead = pCtx->pBuffer;
+}
 
 static void _hb_jsonCtxAdd( PHB_JSON_ENCODE_CTX pCtx, const char * szString, HB_SIZE nLen )
 {
    if( pCtx->pHead + nLen >= pCtx->pBuffer + pCtx->nAlloc )
    {
-      HB_SIZE nSize = pCtx->pHead - pCtx->pBuffer;
+      if( pCtx->pWrite )
+      {
+         _hb_jsonCtxFlush( pCtx );
+         if( nLen >= pCtx->nAlloc )
+         {
+            if( ! pCtx->fError &&
+                pCtx->pWrite( pCtx->cargo, szString, nLen ) != nLen )
+               pCtx->fError = HB_TRUE;
+            return;
+         }
+      }
+      else
+      {
+         HB_SIZE nSize = pCtx->pHead - pCtx->pBuffer;
 
-      pCtx->nAlloc += ( pCtx->nAlloc << 1 ) + nLen;
-      pCtx->pBuffer = ( char * ) hb_xrealloc( pCtx->pBuffer, pCtx->nAlloc );
-      pCtx->pHead = pCtx->pBuffer + nSize;
+         pCtx->nAlloc += ( pCtx->nAlloc << 1 ) + nLen;
+         pCtx->pBuffer = ( char * ) hb_xrealloc( pCtx->pBuffer, pCtx->nAlloc );
+         pCtx->pHead = pCtx->pBuffer + nSize;
+      }
    }
    if( szString )
    {
@@ -128,16 +266,32 @@ static void _hb_jsonCtxAddIndent( PHB_JSON_ENCODE_CTX pCtx, HB_SIZE nLevel )
    if( nLevel > 0 )
    {
       HB_SIZE nCount = nLevel * ( pCtx->iIndent > 0 ? pCtx->iIndent : 1 );
-      if( pCtx->pHead + nCount >= pCtx->pBuffer + pCtx->nAlloc )
+
+      while( nCount > 0 )
       {
-         HB_SIZE nSize = pCtx->pHead - pCtx->pBuffer;
+         HB_SIZE nPart = nCount;
 
-         pCtx->nAlloc += ( pCtx->nAlloc << 1 ) + nCount;
-         pCtx->pBuffer = ( char * ) hb_xrealloc( pCtx->pBuffer, pCtx->nAlloc );
-         pCtx->pHead = pCtx->pBuffer + nSize;
+         if( pCtx->pHead + nPart >= pCtx->pBuffer + pCtx->nAlloc )
+         {
+            if( pCtx->pWrite )
+            {
+               _hb_jsonCtxFlush( pCtx );
+               if( nPart >= pCtx->nAlloc )
+                  nPart = pCtx->nAlloc - 1;
+            }
+            else
+            {
+               HB_SIZE nSize = pCtx->pHead - pCtx->pBuffer;
+
+               pCtx->nAlloc += ( pCtx->nAlloc << 1 ) + nPart;
+               pCtx->pBuffer = ( char * ) hb_xrealloc( pCtx->pBuffer, pCtx->nAlloc );
+               pCtx->pHead = pCtx->pBuffer + nSize;
+            }
+         }
+         hb_xmemset( pCtx->pHead, pCtx->iIndent > 0 ? ' ' : '\t', nPart );
+         pCtx->pHead += nPart;
+         nCount -= nPart;
       }
-      hb_xmemset( pCtx->pHead, pCtx->iIndent > 0 ? ' ' : '\t', nCount );
-      pCtx->pHead += nCount;
    }
 }
 
@@ -154,7 +308,9 @@ static void _hb_jsonEncode( PHB_ITEM pValue, PHB_JSON_ENCODE_CTX pCtx,
       {
          if( pCtx->pId[ nIndex ] == id )
          {
-            if( ! fEOL && pCtx->iIndent )
+            if( fEOL )
+               _hb_jsonCtxAdd( pCtx, " ", 1 );
+            else if( pCtx->iIndent )
                _hb_jsonCtxAddIndent( pCtx, nLevel );
             _hb_jsonCtxAdd( pCtx, "null", 4 );
             return;
@@ -169,10 +325,7 @@ static void _hb_jsonEncode( PHB_ITEM pValue, PHB_JSON_ENCODE_CTX pCtx,
    }
 
    if( fEOL )
-   {
-      --pCtx->pHead;
       _hb_jsonCtxAdd( pCtx, pCtx->szEol, pCtx->iEolLen );
-   }
 
    if( HB_IS_STRING( pValue ) )
    {
@@ -195,19 +348,17 @@ static void _hb_jsonEncode( PHB_ITEM pValue, PHB_JSON_ENCODE_CTX pCtx,
       nPos = 0;
       while( nPos < nLen )
       {
-         unsigned char uch = szString[ nPos ];
-         HB_SIZE nPos2 = nPos;
-         while( uch >= ' ' && uch != '\\' && uch != '\"' )
-            uch = szString[ ++nPos2 ];
-         if( nPos2 > nPos )
+         HB_SIZE nPlain = _hb_jsonPlainLen( szString + nPos, nLen - nPos );
+
+         if( nPlain > 0 )
          {
-            _hb_jsonCtxAdd( pCtx, szString + nPos, nPos2 - nPos );
-            if( nPos2 >= nLen )
+            _hb_jsonCtxAdd( pCtx, szString + nPos, nPlain );
+            nPos += nPlain;
+            if( nPos >= nLen )
                break;
-            nPos = nPos2;
          }
 
-         switch( uch )
+         switch( szString[ nPos ] )
          {
             case '\\':
                _hb_jsonCtxAdd( pCtx, "\\\\", 2 );
@@ -231,7 +382,7 @@ static void _hb_jsonEncode( PHB_ITEM pValue, PHB_JSON_ENCODE_CTX pCtx,
                _hb_jsonCtxAdd( pCtx, "\\t", 2 );
                break;
             default:
-               hb_snprintf( buf, sizeof( buf ), "\\u00%02X", uch );
+               hb_snprintf( buf, sizeof( buf ), "\\u00%02X", ( unsigned char ) szString[ nPos ] );
                _hb_jsonCtxAdd( pCtx, buf, 6 );
                break;
          }
@@ -367,8 +518,8 @@ static void _hb_jsonEncode( PHB_ITEM pValue, PHB_JSON_ENCODE_CTX pCtx,
 
                if( pCtx->iIndent )
                {
-                  _hb_jsonCtxAdd( pCtx, ": ", 2 );
                   fEOL = ( HB_IS_ARRAY( pItem ) || HB_IS_HASH( pItem ) ) && hb_itemSize( pItem ) > 0;
+                  _hb_jsonCtxAdd( pCtx, ": ", fEOL ? 1 : 2 );
                }
                else
                {
@@ -397,107 +548,186 @@ static void _hb_jsonEncode( PHB_ITEM pValue, PHB_JSON_ENCODE_CTX pCtx,
 }
 
 
-static const char * _skipws( const char * szSource )
+/* make at least nNeed bytes available, returns HB_FALSE at the end of input */
+static HB_BOOL _hb_jsonFill( PHB_JSON_DECODE_CTX pCtx, HB_SIZE nNeed )
 {
-   while( *szSource == ' ' || *szSource == '\t' || *szSource == '\n' || *szSource == '\r' )
-      szSource++;
-   return szSource;
+   while( ( HB_SIZE ) ( pCtx->pEnd - pCtx->pPos ) < nNeed )
+   {
+      HB_SIZE nLeft = pCtx->pEnd - pCtx->pPos, nRead;
+
+      if( ! pCtx->pRead )
+         return HB_FALSE;
+
+      pCtx->nRead += pCtx->pPos - pCtx->pStart;
+      if( nLeft > 0 )
+         memmove( pCtx->pBuffer, pCtx->pPos, nLeft );
+      pCtx->pStart = pCtx->pPos = pCtx->pBuffer;
+      pCtx->pEnd = pCtx->pBuffer + nLeft;
+
+      nRead = pCtx->pRead( pCtx->cargo, pCtx->pBuffer + nLeft, pCtx->nSize - nLeft );
+      if( nRead == 0 || nRead > pCtx->nSize - nLeft )
+      {
+         pCtx->pRead = NULL;
+         return HB_FALSE;
+      }
+      pCtx->pEnd += nRead;
+   }
+   return HB_TRUE;
 }
 
-static const char * _hb_jsonDecode( const char * szSource, PHB_ITEM pValue, PHB_CODEPAGE cdp )
+#define _hb_jsonPeek( p )  ( ( p )->pPos < ( p )->pEnd || _hb_jsonFill( p, 1 ) ? \
+                             ( unsigned char ) *( p )->pPos : 0 )
+
+static void _skipws( PHB_JSON_DECODE_CTX pCtx )
 {
-   if( *szSource == '\"' )
+   for( ;; )
    {
-      char * szDest, * szHead;
-      HB_SIZE nAlloc = 16;
+      while( pCtx->pPos < pCtx->pEnd &&
+             ( *pCtx->pPos == ' ' || *pCtx->pPos == '\t' ||
+               *pCtx->pPos == '\n' || *pCtx->pPos == '\r' ) )
+         pCtx->pPos++;
+      if( pCtx->pPos < pCtx->pEnd || ! _hb_jsonFill( pCtx, 1 ) )
+         break;
+   }
+}
 
-      szHead = szDest = ( char * ) hb_xgrab( nAlloc );
-      szSource++;
-      while( *szSource != '\"' )
+static void _hb_jsonStrAdd( PHB_JSON_DECODE_CTX pCtx, const char * szText, HB_SIZE nLen )
+{
+   if( pCtx->nStrLen + nLen + 8 > pCtx->nStrAlloc )
+   {
+      pCtx->nStrAlloc += ( pCtx->nStrAlloc >> 1 ) + nLen + 64;
+      pCtx->pStr = ( char * ) hb_xrealloc( pCtx->pStr, pCtx->nStrAlloc );
+   }
+   if( szText )
+   {
+      memcpy( pCtx->pStr + pCtx->nStrLen, szText, nLen );
+      pCtx->nStrLen += nLen;
+   }
+}
+
+static void _hb_jsonPutStr( PHB_JSON_DECODE_CTX pCtx, PHB_ITEM pValue,
+                            const char * szText, HB_SIZE nLen )
+{
+   if( pCtx->cdp && hb_vmCDP() != pCtx->cdp )
+      hb_itemPutStrLen( pValue, pCtx->cdp, szText, nLen );
+   else
+      hb_itemPutCL( pValue, szText, nLen );
+}
+
+static HB_BOOL _hb_jsonDecodeString( PHB_JSON_DECODE_CTX pCtx, PHB_ITEM pValue )
+{
+   pCtx->nStrLen = 0;
+   pCtx->pPos++;
+   for( ;; )
+   {
+      HB_SIZE nAvail = pCtx->pEnd - pCtx->pPos;
+      HB_SIZE nPlain = _hb_jsonPlainLen( pCtx->pPos, nAvail );
+      char ch;
+
+      if( nPlain == nAvail )
+      {
+         /* string continues in next block */
+         _hb_jsonStrAdd( pCtx, pCtx->pPos, nPlain );
+         pCtx->pPos += nPlain;
+         if( ! _hb_jsonFill( pCtx, 1 ) )
+            return HB_FALSE;
+         continue;
+      }
+
+      ch = pCtx->pPos[ nPlain ];
+      if( ch == '\"' )
       {
-         if( szHead + 6 >= szDest + nAlloc )
+         /* strings without escape sequences are stored directly
+            from source buffer */
+         if( pCtx->nStrLen == 0 )
+            _hb_jsonPutStr( pCtx, pValue, pCtx->pPos, nPlain );
+         else
          {
-            HB_SIZE nLen = szHead - szDest;
-            nAlloc += nAlloc << 1;
-            szDest = ( char * ) hb_xrealloc( szDest, nAlloc );
-            szHead = szDest + nLen;
+            _hb_jsonStrAdd( pCtx, pCtx->pPos, nPlain );
+            _hb_jsonPutStr( pCtx, pValue, pCtx->pStr, pCtx->nStrLen );
          }
-         if( *szSource == '\\' )
+         pCtx->pPos += nPlain + 1;
+         return HB_TRUE;
+      }
+      else if( ch != '\\' )
+         return HB_FALSE;
+
+      _hb_jsonStrAdd( pCtx, pCtx->pPos, nPlain );
+      pCtx->pPos += nPlain;
+      if( ! _hb_jsonFill( pCtx, 2 ) )
+         return HB_FALSE;
+
+      switch( pCtx->pPos[ 1 ] )
+      {
+         case '\"':
+            ch = '\"';
+            break;
+         case '\\':
+            ch = '\\';
+            break;
+         case '/':
+            ch = '/';
+            break;
+         case 'b':
+            ch = '\b';
+            break;
+         case 'f':
+            ch = '\f';
+            break;
+         case 'n':
+            ch = '\n';
+            break;
+         case 'r':
+            ch = '\r';
+            break;
+         case 't':
+            ch = '\t';
+            break;
+         case 'u':
          {
-            szSource++;
-            switch( *szSource )
+            HB_WCHAR wc = 0;
+            int i;
+
+            if( ! _hb_jsonFill( pCtx, 6 ) )
+               return HB_FALSE;
+            for( i = 2; i < 6; i++ )
             {
-               case '\"':
-                  *szHead++ = '\"';
-                  break;
-               case '\\':
-                  *szHead++ = '\\';
-                  break;
-               case '/':
-                  *szHead++ = '/';
-                  break;
-               case 'b':
-                  *szHead++ = '\b';
-                  break;
-               case 'f':
-                  *szHead++ = '\f';
-                  break;
-               case 'n':
-                  *szHead++ = '\n';
-                  break;
-               case 'r':
-                  *szHead++ = '\r';
-                  break;
-               case 't':
-                  *szHead++ = '\t';
-                  break;
-               case 'u':
-               {
-                  HB_WCHAR wc = 0;
-                  int i;
-
-                  for( i = 0; i < 4; i++ )
-                  {
-                     char c = *++szSource;
-                     wc <<= 4;
-                     if( c >= '0' && c <= '9' )
-                        wc += c - '0';
-                     else if( c >= 'A' && c <= 'F' )
-                        wc += c - 'A' + 10;
-                     else if( c >= 'a' && c <= 'f' )
-                        wc += c - 'a' + 10;
-                     else
-                     {
-                        hb_xfree( szDest );
-                        return NULL;
-                     }
-                  }
-                  szHead += hb_cdpU16ToStr( cdp ? cdp : hb_vmCDP(), HB_CDP_ENDIAN_NATIVE,
-                                            &wc, 1, szHead, szDest + nAlloc - szHead );
-                  break;
-               }
-               default:
-                  hb_xfree( szDest );
-                  return NULL;
+               char c = pCtx->pPos[ i ];
+               wc <<= 4;
+               if( c >= '0' && c <= '9' )
+                  wc += c - '0';
+               else if( c >= 'A' && c <= 'F' )
+                  wc += c - 'A' + 10;
+               else if( c >= 'a' && c <= 'f' )
+                  wc += c - 'a' + 10;
+               else
+                  return HB_FALSE;
             }
-            szSource++;
-         }
-         else if( *( const unsigned char * ) szSource >= ' ' )
-            *szHead++ = *szSource++;
-         else
-         {
-            hb_xfree( szDest );
-            return NULL;
+            _hb_jsonStrAdd( pCtx, NULL, 0 );
+            pCtx->nStrLen += hb_cdpU16ToStr( pCtx->cdp ? pCtx->cdp : hb_vmCDP(),
+                                             HB_CDP_ENDIAN_NATIVE, &wc, 1,
+                                             pCtx->pStr + pCtx->nStrLen,
+                                             pCtx->nStrAlloc - pCtx->nStrLen );
+            pCtx->pPos += 6;
+            continue;
          }
+         default:
+            return HB_FALSE;
       }
-      if( cdp && hb_vmCDP() != cdp )
-         hb_itemPutStrLen( pValue, cdp, szDest, szHead - szDest );
-      else
-         hb_itemPutCL( pValue, szDest, szHead - szDest );
-      hb_xfree( szDest );
-      return szSource + 1;
+      _hb_jsonStrAdd( pCtx, &ch, 1 );
+      pCtx->pPos += 2;
+   }
+}
+
+static HB_BOOL _hb_jsonDecode( PHB_JSON_DECODE_CTX pCtx, PHB_ITEM pValue )
+{
+   int ch = _hb_jsonPeek( pCtx );
+
+   if( ch == '\"' )
+   {
+      return _hb_jsonDecodeString( pCtx, pValue );
    }
-   else if( *szSource == '-' || ( *szSource >= '0' && *szSource <= '9' ) )
+   else if( ch == '-' || ( ch >= '0' && ch <= '9' ) )
    {
       /* NOTE: this function is much less strict to number format than
                JSON syntax definition. This is allowed behaviour [Mindaugas] */
@@ -506,44 +736,55 @@ static const char * _hb_jsonDecode( const char * szSource, PHB_ITEM pValue, PHB_
       HB_BOOL fNeg, fDbl = HB_FALSE;
       int iDec = 0;
 
-      fNeg = *szSource == '-';
+      fNeg = ch == '-';
       if( fNeg )
-         szSource++;
+      {
+         pCtx->pPos++;
+         ch = _hb_jsonPeek( pCtx );
+      }
 
-      while( *szSource >= '0' && *szSource <= '9' )
+      while( ch >= '0' && ch <= '9' )
       {
-         nValue = nValue * 10 + *szSource - '0';
-         szSource++;
+         nValue = nValue * 10 + ch - '0';
+         pCtx->pPos++;
+         ch = _hb_jsonPeek( pCtx );
       }
-      if( *szSource == '.' )
+      if( ch == '.' )
       {
          double mult = 1;
 
          dblValue = ( double ) nValue;
          fDbl = HB_TRUE;
-         szSource++;
-         while( *szSource >= '0' && *szSource <= '9' )
+         pCtx->pPos++;
+         ch = _hb_jsonPeek( pCtx );
+         while( ch >= '0' && ch <= '9' )
          {
             mult /= 10;
-            dblValue += ( ( double ) ( *szSource - '0' ) ) * mult;
-            szSource++;
+            dblValue += ( ( double ) ( ch - '0' ) ) * mult;
+            pCtx->pPos++;
+            ch = _hb_jsonPeek( pCtx );
             iDec++;
          }
       }
-      if( *szSource == 'e' || *szSource == 'E' )
+      if( ch == 'e' || ch == 'E' )
       {
          HB_BOOL fNegExp;
          int iExp = 0;
 
-         szSource++;
-         fNegExp = *szSource == '-';
+         pCtx->pPos++;
+         ch = _hb_jsonPeek( pCtx );
+         fNegExp = ch == '-';
          if( fNegExp )
-            szSource++;
+         {
+            pCtx->pPos++;
+            ch = _hb_jsonPeek( pCtx );
+         }
 
-         while( *szSource >= '0' && *szSource <= '9' )
+         while( ch >= '0' && ch <= '9' )
          {
-            iExp = iExp * 10 + *szSource - '0';
-            szSource++;
+            iExp = iExp * 10 + ch - '0';
+            pCtx->pPos++;
+            ch = _hb_jsonPeek( pCtx );
          }
          if( ! fDbl )
          {
@@ -559,64 +800,70 @@ static const char * _hb_jsonDecode( const char * szSource, PHB_ITEM pValue, PHB_
          hb_itemPutNDDec( pValue, hb_numRound( fNeg ? -dblValue : dblValue, iDec ), iDec );
       else
          hb_itemPutNInt( pValue, fNeg ? -nValue : nValue );
-      return szSource;
+      return HB_TRUE;
    }
-   else if( ! strncmp( szSource, "null", 4 ) )
+   else if( ch == 'n' || ch == 't' || ch == 'f' )
    {
-      hb_itemClear( pValue );
-      return szSource + 4;
-   }
-   else if( ! strncmp( szSource, "true", 4 ) )
-   {
-      hb_itemPutL( pValue, HB_TRUE );
-      return szSource + 4;
-   }
-   else if( ! strncmp( szSource, "false", 5 ) )
-   {
-      hb_itemPutL( pValue, HB_FALSE );
-      return szSource + 5;
+      HB_SIZE nLen = ch == 'f' ? 5 : 4;
+
+      if( ! _hb_jsonFill( pCtx, nLen ) )
+         return HB_FALSE;
+      else if( ! memcmp( pCtx->pPos, "null", 4 ) )
+         hb_itemClear( pValue );
+      else if( ! memcmp( pCtx->pPos, "true", 4 ) )
+         hb_itemPutL( pValue, HB_TRUE );
+      else if( ! memcmp( pCtx->pPos, "false", 5 ) )
+         hb_itemPutL( pValue, HB_FALSE );
+      else
+         return HB_FALSE;
+      pCtx->pPos += nLen;
+      return HB_TRUE;
    }
-   else if( *szSource == '[' )
+   else if( ch == '[' )
    {
       hb_arrayNew( pValue, 0 );
-      szSource = _skipws( szSource + 1 );
-      if( *szSource != ']' )
+      pCtx->pPos++;
+      _skipws( pCtx );
+      if( _hb_jsonPeek( pCtx ) != ']' )
       {
          PHB_ITEM pItem = hb_itemNew( NULL );
 
          for( ;; )
          {
-            szSource = _hb_jsonDecode( szSource, pItem, cdp );
-            if( ! szSource )
+            if( ! _hb_jsonDecode( pCtx, pItem ) )
             {
                hb_itemRelease( pItem );
-               return NULL;
+               return HB_FALSE;
             }
             hb_arrayAddForward( pValue, pItem );
 
-            szSource = _skipws( szSource );
-            if( *szSource == ',' )
+            _skipws( pCtx );
+            ch = _hb_jsonPeek( pCtx );
+            if( ch == ',' )
             {
-               szSource = _skipws( szSource + 1 );
+               pCtx->pPos++;
+               _skipws( pCtx );
                continue;
             }
-            else if( *szSource == ']' )
+            else if( ch == ']' )
                break;
             else
             {
                hb_itemRelease( pItem );
-               return NULL;
+               return HB_FALSE;
             }
          }
          hb_itemRelease( pItem );
       }
-      return szSource + 1;
+      pCtx->pPos++;
+      return HB_TRUE;
    }
-   else if( *szSource == '{' )
+   else if( ch == '{' )
    {
       hb_hashNew( pValue );
-      szSource = _skipws( szSource + 1 );
-      if( *szSource != '}' )
+      pCtx->pPos++;
+      _skipws( pCtx );
+      if( _hb_jsonPeek( pCtx ) != '}' )
       {
          PHB_ITEM pItemKey = hb_itemNew( NULL );
          PHB_ITEM pItemValue = hb_itemNew( NULL );
@@ -624,51 +871,150 @@ static const char * _hb_jsonDecode( const char * szSource, PHB_ITEM pValue, PHB_
          for( ;; )
          {
             /* Do we need to check if key does not exist yet? */
-            if( ( szSource = _hb_jsonDecode( szSource, pItemKey, cdp ) ) == NULL ||
-                ! HB_IS_STRING( pItemKey ) ||
-                * ( szSource = _skipws( szSource ) ) != ':' ||
-                ( szSource = _hb_jsonDecode( _skipws( szSource + 1 ), pItemValue, cdp ) ) == NULL)
+            if( _hb_jsonPeek( pCtx ) != '\"' ||
+                ! _hb_jsonDecodeString( pCtx, pItemKey ) ||
+                ( _skipws( pCtx ), _hb_jsonPeek( pCtx ) ) != ':' ||
+                ( pCtx->pPos++, _skipws( pCtx ), ! _hb_jsonDecode( pCtx, pItemValue ) ) )
             {
                hb_itemRelease( pItemKey );
                hb_itemRelease( pItemValue );
-               return NULL;
+               return HB_FALSE;
             }
 
             hb_hashAdd( pValue, pItemKey, pItemValue );
-            szSource = _skipws( szSource );
-            if( *szSource == ',' )
+            _skipws( pCtx );
+            ch = _hb_jsonPeek( pCtx );
+            if( ch == ',' )
             {
-               szSource = _skipws( szSource + 1 );
+               pCtx->pPos++;
+               _skipws( pCtx );
                continue;
             }
-            else if( *szSource == '}' )
+            else if( ch == '}' )
                break;
             else
             {
                hb_itemRelease( pItemKey );
                hb_itemRelease( pItemValue );
-               return NULL;
+               return HB_FALSE;
             }
          }
          hb_itemRelease( pItemKey );
          hb_itemRelease( pItemValue );
       }
-      return szSource + 1;
+      pCtx->pPos++;
+      return HB_TRUE;
    }
-   return NULL;
+   return HB_FALSE;
 }
 
-/* C level API functions */
+static HB_BOOL _hb_jsonEvent( PHB_JSON_DECODE_CTX pCtx, int iEvent, PHB_ITEM pValue )
+{
+   PHB_ITEM pResult;
 
-char * hb_jsonEncodeCP( PHB_ITEM pValue, HB_SIZE * pnLen, int iIndent, PHB_CODEPAGE cdp )
+   hb_itemPutNI( pCtx->pEventId, iEvent );
+   pResult = hb_vmEvalBlockV( pCtx->pEvent, 2, pCtx->pEventId, pValue );
+   if( hb_vmRequestQuery() != 0 ||
+       ( HB_IS_LOGICAL( pResult ) && ! hb_itemGetL( pResult ) ) )
+      pCtx->fStop = HB_TRUE;
+
+   return ! pCtx->fStop;
+}
+
+/* decode value passing it to event codeblock, arrays and objects
+   above nDepth level are reported as sequence of events */
+static HB_BOOL _hb_jsonDecodeEvent( PHB_JSON_DECODE_CTX pCtx, PHB_ITEM pItem, int iLevel )
 {
-   PHB_JSON_ENCODE_CTX pCtx;
-   char * szRet;
-   HB_SIZE nLen;
+   int ch = _hb_jsonPeek( pCtx );
+
+   if( iLevel < pCtx->iDepth && ( ch == '[' || ch == '{' ) )
+   {
+      int iClose = ch == '[' ? ']' : '}';
+
+      hb_itemClear( pItem );
+      if( ! _hb_jsonEvent( pCtx, ch == '[' ? HB_JSON_EV_ARRAY : HB_JSON_EV_OBJECT, pItem ) )
+         return HB_FALSE;
+      pCtx->pPos++;
+      _skipws( pCtx );
+      if( _hb_jsonPeek( pCtx ) != iClose )
+      {
+         for( ;; )
+         {
+            if( iClose == '}' )
+            {
+               if( _hb_jsonPeek( pCtx ) != '\"' ||
+                   ! _hb_jsonDecodeString( pCtx, pItem ) ||
+                   ! _hb_jsonEvent( pCtx, HB_JSON_EV_KEY, pItem ) )
+                  return HB_FALSE;
+               _skipws( pCtx );
+               if( _hb_jsonPeek( pCtx ) != ':' )
+                  return HB_FALSE;
+               pCtx->pPos++;
+               _skipws( pCtx );
+            }
+            if( ! _hb_jsonDecodeEvent( pCtx, pItem, iLevel + 1 ) )
+               return HB_FALSE;
+
+            _skipws( pCtx );
+            ch = _hb_jsonPeek( pCtx );
+            if( ch == ',' )
+            {
+               pCtx->pPos++;
+               _skipws( pCtx );
+            }
+            else if( ch == iClose )
+               break;
+            else
+               return HB_FALSE;
+         }
+      }
+      pCtx->pPos++;
+      hb_itemClear( pItem );
+      return _hb_jsonEvent( pCtx, iClose == ']' ? HB_JSON_EV_ARRAYEND : HB_JSON_EV_OBJECTEND, pItem );
+   }
+   else if( ! _hb_jsonDecode( pCtx, pItem ) )
+      return HB_FALSE;
+
+   return _hb_jsonEvent( pCtx, HB_JSON_EV_VALUE, pItem );
+}
+
+static HB_SIZE _hb_jsonDecodeCtx( PHB_JSON_DECODE_CTX pCtx, PHB_ITEM pValue )
+{
+   PHB_ITEM pItem = pValue ? pValue : hb_itemNew( NULL );
+   HB_BOOL fResult;
+
+   _skipws( pCtx );
+   if( pCtx->pEvent )
+   {
+      pCtx->pEventId = hb_itemNew( NULL );
+      fResult = _hb_jsonDecodeEvent( pCtx, pItem, 0 ) || pCtx->fStop;
+      hb_itemRelease( pCtx->pEventId );
+   }
+   else
+      fResult = _hb_jsonDecode( pCtx, pItem );
 
-   pCtx = ( PHB_JSON_ENCODE_CTX ) hb_xgrab( sizeof( HB_JSON_ENCODE_CTX ) );
-   pCtx->nAlloc = 16;
-   pCtx->pHead = pCtx->pBuffer = ( char * ) hb_xgrab( pCtx->nAlloc );
+   if( ! pValue )
+      hb_itemRelease( pItem );
+   if( pCtx->pStr )
+      hb_xfree( pCtx->pStr );
+
+   return fResult ? pCtx->nRead + ( pCtx->pPos - pCtx->pStart ) : 0;
+}
+
+static void _hb_jsonDecodeInit( PHB_JSON_DECODE_CTX pCtx, const char * szSource,
+                                HB_SIZE nLen, PHB_CODEPAGE cdp )
+{
+   memset( pCtx, 0, sizeof( HB_JSON_DECODE_CTX ) );
+   pCtx->pStart = pCtx->pPos = szSource;
+   pCtx->pEnd = szSource + nLen;
+   pCtx->cdp = cdp;
+   pCtx->iDepth = INT_MAX;
+}
+
+/* C level API functions */
+
+static void _hb_jsonEncodeInit( PHB_JSON_ENCODE_CTX pCtx, int iIndent )
+{
    pCtx->nAllocId = 8;
    pCtx->pId = ( void ** ) hb_xgrab( sizeof( void * ) * pCtx->nAllocId );
    pCtx->iIndent = iIndent;
@@ -676,16 +1022,27 @@ char * hb_jsonEncodeCP( PHB_ITEM pValue, HB_SIZE * pnLen, int iIndent, PHB_CODEP
    if( ! pCtx->szEol || ! pCtx->szEol[ 0 ] )
       pCtx->szEol = hb_conNewLine();
    pCtx->iEolLen = ( int ) strlen( pCtx->szEol );
+}
 
-   _hb_jsonEncode( pValue, pCtx, 0, HB_FALSE, cdp );
+char * hb_jsonEncodeCP( PHB_ITEM pValue, HB_SIZE * pnLen, int iIndent, PHB_CODEPAGE cdp )
+{
+   HB_JSON_ENCODE_CTX ctx;
+   char * szRet;
+   HB_SIZE nLen;
+
+   memset( &ctx, 0, sizeof( ctx ) );
+   ctx.nAlloc = 16;
+   ctx.pHead = ctx.pBuffer = ( char * ) hb_xgrab( ctx.nAlloc );
+   _hb_jsonEncodeInit( &ctx, iIndent );
+
+   _hb_jsonEncode( pValue, &ctx, 0, HB_FALSE, cdp );
    if( iIndent )
-      _hb_jsonCtxAdd( pCtx, pCtx->szEol, pCtx->iEolLen );
+      _hb_jsonCtxAdd( &ctx, ctx.szEol, ctx.iEolLen );
 
-   nLen = pCtx->pHead - pCtx->pBuffer;
-   szRet = ( char * ) hb_xrealloc( pCtx->pBuffer, nLen + 1 );
+   nLen = ctx.pHead - ctx.pBuffer;
+   szRet = ( char * ) hb_xrealloc( ctx.pBuffer, nLen + 1 );
    szRet[ nLen ] = '\0';
-   hb_xfree( pCtx->pId );
-   hb_xfree( pCtx );
+   hb_xfree( ctx.pId );
    if( pnLen )
       *pnLen = nLen;
    return szRet;
@@ -696,17 +1053,38 @@ char * hb_jsonEncode( PHB_ITEM pValue, HB_SIZE * pnLen, int iIndent )
    return hb_jsonEncodeCP( pValue, pnLen, iIndent, NULL );
 }
 
+HB_BOOL hb_jsonEncodeStream( PHB_ITEM pValue, PHB_JSON_WRITE_FUNC pWrite, void * cargo,
+                             int iIndent, PHB_CODEPAGE cdp )
+{
+   HB_JSON_ENCODE_CTX ctx;
+
+   memset( &ctx, 0, sizeof( ctx ) );
+   ctx.nAlloc = HB_JSON_BUFSIZE;
+   ctx.pHead = ctx.pBuffer = ( char * ) hb_xgrab( ctx.nAlloc );
+   ctx.pWrite = pWrite;
+   ctx.cargo = cargo;
+   _hb_jsonEncodeInit( &ctx, iIndent );
+
+   _hb_jsonEncode( pValue, &ctx, 0, HB_FALSE, cdp );
+   if( iIndent )
+      _hb_jsonCtxAdd( &ctx, ctx.szEol, ctx.iEolLen );
+   _hb_jsonCtxFlush( &ctx );
+
+   hb_xfree( ctx.pBuffer );
+   hb_xfree( ctx.pId );
+
+   return ! ctx.fError;
+}
+
 HB_SIZE hb_jsonDecodeCP( const char * szSource, PHB_ITEM pValue, PHB_CODEPAGE cdp )
 {
-   PHB_ITEM pItem = pValue ? pValue : hb_itemNew( NULL );
-   const char * sz;
+   HB_JSON_DECODE_CTX ctx;
 
-   sz = szSource ? _hb_jsonDecode( _skipws( szSource ), pItem, cdp ) : NULL;
-   if( ! pValue )
-      hb_itemRelease( pItem );
-   if( sz )
-      return sz - szSource;
-   return 0;
+   if( ! szSource )
+      return 0;
+
+   _hb_jsonDecodeInit( &ctx, szSource, strlen( szSource ), cdp );
+   return _hb_jsonDecodeCtx( &ctx, pValue );
 }
 
 HB_SIZE hb_jsonDecode( const char * szSource, PHB_ITEM pValue )
@@ -714,6 +1092,23 @@ HB_SIZE hb_jsonDecode( const char * szSource, PHB_ITEM pValue )
    return hb_jsonDecodeCP( szSource, pValue, NULL );
 }
 
+HB_SIZE hb_jsonDecodeStream( PHB_JSON_READ_FUNC pRead, void * cargo,
+                             PHB_ITEM pValue, PHB_CODEPAGE cdp )
+{
+   HB_JSON_DECODE_CTX ctx;
+   HB_SIZE nResult;
+
+   _hb_jsonDecodeInit( &ctx, NULL, 0, cdp );
+   ctx.pRead = pRead;
+   ctx.cargo = cargo;
+   ctx.nSize = HB_JSON_BUFSIZE;
+   ctx.pBuffer = ( char * ) hb_xgrab( ctx.nSize );
+   nResult = _hb_jsonDecodeCtx( &ctx, pValue );
+   hb_xfree( ctx.pBuffer );
+
+   return nResult;
+}
+
 /* Harbour level API functions */
 
 static PHB_CODEPAGE _hb_jsonCdpPar( int iParam )
@@ -728,6 +1123,121 @@ static PHB_CODEPAGE _hb_jsonCdpPar( int iParam )
    return NULL;
 }
 
+typedef struct
+{
+   HB_FHANDLE hFile;
+   PHB_FILE   pFile;
+   PHB_SOCKEX pSock;
+   PHB_ITEM   pBlock;
+   PHB_ITEM   pChunk;          /* unread part of data returned by pBlock */
+   HB_SIZE    nChunkPos;
+   HB_BOOL    fRead;           /* hFile was already read */
+   HB_BOOL    fBadHandle;      /* the first read from hFile failed */
+} HB_JSON_IO, * PHB_JSON_IO;
+
+static HB_BOOL _hb_jsonIOParam( PHB_JSON_IO pIO, int iParam )
+{
+   PHB_ITEM pItem = hb_param( iParam, HB_IT_NUMERIC | HB_IT_POINTER | HB_IT_BLOCK );
+
+   memset( pIO, 0, sizeof( HB_JSON_IO ) );
+   pIO->hFile = FS_ERROR;
+
+   if( pItem )
+   {
+      if( HB_IS_NUMERIC( pItem ) )
+         pIO->hFile = hb_numToHandle( hb_itemGetNInt( pItem ) );
+      else if( HB_IS_BLOCK( pItem ) )
+         pIO->pBlock = pItem;
+      else if( ( pIO->pFile = hb_fileItemGet( pItem ) ) == NULL )
+         pIO->pSock = hb_sockexItemGet( pItem );
+   }
+   return pIO->hFile != FS_ERROR || pIO->pBlock || pIO->pFile || pIO->pSock;
+}
+
+static HB_SIZE _hb_jsonIORead( void * cargo, void * buffer, HB_SIZE nSize )
+{
+   PHB_JSON_IO pIO = ( PHB_JSON_IO ) cargo;
+   HB_SIZE nRead = 0;
+
+   if( pIO->pFile )
+      nRead = hb_fileRead( pIO->pFile, buffer, nSize, -1 );
+   else if( pIO->pSock )
+   {
+      long lRead = hb_sockexRead( pIO->pSock, buffer,
+                                  nSize > LONG_MAX ? LONG_MAX : ( long ) nSize, -1 );
+      nRead = lRead > 0 ? ( HB_SIZE ) lRead : 0;
+   }
+   else if( pIO->pBlock )
+   {
+      if( pIO->pChunk == NULL )
+      {
+         PHB_ITEM pSize = hb_itemPutNS( NULL, nSize );
+
+         pIO->pChunk = hb_itemNew( hb_vmEvalBlockV( pIO->pBlock, 1, pSize ) );
+         pIO->nChunkPos = 0;
+         hb_itemRelease( pSize );
+         if( hb_vmRequestQuery() != 0 )
+            hb_itemClear( pIO->pChunk );
+      }
+      nRead = hb_itemGetCLen( pIO->pChunk ) - pIO->nChunkPos;
+      if( nRead > nSize )
+         nRead = nSize;
+      memcpy( buffer, hb_itemGetCPtr( pIO->pChunk ) + pIO->nChunkPos, nRead );
+      pIO->nChunkPos += nRead;
+      if( pIO->nChunkPos >= hb_itemGetCLen( pIO->pChunk ) )
+      {
+         hb_itemRelease( pIO->pChunk );
+         pIO->pChunk = NULL;
+      }
+   }
+   else
+   {
+      nRead = hb_fsReadLarge( pIO->hFile, buffer, nSize );
+      if( ! pIO->fRead && nRead == 0 && hb_fsError() != 0 )
+         pIO->fBadHandle = HB_TRUE;
+      pIO->fRead = HB_TRUE;
+   }
+
+   return nRead == ( HB_SIZE ) FS_ERROR ? 0 : nRead;
+}
+
+static HB_SIZE _hb_jsonIOWrite( void * cargo, const void * buffer, HB_SIZE nSize )
+{
+   PHB_JSON_IO pIO = ( PHB_JSON_IO ) cargo;
+   HB_SIZE nWritten = 0;
+
+   if( pIO->pFile )
+      nWritten = hb_fileWrite( pIO->pFile, buffer, nSize, -1 );
+   else if( pIO->pSock )
+   {
+      const char * data = ( const char * ) buffer;
+
+      while( nWritten < nSize )
+      {
+         HB_SIZE nPart = nSize - nWritten;
+         long lSent = hb_sockexWrite( pIO->pSock, data + nWritten,
+                                      nPart > LONG_MAX ? LONG_MAX : ( long ) nPart, -1 );
+         if( lSent <= 0 )
+            break;
+         nWritten += lSent;
+      }
+   }
+   else if( pIO->pBlock )
+   {
+      PHB_ITEM pData = hb_itemPutCL( NULL, ( const char * ) buffer, nSize );
+      PHB_ITEM pResult = hb_vmEvalBlockV( pIO->pBlock, 1, pData );
+
+      hb_itemRelease( pData );
+      if( hb_vmRequestQuery() == 0 &&
+          ! ( HB_IS_LOGICAL( pResult ) && ! hb_itemGetL( pResult ) ) )
+         nWritten = nSize;
+   }
+   else
+      nWritten = hb_fsWriteLarge( pIO->hFile, buffer, nSize );
+
+   return nWritten;
+}
+
 HB_FUNC( HB_JSONENCODE )
 {
    PHB_ITEM pItem = hb_param( 1, HB_IT_ANY );
@@ -744,7 +1254,15 @@ HB_FUNC( HB_JSONENCODE )
 HB_FUNC( HB_JSONDECODE )
 {
    PHB_ITEM pItem = hb_itemNew( NULL );
-   HB_SIZE nSize = hb_jsonDecodeCP( hb_parc( 1 ), pItem, _hb_jsonCdpPar( 3 ) );
+   HB_SIZE nSize = 0;
+
+   if( HB_ISCHAR( 1 ) )
+   {
+      HB_JSON_DECODE_CTX ctx;
+
+      _hb_jsonDecodeInit( &ctx, hb_parc( 1 ), hb_parclen( 1 ), _hb_jsonCdpPar( 3 ) );
+      nSize = _hb_jsonDecodeCtx( &ctx, pItem );
+   }
 
    if( HB_ISBYREF( 2 ) )
    {
@@ -755,3 +1273,71 @@ HB_FUNC( HB_JSONDECODE )
    else
       hb_itemReturnRelease( pItem );
 }
+
+/* hb_jsonEncodeStream( xValue, <nHandle | pFile | pSocket | bWrite>,
+                        [ lHuman = .F. | nIndent = 0 ], [ cCdp ] ) --> lSuccess */
+HB_FUNC( HB_JSONENCODESTREAM )
+{
+   PHB_ITEM pItem = hb_param( 1, HB_IT_ANY );
+   HB_JSON_IO io;
+
+   if( pItem && _hb_jsonIOParam( &io, 2 ) )
+   {
+      int iIndent = hb_parl( 3 ) ? INDENT_SIZE : hb_parni( 3 );
+      HB_BOOL fResult = hb_jsonEncodeStream( pItem, _hb_jsonIOWrite, &io,
+                                             iIndent, _hb_jsonCdpPar( 4 ) );
+      if( fResult && io.pSock )
+         hb_sockexFlush( io.pSock, -1, HB_FALSE );
+      hb_retl( fResult );
+   }
+   else
+      hb_errRT_BASE_SubstR( EG_ARG, 3012, NULL, HB_ERR_FUNCNAME, HB_ERR_ARGS_BASEPARAMS );
+}
+
+/* hb_jsonDecodeStream( <cJSON | nHandle | pFile | pSocket | bRead>,
+                        [ @xValue ], [ bEvent ], [ nDepth ], [ cCdp ] ) --> nLengthDecoded */
+HB_FUNC( HB_JSONDECODESTREAM )
+{
+   HB_JSON_DECODE_CTX ctx;
+   HB_JSON_IO io;
+   HB_BOOL fString = HB_ISCHAR( 1 );
+
+   if( fString || _hb_jsonIOParam( &io, 1 ) )
+   {
+      PHB_ITEM pItem = hb_itemNew( NULL );
+      HB_SIZE nSize;
+
+      if( fString )
+         _hb_jsonDecodeInit( &ctx, hb_parc( 1 ), hb_parclen( 1 ), _hb_jsonCdpPar( 5 ) );
+      else
+      {
+         _hb_jsonDecodeInit( &ctx, NULL, 0, _hb_jsonCdpPar( 5 ) );
+         ctx.pRead = _hb_jsonIORead;
+         ctx.cargo = &io;
+         ctx.nSize = HB_JSON_BUFSIZE;
+         ctx.pBuffer = ( char * ) hb_xgrab( ctx.nSize );
+      }
+      ctx.pEvent = hb_param( 3, HB_IT_BLOCK );
+      if( HB_ISNUM( 4 ) && hb_parni( 4 ) >= 0 )
+         ctx.iDepth = hb_parni( 4 );
+
+      nSize = _hb_jsonDecodeCtx( &ctx, pItem );
+
+      if( ctx.pBuffer )
+         hb_xfree( ctx.pBuffer );
+      if( ! fString && io.pChunk )
+         hb_itemRelease( io.pChunk );
+
+      if( ! fString && io.fBadHandle )
+         hb_errRT_BASE_SubstR( EG_ARG, 3012, NULL, HB_ERR_FUNCNAME, HB_ERR_ARGS_BASEPARAMS );
+      else
+      {
+         hb_retns( ( HB_ISIZ ) nSize );
+         if( ctx.pEvent == NULL )
+            hb_itemParamStoreForward( 2, pItem );
+      }
+      hb_itemRelease( pItem );
+   }
+   else
+      hb_errRT_BASE_SubstR( EG_ARG, 3012, NULL, HB_ERR_FUNCNAME, HB_ERR_ARGS_BASEPARAMS );
+}
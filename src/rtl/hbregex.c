@@ -54,6 +54,7 @@
 #include "hbinit.h"
 #if defined( HB_HAS_PCRE2 )
 #include "hbvm.h"
+#include "hbstack.h"
 #endif
 
 #if defined( HB_HAS_PCRE ) || defined( HB_HAS_PCRE2 )
@@ -64,6 +65,58 @@
    static pcre2_general_context * s_re_ctxg;
    static pcre2_compile_context * s_re_ctxc;
    static pcre2_match_context *   s_re_ctxm;
+   static int s_iJITEnabled;
+
+/* JIT stack size limits */
+#ifndef HB_PCRE2_JIT_STACK_MIN
+#define HB_PCRE2_JIT_STACK_MIN   0x8000
+#endif
+#ifndef HB_PCRE2_JIT_STACK_MAX
+#define HB_PCRE2_JIT_STACK_MAX   0x100000
+#endif
+
+/* JIT code cannot share stack between threads so each thread
+   has its own JIT stack and match context with this stack assigned */
+typedef struct
+{
+   pcre2_jit_stack *     pJITStack;
+   pcre2_match_context * pCtxM;
+} HB_PCRE2TSD, * PHB_PCRE2TSD;
+
+static void hb_pcre2TSDRelease( void * cargo )
+{
+   PHB_PCRE2TSD pTSD = ( PHB_PCRE2TSD ) cargo;
+
+   if( pTSD->pCtxM )
+      pcre2_match_context_free( pTSD->pCtxM );
+   if( pTSD->pJITStack )
+      pcre2_jit_stack_free( pTSD->pJITStack );
+}
+
+static HB_TSD_NEW( s_pcre2TSD, sizeof( HB_PCRE2TSD ), NULL, hb_pcre2TSDRelease );
+
+static pcre2_match_context * hb_pcre2MatchContext( void )
+{
+   PHB_PCRE2TSD pTSD;
+
+   if( ! s_iJITEnabled )
+      return s_re_ctxm;
+
+   pTSD = ( PHB_PCRE2TSD ) hb_stackGetTSD( &s_pcre2TSD );
+   if( pTSD->pCtxM == NULL )
+   {
+      pTSD->pCtxM = pcre2_match_context_copy( s_re_ctxm );
+      if( pTSD->pCtxM == NULL )
+         return s_re_ctxm;
+      pTSD->pJITStack = pcre2_jit_stack_create( HB_PCRE2_JIT_STACK_MIN,
+                                                HB_PCRE2_JIT_STACK_MAX,
+                                                s_re_ctxg );
+      if( pTSD->pJITStack )
+         pcre2_jit_stack_assign( pTSD->pCtxM, NULL, pTSD->pJITStack );
+   }
+
+   return pTSD->pCtxM;
+}
 #endif
 
 static void hb_regfree( PHB_REGEX pRegEx )
@@ -100,6 +153,10 @@ static int hb_regcomp( PHB_REGEX pRegEx, const char * szRegEx )
                                     uiCFlags,
                                     &iError,
                                     &iErrOffset, s_re_ctxc );
+   /* pcre2_match() uses JIT code when available, if JIT compilation
+      fails (i.e. unsupported pattern) interpreter is used */
+   if( pRegEx->re_pcre && s_iJITEnabled )
+      pcre2_jit_compile( pRegEx->re_pcre, PCRE2_JIT_COMPLETE );
    return pRegEx->re_pcre ? 0 : -1;
 #elif defined( HB_HAS_PCRE )
    const unsigned char * pCharTable = NULL;
@@ -143,7 +200,7 @@ static int hb_regexec( PHB_REGEX pRegEx, const char * szString, HB_SIZE nLen,
                                      ( PCRE2_SIZE ) nLen,
                                      ( PCRE2_SIZE ) 0 /* startoffset */,
                                      ( HB_U32 ) pRegEx->iEFlags,
-                                     aMatches, s_re_ctxm );
+                                     aMatches, hb_pcre2MatchContext() );
    if( iResult == 0 )
    {
       PCRE2_SIZE i;
@@ -252,7 +309,7 @@ HB_FUNC( HB_ATX )
          if( nLen && nStart <= nLen && nStart <= nEnd )
          {
 #if defined( HB_HAS_PCRE2 )
-            HB_REGMATCH * aMatches = pcre2_match_data_create( 1, NULL );
+            HB_REGMATCH * aMatches = hb_regexMatchDataGet();
 
             if( aMatches )
             {
@@ -280,7 +337,7 @@ HB_FUNC( HB_ATX )
                   nStart = nLen = 0;
 
 #if defined( HB_HAS_PCRE2 )
-               pcre2_match_data_free( aMatches );
+               hb_regexMatchDataPut( aMatches );
             }
             else
                nStart = nLen = 0;
@@ -331,9 +388,12 @@ static HB_BOOL hb_regex( int iRequest )
       return HB_FALSE;
 
 #if defined( HB_HAS_PCRE2 )
-   aMatches = pcre2_match_data_create( REGEX_MAX_GROUPS, NULL );
+   aMatches = hb_regexMatchDataGet();
    if( ! aMatches )
+   {
+      hb_regexFree( pRegEx );
       return HB_FALSE;
+   }
 #endif
 
    pszString = hb_itemGetCPtr( pString );
@@ -540,7 +600,7 @@ static HB_BOOL hb_regex( int iRequest )
    }
 
 #if defined( HB_HAS_PCRE2 )
-   pcre2_match_data_free( aMatches );
+   hb_regexMatchDataPut( aMatches );
 #endif
 
    hb_regexFree( pRegEx );
@@ -650,6 +710,9 @@ HB_CALL_ON_STARTUP_BEGIN( _hb_regex_init_ )
    /* detect UTF-8 support. */
    if( pcre2_config( PCRE2_CONFIG_UNICODE, &s_iUTF8Enabled ) != 0 )
       s_iUTF8Enabled = 0;
+   /* detect JIT support, it's not available in bundled PCRE2 */
+   if( pcre2_config( PCRE2_CONFIG_JIT, &s_iJITEnabled ) != 0 )
+      s_iJITEnabled = 0;
 
    s_re_ctxg = pcre2_general_context_create( hb_pcre2_grab, hb_pcre2_free, NULL );
    s_re_ctxc = pcre2_compile_context_create( s_re_ctxg );
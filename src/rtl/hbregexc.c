@@ -49,6 +49,83 @@
 #include "hbregex.h"
 #include "hbapiitm.h"
 #include "hbapierr.h"
+#include "hbapicdp.h"
+#include "hbstack.h"
+#include "hbthread.h"
+#include "hbvm.h"
+
+/* number of compiled patterns passed as strings kept in cache */
+#ifndef HB_REGEX_CACHE_SIZE
+#define HB_REGEX_CACHE_SIZE   64
+#endif
+
+/* internal flag used in cache key, compiled pattern depends on HVM CP */
+#define HBREG_CACHE_UTF8      0x10000
+
+typedef struct
+{
+   char *      szRegEx;
+   HB_SIZE     nLen;
+   int         iFlags;
+   HB_U32      uiHash;
+   HB_MAXUINT  nTick;
+   PHB_REGEX   pRegEx;
+} HB_REGEX_CACHE, * PHB_REGEX_CACHE;
+
+static HB_CRITICAL_NEW( s_regexMtx );
+static HB_REGEX_CACHE s_regexCache[ HB_REGEX_CACHE_SIZE ];
+static HB_MAXUINT s_nRegexTick = 0;
+static HB_BOOL s_fRegexCacheInit = HB_FALSE;
+
+#if defined( HB_HAS_PCRE2 )
+
+/* match data buffer reused by all regex calls in given thread */
+typedef struct
+{
+   HB_REGMATCH * aMatches;
+   HB_BOOL       fUsed;
+} HB_REGEXTSD, * PHB_REGEXTSD;
+
+static void hb_regexTSDRelease( void * cargo )
+{
+   PHB_REGEXTSD pTSD = ( PHB_REGEXTSD ) cargo;
+
+   if( pTSD->aMatches )
+   {
+      pcre2_match_data_free( pTSD->aMatches );
+      pTSD->aMatches = NULL;
+   }
+}
+
+static HB_TSD_NEW( s_regexTSD, sizeof( HB_REGEXTSD ), NULL, hb_regexTSDRelease );
+
+HB_REGMATCH * hb_regexMatchDataGet( void )
+{
+   PHB_REGEXTSD pTSD = ( PHB_REGEXTSD ) hb_stackGetTSD( &s_regexTSD );
+
+   if( pTSD->fUsed )
+      /* nested call, should not happen but be safe */
+      return pcre2_match_data_create( REGEX_MAX_GROUPS, NULL );
+
+   if( ! pTSD->aMatches )
+      pTSD->aMatches = pcre2_match_data_create( REGEX_MAX_GROUPS, NULL );
+   if( pTSD->aMatches )
+      pTSD->fUsed = HB_TRUE;
+
+   return pTSD->aMatches;
+}
+
+void hb_regexMatchDataPut( HB_REGMATCH * aMatches )
+{
+   PHB_REGEXTSD pTSD = ( PHB_REGEXTSD ) hb_stackGetTSD( &s_regexTSD );
+
+   if( aMatches == pTSD->aMatches )
+      pTSD->fUsed = HB_FALSE;
+   else if( aMatches )
+      pcre2_match_data_free( aMatches );
+}
+
+#endif
 
 static void hb_regfree( PHB_REGEX pRegEx )
 {
@@ -121,6 +198,126 @@ PHB_REGEX hb_regexCompile( const char * szRegEx, HB_SIZE nLen, int iFlags )
    return pRegEx;
 }
 
+static void hb_regexCacheRelease( void * cargo )
+{
+   int i;
+
+   HB_SYMBOL_UNUSED( cargo );
+
+   hb_threadEnterCriticalSection( &s_regexMtx );
+   for( i = 0; i < HB_REGEX_CACHE_SIZE; ++i )
+   {
+      PHB_REGEX_CACHE pEntry = &s_regexCache[ i ];
+
+      if( pEntry->pRegEx )
+      {
+         hb_gcRefFree( pEntry->pRegEx );
+         hb_xfree( pEntry->szRegEx );
+         memset( pEntry, 0, sizeof( *pEntry ) );
+      }
+   }
+   s_fRegexCacheInit = HB_FALSE;
+   hb_threadLeaveCriticalSection( &s_regexMtx );
+}
+
+/* Find pattern in cache and return it with new reference or set
+   *ppFree to empty or least recently used entry. Must be called
+   with s_regexMtx locked */
+static PHB_REGEX hb_regexCacheFind( const char * szRegEx, HB_SIZE nLen,
+                                    int iKey, HB_U32 uiHash,
+                                    PHB_REGEX_CACHE * ppFree )
+{
+   PHB_REGEX_CACHE pFree = NULL;
+   int i;
+
+   for( i = 0; i < HB_REGEX_CACHE_SIZE; ++i )
+   {
+      PHB_REGEX_CACHE pEntry = &s_regexCache[ i ];
+
+      if( pEntry->pRegEx == NULL )
+      {
+         if( pFree == NULL || pFree->pRegEx )
+            pFree = pEntry;
+      }
+      else if( pEntry->uiHash == uiHash && pEntry->iFlags == iKey &&
+               pEntry->nLen == nLen &&
+               memcmp( pEntry->szRegEx, szRegEx, nLen ) == 0 )
+      {
+         pEntry->nTick = ++s_nRegexTick;
+         hb_gcRefInc( pEntry->pRegEx );
+         return pEntry->pRegEx;
+      }
+      else if( pFree == NULL || ( pFree->pRegEx && pEntry->nTick < pFree->nTick ) )
+         pFree = pEntry;
+   }
+   *ppFree = pFree;
+
+   return NULL;
+}
+
+/* Compile regular expression passed as string using cache of recently
+   used patterns. Cached regex is shared between threads and has
+   additional reference which is released by hb_regexFree() */
+static PHB_REGEX hb_regexCompileCached( const char * szRegEx, HB_SIZE nLen, int iFlags )
+{
+   PHB_REGEX_CACHE pFree;
+   PHB_REGEX pRegEx, pCached;
+   int iKey = iFlags | ( hb_cdpIsUTF8( NULL ) ? HBREG_CACHE_UTF8 : 0 );
+   HB_U32 uiHash = 2166136261U;
+   HB_SIZE n;
+
+   for( n = 0; n < nLen; ++n )
+      uiHash = ( uiHash ^ ( HB_UCHAR ) szRegEx[ n ] ) * 16777619U;
+
+   hb_threadEnterCriticalSection( &s_regexMtx );
+   pRegEx = hb_regexCacheFind( szRegEx, nLen, iKey, uiHash, &pFree );
+   hb_threadLeaveCriticalSection( &s_regexMtx );
+
+   if( pRegEx == NULL )
+   {
+      /* compile outside of lock, other thread could do the same
+         in the meantime so check the cache again before storing */
+      pRegEx = hb_regexCompile( szRegEx, nLen, iFlags );
+      if( pRegEx )
+      {
+         hb_threadEnterCriticalSection( &s_regexMtx );
+         pCached = hb_regexCacheFind( szRegEx, nLen, iKey, uiHash, &pFree );
+         if( pCached == NULL )
+         {
+            if( ! s_fRegexCacheInit )
+            {
+               s_fRegexCacheInit = HB_TRUE;
+               hb_vmAtQuit( hb_regexCacheRelease, NULL );
+            }
+            if( pFree->pRegEx )
+            {
+               hb_gcRefFree( pFree->pRegEx );
+               hb_xfree( pFree->szRegEx );
+            }
+            pRegEx->fCached = HB_TRUE;
+            hb_gcRefInc( pRegEx );
+            pFree->szRegEx = ( char * ) hb_xgrab( nLen + 1 );
+            memcpy( pFree->szRegEx, szRegEx, nLen );
+            pFree->szRegEx[ nLen ] = '\0';
+            pFree->nLen = nLen;
+            pFree->iFlags = iKey;
+            pFree->uiHash = uiHash;
+            pFree->nTick = ++s_nRegexTick;
+            pFree->pRegEx = pRegEx;
+         }
+         hb_threadLeaveCriticalSection( &s_regexMtx );
+
+         if( pCached )
+         {
+            hb_regexFree( pRegEx );
+            pRegEx = pCached;
+         }
+      }
+   }
+
+   return pRegEx;
+}
+
 PHB_REGEX hb_regexGet( PHB_ITEM pRegExItm, int iFlags )
 {
    PHB_REGEX pRegEx = NULL;
@@ -141,7 +338,7 @@ PHB_REGEX hb_regexGet( PHB_ITEM pRegExItm, int iFlags )
          if( nLen > 0 )
          {
             fArgError = HB_FALSE;
-            pRegEx = hb_regexCompile( szRegEx, nLen, iFlags );
+            pRegEx = hb_regexCompileCached( szRegEx, nLen, iFlags );
          }
       }
    }
@@ -156,7 +353,9 @@ PHB_REGEX hb_regexGet( PHB_ITEM pRegExItm, int iFlags )
 
 void hb_regexFree( PHB_REGEX pRegEx )
 {
-   if( pRegEx && pRegEx->fFree )
+   if( pRegEx && pRegEx->fCached )
+      hb_gcRefFree( pRegEx );
+   else if( pRegEx && pRegEx->fFree )
    {
       ( s_reg_free )( pRegEx );
       hb_gcFree( pRegEx );
@@ -166,19 +365,24 @@ void hb_regexFree( PHB_REGEX pRegEx )
 HB_BOOL hb_regexMatch( PHB_REGEX pRegEx, const char * szString, HB_SIZE nLen, HB_BOOL fFull )
 {
 #if defined( HB_HAS_PCRE2 )
-   HB_REGMATCH * aMatches = pcre2_match_data_create( 1, NULL );
+   HB_REGMATCH * aMatches = hb_regexMatchDataGet();
 #else
    HB_REGMATCH aMatches[ HB_REGMATCH_SIZE( 1 ) ];
 #endif
    HB_BOOL fMatch;
 
+#if defined( HB_HAS_PCRE2 )
+   if( ! aMatches )
+      return HB_FALSE;
+#endif
+
    fMatch = ( s_reg_exec )( pRegEx, szString, nLen, 1, aMatches ) > 0;
    fMatch = fMatch && ( ! fFull ||
             ( HB_REGMATCH_SO( aMatches, 0 ) == 0 &&
               ( HB_SIZE ) HB_REGMATCH_EO( aMatches, 0 ) == nLen ) );
 
 #if defined( HB_HAS_PCRE2 )
-   pcre2_match_data_free( aMatches );
+   hb_regexMatchDataPut( aMatches );
 #endif
 
    return fMatch;
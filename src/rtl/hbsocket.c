@@ -84,6 +84,12 @@
    platform supports poll() function:
       #define HB_HAS_POLL
 
+   platform supports epoll_create()/epoll_ctl()/epoll_wait() functions:
+      #define HB_HAS_EPOLL
+
+   platform supports sendfile() function sending file data to socket:
+      #define HB_HAS_SENDFILE
+
    platform uses sockaddr structure which contains sa_len member:
       #define HB_HAS_SOCKADDR_SA_LEN
 
@@ -148,6 +154,12 @@
 #  endif
 #  if defined( HB_OS_LINUX )
 #     define HB_HAS_SELECT_TIMER
+#     if ! defined( __WATCOMC__ ) && ! defined( HB_NO_EPOLL )
+#        define HB_HAS_EPOLL
+#     endif
+#     if ! defined( __WATCOMC__ ) && ! defined( HB_NO_SENDFILE )
+#        define HB_HAS_SENDFILE
+#     endif
 #     if defined( HB_CPU_MIPS )
 #        define HB_SOCKET_TRANSLATE_TYPE
 #     endif
@@ -266,6 +278,12 @@
 #  if defined( HB_HAS_POLL )
 #     include <poll.h>
 #  endif
+#  if defined( HB_HAS_EPOLL )
+#     include <sys/epoll.h>
+#  endif
+#  if defined( HB_HAS_SENDFILE )
+#     include <sys/sendfile.h>
+#  endif
 #  include <netinet/tcp.h>
 #  if ! ( defined( HB_OS_LINUX ) && defined( __WATCOMC__ ) )
 #     include <net/if.h>
@@ -325,6 +343,7 @@
 #include "hbstack.h"
 #include "hbthread.h"
 #include "hbdate.h"
+#include "hbapifs.h"
 
 /* TODO change error description to something more user friendly */
 static const char * s_socketErrors[] = {
@@ -595,6 +614,17 @@ long hb_socketSend( HB_SOCKET sd, const void * data, long len, int flags, HB_MAX
    return -1;
 }
 
+long hb_socketSendFile( HB_SOCKET sd, HB_FHANDLE hFile, HB_FOFFSET nOffset, long len, HB_MAXINT timeout )
+{
+   HB_SYMBOL_UNUSED( sd );
+   HB_SYMBOL_UNUSED( hFile );
+   HB_SYMBOL_UNUSED( nOffset );
+   HB_SYMBOL_UNUSED( len );
+   HB_SYMBOL_UNUSED( timeout );
+   hb_socketSetError( HB_SOCKET_ERR_INVALIDHANDLE );
+   return -1;
+}
+
 long hb_socketSendTo( HB_SOCKET sd, const void * data, long len, int flags, const void * pSockAddr, unsigned uiSockLen, HB_MAXINT timeout )
 {
    HB_SYMBOL_UNUSED( sd );
@@ -763,6 +793,53 @@ int hb_socketSelect( PHB_ITEM pArrayRD, HB_BOOL fSetRD,
    return -1;
 }
 
+PHB_SOCKET_POLL hb_socketPollNew( void )
+{
+   hb_socketSetError( HB_SOCKET_ERR_NOSUPPORT );
+   return NULL;
+}
+
+void hb_socketPollFree( PHB_SOCKET_POLL pPoll )
+{
+   HB_SYMBOL_UNUSED( pPoll );
+}
+
+int hb_socketPollAdd( PHB_SOCKET_POLL pPoll, HB_SOCKET sd, int iEvents )
+{
+   HB_SYMBOL_UNUSED( pPoll );
+   HB_SYMBOL_UNUSED( sd );
+   HB_SYMBOL_UNUSED( iEvents );
+   hb_socketSetError( HB_SOCKET_ERR_NOSUPPORT );
+   return -1;
+}
+
+int hb_socketPollMod( PHB_SOCKET_POLL pPoll, HB_SOCKET sd, int iEvents )
+{
+   HB_SYMBOL_UNUSED( pPoll );
+   HB_SYMBOL_UNUSED( sd );
+   HB_SYMBOL_UNUSED( iEvents );
+   hb_socketSetError( HB_SOCKET_ERR_NOSUPPORT );
+   return -1;
+}
+
+int hb_socketPollDel( PHB_SOCKET_POLL pPoll, HB_SOCKET sd )
+{
+   HB_SYMBOL_UNUSED( pPoll );
+   HB_SYMBOL_UNUSED( sd );
+   hb_socketSetError( HB_SOCKET_ERR_NOSUPPORT );
+   return -1;
+}
+
+int hb_socketPollWait( PHB_SOCKET_POLL pPoll, PHB_SOCKET_POLLFD pEvents, int iMax, HB_MAXINT timeout )
+{
+   HB_SYMBOL_UNUSED( pPoll );
+   HB_SYMBOL_UNUSED( pEvents );
+   HB_SYMBOL_UNUSED( iMax );
+   HB_SYMBOL_UNUSED( timeout );
+   hb_socketSetError( HB_SOCKET_ERR_NOSUPPORT );
+   return -1;
+}
+
 HB_BOOL hb_socketResolveInetAddr( void ** pSockAddr, unsigned * puiLen, const char * szAddr, int iPort )
 {
    HB_SYMBOL_UNUSED( szAddr );
@@ -2641,6 +2718,67 @@ long hb_socketSend( HB_SOCKET sd, const void * data, long len, int flags, HB_MAX
    return lSent;
 }
 
+/* send file contents starting from given offset without copying
+   them to user space when platform supports it, returns number of
+   bytes sent which can be smaller then requested */
+long hb_socketSendFile( HB_SOCKET sd, HB_FHANDLE hFile, HB_FOFFSET nOffset,
+                        long len, HB_MAXINT timeout )
+{
+#if defined( HB_HAS_SENDFILE )
+   long lSent = 0;
+
+   hb_vmUnlock();
+
+   if( timeout >= 0 )
+   {
+      lSent = hb_socketSelectWR( sd, timeout );
+      if( lSent == 0 )
+      {
+         hb_socketSetError( HB_SOCKET_ERR_TIMEOUT );
+         lSent = -1;
+      }
+   }
+   if( lSent >= 0 )
+   {
+      off_t offset = ( off_t ) nOffset;
+      int iError;
+
+      do
+      {
+         lSent = ( long ) sendfile( sd, ( int ) hFile, &offset, ( size_t ) len );
+         iError = lSent >= 0 ? 0 : HB_SOCK_GETERROR();
+         hb_socketSetOsError( iError );
+      }
+      while( lSent == -1 && HB_SOCK_IS_EINTR( iError ) &&
+             hb_vmRequestQuery() == 0 );
+   }
+   hb_vmLock();
+
+   return lSent;
+#else
+   long lSent = 0;
+   HB_SIZE nRead;
+   void * buffer;
+
+   if( len > 0x10000 )
+      len = 0x10000;
+   buffer = hb_xgrab( len );
+   nRead = hb_fsReadAt( hFile, buffer, len, nOffset );
+   if( nRead == ( HB_SIZE ) FS_ERROR )
+   {
+      hb_socketSetError( HB_SOCKET_ERR_INVAL );
+      lSent = -1;
+   }
+   else if( nRead > 0 )
+      lSent = hb_socketSend( sd, buffer, ( long ) nRead, 0, timeout );
+   else
+      hb_socketSetError( HB_SOCKET_ERR_NONE );
+   hb_xfree( buffer );
+
+   return lSent;
+#endif
+}
+
 long hb_socketSendTo( HB_SOCKET sd, const void * data, long len, int flags,
                       const void * pSockAddr, unsigned uiSockLen, HB_MAXINT timeout )
 {
@@ -3298,6 +3436,454 @@ int hb_socketSelect( PHB_ITEM pArrayRD, HB_BOOL fSetRD,
 #endif /* ! HB_HAS_POLL */
 }
 
+/* persistent socket event multiplexer */
+
+#if defined( HB_HAS_EPOLL )
+
+typedef struct _HB_SOCKET_POLL
+{
+   int epfd;
+}
+HB_SOCKET_POLL;
+
+static unsigned int hb_socketPollToEpoll( int iEvents )
+{
+   unsigned int uiEvents = 0;
+
+   if( iEvents & HB_SOCKET_POLL_READ )
+      uiEvents |= EPOLLIN;
+   if( iEvents & HB_SOCKET_POLL_WRITE )
+      uiEvents |= EPOLLOUT;
+   if( iEvents & HB_SOCKET_POLL_PRI )
+      uiEvents |= EPOLLPRI;
+   if( iEvents & HB_SOCKET_POLL_ONESHOT )
+      uiEvents |= EPOLLONESHOT;
+
+   return uiEvents;
+}
+
+static int hb_socketPollFromEpoll( unsigned int uiEvents )
+{
+   int iEvents = 0;
+
+   if( uiEvents & EPOLLIN )
+      iEvents |= HB_SOCKET_POLL_READ;
+   if( uiEvents & EPOLLOUT )
+      iEvents |= HB_SOCKET_POLL_WRITE;
+   if( uiEvents & EPOLLPRI )
+      iEvents |= HB_SOCKET_POLL_PRI;
+   if( uiEvents & EPOLLERR )
+      iEvents |= HB_SOCKET_POLL_ERROR;
+   if( uiEvents & EPOLLHUP )
+      iEvents |= HB_SOCKET_POLL_HUP;
+
+   return iEvents;
+}
+
+static int hb_socketPollCtl( PHB_SOCKET_POLL pPoll, int iOper, HB_SOCKET sd, int iEvents )
+{
+   struct epoll_event event;
+   int ret;
+
+   memset( &event, 0, sizeof( event ) );
+   event.events = hb_socketPollToEpoll( iEvents );
+   event.data.fd = sd;
+
+   ret = epoll_ctl( pPoll->epfd, iOper, sd, &event );
+   hb_socketSetOsError( ret == -1 ? HB_SOCK_GETERROR() : 0 );
+
+   return ret;
+}
+
+PHB_SOCKET_POLL hb_socketPollNew( void )
+{
+   PHB_SOCKET_POLL pPoll = NULL;
+   int epfd;
+
+#  if defined( EPOLL_CLOEXEC )
+   epfd = epoll_create1( EPOLL_CLOEXEC );
+#  else
+   epfd = epoll_create( 256 );
+#  endif
+   hb_socketSetOsError( epfd == -1 ? HB_SOCK_GETERROR() : 0 );
+
+   if( epfd != -1 )
+   {
+      pPoll = ( PHB_SOCKET_POLL ) hb_xgrabz( sizeof( HB_SOCKET_POLL ) );
+      pPoll->epfd = epfd;
+   }
+
+   return pPoll;
+}
+
+void hb_socketPollFree( PHB_SOCKET_POLL pPoll )
+{
+   close( pPoll->epfd );
+   hb_xfree( pPoll );
+}
+
+int hb_socketPollAdd( PHB_SOCKET_POLL pPoll, HB_SOCKET sd, int iEvents )
+{
+   return hb_socketPollCtl( pPoll, EPOLL_CTL_ADD, sd, iEvents );
+}
+
+int hb_socketPollMod( PHB_SOCKET_POLL pPoll, HB_SOCKET sd, int iEvents )
+{
+   return hb_socketPollCtl( pPoll, EPOLL_CTL_MOD, sd, iEvents );
+}
+
+int hb_socketPollDel( PHB_SOCKET_POLL pPoll, HB_SOCKET sd )
+{
+   return hb_socketPollCtl( pPoll, EPOLL_CTL_DEL, sd, 0 );
+}
+
+int hb_socketPollWait( PHB_SOCKET_POLL pPoll, PHB_SOCKET_POLLFD pEvents, int iMax, HB_MAXINT timeout )
+{
+   struct epoll_event * pEpEvents;
+   HB_MAXUINT timer;
+   int iResult, iError, i;
+
+   if( iMax <= 0 )
+   {
+      hb_socketSetError( HB_SOCKET_ERR_PARAMVALUE );
+      return -1;
+   }
+
+   pEpEvents = ( struct epoll_event * ) hb_xgrab( iMax * sizeof( struct epoll_event ) );
+   timer = hb_timerInit( timeout );
+
+   hb_vmUnlock();
+   do
+   {
+      int tout = timeout < 0 || timeout > 1000 ? 1000 : ( int ) timeout;
+      iResult = epoll_wait( pPoll->epfd, pEpEvents, iMax, tout );
+      iError = iResult >= 0 ? 0 : HB_SOCK_GETERROR();
+      hb_socketSetOsError( iError );
+      if( iResult == -1 && HB_SOCK_IS_EINTR( iError ) )
+         iResult = 0;
+   }
+   while( iResult == 0 && ( timeout = hb_timerTest( timeout, &timer ) ) != 0 &&
+          hb_vmRequestQuery() == 0 );
+   hb_vmLock();
+
+   for( i = 0; i < iResult; ++i )
+   {
+      pEvents[ i ].sd = pEpEvents[ i ].data.fd;
+      pEvents[ i ].events = hb_socketPollFromEpoll( pEpEvents[ i ].events );
+   }
+   hb_xfree( pEpEvents );
+
+   return iResult;
+}
+
+#else /* ! HB_HAS_EPOLL */
+
+/* generic implementation, the registered sockets are kept in
+   an array sorted by socket handle and the poll()/select() set is
+   refreshed from it before each wait slice */
+
+typedef struct _HB_SOCKET_POLL
+{
+   PHB_SOCKET_POLLFD pFDs;
+   int               iCount;
+   int               iSize;
+   int               iNext;
+}
+HB_SOCKET_POLL;
+
+#define HB_SOCKPOLL_LOCK()      hb_threadEnterCriticalSection( &s_pollMtx )
+#define HB_SOCKPOLL_UNLOCK()    hb_threadLeaveCriticalSection( &s_pollMtx )
+static HB_CRITICAL_NEW( s_pollMtx );
+
+static HB_BOOL hb_socketPollFind( PHB_SOCKET_POLL pPoll, HB_SOCKET sd, int * piPos )
+{
+   int iFirst = 0, iLast = pPoll->iCount;
+
+   while( iFirst < iLast )
+   {
+      int iMiddle = ( iFirst + iLast ) >> 1;
+
+      if( pPoll->pFDs[ iMiddle ].sd < sd )
+         iFirst = iMiddle + 1;
+      else
+         iLast = iMiddle;
+   }
+   *piPos = iFirst;
+
+   return iFirst < pPoll->iCount && pPoll->pFDs[ iFirst ].sd == sd;
+}
+
+PHB_SOCKET_POLL hb_socketPollNew( void )
+{
+   hb_socketSetError( 0 );
+   return ( PHB_SOCKET_POLL ) hb_xgrabz( sizeof( HB_SOCKET_POLL ) );
+}
+
+void hb_socketPollFree( PHB_SOCKET_POLL pPoll )
+{
+   if( pPoll->pFDs )
+      hb_xfree( pPoll->pFDs );
+   hb_xfree( pPoll );
+}
+
+int hb_socketPollAdd( PHB_SOCKET_POLL pPoll, HB_SOCKET sd, int iEvents )
+{
+   int iPos, iResult = -1;
+
+   if( sd == HB_NO_SOCKET )
+      hb_socketSetError( HB_SOCKET_ERR_INVALIDHANDLE );
+   else
+   {
+      HB_SOCKPOLL_LOCK();
+      if( hb_socketPollFind( pPoll, sd, &iPos ) )
+         hb_socketSetError( HB_SOCKET_ERR_PARAMVALUE );
+      else
+      {
+         if( pPoll->iCount == pPoll->iSize )
+         {
+            pPoll->iSize += pPoll->iSize >> 1 > 16 ? pPoll->iSize >> 1 : 16;
+            pPoll->pFDs = ( PHB_SOCKET_POLLFD ) hb_xrealloc( pPoll->pFDs,
+                                 pPoll->iSize * sizeof( HB_SOCKET_POLLFD ) );
+         }
+         if( iPos < pPoll->iCount )
+            memmove( &pPoll->pFDs[ iPos + 1 ], &pPoll->pFDs[ iPos ],
+                     ( pPoll->iCount - iPos ) * sizeof( HB_SOCKET_POLLFD ) );
+         pPoll->pFDs[ iPos ].sd = sd;
+         pPoll->pFDs[ iPos ].events = iEvents;
+         pPoll->iCount++;
+         hb_socketSetError( 0 );
+         iResult = 0;
+      }
+      HB_SOCKPOLL_UNLOCK();
+   }
+
+   return iResult;
+}
+
+int hb_socketPollMod( PHB_SOCKET_POLL pPoll, HB_SOCKET sd, int iEvents )
+{
+   int iPos, iResult = -1;
+
+   HB_SOCKPOLL_LOCK();
+   if( hb_socketPollFind( pPoll, sd, &iPos ) )
+   {
+      pPoll->pFDs[ iPos ].events = iEvents;
+      hb_socketSetError( 0 );
+      iResult = 0;
+   }
+   else
+      hb_socketSetError( HB_SOCKET_ERR_INVALIDHANDLE );
+   HB_SOCKPOLL_UNLOCK();
+
+   return iResult;
+}
+
+int hb_socketPollDel( PHB_SOCKET_POLL pPoll, HB_SOCKET sd )
+{
+   int iPos, iResult = -1;
+
+   HB_SOCKPOLL_LOCK();
+   if( hb_socketPollFind( pPoll, sd, &iPos ) )
+   {
+      pPoll->iCount--;
+      if( iPos < pPoll->iCount )
+         memmove( &pPoll->pFDs[ iPos ], &pPoll->pFDs[ iPos + 1 ],
+                  ( pPoll->iCount - iPos ) * sizeof( HB_SOCKET_POLLFD ) );
+      hb_socketSetError( 0 );
+      iResult = 0;
+   }
+   else
+      hb_socketSetError( HB_SOCKET_ERR_INVALIDHANDLE );
+   HB_SOCKPOLL_UNLOCK();
+
+   return iResult;
+}
+
+/* take a copy of armed sockets, it allows to modify the set
+   from other threads when wait is in progress */
+static int hb_socketPollSnapshot( PHB_SOCKET_POLL pPoll,
+                                  PHB_SOCKET_POLLFD * pFDs, int * piSize )
+{
+   int iCount = 0, i;
+
+   HB_SOCKPOLL_LOCK();
+   if( pPoll->iCount > *piSize )
+   {
+      *piSize = pPoll->iCount;
+      *pFDs = ( PHB_SOCKET_POLLFD ) hb_xrealloc( *pFDs,
+                                 *piSize * sizeof( HB_SOCKET_POLLFD ) );
+   }
+   for( i = 0; i < pPoll->iCount; ++i )
+   {
+      if( pPoll->pFDs[ i ].events & ( HB_SOCKET_POLL_READ |
+                                      HB_SOCKET_POLL_WRITE |
+                                      HB_SOCKET_POLL_PRI ) )
+         ( *pFDs )[ iCount++ ] = pPoll->pFDs[ i ];
+   }
+   HB_SOCKPOLL_UNLOCK();
+
+   return iCount;
+}
+
+int hb_socketPollWait( PHB_SOCKET_POLL pPoll, PHB_SOCKET_POLLFD pEvents, int iMax, HB_MAXINT timeout )
+{
+   PHB_SOCKET_POLLFD pFDs = NULL;
+   HB_MAXUINT timer;
+   int iResult, iError, iCount, iSize = 0, iFound = 0, iPos, i;
+#if defined( HB_HAS_POLL )
+   struct pollfd * pfds = NULL;
+   int iPfdSize = 0;
+#else
+   fd_set fds[ 3 ];
+   HB_SOCKET maxsd;
+   struct timeval tv;
+#endif
+
+   if( iMax <= 0 )
+   {
+      hb_socketSetError( HB_SOCKET_ERR_PARAMVALUE );
+      return -1;
+   }
+
+   timer = hb_timerInit( timeout );
+
+   for( ;; )
+   {
+      iCount = hb_socketPollSnapshot( pPoll, &pFDs, &iSize );
+
+#if defined( HB_HAS_POLL )
+      if( iCount > iPfdSize )
+      {
+         iPfdSize = iCount;
+         pfds = ( struct pollfd * ) hb_xrealloc( pfds, iPfdSize * sizeof( struct pollfd ) );
+      }
+      for( i = 0; i < iCount; ++i )
+      {
+         pfds[ i ].fd = pFDs[ i ].sd;
+         pfds[ i ].events = pfds[ i ].revents = 0;
+         if( pFDs[ i ].events & HB_SOCKET_POLL_READ )
+            pfds[ i ].events |= POLLIN;
+         if( pFDs[ i ].events & HB_SOCKET_POLL_WRITE )
+            pfds[ i ].events |= POLLOUT;
+         if( pFDs[ i ].events & HB_SOCKET_POLL_PRI )
+            pfds[ i ].events |= POLLPRI;
+      }
+
+      hb_vmUnlock();
+      iResult = poll( pfds, ( nfds_t ) iCount,
+                      timeout < 0 || timeout > 1000 ? 1000 : ( int ) timeout );
+#else
+      maxsd = 0;
+      FD_ZERO( &fds[ 0 ] );
+      FD_ZERO( &fds[ 1 ] );
+      FD_ZERO( &fds[ 2 ] );
+      for( i = 0; i < iCount; ++i )
+      {
+         if( maxsd < pFDs[ i ].sd )
+            maxsd = pFDs[ i ].sd;
+         if( pFDs[ i ].events & HB_SOCKET_POLL_READ )
+            FD_SET( ( HB_SOCKET_T ) pFDs[ i ].sd, &fds[ 0 ] );
+         if( pFDs[ i ].events & HB_SOCKET_POLL_WRITE )
+            FD_SET( ( HB_SOCKET_T ) pFDs[ i ].sd, &fds[ 1 ] );
+         FD_SET( ( HB_SOCKET_T ) pFDs[ i ].sd, &fds[ 2 ] );
+      }
+      if( timeout < 0 || timeout >= 1000 )
+      {
+         tv.tv_sec = 1;
+         tv.tv_usec = 0;
+      }
+      else
+      {
+         tv.tv_sec = ( long ) ( timeout / 1000 );
+         tv.tv_usec = ( long ) ( timeout % 1000 ) * 1000;
+      }
+
+      hb_vmUnlock();
+      if( iCount > 0 )
+         iResult = select( ( int ) ( maxsd + 1 ), &fds[ 0 ], &fds[ 1 ], &fds[ 2 ], &tv );
+      else
+      {
+         /* select() with empty sets is refused by some platforms */
+         hb_threadReleaseCPU();
+         iResult = 0;
+      }
+#endif
+      iError = iResult >= 0 ? 0 : HB_SOCK_GETERROR();
+      hb_socketSetOsError( iError );
+      if( iResult == -1 && HB_SOCK_IS_EINTR( iError ) )
+         iResult = 0;
+      hb_vmLock();
+
+      if( iResult != 0 || ( timeout = hb_timerTest( timeout, &timer ) ) == 0 ||
+          hb_vmRequestQuery() != 0 )
+         break;
+   }
+
+   if( iResult > 0 )
+   {
+      HB_SOCKPOLL_LOCK();
+      /* start from the position where previous scan stopped
+         to not starve sockets with higher handles */
+      iPos = pPoll->iNext < iCount ? pPoll->iNext : 0;
+      for( i = 0; i < iCount && iFound < iMax; ++i, ++iPos )
+      {
+         int iEvents = 0;
+
+         if( iPos == iCount )
+            iPos = 0;
+#if defined( HB_HAS_POLL )
+         if( pfds[ iPos ].revents & POLLIN )
+            iEvents |= HB_SOCKET_POLL_READ;
+         if( pfds[ iPos ].revents & POLLOUT )
+            iEvents |= HB_SOCKET_POLL_WRITE;
+         if( pfds[ iPos ].revents & POLLPRI )
+            iEvents |= HB_SOCKET_POLL_PRI;
+         if( pfds[ iPos ].revents & ( POLLERR | POLLNVAL ) )
+            iEvents |= HB_SOCKET_POLL_ERROR;
+         if( pfds[ iPos ].revents & POLLHUP )
+            iEvents |= HB_SOCKET_POLL_HUP;
+#else
+         if( FD_ISSET( ( HB_SOCKET_T ) pFDs[ iPos ].sd, &fds[ 0 ] ) )
+            iEvents |= HB_SOCKET_POLL_READ;
+         if( FD_ISSET( ( HB_SOCKET_T ) pFDs[ iPos ].sd, &fds[ 1 ] ) )
+            iEvents |= HB_SOCKET_POLL_WRITE;
+         if( FD_ISSET( ( HB_SOCKET_T ) pFDs[ iPos ].sd, &fds[ 2 ] ) )
+            iEvents |= ( pFDs[ iPos ].events & HB_SOCKET_POLL_PRI ) ?
+                       HB_SOCKET_POLL_PRI : HB_SOCKET_POLL_ERROR;
+#endif
+         if( iEvents != 0 )
+         {
+            int iIndex;
+
+            /* ignore sockets removed or disarmed by other threads */
+            if( hb_socketPollFind( pPoll, pFDs[ iPos ].sd, &iIndex ) &&
+                pPoll->pFDs[ iIndex ].events != HB_SOCKET_POLL_ONESHOT )
+            {
+               if( pPoll->pFDs[ iIndex ].events & HB_SOCKET_POLL_ONESHOT )
+                  pPoll->pFDs[ iIndex ].events = HB_SOCKET_POLL_ONESHOT;
+               pEvents[ iFound ].sd = pFDs[ iPos ].sd;
+               pEvents[ iFound ].events = iEvents;
+               ++iFound;
+            }
+         }
+      }
+      pPoll->iNext = iPos;
+      HB_SOCKPOLL_UNLOCK();
+      iResult = iFound;
+   }
+
+#if defined( HB_HAS_POLL )
+   if( pfds )
+      hb_xfree( pfds );
+#endif
+   if( pFDs )
+      hb_xfree( pFDs );
+
+   return iResult;
+}
+
+#endif /* ! HB_HAS_EPOLL */
+
 
 /*
  * DNS functions
@@ -58,6 +58,7 @@
  * hb_socketAccept( hSocket, [ @aAddr ], [ nTimeout = FOREVER ] ) --> hConnectionSocket
  * hb_socketConnect( hSocket, aAddr, [ nTimeout = FOREVER ] ) --> lSuccess
  * hb_socketSend( hSocket, cBuffer, [ nLen = Len( cBuffer ) ], [ nFlags = 0 ], [ nTimeout = FOREVER ] ) --> nBytesSent
+ * hb_socketSendFile( hSocket, pFile, [ nOffset = 0 ], [ nLen = all ], [ nTimeout = FOREVER ] ) --> nBytesSent
  * hb_socketSendTo( hSocket, cBuffer, [ nLen = Len( cBuffer ) ], [ nFlags = 0 ], aAddr, [ nTimeout = FOREVER ] ) --> nBytesSent
  * hb_socketRecv( hSocket, @cBuffer, [ nLen = Len( cBuffer ) ], [ nFlags = 0 ], [ nTimeout = FOREVER ] ) --> nBytesRecv
  * hb_socketRecvFrom( hSocket, @cBuffer, [ nLen = Len( cBuffer ) ], [ nFlags = 0 ], @aAddr, [ nTimeout = FOREVER ] ) --> nBytesRecv
@@ -89,6 +90,13 @@
  * hb_socketFlush( hSocket, [ nTimeout = FOREVER ], [ lSync ] ) --> nBytesLeft
  * hb_socketAutoFlush( hSocket, [ nNewSetting ] ) --> nPrevSetting
  * hb_socketAutoShutdown( hSocket, [ lNewSetting ] ) --> lPrevSetting
+ * hb_socketPollNew() --> pPoll
+ * hb_socketPollAdd( pPoll, hSocket, [ nEvents = HB_SOCKET_POLL_READ ], [ xCargo ] ) --> lSuccess
+ * hb_socketPollMod( pPoll, hSocket, nEvents, [ xCargo ] ) --> lSuccess
+ * hb_socketPollDel( pPoll, hSocket ) --> lSuccess
+ * hb_socketPollCount( pPoll ) --> nSockets
+ * hb_socketPollWait( pPoll, [ nTimeout = FOREVER ], [ nMaxEvents = 64 ] ) --> aEvents | NIL
+ * hb_socketPollDispatch( pPoll, [ nTimeout = FOREVER ], [ nMaxEvents = 64 ] ) --> nEvents
  */
 
 /* this has to be declared before hbsocket.h is included */
@@ -99,7 +107,9 @@
 #include "hbapierr.h"
 #include "hbvm.h"
 #include "hbstack.h"
+#include "hbthread.h"
 #include "hbsocket.h"
+#include "hbapifs.h"
 
 static HB_BOOL s_fInit = HB_FALSE;
 
@@ -1080,6 +1090,66 @@ HB_FUNC( HB_SOCKETSEND )
    }
 }
 
+HB_FUNC( HB_SOCKETSENDFILE )
+{
+   PHB_SOCKEX pSock = hb_sockexParam( 1 );
+
+   if( pSock )
+   {
+      PHB_FILE pFile = hb_fileParam( 2 );
+
+      if( pFile )
+      {
+         HB_FOFFSET nOffset = ( HB_FOFFSET ) hb_parnint( 3 );
+         HB_MAXINT timeout = hb_parnintdef( 5, -1 );
+         HB_FHANDLE hFile = hb_fileHandle( pFile );
+         HB_FOFFSET nSize;
+         long lLen;
+
+         if( HB_ISNUM( 4 ) )
+            nSize = ( HB_FOFFSET ) hb_parnint( 4 );
+         else
+            nSize = hb_fileSize( pFile ) - nOffset;
+         lLen = nSize > 0x40000000 ? 0x40000000 : ( long ) nSize;
+
+         if( lLen <= 0 || nOffset < 0 )
+            lLen = 0;
+         else if( hFile != FS_ERROR && ! pSock->fRedirAll )
+            lLen = hb_socketSendFile( pSock->sd, hFile, nOffset, lLen, timeout );
+         else
+         {
+            /* not a local file or socket with filters, use buffered copy */
+            void * buffer;
+            HB_SIZE nRead;
+
+            if( lLen > 0x10000 )
+               lLen = 0x10000;
+            buffer = hb_xgrab( lLen );
+            nRead = hb_fileReadAt( pFile, buffer, lLen, nOffset );
+            if( nRead == ( HB_SIZE ) FS_ERROR )
+            {
+               hb_socketSetError( HB_SOCKET_ERR_INVAL );
+               lLen = -1;
+            }
+            else if( nRead == 0 )
+               lLen = 0;
+            else if( pSock->fRedirAll )
+            {
+               int iAutoFlush = pSock->iAutoFlush;
+               if( iAutoFlush <= 0 )
+                  pSock->iAutoFlush = 15000;
+               lLen = hb_sockexWrite( pSock, buffer, ( long ) nRead, timeout );
+               pSock->iAutoFlush = iAutoFlush;
+            }
+            else
+               lLen = hb_socketSend( pSock->sd, buffer, ( long ) nRead, 0, timeout );
+            hb_xfree( buffer );
+         }
+         hb_retnl( lLen );
+      }
+   }
+}
+
 HB_FUNC( HB_SOCKETSENDTO )
 {
    HB_SOCKET socket = hb_socketParam( 1 );
@@ -1512,3 +1582,454 @@ HB_FUNC( HB_SOCKETAUTOSHUTDOWN )
          hb_sockexSetShutDown( pSock, hb_parl( 2 ) );
    }
 }
+
+/* socket event multiplexer */
+
+typedef struct
+{
+   HB_SOCKET   sd;
+   int         iEvents;
+   HB_BOOL     fFilter;
+   PHB_ITEM    pSocket;
+   PHB_ITEM    pCargo;
+}
+HB_SOCKPOLL_ENTRY, * PHB_SOCKPOLL_ENTRY;
+
+typedef struct
+{
+   PHB_SOCKET_POLL      pPoll;
+   PHB_SOCKPOLL_ENTRY   pEntries;   /* sorted by socket handle */
+   HB_SIZE              nCount;
+   HB_SIZE              nSize;
+   HB_SIZE              nFilters;   /* number of sockets with sockex filters */
+}
+HB_SOCKPOLL, * PHB_SOCKPOLL;
+
+#define HB_SOCKPOLL_LOCK()      hb_threadEnterCriticalSection( &s_sockPollMtx )
+#define HB_SOCKPOLL_UNLOCK()    hb_threadLeaveCriticalSection( &s_sockPollMtx )
+static HB_CRITICAL_NEW( s_sockPollMtx );
+
+#define HB_SOCKPOLL_MAXEVENTS   64
+
+static HB_BOOL s_sockPollFind( PHB_SOCKPOLL pSockPoll, HB_SOCKET sd, HB_SIZE * pnPos )
+{
+   HB_SIZE nFirst = 0, nLast = pSockPoll->nCount;
+
+   while( nFirst < nLast )
+   {
+      HB_SIZE nMiddle = ( nFirst + nLast ) >> 1;
+
+      if( pSockPoll->pEntries[ nMiddle ].sd < sd )
+         nFirst = nMiddle + 1;
+      else
+         nLast = nMiddle;
+   }
+   *pnPos = nFirst;
+
+   return nFirst < pSockPoll->nCount && pSockPoll->pEntries[ nFirst ].sd == sd;
+}
+
+/* remove entry from the set, items have to be released by caller
+   after leaving critical section */
+static void s_sockPollRemove( PHB_SOCKPOLL pSockPoll, HB_SIZE nPos,
+                              PHB_ITEM * pSocket, PHB_ITEM * pCargo )
+{
+   PHB_SOCKPOLL_ENTRY pEntry = &pSockPoll->pEntries[ nPos ];
+
+   hb_socketPollDel( pSockPoll->pPoll, pEntry->sd );
+   if( pEntry->fFilter )
+      pSockPoll->nFilters--;
+   *pSocket = pEntry->pSocket;
+   *pCargo = pEntry->pCargo;
+   if( --pSockPoll->nCount > nPos )
+      memmove( pEntry, pEntry + 1,
+               ( pSockPoll->nCount - nPos ) * sizeof( HB_SOCKPOLL_ENTRY ) );
+}
+
+/* socket closed without removing it from the set, its descriptor
+   may be already reused by new socket */
+static HB_BOOL s_sockPollStale( PHB_SOCKPOLL_ENTRY pEntry )
+{
+   PHB_SOCKEX pSock = hb_sockexItemGet( pEntry->pSocket );
+
+   return pSock == NULL || pSock->sd != pEntry->sd;
+}
+
+static HB_GARBAGE_FUNC( hb_sockpoll_destructor )
+{
+   PHB_SOCKPOLL * pSockPollPtr = ( PHB_SOCKPOLL * ) Cargo;
+   PHB_SOCKPOLL pSockPoll = *pSockPollPtr;
+
+   if( pSockPoll )
+   {
+      *pSockPollPtr = NULL;
+
+      while( pSockPoll->nCount > 0 )
+      {
+         --pSockPoll->nCount;
+         hb_itemRelease( pSockPoll->pEntries[ pSockPoll->nCount ].pSocket );
+         if( pSockPoll->pEntries[ pSockPoll->nCount ].pCargo )
+            hb_itemRelease( pSockPoll->pEntries[ pSockPoll->nCount ].pCargo );
+      }
+      if( pSockPoll->pEntries )
+         hb_xfree( pSockPoll->pEntries );
+      hb_socketPollFree( pSockPoll->pPoll );
+      hb_xfree( pSockPoll );
+   }
+}
+
+static HB_GARBAGE_FUNC( hb_sockpoll_mark )
+{
+   PHB_SOCKPOLL pSockPoll = *( PHB_SOCKPOLL * ) Cargo;
+
+   if( pSockPoll )
+   {
+      HB_SIZE nPos;
+
+      for( nPos = 0; nPos < pSockPoll->nCount; ++nPos )
+      {
+         hb_gcMark( pSockPoll->pEntries[ nPos ].pSocket );
+         if( pSockPoll->pEntries[ nPos ].pCargo )
+            hb_gcMark( pSockPoll->pEntries[ nPos ].pCargo );
+      }
+   }
+}
+
+static const HB_GC_FUNCS s_gcSockPollFuncs =
+{
+   hb_sockpoll_destructor,
+   hb_sockpoll_mark
+};
+
+static PHB_SOCKPOLL s_sockPollParam( int iParam )
+{
+   PHB_SOCKPOLL * pSockPollPtr = ( PHB_SOCKPOLL * ) hb_parptrGC( &s_gcSockPollFuncs, iParam );
+
+   if( pSockPollPtr && *pSockPollPtr )
+      return *pSockPollPtr;
+
+   hb_errRT_BASE_SubstR( EG_ARG, 3012, NULL, HB_ERR_FUNCNAME, HB_ERR_ARGS_BASEPARAMS );
+   return NULL;
+}
+
+static PHB_ITEM s_sockPollItemNew( PHB_ITEM pItem )
+{
+   pItem = hb_itemNew( pItem );
+   hb_gcUnlock( pItem );
+
+   return pItem;
+}
+
+static HB_BOOL s_sockPollSet( PHB_SOCKPOLL pSockPoll, PHB_ITEM pSocket,
+                              int iEvents, PHB_ITEM pCargo, HB_BOOL fNew )
+{
+   PHB_SOCKEX pSock = hb_sockexItemGet( pSocket );
+   PHB_ITEM pOldCargo = NULL, pStaleSocket = NULL, pStaleCargo = NULL;
+   HB_BOOL fResult = HB_FALSE, fFound;
+   HB_SIZE nPos;
+
+   if( pSock == NULL || pSock->sd == HB_NO_SOCKET )
+   {
+      hb_socketSetError( HB_SOCKET_ERR_INVALIDHANDLE );
+      return HB_FALSE;
+   }
+
+   HB_SOCKPOLL_LOCK();
+   fFound = s_sockPollFind( pSockPoll, pSock->sd, &nPos );
+   if( fFound && s_sockPollStale( &pSockPoll->pEntries[ nPos ] ) )
+   {
+      s_sockPollRemove( pSockPoll, nPos, &pStaleSocket, &pStaleCargo );
+      fFound = HB_FALSE;
+   }
+   if( fFound )
+   {
+      if( fNew )
+         hb_socketSetError( HB_SOCKET_ERR_PARAMVALUE );
+      else if( hb_socketPollMod( pSockPoll->pPoll, pSock->sd, iEvents ) == 0 )
+      {
+         pSockPoll->pEntries[ nPos ].iEvents = iEvents;
+         if( pCargo )
+         {
+            pOldCargo = pSockPoll->pEntries[ nPos ].pCargo;
+            pSockPoll->pEntries[ nPos ].pCargo = s_sockPollItemNew( pCargo );
+         }
+         fResult = HB_TRUE;
+      }
+   }
+   else if( ! fNew )
+      hb_socketSetError( HB_SOCKET_ERR_INVALIDHANDLE );
+   else if( hb_socketPollAdd( pSockPoll->pPoll, pSock->sd, iEvents ) == 0 )
+   {
+      PHB_SOCKPOLL_ENTRY pEntry;
+
+      if( pSockPoll->nCount == pSockPoll->nSize )
+      {
+         pSockPoll->nSize += pSockPoll->nSize >> 1 > 16 ? pSockPoll->nSize >> 1 : 16;
+         pSockPoll->pEntries = ( PHB_SOCKPOLL_ENTRY )
+            hb_xrealloc( pSockPoll->pEntries, pSockPoll->nSize * sizeof( HB_SOCKPOLL_ENTRY ) );
+      }
+      pEntry = &pSockPoll->pEntries[ nPos ];
+      if( nPos < pSockPoll->nCount )
+         memmove( pEntry + 1, pEntry,
+                  ( pSockPoll->nCount - nPos ) * sizeof( HB_SOCKPOLL_ENTRY ) );
+      pSockPoll->nCount++;
+      pEntry->sd = pSock->sd;
+      pEntry->iEvents = iEvents;
+      /* filters may keep already decoded data in their own buffers
+         which is invisible for OS level multiplexer */
+      pEntry->fFilter = ! hb_sockexIsRaw( pSock );
+      if( pEntry->fFilter )
+         pSockPoll->nFilters++;
+      pEntry->pSocket = s_sockPollItemNew( pSocket );
+      pEntry->pCargo = pCargo ? s_sockPollItemNew( pCargo ) : NULL;
+      fResult = HB_TRUE;
+   }
+   HB_SOCKPOLL_UNLOCK();
+
+   if( pOldCargo )
+      hb_itemRelease( pOldCargo );
+   if( pStaleCargo )
+      hb_itemRelease( pStaleCargo );
+   if( pStaleSocket )
+      hb_itemRelease( pStaleSocket );
+
+   return fResult;
+}
+
+/* wait for events and return them in array of
+   { hSocket, nEvents, xCargo } items */
+static PHB_ITEM s_sockPollWait( PHB_SOCKPOLL pSockPoll, HB_MAXINT timeout, int iMax )
+{
+   PHB_SOCKET_POLLFD pEvents;
+   PHB_ITEM pResult = NULL;
+   HB_SIZE nPos, nFound = 0;
+   int iBuffered = 0, iCount, i, iRelease = 0;
+   PHB_ITEM * pRelease = NULL;
+
+   if( iMax <= 0 )
+      iMax = HB_SOCKPOLL_MAXEVENTS;
+   pEvents = ( PHB_SOCKET_POLLFD ) hb_xgrab( iMax * 2 * sizeof( HB_SOCKET_POLLFD ) );
+
+   if( pSockPoll->nFilters > 0 )
+   {
+      HB_SOCKPOLL_LOCK();
+      for( nPos = 0; nPos < pSockPoll->nCount && iBuffered < iMax; ++nPos )
+      {
+         PHB_SOCKPOLL_ENTRY pEntry = &pSockPoll->pEntries[ nPos ];
+
+         if( pEntry->fFilter && ( pEntry->iEvents & HB_SOCKET_POLL_READ ) )
+         {
+            PHB_SOCKEX pSock = hb_sockexItemGet( pEntry->pSocket );
+
+            if( pSock && pSock->pFilter->CanRead( pSock, HB_TRUE, 0 ) > 0 )
+            {
+               pEvents[ iMax + iBuffered ].sd = pEntry->sd;
+               pEvents[ iMax + iBuffered ].events = HB_SOCKET_POLL_READ;
+               ++iBuffered;
+            }
+         }
+      }
+      HB_SOCKPOLL_UNLOCK();
+   }
+
+   iCount = hb_socketPollWait( pSockPoll->pPoll, pEvents, iMax - iBuffered,
+                               iBuffered > 0 ? 0 : timeout );
+   if( iCount >= 0 || iBuffered > 0 )
+   {
+      if( iCount < 0 )
+         iCount = 0;
+      /* merge events for sockets with buffered data */
+      for( i = 0; i < iBuffered; ++i )
+      {
+         int j;
+
+         for( j = 0; j < iCount; ++j )
+         {
+            if( pEvents[ j ].sd == pEvents[ iMax + i ].sd )
+               break;
+         }
+         if( j == iCount )
+            pEvents[ iCount++ ] = pEvents[ iMax + i ];
+         else
+            pEvents[ j ].events |= HB_SOCKET_POLL_READ;
+      }
+
+      pResult = hb_itemArrayNew( iCount );
+      if( iCount > 0 )
+         pRelease = ( PHB_ITEM * ) hb_xgrab( iCount * 2 * sizeof( PHB_ITEM ) );
+
+      HB_SOCKPOLL_LOCK();
+      for( i = 0; i < iCount; ++i )
+      {
+         /* socket could be removed by other thread in the meantime */
+         if( s_sockPollFind( pSockPoll, pEvents[ i ].sd, &nPos ) )
+         {
+            PHB_SOCKPOLL_ENTRY pEntry = &pSockPoll->pEntries[ nPos ];
+            PHB_ITEM pEvent = hb_arrayGetItemPtr( pResult, ++nFound );
+
+            hb_arrayNew( pEvent, HB_SOCKET_POLLEV_LEN );
+            hb_arraySet( pEvent, HB_SOCKET_POLLEV_SOCKET, pEntry->pSocket );
+            hb_arraySetNI( pEvent, HB_SOCKET_POLLEV_EVENTS, pEvents[ i ].events );
+            if( pEntry->pCargo )
+               hb_arraySet( pEvent, HB_SOCKET_POLLEV_CARGO, pEntry->pCargo );
+            if( pEntry->iEvents & HB_SOCKET_POLL_ONESHOT )
+            {
+               s_sockPollRemove( pSockPoll, nPos, &pRelease[ iRelease ],
+                                 &pRelease[ iRelease + 1 ] );
+               iRelease += 2;
+            }
+         }
+      }
+      HB_SOCKPOLL_UNLOCK();
+
+      if( nFound < ( HB_SIZE ) iCount )
+         hb_arraySize( pResult, nFound );
+
+      while( iRelease > 0 )
+      {
+         if( pRelease[ --iRelease ] )
+            hb_itemRelease( pRelease[ iRelease ] );
+      }
+      if( pRelease )
+         hb_xfree( pRelease );
+   }
+   hb_xfree( pEvents );
+
+   return pResult;
+}
+
+HB_FUNC( HB_SOCKETPOLLNEW )
+{
+   PHB_SOCKET_POLL pPoll = hb_socketPollNew();
+
+   if( pPoll )
+   {
+      PHB_SOCKPOLL * pSockPollPtr = ( PHB_SOCKPOLL * )
+                        hb_gcAllocate( sizeof( PHB_SOCKPOLL ), &s_gcSockPollFuncs );
+
+      *pSockPollPtr = ( PHB_SOCKPOLL ) hb_xgrabz( sizeof( HB_SOCKPOLL ) );
+      ( *pSockPollPtr )->pPoll = pPoll;
+      hb_retptrGC( pSockPollPtr );
+   }
+}
+
+HB_FUNC( HB_SOCKETPOLLADD )
+{
+   PHB_SOCKPOLL pSockPoll = s_sockPollParam( 1 );
+
+   if( pSockPoll )
+   {
+      PHB_ITEM pSocket = hb_param( 2, HB_IT_POINTER );
+
+      if( pSocket && hb_sockexItemGet( pSocket ) )
+         hb_retl( s_sockPollSet( pSockPoll, pSocket,
+                                 hb_parnidef( 3, HB_SOCKET_POLL_READ ),
+                                 hb_param( 4, HB_IT_ANY ), HB_TRUE ) );
+      else
+         hb_errRT_BASE_SubstR( EG_ARG, 3012, NULL, HB_ERR_FUNCNAME, HB_ERR_ARGS_BASEPARAMS );
+   }
+}
+
+HB_FUNC( HB_SOCKETPOLLMOD )
+{
+   PHB_SOCKPOLL pSockPoll = s_sockPollParam( 1 );
+
+   if( pSockPoll )
+   {
+      PHB_ITEM pSocket = hb_param( 2, HB_IT_POINTER );
+
+      if( pSocket && hb_sockexItemGet( pSocket ) && HB_ISNUM( 3 ) )
+         hb_retl( s_sockPollSet( pSockPoll, pSocket, hb_parni( 3 ),
+                                 hb_pcount() >= 4 ? hb_param( 4, HB_IT_ANY ) : NULL,
+                                 HB_FALSE ) );
+      else
+         hb_errRT_BASE_SubstR( EG_ARG, 3012, NULL, HB_ERR_FUNCNAME, HB_ERR_ARGS_BASEPARAMS );
+   }
+}
+
+HB_FUNC( HB_SOCKETPOLLDEL )
+{
+   PHB_SOCKPOLL pSockPoll = s_sockPollParam( 1 );
+
+   if( pSockPoll )
+   {
+      PHB_SOCKEX pSock = hb_sockexItemGet( hb_param( 2, HB_IT_POINTER ) );
+
+      if( pSock )
+      {
+         PHB_ITEM pSocket = NULL, pCargo = NULL;
+         HB_SIZE nPos;
+
+         HB_SOCKPOLL_LOCK();
+         if( s_sockPollFind( pSockPoll, pSock->sd, &nPos ) )
+            s_sockPollRemove( pSockPoll, nPos, &pSocket, &pCargo );
+         else
+            hb_socketSetError( HB_SOCKET_ERR_INVALIDHANDLE );
+         HB_SOCKPOLL_UNLOCK();
+
+         if( pCargo )
+            hb_itemRelease( pCargo );
+         if( pSocket )
+         {
+            hb_itemRelease( pSocket );
+            hb_socketSetError( 0 );
+         }
+         hb_retl( pSocket != NULL );
+      }
+      else
+         hb_errRT_BASE_SubstR( EG_ARG, 3012, NULL, HB_ERR_FUNCNAME, HB_ERR_ARGS_BASEPARAMS );
+   }
+}
+
+HB_FUNC( HB_SOCKETPOLLCOUNT )
+{
+   PHB_SOCKPOLL pSockPoll = s_sockPollParam( 1 );
+
+   if( pSockPoll )
+      hb_retns( pSockPoll->nCount );
+}
+
+HB_FUNC( HB_SOCKETPOLLWAIT )
+{
+   PHB_SOCKPOLL pSockPoll = s_sockPollParam( 1 );
+
+   if( pSockPoll )
+   {
+      PHB_ITEM pResult = s_sockPollWait( pSockPoll, hb_parnintdef( 2, -1 ),
+                                         hb_parni( 3 ) );
+      if( pResult )
+         hb_itemReturnRelease( pResult );
+   }
+}
+
+HB_FUNC( HB_SOCKETPOLLDISPATCH )
+{
+   PHB_SOCKPOLL pSockPoll = s_sockPollParam( 1 );
+
+   if( pSockPoll )
+   {
+      PHB_ITEM pResult = s_sockPollWait( pSockPoll, hb_parnintdef( 2, -1 ),
+                                         hb_parni( 3 ) );
+      if( pResult )
+      {
+         PHB_ITEM pPollItem = hb_param( 1, HB_IT_POINTER );
+         HB_SIZE nLen = hb_arrayLen( pResult ), nPos;
+
+         for( nPos = 1; nPos <= nLen && hb_vmRequestQuery() == 0; ++nPos )
+         {
+            PHB_ITEM pEvent = hb_arrayGetItemPtr( pResult, nPos );
+            PHB_ITEM pBlock = hb_arrayGetItemPtr( pEvent, HB_SOCKET_POLLEV_CARGO );
+
+            if( pBlock && HB_IS_EVALITEM( pBlock ) )
+               hb_vmEvalBlockV( pBlock, 3,
+                                hb_arrayGetItemPtr( pEvent, HB_SOCKET_POLLEV_SOCKET ),
+                                hb_arrayGetItemPtr( pEvent, HB_SOCKET_POLLEV_EVENTS ),
+                                pPollItem );
+         }
+         hb_itemRelease( pResult );
+         hb_retns( nLen );
+      }
+      else
+         hb_retni( -1 );
+   }
+}
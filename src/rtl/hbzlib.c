@@ -492,6 +492,114 @@ HB_FUNC( HB_GZCOMPRESS )
       hb_errRT_BASE_SubstR( EG_ARG, 3012, NULL, HB_ERR_FUNCNAME, HB_ERR_ARGS_BASEPARAMS );
 }
 
+/* incremental compression streams */
+
+typedef struct
+{
+   z_stream stream;
+   HB_BOOL  fInit;
+} HB_ZSTREAM, * PHB_ZSTREAM;
+
+static HB_GARBAGE_FUNC( hb_zstream_destructor )
+{
+   PHB_ZSTREAM pZStream = ( PHB_ZSTREAM ) Cargo;
+
+   if( pZStream->fInit )
+   {
+      deflateEnd( &pZStream->stream );
+      pZStream->fInit = HB_FALSE;
+   }
+}
+
+static const HB_GC_FUNCS s_gcZStreamFuncs =
+{
+   hb_zstream_destructor,
+   hb_gcDummyMark
+};
+
+/*
+ * hb_ZDeflateNew( [<nLevel>], [<lGZip>] ) => <pStream> or NIL on Error
+ */
+HB_FUNC( HB_ZDEFLATENEW )
+{
+   PHB_ZSTREAM pZStream = ( PHB_ZSTREAM ) hb_gcAllocate( sizeof( HB_ZSTREAM ),
+                                                         &s_gcZStreamFuncs );
+
+   memset( pZStream, 0, sizeof( HB_ZSTREAM ) );
+   pZStream->stream.zalloc = s_zlib_alloc;
+   pZStream->stream.zfree  = s_zlib_free;
+   pZStream->stream.opaque = NULL;
+   if( deflateInit2( &pZStream->stream,
+                     hb_parnidef( 1, Z_DEFAULT_COMPRESSION ), Z_DEFLATED,
+                     15 + ( hb_parl( 2 ) ? 16 : 0 ), 8,
+                     Z_DEFAULT_STRATEGY ) == Z_OK )
+   {
+      pZStream->fInit = HB_TRUE;
+      hb_retptrGC( pZStream );
+   }
+   else
+      hb_gcFree( pZStream );
+}
+
+/*
+ * hb_ZDeflate( <pStream>, <cData>, [<lFinish>] ) => <cCompressedData> or NIL on Error
+ *
+ * Without <lFinish> output is flushed to byte boundary, so each returned
+ * block can be decompressed as soon as it is received. After <lFinish>
+ * stream is closed and cannot be used anymore.
+ */
+HB_FUNC( HB_ZDEFLATE )
+{
+   PHB_ZSTREAM pZStream = ( PHB_ZSTREAM ) hb_parptrGC( &s_gcZStreamFuncs, 1 );
+   const char * szData = hb_parc( 2 );
+
+   if( pZStream && ( szData || HB_ISNIL( 2 ) ) )
+   {
+      if( pZStream->fInit )
+      {
+         int iFlush = hb_parl( 3 ) ? Z_FINISH : Z_SYNC_FLUSH;
+         HB_SIZE nLen = hb_parclen( 2 ), nDst = 0,
+                 nSize = s_zlibCompressBound( nLen ) + 32;
+         char * pDest = ( char * ) hb_xgrab( nSize + 1 );
+         int iResult;
+
+         pZStream->stream.next_in  = ( Bytef * ) HB_UNCONST( szData ? szData : "" );
+         pZStream->stream.avail_in = ( uInt ) nLen;
+         for( ;; )
+         {
+            pZStream->stream.next_out  = ( Bytef * ) pDest + nDst;
+            pZStream->stream.avail_out = ( uInt ) ( nSize - nDst );
+            iResult = deflate( &pZStream->stream, iFlush );
+            nDst = nSize - pZStream->stream.avail_out;
+            if( iResult == Z_BUF_ERROR && nDst < nSize )
+               iResult = Z_OK;   /* nothing more to flush */
+            else if( iResult == Z_OK && pZStream->stream.avail_out == 0 )
+            {
+               nSize += nSize >> 1;
+               pDest = ( char * ) hb_xrealloc( pDest, nSize + 1 );
+               continue;
+            }
+            break;
+         }
+
+         if( iFlush == Z_FINISH )
+         {
+            deflateEnd( &pZStream->stream );
+            pZStream->fInit = HB_FALSE;
+            if( iResult == Z_STREAM_END )
+               iResult = Z_OK;
+         }
+
+         if( iResult == Z_OK )
+            hb_retclen_buffer( pDest, nDst );
+         else
+            hb_xfree( pDest );
+      }
+   }
+   else
+      hb_errRT_BASE_SubstR( EG_ARG, 3012, NULL, HB_ERR_FUNCNAME, HB_ERR_ARGS_BASEPARAMS );
+}
+
 /*
  * hb_ZError( <nError> ) => <cErrorDescription>
  */
@@ -49,6 +49,7 @@
 #include "hbapicls.h"
 #include "hbapicdp.h"
 #include "hbapierr.h"
+#include "hbapifs.h"
 #include "hbzlib.h"
 #include "hbvm.h"
 #include "hbstack.h"
@@ -100,6 +101,11 @@ HB_UCHAR [ 1 ] - item type
   40. HASHFLAGS         2
   41. HASHDEFAULT VALUE 0
   42. ZCOMPRESS         4+4+n
+  43. STREAM            1+1   (stream format header: version, flags)
+  44. STRDEF            2+n   (string added to string table)
+  45. STRIDX8           1     (index to string table)
+  46. STRIDX16          2     (index to string table)
+  47. CONTREF           4     (index to array of arrays and hashes)
 
 xHarbour types HB_SERIAL_XHB_*:
   67. 'C' <BE64:n><str> 8+n
@@ -166,6 +172,11 @@ complex ones:
 #define HB_SERIAL_HASHFLAGS  40
 #define HB_SERIAL_HASHDEFVAL 41
 #define HB_SERIAL_ZCOMPRESS  42
+#define HB_SERIAL_STREAM     43
+#define HB_SERIAL_STRDEF     44
+#define HB_SERIAL_STRIDX8    45
+#define HB_SERIAL_STRIDX16   46
+#define HB_SERIAL_CONTREF    47
 /* xHarbour types */
 #define HB_SERIAL_XHB_A      65
 #define HB_SERIAL_XHB_B      66
@@ -204,6 +215,8 @@ static HB_SIZE hb_deserializeItem( PHB_ITEM pItem,
                                    PHB_CODEPAGE cdpIn, PHB_CODEPAGE cdpOut,
                                    const HB_UCHAR * pBuffer, HB_SIZE nOffset,
                                    PHB_REF_LIST pRefList );
+static PHB_ITEM hb_serialReadMem( const char ** pBufferPtr, HB_SIZE * pnSize,
+                                  PHB_CODEPAGE cdpIn, PHB_CODEPAGE cdpOut );
 
 #if 0
 static void hb_itemSerialRefListShow( PHB_REF_LIST pRefList )
@@ -1610,7 +1623,19 @@ static HB_SIZE hb_deserializeItem( PHB_ITEM pItem,
 
                hb_itemSerialRefListInit( &refListZ );
                pBuffer = ( const HB_UCHAR * ) szVal;
-               if( hb_deserializeTest( &pBuffer, &nLen, 0, &refListZ ) )
+               if( nLen > 0 && *pBuffer == HB_SERIAL_STREAM )
+               {
+                  PHB_ITEM pValue = hb_serialReadMem( ( const char ** ) &pBuffer, &nLen,
+                                                      cdpIn, cdpOut );
+                  if( pValue )
+                  {
+                     hb_itemMove( pItem, pValue );
+                     hb_itemRelease( pValue );
+                  }
+                  else
+                     hb_itemClear( pItem );
+               }
+               else if( hb_deserializeTest( &pBuffer, &nLen, 0, &refListZ ) )
                   hb_deserializeItem( pItem, cdpIn, cdpOut, ( const HB_UCHAR * ) szVal, 0, &refListZ );
                else
                   hb_itemClear( pItem );
@@ -1797,6 +1822,701 @@ static HB_SIZE hb_deserializeItem( PHB_ITEM pItem,
    return nOffset;
 }
 
+/*
+ * stream format (HB_SERIALIZE_STRTABLE)
+ *
+ * Single pass format which can be written to and read from files
+ * without buffering whole data. It begins with HB_SERIAL_STREAM
+ * header and uses the same type codes as above for scalar values.
+ * Strings shorter then HB_SERIAL_STRTAB_*LEN are stored only once,
+ * next occurrences refer to string table index. Arrays and hashes
+ * are numbered in the order they appear and shared or cyclic
+ * references are stored as HB_SERIAL_CONTREF. Default hash value
+ * follows hash pairs instead of preceding them.
+ */
+
+#define HB_SERIAL_STREAM_VER     1
+#define HB_SERIAL_STREAM_REFS    0x01        /* arrays and hashes are numbered */
+
+#define HB_SERIAL_STRTAB_MAX     0x10000     /* maximal number of strings in table */
+#define HB_SERIAL_STRTAB_KEYLEN  255         /* maximal length of hash keys in table */
+#define HB_SERIAL_STRTAB_VALLEN  64          /* maximal length of other strings in table */
+#define HB_SERIAL_BUFSIZE        0x10000
+
+typedef struct
+{
+   const char *   szText;
+   HB_SIZE        nLen;
+   HB_SIZE        nIndex;
+} HB_SERIAL_STR, * PHB_SERIAL_STR;
+
+typedef struct
+{
+   void *         id;
+   HB_SIZE        nIndex;
+} HB_SERIAL_CONT, * PHB_SERIAL_CONT;
+
+typedef struct
+{
+   HB_UCHAR *     pBuffer;
+   HB_SIZE        nSize;
+   HB_SIZE        nPos;
+   PHB_FILE       pFile;
+   HB_BOOL        fError;
+   int            iFlags;
+   PHB_CODEPAGE   cdpIn;
+   PHB_CODEPAGE   cdpOut;
+   PHB_SERIAL_STR pStrings;      /* hash table of stored strings */
+   HB_SIZE        nStrSize;
+   HB_SIZE        nStrCount;
+   PHB_SERIAL_CONT pConts;       /* hash table of stored arrays and hashes */
+   HB_SIZE        nContSize;
+   HB_SIZE        nContCount;
+} HB_SERIAL_WR, * PHB_SERIAL_WR;
+
+typedef struct
+{
+   const HB_UCHAR * pBuffer;
+   HB_SIZE        nPos;
+   HB_SIZE        nLen;
+   HB_UCHAR *     pAlloc;
+   HB_SIZE        nSize;
+   PHB_FILE       pFile;
+   PHB_CODEPAGE   cdpIn;
+   PHB_CODEPAGE   cdpOut;
+   PHB_ITEM       pStrings;
+   PHB_ITEM       pConts;
+} HB_SERIAL_RD, * PHB_SERIAL_RD;
+
+static HB_SIZE hb_serialStrHash( const char * szText, HB_SIZE nLen )
+{
+   HB_U32 nHash = 2166136261U;
+
+   while( nLen-- )
+   {
+      nHash ^= ( HB_UCHAR ) *szText++;
+      nHash *= 16777619U;
+   }
+   return nHash;
+}
+
+/* returns HB_TRUE and string index if string is already in the table,
+   otherwise adds it and sets new index or HB_SERIAL_DUMMYOFFSET when
+   table is full */
+static HB_BOOL hb_serialStrIndex( PHB_SERIAL_WR pWr, const char * szText,
+                                  HB_SIZE nLen, HB_SIZE * pnIndex )
+{
+   HB_SIZE nMask, nSlot;
+
+   if( ( pWr->nStrCount + 1 ) << 1 > pWr->nStrSize )
+   {
+      PHB_SERIAL_STR pOld = pWr->pStrings;
+      HB_SIZE nOld = pWr->nStrSize, n;
+
+      if( pWr->nStrCount >= HB_SERIAL_STRTAB_MAX && pOld )
+      {
+         /* table is full, only search it */
+         nMask = nOld - 1;
+         nSlot = hb_serialStrHash( szText, nLen ) & nMask;
+         while( pOld[ nSlot ].szText )
+         {
+            if( pOld[ nSlot ].nLen == nLen &&
+                memcmp( pOld[ nSlot ].szText, szText, nLen ) == 0 )
+            {
+               *pnIndex = pOld[ nSlot ].nIndex;
+               return HB_TRUE;
+            }
+            nSlot = ( nSlot + 1 ) & nMask;
+         }
+         *pnIndex = HB_SERIAL_DUMMYOFFSET;
+         return HB_FALSE;
+      }
+
+      pWr->nStrSize = nOld ? nOld << 1 : 256;
+      pWr->pStrings = ( PHB_SERIAL_STR ) hb_xgrabz( pWr->nStrSize * sizeof( HB_SERIAL_STR ) );
+      nMask = pWr->nStrSize - 1;
+      for( n = 0; n < nOld; ++n )
+      {
+         if( pOld[ n ].szText )
+         {
+            nSlot = hb_serialStrHash( pOld[ n ].szText, pOld[ n ].nLen ) & nMask;
+            while( pWr->pStrings[ nSlot ].szText )
+               nSlot = ( nSlot + 1 ) & nMask;
+            pWr->pStrings[ nSlot ] = pOld[ n ];
+         }
+      }
+      if( pOld )
+         hb_xfree( pOld );
+   }
+
+   nMask = pWr->nStrSize - 1;
+   nSlot = hb_serialStrHash( szText, nLen ) & nMask;
+   while( pWr->pStrings[ nSlot ].szText )
+   {
+      if( pWr->pStrings[ nSlot ].nLen == nLen &&
+          memcmp( pWr->pStrings[ nSlot ].szText, szText, nLen ) == 0 )
+      {
+         *pnIndex = pWr->pStrings[ nSlot ].nIndex;
+         return HB_TRUE;
+      }
+      nSlot = ( nSlot + 1 ) & nMask;
+   }
+   pWr->pStrings[ nSlot ].szText = szText;
+   pWr->pStrings[ nSlot ].nLen = nLen;
+   pWr->pStrings[ nSlot ].nIndex = *pnIndex = pWr->nStrCount++;
+
+   return HB_FALSE;
+}
+
+/* returns HB_TRUE and index of already stored array or hash,
+   otherwise registers it */
+static HB_BOOL hb_serialContIndex( PHB_SERIAL_WR pWr, void * id, HB_SIZE * pnIndex )
+{
+   HB_SIZE nMask, nSlot;
+
+   if( ( pWr->nContCount + 1 ) << 1 > pWr->nContSize )
+   {
+      PHB_SERIAL_CONT pOld = pWr->pConts;
+      HB_SIZE nOld = pWr->nContSize, n;
+
+      pWr->nContSize = nOld ? nOld << 1 : 256;
+      pWr->pConts = ( PHB_SERIAL_CONT ) hb_xgrabz( pWr->nContSize * sizeof( HB_SERIAL_CONT ) );
+      nMask = pWr->nContSize - 1;
+      for( n = 0; n < nOld; ++n )
+      {
+         if( pOld[ n ].id )
+         {
+            nSlot = ( ( HB_PTRUINT ) pOld[ n ].id >> 3 ) * 2654435761U & nMask;
+            while( pWr->pConts[ nSlot ].id )
+               nSlot = ( nSlot + 1 ) & nMask;
+            pWr->pConts[ nSlot ] = pOld[ n ];
+         }
+      }
+      if( pOld )
+         hb_xfree( pOld );
+   }
+
+   nMask = pWr->nContSize - 1;
+   nSlot = ( ( HB_PTRUINT ) id >> 3 ) * 2654435761U & nMask;
+   while( pWr->pConts[ nSlot ].id )
+   {
+      if( pWr->pConts[ nSlot ].id == id )
+      {
+         *pnIndex = pWr->pConts[ nSlot ].nIndex;
+         return HB_TRUE;
+      }
+      nSlot = ( nSlot + 1 ) & nMask;
+   }
+   pWr->pConts[ nSlot ].id = id;
+   pWr->pConts[ nSlot ].nIndex = pWr->nContCount++;
+
+   return HB_FALSE;
+}
+
+static void hb_serialWrFlush( PHB_SERIAL_WR pWr )
+{
+   if( pWr->nPos > 0 && ! pWr->fError &&
+       hb_fileWrite( pWr->pFile, pWr->pBuffer, pWr->nPos, -1 ) != pWr->nPos )
+      pWr->fError = HB_TRUE;
+   pWr->nPos = 0;
+}
+
+/* returns buffer with at least nLen free bytes */
+static HB_UCHAR * hb_serialWrReserve( PHB_SERIAL_WR pWr, HB_SIZE nLen )
+{
+   if( pWr->nPos + nLen > pWr->nSize )
+   {
+      if( pWr->pFile )
+         hb_serialWrFlush( pWr );
+      if( pWr->nPos + nLen > pWr->nSize )
+      {
+         pWr->nSize += ( pWr->pFile ? 0 : pWr->nSize >> 1 ) + nLen;
+         pWr->pBuffer = ( HB_UCHAR * ) hb_xrealloc( pWr->pBuffer, pWr->nSize + 1 );
+      }
+   }
+   return pWr->pBuffer + pWr->nPos;
+}
+
+static void hb_serialWrCount( PHB_SERIAL_WR pWr, int iType8, HB_SIZE nLen )
+{
+   HB_UCHAR * pBuffer = hb_serialWrReserve( pWr, 5 );
+
+   if( nLen <= 255 )
+   {
+      pBuffer[ 0 ] = ( HB_UCHAR ) iType8;
+      pBuffer[ 1 ] = ( HB_UCHAR ) nLen;
+      pWr->nPos += 2;
+   }
+   else if( nLen <= UINT16_MAX )
+   {
+      pBuffer[ 0 ] = ( HB_UCHAR ) ( iType8 + 1 );
+      HB_PUT_LE_UINT16( &pBuffer[ 1 ], nLen );
+      pWr->nPos += 3;
+   }
+   else
+   {
+      pBuffer[ 0 ] = ( HB_UCHAR ) ( iType8 + 2 );
+      HB_PUT_LE_UINT32( &pBuffer[ 1 ], nLen );
+      pWr->nPos += 5;
+   }
+}
+
+static void hb_serialWrItem( PHB_SERIAL_WR pWr, PHB_ITEM pItem, HB_BOOL fKey )
+{
+   HB_UCHAR * pBuffer;
+   HB_SIZE nLen, nIndex, n;
+
+   if( HB_IS_BYREF( pItem ) )
+      pItem = hb_itemUnRef( pItem );
+
+   switch( hb_itemType( pItem ) )
+   {
+      case HB_IT_STRING:
+      case HB_IT_MEMO:
+         nLen = hb_itemGetCLen( pItem );
+         if( nLen > 0 &&
+             nLen <= ( fKey ? HB_SERIAL_STRTAB_KEYLEN : HB_SERIAL_STRTAB_VALLEN ) )
+         {
+            const char * szText = hb_itemGetCPtr( pItem );
+
+            if( hb_serialStrIndex( pWr, szText, nLen, &nIndex ) )
+            {
+               pBuffer = hb_serialWrReserve( pWr, 3 );
+               if( nIndex <= 255 )
+               {
+                  pBuffer[ 0 ] = HB_SERIAL_STRIDX8;
+                  pBuffer[ 1 ] = ( HB_UCHAR ) nIndex;
+                  pWr->nPos += 2;
+               }
+               else
+               {
+                  pBuffer[ 0 ] = HB_SERIAL_STRIDX16;
+                  HB_PUT_LE_UINT16( &pBuffer[ 1 ], nIndex );
+                  pWr->nPos += 3;
+               }
+               break;
+            }
+            else if( nIndex != HB_SERIAL_DUMMYOFFSET )
+            {
+               n = hb_cdpnDupLen( szText, nLen, pWr->cdpIn, pWr->cdpOut );
+               pBuffer = hb_serialWrReserve( pWr, n + 3 );
+               pBuffer[ 0 ] = HB_SERIAL_STRDEF;
+               HB_PUT_LE_UINT16( &pBuffer[ 1 ], n );
+               hb_cdpnDup2( szText, nLen, ( char * ) &pBuffer[ 3 ], &n,
+                            pWr->cdpIn, pWr->cdpOut );
+               pWr->nPos += n + 3;
+               break;
+            }
+         }
+         n = hb_itemSerialSize( pItem, pWr->iFlags, pWr->cdpIn, pWr->cdpOut, NULL, 0 );
+         hb_serialWrReserve( pWr, n );
+         pWr->nPos = hb_serializeItem( pItem, pWr->iFlags, pWr->cdpIn, pWr->cdpOut,
+                                       pWr->pBuffer, pWr->nPos, NULL );
+         break;
+
+      case HB_IT_ARRAY:
+      {
+         HB_USHORT uiClass;
+
+         if( ( pWr->iFlags & HB_SERIALIZE_IGNOREREF ) == 0 &&
+             hb_serialContIndex( pWr, hb_arrayId( pItem ), &nIndex ) )
+         {
+            pBuffer = hb_serialWrReserve( pWr, 5 );
+            pBuffer[ 0 ] = HB_SERIAL_CONTREF;
+            HB_PUT_LE_UINT32( &pBuffer[ 1 ], nIndex );
+            pWr->nPos += 5;
+            break;
+         }
+         uiClass = hb_objGetClass( pItem );
+         if( uiClass )
+         {
+            const char * szClass = hb_clsName( uiClass ),
+                       * szFunc = hb_clsFuncName( uiClass );
+            if( szClass && szFunc )
+            {
+               HB_SIZE nClass = strlen( szClass ) + 1, nFunc = strlen( szFunc ) + 1;
+
+               pBuffer = hb_serialWrReserve( pWr, nClass + nFunc + 1 );
+               pBuffer[ 0 ] = HB_SERIAL_OBJ;
+               memcpy( &pBuffer[ 1 ], szClass, nClass );
+               memcpy( &pBuffer[ 1 + nClass ], szFunc, nFunc );
+               pWr->nPos += nClass + nFunc + 1;
+            }
+         }
+         nLen = hb_arrayLen( pItem );
+         hb_serialWrCount( pWr, HB_SERIAL_ARRAY8, nLen );
+         for( n = 1; n <= nLen && ! pWr->fError; n++ )
+            hb_serialWrItem( pWr, hb_arrayGetItemPtr( pItem, n ), HB_FALSE );
+         break;
+      }
+
+      case HB_IT_HASH:
+      {
+         int iHashFlags;
+         PHB_ITEM pDefVal;
+
+         if( ( pWr->iFlags & HB_SERIALIZE_IGNOREREF ) == 0 &&
+             hb_serialContIndex( pWr, hb_hashId( pItem ), &nIndex ) )
+         {
+            pBuffer = hb_serialWrReserve( pWr, 5 );
+            pBuffer[ 0 ] = HB_SERIAL_CONTREF;
+            HB_PUT_LE_UINT32( &pBuffer[ 1 ], nIndex );
+            pWr->nPos += 5;
+            break;
+         }
+         iHashFlags = hb_hashGetFlags( pItem );
+         pDefVal = hb_hashGetDefault( pItem );
+         pBuffer = hb_serialWrReserve( pWr, 4 );
+         if( pDefVal )
+            *pBuffer++ = HB_SERIAL_HASHDEFVAL;
+         if( ( iHashFlags & ~HB_HASH_RESORT ) != HB_HASH_FLAG_DEFAULT )
+         {
+            pBuffer[ 0 ] = HB_SERIAL_HASHFLAGS;
+            HB_PUT_LE_UINT16( &pBuffer[ 1 ], iHashFlags );
+            pBuffer += 3;
+         }
+         pWr->nPos = pBuffer - pWr->pBuffer;
+         nLen = hb_hashLen( pItem );
+         hb_serialWrCount( pWr, HB_SERIAL_HASH8, nLen );
+         for( n = 1; n <= nLen && ! pWr->fError; n++ )
+         {
+            hb_serialWrItem( pWr, hb_hashGetKeyAt( pItem, n ), HB_TRUE );
+            hb_serialWrItem( pWr, hb_hashGetValueAt( pItem, n ), HB_FALSE );
+         }
+         if( pDefVal )
+            hb_serialWrItem( pWr, pDefVal, HB_FALSE );
+         break;
+      }
+
+      default:
+         /* scalar values: NIL, LOGICAL, DATE, TIMESTAMP, NUMERIC, SYMBOL */
+         hb_serialWrReserve( pWr, HB_SYMBOL_NAME_LEN + 16 );
+         pWr->nPos = hb_serializeItem( pItem, pWr->iFlags, pWr->cdpIn, pWr->cdpOut,
+                                       pWr->pBuffer, pWr->nPos, NULL );
+         break;
+   }
+}
+
+static HB_BOOL hb_serialWrite( PHB_SERIAL_WR pWr, PHB_ITEM pItem )
+{
+   HB_UCHAR * pBuffer = hb_serialWrReserve( pWr, 3 );
+
+   pBuffer[ 0 ] = HB_SERIAL_STREAM;
+   pBuffer[ 1 ] = HB_SERIAL_STREAM_VER;
+   pBuffer[ 2 ] = ( pWr->iFlags & HB_SERIALIZE_IGNOREREF ) ? 0 : HB_SERIAL_STREAM_REFS;
+   pWr->nPos += 3;
+
+   hb_serialWrItem( pWr, pItem, HB_FALSE );
+
+   if( pWr->pStrings )
+      hb_xfree( pWr->pStrings );
+   if( pWr->pConts )
+      hb_xfree( pWr->pConts );
+
+   return ! pWr->fError;
+}
+
+/* make at least nNeed bytes available */
+static HB_BOOL hb_serialRdNeed( PHB_SERIAL_RD pRd, HB_SIZE nNeed )
+{
+   HB_SIZE nLeft = pRd->nLen - pRd->nPos;
+
+   if( nLeft >= nNeed )
+      return HB_TRUE;
+   else if( ! pRd->pFile )
+      return HB_FALSE;
+
+   if( nNeed > pRd->nSize )
+   {
+      pRd->nSize = HB_MAX( nNeed, pRd->nSize << 1 );
+      pRd->pAlloc = ( HB_UCHAR * ) hb_xrealloc( pRd->pAlloc, pRd->nSize );
+   }
+   if( nLeft > 0 )
+      memmove( pRd->pAlloc, pRd->pAlloc + pRd->nPos, nLeft );
+   pRd->pBuffer = pRd->pAlloc;
+   pRd->nPos = 0;
+   pRd->nLen = nLeft;
+
+   while( pRd->nLen < nNeed )
+   {
+      HB_SIZE nRead = hb_fileRead( pRd->pFile, pRd->pAlloc + pRd->nLen,
+                                   pRd->nSize - pRd->nLen, -1 );
+      if( nRead == 0 || nRead == ( HB_SIZE ) FS_ERROR )
+         return HB_FALSE;
+      pRd->nLen += nRead;
+   }
+   return HB_TRUE;
+}
+
+static HB_BOOL hb_serialRdItem( PHB_SERIAL_RD pRd, PHB_ITEM pItem )
+{
+   const HB_UCHAR * pBuffer;
+   char * szVal;
+   HB_SIZE nLen, nIndex, n;
+
+   if( ! hb_serialRdNeed( pRd, 1 ) )
+      return HB_FALSE;
+
+   pBuffer = pRd->pBuffer + pRd->nPos;
+   switch( pBuffer[ 0 ] )
+   {
+      case HB_SERIAL_STRDEF:
+         if( ! hb_serialRdNeed( pRd, 3 ) ||
+             ! hb_serialRdNeed( pRd, 3 + HB_GET_LE_UINT16( pRd->pBuffer + pRd->nPos + 1 ) ) )
+            return HB_FALSE;
+         pBuffer = pRd->pBuffer + pRd->nPos;
+         nLen = n = HB_GET_LE_UINT16( &pBuffer[ 1 ] );
+         szVal = hb_cdpnDup( ( const char * ) &pBuffer[ 3 ], &nLen,
+                             pRd->cdpIn, pRd->cdpOut );
+         hb_itemPutCLPtr( pItem, szVal, nLen );
+         hb_arrayAdd( pRd->pStrings, pItem );
+         pRd->nPos += n + 3;
+         break;
+
+      case HB_SERIAL_STRIDX8:
+      case HB_SERIAL_STRIDX16:
+         n = pBuffer[ 0 ] == HB_SERIAL_STRIDX8 ? 2 : 3;
+         if( ! hb_serialRdNeed( pRd, n ) )
+            return HB_FALSE;
+         pBuffer = pRd->pBuffer + pRd->nPos;
+         nIndex = n == 2 ? pBuffer[ 1 ] : HB_GET_LE_UINT16( &pBuffer[ 1 ] );
+         if( ! hb_arrayGet( pRd->pStrings, nIndex + 1, pItem ) )
+            return HB_FALSE;
+         pRd->nPos += n;
+         break;
+
+      case HB_SERIAL_CONTREF:
+         if( ! hb_serialRdNeed( pRd, 5 ) )
+            return HB_FALSE;
+         nIndex = HB_GET_LE_UINT32( pRd->pBuffer + pRd->nPos + 1 );
+         if( ! pRd->pConts || ! hb_arrayGet( pRd->pConts, nIndex + 1, pItem ) )
+            return HB_FALSE;
+         pRd->nPos += 5;
+         break;
+
+      case HB_SERIAL_ARRAY8:
+      case HB_SERIAL_ARRAY16:
+      case HB_SERIAL_ARRAY32:
+      case HB_SERIAL_HASH8:
+      case HB_SERIAL_HASH16:
+      case HB_SERIAL_HASH32:
+      {
+         int iType = pBuffer[ 0 ];
+         HB_BOOL fHash = iType >= HB_SERIAL_HASH8;
+
+         switch( iType - ( fHash ? HB_SERIAL_HASH8 : HB_SERIAL_ARRAY8 ) )
+         {
+            case 0:
+               n = 2;
+               break;
+            case 1:
+               n = 3;
+               break;
+            default:
+               n = 5;
+         }
+         if( ! hb_serialRdNeed( pRd, n ) )
+            return HB_FALSE;
+         pBuffer = pRd->pBuffer + pRd->nPos;
+         nLen = n == 2 ? pBuffer[ 1 ] :
+                n == 3 ? HB_GET_LE_UINT16( &pBuffer[ 1 ] ) :
+                         HB_GET_LE_UINT32( &pBuffer[ 1 ] );
+         pRd->nPos += n;
+         /* protection against corrupted data */
+         if( ! pRd->pFile && nLen > pRd->nLen - pRd->nPos )
+            return HB_FALSE;
+
+         if( fHash )
+         {
+            PHB_ITEM pKey, pVal;
+
+            hb_hashNew( pItem );
+            hb_hashSetFlags( pItem, HB_HASH_BINARY | HB_HASH_RESORT );
+            hb_hashPreallocate( pItem, nLen );
+            if( pRd->pConts )
+               hb_arrayAdd( pRd->pConts, pItem );
+            while( nLen-- )
+            {
+               if( ! hb_hashAllocNewPair( pItem, &pKey, &pVal ) ||
+                   ! hb_serialRdItem( pRd, pKey ) ||
+                   ! hb_serialRdItem( pRd, pVal ) )
+                  return HB_FALSE;
+            }
+         }
+         else
+         {
+            hb_arrayNew( pItem, nLen );
+            if( pRd->pConts )
+               hb_arrayAdd( pRd->pConts, pItem );
+            for( n = 1; n <= nLen; n++ )
+            {
+               if( ! hb_serialRdItem( pRd, hb_arrayGetItemPtr( pItem, n ) ) )
+                  return HB_FALSE;
+            }
+         }
+         break;
+      }
+
+      case HB_SERIAL_HASHFLAGS:
+      {
+         int iHashFlags;
+
+         if( ! hb_serialRdNeed( pRd, 3 ) )
+            return HB_FALSE;
+         iHashFlags = HB_GET_LE_UINT16( pRd->pBuffer + pRd->nPos + 1 );
+         pRd->nPos += 3;
+         if( ! hb_serialRdItem( pRd, pItem ) || ! HB_IS_HASH( pItem ) )
+            return HB_FALSE;
+         hb_hashClearFlags( pItem, HB_HASH_FLAG_MASK );
+         if( ( iHashFlags & ( HB_HASH_KEEPORDER | HB_HASH_BINARY ) ) != HB_HASH_BINARY )
+            iHashFlags |= HB_HASH_RESORT;
+         hb_hashSetFlags( pItem, iHashFlags );
+         break;
+      }
+
+      case HB_SERIAL_HASHDEFVAL:
+      {
+         PHB_ITEM pDefVal;
+
+         pRd->nPos++;
+         if( ! hb_serialRdItem( pRd, pItem ) || ! HB_IS_HASH( pItem ) )
+            return HB_FALSE;
+         pDefVal = hb_itemNew( NULL );
+         if( ! hb_serialRdItem( pRd, pDefVal ) )
+         {
+            hb_itemRelease( pDefVal );
+            return HB_FALSE;
+         }
+         hb_hashSetDefault( pItem, pDefVal );
+         hb_itemRelease( pDefVal );
+         break;
+      }
+
+      case HB_SERIAL_OBJ:
+      {
+         char szClass[ HB_SYMBOL_NAME_LEN + 1 ], szFunc[ HB_SYMBOL_NAME_LEN + 1 ];
+         HB_SIZE nClass, nFunc;
+
+         for( ;; )
+         {
+            pBuffer = pRd->pBuffer + pRd->nPos;
+            nLen = pRd->nLen - pRd->nPos;
+            nClass = hb_strnlen( ( const char * ) pBuffer + 1, nLen - 1 );
+            if( nClass + 1 < nLen )
+            {
+               nFunc = hb_strnlen( ( const char * ) pBuffer + nClass + 2, nLen - nClass - 2 );
+               if( nClass + nFunc + 2 < nLen )
+                  break;
+            }
+            if( nLen > ( HB_SYMBOL_NAME_LEN + 1 ) * 2 || ! hb_serialRdNeed( pRd, nLen + 1 ) )
+               return HB_FALSE;
+         }
+         if( nClass > HB_SYMBOL_NAME_LEN || nFunc > HB_SYMBOL_NAME_LEN )
+            return HB_FALSE;
+         memcpy( szClass, pBuffer + 1, nClass + 1 );
+         memcpy( szFunc, pBuffer + nClass + 2, nFunc + 1 );
+         pRd->nPos += nClass + nFunc + 3;
+         if( ! hb_serialRdItem( pRd, pItem ) )
+            return HB_FALSE;
+         hb_objSetClass( pItem, szClass, szFunc );
+         break;
+      }
+
+      case HB_SERIAL_NIL:
+      case HB_SERIAL_TRUE:
+      case HB_SERIAL_FALSE:
+      case HB_SERIAL_ZERO:
+      case HB_SERIAL_INT8:
+      case HB_SERIAL_INT16:
+      case HB_SERIAL_INT24:
+      case HB_SERIAL_INT32:
+      case HB_SERIAL_INT64:
+      case HB_SERIAL_DOUBLE:
+      case HB_SERIAL_DATE:
+      case HB_SERIAL_STRING8:
+      case HB_SERIAL_STRING16:
+      case HB_SERIAL_STRING32:
+      case HB_SERIAL_SYMBOL:
+      case HB_SERIAL_STRNUL:
+      case HB_SERIAL_STRPAD8:
+      case HB_SERIAL_STRPAD16:
+      case HB_SERIAL_STRPAD32:
+      case HB_SERIAL_INT8NUM:
+      case HB_SERIAL_INT16NUM:
+      case HB_SERIAL_INT24NUM:
+      case HB_SERIAL_INT32NUM:
+      case HB_SERIAL_INT64NUM:
+      case HB_SERIAL_DBLNUM:
+      case HB_SERIAL_TIMESTAMP:
+         for( ;; )
+         {
+            pBuffer = pRd->pBuffer + pRd->nPos;
+            nLen = pRd->nLen - pRd->nPos;
+            if( hb_deserializeTest( &pBuffer, &nLen, 0, NULL ) )
+               break;
+            if( ! hb_serialRdNeed( pRd, pRd->nLen - pRd->nPos + 1 ) )
+               return HB_FALSE;
+         }
+         pRd->nPos = hb_deserializeItem( pItem, pRd->cdpIn, pRd->cdpOut,
+                                         pRd->pBuffer, pRd->nPos, NULL );
+         break;
+
+      default:
+         return HB_FALSE;
+   }
+
+   return HB_TRUE;
+}
+
+static PHB_ITEM hb_serialRead( PHB_SERIAL_RD pRd )
+{
+   PHB_ITEM pItem = NULL;
+
+   if( hb_serialRdNeed( pRd, 3 ) &&
+       pRd->pBuffer[ pRd->nPos ] == HB_SERIAL_STREAM &&
+       pRd->pBuffer[ pRd->nPos + 1 ] <= HB_SERIAL_STREAM_VER )
+   {
+      pRd->pStrings = hb_itemArrayNew( 0 );
+      if( pRd->pBuffer[ pRd->nPos + 2 ] & HB_SERIAL_STREAM_REFS )
+         pRd->pConts = hb_itemArrayNew( 0 );
+      pRd->nPos += 3;
+
+      pItem = hb_itemNew( NULL );
+      if( ! hb_serialRdItem( pRd, pItem ) )
+      {
+         hb_itemRelease( pItem );
+         pItem = NULL;
+      }
+      hb_itemRelease( pRd->pStrings );
+      if( pRd->pConts )
+         hb_itemRelease( pRd->pConts );
+   }
+   return pItem;
+}
+
+/* decode stream format from memory buffer */
+static PHB_ITEM hb_serialReadMem( const char ** pBufferPtr, HB_SIZE * pnSize,
+                                  PHB_CODEPAGE cdpIn, PHB_CODEPAGE cdpOut )
+{
+   HB_SERIAL_RD rd;
+   PHB_ITEM pItem;
+
+   memset( &rd, 0, sizeof( rd ) );
+   rd.pBuffer = ( const HB_UCHAR * ) *pBufferPtr;
+   rd.nLen = pnSize ? *pnSize : HB_SIZE_MAX;
+   rd.cdpIn = cdpIn;
+   rd.cdpOut = cdpOut;
+
+   pItem = hb_serialRead( &rd );
+   if( pItem )
+   {
+      *pBufferPtr += rd.nPos;
+      if( pnSize )
+         *pnSize -= rd.nPos;
+   }
+   return pItem;
+}
+
 /*
  * public API functions
  */
@@ -1804,16 +2524,34 @@ char * hb_itemSerializeCP( PHB_ITEM pItem, int iFlags,
                            PHB_CODEPAGE cdpIn, PHB_CODEPAGE cdpOut,
                            HB_SIZE * pnSize )
 {
-   HB_REF_LIST refList;
    HB_UCHAR * pBuffer;
    HB_SIZE nSize;
 
-   hb_itemSerialRefListInit( &refList );
-   nSize = hb_itemSerialSize( pItem, iFlags, cdpIn, cdpOut, &refList, 0 );
-   pBuffer = ( HB_UCHAR * ) hb_xgrab( nSize + 1 );
-   hb_itemSerialUnusedFree( &refList );
-   hb_serializeItem( pItem, iFlags, cdpIn, cdpOut, pBuffer, 0, &refList );
-   hb_itemSerialRefListFree( &refList );
+   if( iFlags & HB_SERIALIZE_STRTABLE )
+   {
+      HB_SERIAL_WR wr;
+
+      memset( &wr, 0, sizeof( wr ) );
+      wr.nSize = 256;
+      wr.pBuffer = ( HB_UCHAR * ) hb_xgrab( wr.nSize + 1 );
+      wr.iFlags = iFlags;
+      wr.cdpIn = cdpIn;
+      wr.cdpOut = cdpOut;
+      hb_serialWrite( &wr, pItem );
+      pBuffer = wr.pBuffer;
+      nSize = wr.nPos;
+   }
+   else
+   {
+      HB_REF_LIST refList;
+
+      hb_itemSerialRefListInit( &refList );
+      nSize = hb_itemSerialSize( pItem, iFlags, cdpIn, cdpOut, &refList, 0 );
+      pBuffer = ( HB_UCHAR * ) hb_xgrab( nSize + 1 );
+      hb_itemSerialUnusedFree( &refList );
+      hb_serializeItem( pItem, iFlags, cdpIn, cdpOut, pBuffer, 0, &refList );
+      hb_itemSerialRefListFree( &refList );
+   }
 
    if( ( iFlags & HB_SERIALIZE_COMPRESS ) != 0 && nSize > 20 )
    {
@@ -1857,6 +2595,9 @@ PHB_ITEM hb_itemDeserializeCP( const char ** pBufferPtr, HB_SIZE * pnSize,
    PHB_ITEM pItem = NULL;
    HB_REF_LIST refList;
 
+   if( ( ! pnSize || *pnSize > 0 ) && *pBuffer == HB_SERIAL_STREAM )
+      return hb_serialReadMem( pBufferPtr, pnSize, cdpIn, cdpOut );
+
    hb_itemSerialRefListInit( &refList );
    if( ! pnSize || hb_deserializeTest( ( const HB_UCHAR ** ) pBufferPtr, pnSize, 0, &refList ) )
    {
@@ -1873,6 +2614,51 @@ PHB_ITEM hb_itemDeserialize( const char ** pBufferPtr, HB_SIZE * pnSize )
    return hb_itemDeserializeCP( pBufferPtr, pnSize, NULL, NULL );
 }
 
+/* write item in stream format to given file */
+HB_BOOL hb_itemSerializeFile( PHB_ITEM pItem, int iFlags,
+                              PHB_CODEPAGE cdpIn, PHB_CODEPAGE cdpOut,
+                              PHB_FILE pFile )
+{
+   HB_SERIAL_WR wr;
+   HB_BOOL fResult;
+
+   memset( &wr, 0, sizeof( wr ) );
+   wr.nSize = HB_SERIAL_BUFSIZE;
+   wr.pBuffer = ( HB_UCHAR * ) hb_xgrab( wr.nSize + 1 );
+   wr.pFile = pFile;
+   wr.iFlags = iFlags | HB_SERIALIZE_STRTABLE;
+   wr.cdpIn = cdpIn;
+   wr.cdpOut = cdpOut;
+   fResult = hb_serialWrite( &wr, pItem );
+   hb_serialWrFlush( &wr );
+   hb_xfree( wr.pBuffer );
+
+   return fResult && ! wr.fError;
+}
+
+/* read single item stored by hb_itemSerializeFile(), file position
+   is set just after the decoded data */
+PHB_ITEM hb_itemDeserializeFile( PHB_FILE pFile,
+                                 PHB_CODEPAGE cdpIn, PHB_CODEPAGE cdpOut )
+{
+   HB_SERIAL_RD rd;
+   PHB_ITEM pItem;
+
+   memset( &rd, 0, sizeof( rd ) );
+   rd.nSize = HB_SERIAL_BUFSIZE;
+   rd.pBuffer = rd.pAlloc = ( HB_UCHAR * ) hb_xgrab( rd.nSize );
+   rd.pFile = pFile;
+   rd.cdpIn = cdpIn;
+   rd.cdpOut = cdpOut;
+
+   pItem = hb_serialRead( &rd );
+   if( rd.nLen > rd.nPos )
+      hb_fileSeek( pFile, -( HB_FOFFSET ) ( rd.nLen - rd.nPos ), FS_RELATIVE );
+   hb_xfree( rd.pAlloc );
+
+   return pItem;
+}
+
 HB_FUNC( HB_SERIALIZE )
 {
    PHB_ITEM pItem = hb_param( 1, HB_IT_ANY );
@@ -1934,3 +2720,44 @@ HB_FUNC( HB_DESERIALIZE )
    else if( pParam )
       hb_itemClear( pParam );
 }
+
+/* hb_vfSerialize( <pFile>, <xValue>, [<nFlags>], [<cCdpIn>], [<cCdpOut>] ) -> <lSuccess> */
+HB_FUNC( HB_VFSERIALIZE )
+{
+   PHB_FILE pFile = hb_fileParam( 1 );
+   PHB_ITEM pItem = hb_param( 2, HB_IT_ANY );
+
+   if( pFile && pItem )
+   {
+      const char * pszCdpIn = hb_parc( 4 ),
+                 * pszCdpOut = hb_parc( 5 );
+      PHB_CODEPAGE cdpIn, cdpOut;
+
+      cdpIn = pszCdpIn ? hb_cdpFindExt( pszCdpIn ) : hb_vmCDP();
+      cdpOut = pszCdpOut ? hb_cdpFindExt( pszCdpOut ) : hb_vmCDP();
+
+      hb_retl( hb_itemSerializeFile( pItem, hb_parni( 3 ),
+                                     cdpIn, cdpOut, pFile ) );
+   }
+}
+
+/* hb_vfDeserialize( <pFile>, [<cCdpIn>], [<cCdpOut>] ) -> <xValue> */
+HB_FUNC( HB_VFDESERIALIZE )
+{
+   PHB_FILE pFile = hb_fileParam( 1 );
+
+   if( pFile )
+   {
+      const char * pszCdpIn = hb_parc( 2 ),
+                 * pszCdpOut = hb_parc( 3 );
+      PHB_CODEPAGE cdpIn, cdpOut;
+      PHB_ITEM pItem;
+
+      cdpIn = pszCdpIn ? hb_cdpFindExt( pszCdpIn ) : hb_vmCDP();
+      cdpOut = pszCdpOut ? hb_cdpFindExt( pszCdpOut ) : hb_vmCDP();
+
+      pItem = hb_itemDeserializeFile( pFile, cdpIn, cdpOut );
+      if( pItem )
+         hb_itemReturnRelease( pItem );
+   }
+}
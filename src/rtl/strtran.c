@@ -82,31 +82,19 @@ HB_FUNC( STRTRAN )
             HB_SIZE nFound = 0;
             HB_SIZE nReplaced = 0;
             HB_SIZE nT = 0;
-            HB_SIZE nS = 0;
+            HB_SIZE nAt;
 
-            while( nT < nText && nText - nT >= nSeek - nS )
+            /* count occurrences to be replaced */
+            while( nText - nT >= nSeek &&
+                   ( nAt = hb_strAt( szSeek, nSeek, szText + nT, nText - nT ) ) != 0 )
             {
-               if( szText[ nT ] == szSeek[ nS ] )
+               nT += nAt - 1 + nSeek;
+               if( ++nFound >= nStart )
                {
-                  ++nT;
-                  if( ++nS == nSeek )
-                  {
-                     if( ++nFound >= nStart )
-                     {
-                        nReplaced++;
-                        if( --nCount == 0 )
-                           nT = nText;
-                     }
-                     nS = 0;
-                  }
-               }
-               else if( nS )
-               {
-                  nT -= nS - 1;
-                  nS = 0;
+                  nReplaced++;
+                  if( --nCount == 0 )
+                     break;
                }
-               else
-                  ++nT;
             }
 
             if( nReplaced )
@@ -123,46 +111,26 @@ HB_FUNC( STRTRAN )
                   char * szResult = ( char * ) hb_xgrab( nLength + 1 );
                   char * szPtr = szResult;
 
+                  /* occurrences before nStart are left unchanged */
                   nFound -= nReplaced;
-                  nT = nS = 0;
-                  do
+                  nT = 0;
+                  while( nFound )
                   {
-                     if( nReplaced && szText[ nT ] == szSeek[ nS ] )
-                     {
-                        ++nT;
-                        if( ++nS == nSeek )
-                        {
-                           const char * szCopy;
-
-                           if( nFound )
-                           {
-                              nFound--;
-                              szCopy = szSeek;
-                           }
-                           else
-                           {
-                              nReplaced--;
-                              szCopy = szReplace;
-                              nS = nReplace;
-                           }
-                           while( nS )
-                           {
-                              *szPtr++ = *szCopy++;
-                              --nS;
-                           }
-                        }
-                     }
-                     else
-                     {
-                        if( nS )
-                        {
-                           nT -= nS;
-                           nS = 0;
-                        }
-                        *szPtr++ = szText[ nT++ ];
-                     }
+                     nT += hb_strAt( szSeek, nSeek, szText + nT, nText - nT ) - 1 + nSeek;
+                     nFound--;
+                  }
+                  memcpy( szPtr, szText, nT );
+                  szPtr += nT;
+                  while( nReplaced-- )
+                  {
+                     nAt = hb_strAt( szSeek, nSeek, szText + nT, nText - nT ) - 1;
+                     memcpy( szPtr, szText + nT, nAt );
+                     szPtr += nAt;
+                     memcpy( szPtr, szReplace, nReplace );
+                     szPtr += nReplace;
+                     nT += nAt + nSeek;
                   }
-                  while( nT < nText );
+                  memcpy( szPtr, szText + nT, nText - nT );
 
                   hb_retclen_buffer( szResult, nLength );
                }
@@ -45,43 +45,13 @@
  */
 
 #include "hbapi.h"
+#include "hbapicdp.h"
 
 HB_FUNC( HB_STRISUTF8 )
 {
-   HB_SIZE nLen = hb_parclen( 1 );
-   HB_BOOL fUtf8 = HB_FALSE;
+   HB_SIZE nLen = hb_parclen( 1 ), nChars;
 
-   if( nLen > 0 )
-   {
-      const char * szText = hb_parc( 1 );
-
-      do
-      {
-         char c = *szText++;
-
-         if( c & 0x80 )
-         {
-            int i = 0;
-
-            while( ( c <<= 1 ) & 0x80  )
-               ++i;
-            if( i == 0 || ( HB_SIZE ) i >= nLen )
-               break;
-            nLen -= i;
-            do
-               if( ( *szText++ & 0xC0 ) != 0x80 )
-                  break;
-            while( --i );
-            if( i != 0 )
-               break;
-
-            fUtf8 = HB_TRUE;
-         }
-      }
-      while( --nLen );
-      if( nLen != 0 )
-         fUtf8 = HB_FALSE;
-   }
-
-   hb_retl( fUtf8 );
+   /* valid UTF-8 string containing at least one multibyte character */
+   hb_retl( nLen > 0 && hb_cdpUTF8Validate( hb_parc( 1 ), nLen, &nChars ) &&
+            nChars < nLen );
 }
@@ -48,40 +48,6 @@
 #include "hbapiitm.h"
 #include "hbapierr.h"
 
-/* trims from the left, and returns a new pointer to szText */
-/* also returns the new length in lLen */
-const char * hb_strLTrim( const char * szText, HB_SIZE * nLen )
-{
-   HB_TRACE( HB_TR_DEBUG, ( "hb_strLTrim(%s, %p)", szText, ( void * ) nLen ) );
-
-   while( *nLen && HB_ISSPACE( *szText ) )
-   {
-      szText++;
-      ( *nLen )--;
-   }
-
-   return szText;
-}
-
-/* return length of szText ignoring trailing white space (or true spaces) */
-HB_SIZE hb_strRTrimLen( const char * szText, HB_SIZE nLen, HB_BOOL bAnySpace )
-{
-   HB_TRACE( HB_TR_DEBUG, ( "hb_strRTrimLen(%s, %lu. %d)", szText, nLen, ( int ) bAnySpace ) );
-
-   if( bAnySpace )
-   {
-      while( nLen && HB_ISSPACE( szText[ nLen - 1 ] ) )
-         nLen--;
-   }
-   else
-   {
-      while( nLen && szText[ nLen - 1 ] == ' ' )
-         nLen--;
-   }
-
-   return nLen;
-}
-
 /* trims leading spaces from a string */
 
 HB_FUNC( LTRIM )
@@ -59,6 +59,18 @@
 
 static void hb_arrayReleaseItems( PHB_BASEARRAY pBaseArray )
 {
+   if( pBaseArray->fShared )
+   {
+      pBaseArray->fShared = HB_FALSE;
+      pBaseArray->fShareOwner = HB_FALSE;
+      /* items are still used by other copy-on-write clones */
+      if( pBaseArray->pItems && ! hb_xRefDec( pBaseArray->pItems ) )
+      {
+         pBaseArray->pItems = NULL;
+         pBaseArray->nLen = pBaseArray->nAllocated = 0;
+      }
+   }
+
    if( pBaseArray->nLen )
    {
       do
@@ -175,6 +187,9 @@ HB_BOOL hb_arrayNew( PHB_ITEM pItem, HB_SIZE nLen ) /* creates a new array */
    pBaseArray->uiClass    = 0;
    pBaseArray->uiPrevCls  = 0;
    pBaseArray->nAllocated = nLen;
+   pBaseArray->fShared    = HB_FALSE;
+   pBaseArray->fFrozen    = HB_FALSE;
+   pBaseArray->fShareOwner = HB_FALSE;
    pItem->type = HB_IT_ARRAY;
    pItem->item.asArray.value = pBaseArray;
 
@@ -185,7 +200,9 @@ void hb_arraySwap( PHB_ITEM pArray1, PHB_ITEM pArray2 )
 {
    HB_TRACE( HB_TR_DEBUG, ( "hb_arraySwap(%p, %p)", ( void * ) pArray1, ( void * ) pArray2 ) );
 
-   if( HB_IS_ARRAY( pArray1 ) && HB_IS_ARRAY( pArray2 ) )
+   if( HB_IS_ARRAY( pArray1 ) && HB_IS_ARRAY( pArray2 ) &&
+       HB_ARRAY_WRITABLE( pArray1->item.asArray.value ) &&
+       HB_ARRAY_WRITABLE( pArray2->item.asArray.value ) )
    {
       HB_BASEARRAY tmpBaseArray;
 
@@ -207,6 +224,9 @@ HB_BOOL hb_arraySize( PHB_ITEM pArray, HB_SIZE nLen )
       {
          HB_SIZE nPos;
 
+         if( ! HB_ARRAY_WRITABLE( pBaseArray ) )
+            return HB_FALSE;
+
          if( pBaseArray->nLen == 0 )
          {
             pBaseArray->pItems = ( PHB_ITEM ) hb_xgrab( nLen * sizeof( HB_ITEM ) );
@@ -321,9 +341,9 @@ HB_BOOL hb_arrayAdd( PHB_ITEM pArray, PHB_ITEM pValue )
    {
       PHB_BASEARRAY pBaseArray = ( PHB_BASEARRAY ) pArray->item.asArray.value;
 
-      if( pBaseArray->nLen < HB_SIZE_MAX )
+      if( pBaseArray->nLen < HB_SIZE_MAX &&
+          hb_arraySize( pArray, pBaseArray->nLen + 1 ) )
       {
-         hb_arraySize( pArray, pBaseArray->nLen + 1 );
          pBaseArray = ( PHB_BASEARRAY ) pArray->item.asArray.value;
          hb_itemCopy( pBaseArray->pItems + ( pBaseArray->nLen - 1 ), pValue );
 
@@ -342,9 +362,9 @@ HB_BOOL hb_arrayAddForward( PHB_ITEM pArray, PHB_ITEM pValue )
    {
       PHB_BASEARRAY pBaseArray = ( PHB_BASEARRAY ) pArray->item.asArray.value;
 
-      if( pBaseArray->nLen < HB_SIZE_MAX )
+      if( pBaseArray->nLen < HB_SIZE_MAX &&
+          hb_arraySize( pArray, pBaseArray->nLen + 1 ) )
       {
-         hb_arraySize( pArray, pBaseArray->nLen + 1 );
          pBaseArray = ( PHB_BASEARRAY ) pArray->item.asArray.value;
          hb_itemMove( pBaseArray->pItems + ( pBaseArray->nLen - 1 ), pValue );
 
@@ -367,6 +387,9 @@ HB_BOOL hb_arrayDel( PHB_ITEM pArray, HB_SIZE nIndex )
       {
          PHB_BASEARRAY pBaseArray = pArray->item.asArray.value;
 
+         if( ! HB_ARRAY_WRITABLE( pBaseArray ) )
+            return HB_FALSE;
+
          if( nIndex == nLen )
          {
             hb_itemSetNil( pBaseArray->pItems + nIndex - 1 );
@@ -397,6 +420,9 @@ HB_BOOL hb_arrayIns( PHB_ITEM pArray, HB_SIZE nIndex )
       {
          PHB_BASEARRAY pBaseArray = pArray->item.asArray.value;
 
+         if( ! HB_ARRAY_WRITABLE( pBaseArray ) )
+            return HB_FALSE;
+
          if( nIndex == nLen )
          {
             hb_itemSetNil( pBaseArray->pItems + nIndex - 1 );
@@ -419,7 +445,8 @@ HB_BOOL hb_arraySet( PHB_ITEM pArray, HB_SIZE nIndex, PHB_ITEM pItem )
 {
    HB_TRACE( HB_TR_DEBUG, ( "hb_arraySet(%p, %" HB_PFS "u, %p)", ( void * ) pArray, nIndex, ( void * ) pItem ) );
 
-   if( HB_IS_ARRAY( pArray ) && nIndex > 0 && nIndex <= pArray->item.asArray.value->nLen )
+   if( HB_IS_ARRAY( pArray ) && nIndex > 0 && nIndex <= pArray->item.asArray.value->nLen &&
+       HB_ARRAY_WRITABLE( pArray->item.asArray.value ) )
    {
       hb_itemCopy( pArray->item.asArray.value->pItems + ( nIndex - 1 ), pItem );
       return HB_TRUE;
@@ -432,7 +459,8 @@ HB_BOOL hb_arraySetForward( PHB_ITEM pArray, HB_SIZE nIndex, PHB_ITEM pItem )
 {
    HB_TRACE( HB_TR_DEBUG, ( "hb_arraySetForward(%p, %" HB_PFS "u, %p)", ( void * ) pArray, nIndex, ( void * ) pItem ) );
 
-   if( HB_IS_ARRAY( pArray ) && nIndex > 0 && nIndex <= pArray->item.asArray.value->nLen )
+   if( HB_IS_ARRAY( pArray ) && nIndex > 0 && nIndex <= pArray->item.asArray.value->nLen &&
+       HB_ARRAY_WRITABLE( pArray->item.asArray.value ) )
    {
       hb_itemMove( pArray->item.asArray.value->pItems + ( nIndex - 1 ), pItem );
       return HB_TRUE;
@@ -450,6 +478,7 @@ HB_BOOL hb_arrayGet( PHB_ITEM pArray, HB_SIZE nIndex, PHB_ITEM pItem )
 
    if( HB_IS_ARRAY( pArray ) && nIndex > 0 && nIndex <= pArray->item.asArray.value->nLen )
    {
+      HB_ARRAY_UNSHARE_GET( pArray->item.asArray.value, nIndex - 1 );
       hb_itemCopy( pItem, pArray->item.asArray.value->pItems + ( nIndex - 1 ) );
       return HB_TRUE;
    }
@@ -464,7 +493,8 @@ HB_BOOL hb_arrayGetItemRef( PHB_ITEM pArray, HB_SIZE nIndex, PHB_ITEM pItem )
 {
    HB_TRACE( HB_TR_DEBUG, ( "hb_arrayGetItemRef(%p, %" HB_PFS "u, %p)", ( void * ) pArray, nIndex, ( void * ) pItem ) );
 
-   if( HB_IS_ARRAY( pArray ) && nIndex > 0 && nIndex <= pArray->item.asArray.value->nLen )
+   if( HB_IS_ARRAY( pArray ) && nIndex > 0 && nIndex <= pArray->item.asArray.value->nLen &&
+       ! pArray->item.asArray.value->fFrozen )
    {
       if( pArray != pItem )
       {
@@ -494,7 +524,10 @@ PHB_ITEM hb_arrayGetItemPtr( PHB_ITEM pArray, HB_SIZE nIndex )
    HB_TRACE( HB_TR_DEBUG, ( "hb_arrayGetItemPtr(%p, %" HB_PFS "u)", ( void * ) pArray, nIndex ) );
 
    if( HB_IS_ARRAY( pArray ) && nIndex > 0 && nIndex <= pArray->item.asArray.value->nLen )
+   {
+      HB_ARRAY_UNSHARE( pArray->item.asArray.value );
       return pArray->item.asArray.value->pItems + nIndex - 1;
+   }
    else
       return NULL;
 }
@@ -703,7 +736,8 @@ HB_BOOL hb_arraySetDS( PHB_ITEM pArray, HB_SIZE nIndex, const char * szDate )
 {
    HB_TRACE( HB_TR_DEBUG, ( "hb_arraySetDS(%p, %" HB_PFS "u, %s)", ( void * ) pArray, nIndex, szDate ) );
 
-   if( HB_IS_ARRAY( pArray ) && nIndex > 0 && nIndex <= pArray->item.asArray.value->nLen )
+   if( HB_IS_ARRAY( pArray ) && nIndex > 0 && nIndex <= pArray->item.asArray.value->nLen &&
+       HB_ARRAY_WRITABLE( pArray->item.asArray.value ) )
    {
       hb_itemPutDS( pArray->item.asArray.value->pItems + nIndex - 1, szDate );
       return HB_TRUE;
@@ -716,7 +750,8 @@ HB_BOOL hb_arraySetDL( PHB_ITEM pArray, HB_SIZE nIndex, long lDate )
 {
    HB_TRACE( HB_TR_DEBUG, ( "hb_arraySetDL(%p, %" HB_PFS "u, %ld)", ( void * ) pArray, nIndex, lDate ) );
 
-   if( HB_IS_ARRAY( pArray ) && nIndex > 0 && nIndex <= pArray->item.asArray.value->nLen )
+   if( HB_IS_ARRAY( pArray ) && nIndex > 0 && nIndex <= pArray->item.asArray.value->nLen &&
+       HB_ARRAY_WRITABLE( pArray->item.asArray.value ) )
    {
       hb_itemPutDL( pArray->item.asArray.value->pItems + nIndex - 1, lDate );
       return HB_TRUE;
@@ -729,7 +764,8 @@ HB_BOOL hb_arraySetTD( PHB_ITEM pArray, HB_SIZE nIndex, double dTimeStamp )
 {
    HB_TRACE( HB_TR_DEBUG, ( "hb_arraySetTD(%p, %" HB_PFS "u, %lf)", ( void * ) pArray, nIndex, dTimeStamp ) );
 
-   if( HB_IS_ARRAY( pArray ) && nIndex > 0 && nIndex <= pArray->item.asArray.value->nLen )
+   if( HB_IS_ARRAY( pArray ) && nIndex > 0 && nIndex <= pArray->item.asArray.value->nLen &&
+       HB_ARRAY_WRITABLE( pArray->item.asArray.value ) )
    {
       hb_itemPutTD( pArray->item.asArray.value->pItems + nIndex - 1, dTimeStamp );
       return HB_TRUE;
@@ -742,7 +778,8 @@ HB_BOOL hb_arraySetTDT( PHB_ITEM pArray, HB_SIZE nIndex, long lJulian, long lMil
 {
    HB_TRACE( HB_TR_DEBUG, ( "hb_arraySetTDT(%p, %" HB_PFS "u, %lu, %lu)", ( void * ) pArray, nIndex, lJulian, lMilliSec ) );
 
-   if( HB_IS_ARRAY( pArray ) && nIndex > 0 && nIndex <= pArray->item.asArray.value->nLen )
+   if( HB_IS_ARRAY( pArray ) && nIndex > 0 && nIndex <= pArray->item.asArray.value->nLen &&
+       HB_ARRAY_WRITABLE( pArray->item.asArray.value ) )
    {
       hb_itemPutTDT( pArray->item.asArray.value->pItems + nIndex - 1, lJulian, lMilliSec );
       return HB_TRUE;
@@ -755,7 +792,8 @@ HB_BOOL hb_arraySetL( PHB_ITEM pArray, HB_SIZE nIndex, HB_BOOL fValue )
 {
    HB_TRACE( HB_TR_DEBUG, ( "hb_arraySetL(%p, %" HB_PFS "u, %d)", ( void * ) pArray, nIndex, fValue ) );
 
-   if( HB_IS_ARRAY( pArray ) && nIndex > 0 && nIndex <= pArray->item.asArray.value->nLen )
+   if( HB_IS_ARRAY( pArray ) && nIndex > 0 && nIndex <= pArray->item.asArray.value->nLen &&
+       HB_ARRAY_WRITABLE( pArray->item.asArray.value ) )
    {
       hb_itemPutL( pArray->item.asArray.value->pItems + nIndex - 1, fValue );
       return HB_TRUE;
@@ -768,7 +806,8 @@ HB_BOOL hb_arraySetNI( PHB_ITEM pArray, HB_SIZE nIndex, int iNumber )
 {
    HB_TRACE( HB_TR_DEBUG, ( "hb_arraySetNI(%p, %" HB_PFS "u, %d)", ( void * ) pArray, nIndex, iNumber ) );
 
-   if( HB_IS_ARRAY( pArray ) && nIndex > 0 && nIndex <= pArray->item.asArray.value->nLen )
+   if( HB_IS_ARRAY( pArray ) && nIndex > 0 && nIndex <= pArray->item.asArray.value->nLen &&
+       HB_ARRAY_WRITABLE( pArray->item.asArray.value ) )
    {
       hb_itemPutNI( pArray->item.asArray.value->pItems + nIndex - 1, iNumber );
       return HB_TRUE;
@@ -781,7 +820,8 @@ HB_BOOL hb_arraySetNL( PHB_ITEM pArray, HB_SIZE nIndex, long lNumber )
 {
    HB_TRACE( HB_TR_DEBUG, ( "hb_arraySetNL(%p, %" HB_PFS "u, %lu)", ( void * ) pArray, nIndex, lNumber ) );
 
-   if( HB_IS_ARRAY( pArray ) && nIndex > 0 && nIndex <= pArray->item.asArray.value->nLen )
+   if( HB_IS_ARRAY( pArray ) && nIndex > 0 && nIndex <= pArray->item.asArray.value->nLen &&
+       HB_ARRAY_WRITABLE( pArray->item.asArray.value ) )
    {
       hb_itemPutNL( pArray->item.asArray.value->pItems + nIndex - 1, lNumber );
       return HB_TRUE;
@@ -794,7 +834,8 @@ HB_BOOL hb_arraySetNS( PHB_ITEM pArray, HB_SIZE nIndex, HB_ISIZ nNumber )
 {
    HB_TRACE( HB_TR_DEBUG, ( "hb_arraySetNS(%p, %" HB_PFS "u, %" HB_PFS "d)", ( void * ) pArray, nIndex, nNumber ) );
 
-   if( HB_IS_ARRAY( pArray ) && nIndex > 0 && nIndex <= pArray->item.asArray.value->nLen )
+   if( HB_IS_ARRAY( pArray ) && nIndex > 0 && nIndex <= pArray->item.asArray.value->nLen &&
+       HB_ARRAY_WRITABLE( pArray->item.asArray.value ) )
    {
       hb_itemPutNS( pArray->item.asArray.value->pItems + nIndex - 1, nNumber );
       return HB_TRUE;
@@ -808,7 +849,8 @@ HB_BOOL hb_arraySetNLL( PHB_ITEM pArray, HB_SIZE nIndex, HB_LONGLONG llNumber )
 {
    HB_TRACE( HB_TR_DEBUG, ( "hb_arraySetNLL(%p, %" HB_PFS "u, %" PFLL "d)", ( void * ) pArray, nIndex, llNumber ) );
 
-   if( HB_IS_ARRAY( pArray ) && nIndex > 0 && nIndex <= pArray->item.asArray.value->nLen )
+   if( HB_IS_ARRAY( pArray ) && nIndex > 0 && nIndex <= pArray->item.asArray.value->nLen &&
+       HB_ARRAY_WRITABLE( pArray->item.asArray.value ) )
    {
       hb_itemPutNLL( pArray->item.asArray.value->pItems + nIndex - 1, llNumber );
       return HB_TRUE;
@@ -822,7 +864,8 @@ HB_BOOL hb_arraySetNInt( PHB_ITEM pArray, HB_SIZE nIndex, HB_MAXINT nNumber )
 {
    HB_TRACE( HB_TR_DEBUG, ( "hb_arraySetNInt(%p, %" HB_PFS "u, %" PFHL "d)", ( void * ) pArray, nIndex, nNumber ) );
 
-   if( HB_IS_ARRAY( pArray ) && nIndex > 0 && nIndex <= pArray->item.asArray.value->nLen )
+   if( HB_IS_ARRAY( pArray ) && nIndex > 0 && nIndex <= pArray->item.asArray.value->nLen &&
+       HB_ARRAY_WRITABLE( pArray->item.asArray.value ) )
    {
       hb_itemPutNInt( pArray->item.asArray.value->pItems + nIndex - 1, nNumber );
       return HB_TRUE;
@@ -835,7 +878,8 @@ HB_BOOL hb_arraySetND( PHB_ITEM pArray, HB_SIZE nIndex, double dNumber )
 {
    HB_TRACE( HB_TR_DEBUG, ( "hb_arraySetND(%p, %" HB_PFS "u, %lf)", ( void * ) pArray, nIndex, dNumber ) );
 
-   if( HB_IS_ARRAY( pArray ) && nIndex > 0 && nIndex <= pArray->item.asArray.value->nLen )
+   if( HB_IS_ARRAY( pArray ) && nIndex > 0 && nIndex <= pArray->item.asArray.value->nLen &&
+       HB_ARRAY_WRITABLE( pArray->item.asArray.value ) )
    {
       hb_itemPutND( pArray->item.asArray.value->pItems + nIndex - 1, dNumber );
       return HB_TRUE;
@@ -848,7 +892,8 @@ HB_BOOL hb_arraySetC( PHB_ITEM pArray, HB_SIZE nIndex, const char * szText )
 {
    HB_TRACE( HB_TR_DEBUG, ( "hb_arraySetC(%p, %" HB_PFS "u, %p)", ( void * ) pArray, nIndex, ( const void * ) szText ) );
 
-   if( HB_IS_ARRAY( pArray ) && nIndex > 0 && nIndex <= pArray->item.asArray.value->nLen )
+   if( HB_IS_ARRAY( pArray ) && nIndex > 0 && nIndex <= pArray->item.asArray.value->nLen &&
+       HB_ARRAY_WRITABLE( pArray->item.asArray.value ) )
    {
       hb_itemPutC( pArray->item.asArray.value->pItems + nIndex - 1, szText );
       return HB_TRUE;
@@ -861,7 +906,8 @@ HB_BOOL hb_arraySetCL( PHB_ITEM pArray, HB_SIZE nIndex, const char * szText, HB_
 {
    HB_TRACE( HB_TR_DEBUG, ( "hb_arraySetC(%p, %" HB_PFS "u, %p, %" HB_PFS "u)", ( void * ) pArray, nIndex, ( const void * ) szText, nLen ) );
 
-   if( HB_IS_ARRAY( pArray ) && nIndex > 0 && nIndex <= pArray->item.asArray.value->nLen )
+   if( HB_IS_ARRAY( pArray ) && nIndex > 0 && nIndex <= pArray->item.asArray.value->nLen &&
+       HB_ARRAY_WRITABLE( pArray->item.asArray.value ) )
    {
       hb_itemPutCL( pArray->item.asArray.value->pItems + nIndex - 1, szText, nLen );
       return HB_TRUE;
@@ -874,7 +920,8 @@ HB_BOOL hb_arraySetCPtr( PHB_ITEM pArray, HB_SIZE nIndex, char * szText )
 {
    HB_TRACE( HB_TR_DEBUG, ( "hb_arraySetCPtr(%p, %" HB_PFS "u, %p)", ( void * ) pArray, nIndex, ( void * ) szText ) );
 
-   if( HB_IS_ARRAY( pArray ) && nIndex > 0 && nIndex <= pArray->item.asArray.value->nLen )
+   if( HB_IS_ARRAY( pArray ) && nIndex > 0 && nIndex <= pArray->item.asArray.value->nLen &&
+       HB_ARRAY_WRITABLE( pArray->item.asArray.value ) )
    {
       hb_itemPutCPtr( pArray->item.asArray.value->pItems + nIndex - 1, szText );
       return HB_TRUE;
@@ -887,7 +934,8 @@ HB_BOOL hb_arraySetCLPtr( PHB_ITEM pArray, HB_SIZE nIndex, char * szText, HB_SIZ
 {
    HB_TRACE( HB_TR_DEBUG, ( "hb_arraySetCLPtr(%p, %" HB_PFS "u, %p, %" HB_PFS "u)", ( void * ) pArray, nIndex, ( void * ) szText, nLen ) );
 
-   if( HB_IS_ARRAY( pArray ) && nIndex > 0 && nIndex <= pArray->item.asArray.value->nLen )
+   if( HB_IS_ARRAY( pArray ) && nIndex > 0 && nIndex <= pArray->item.asArray.value->nLen &&
+       HB_ARRAY_WRITABLE( pArray->item.asArray.value ) )
    {
       hb_itemPutCLPtr( pArray->item.asArray.value->pItems + nIndex - 1, szText, nLen );
       return HB_TRUE;
@@ -900,7 +948,8 @@ HB_BOOL hb_arraySetCConst( PHB_ITEM pArray, HB_SIZE nIndex, const char * szText
 {
    HB_TRACE( HB_TR_DEBUG, ( "hb_arraySetCConst(%p, %" HB_PFS "u, %p)", ( void * ) pArray, nIndex, ( const void * ) szText ) );
 
-   if( HB_IS_ARRAY( pArray ) && nIndex > 0 && nIndex <= pArray->item.asArray.value->nLen )
+   if( HB_IS_ARRAY( pArray ) && nIndex > 0 && nIndex <= pArray->item.asArray.value->nLen &&
+       HB_ARRAY_WRITABLE( pArray->item.asArray.value ) )
    {
       hb_itemPutCConst( pArray->item.asArray.value->pItems + nIndex - 1, szText );
       return HB_TRUE;
@@ -913,7 +962,8 @@ HB_BOOL hb_arraySetPtr( PHB_ITEM pArray, HB_SIZE nIndex, void * pValue )
 {
    HB_TRACE( HB_TR_DEBUG, ( "hb_arraySetPtr(%p, %" HB_PFS "u, %p)", ( void * ) pArray, nIndex, pValue ) );
 
-   if( HB_IS_ARRAY( pArray ) && nIndex > 0 && nIndex <= pArray->item.asArray.value->nLen )
+   if( HB_IS_ARRAY( pArray ) && nIndex > 0 && nIndex <= pArray->item.asArray.value->nLen &&
+       HB_ARRAY_WRITABLE( pArray->item.asArray.value ) )
    {
       hb_itemPutPtr( pArray->item.asArray.value->pItems + nIndex - 1, pValue );
       return HB_TRUE;
@@ -926,7 +976,8 @@ HB_BOOL hb_arraySetPtrGC( PHB_ITEM pArray, HB_SIZE nIndex, void * pValue )
 {
    HB_TRACE( HB_TR_DEBUG, ( "hb_arraySetPtrGC(%p, %" HB_PFS "u, %p)", ( void * ) pArray, nIndex, pValue ) );
 
-   if( HB_IS_ARRAY( pArray ) && nIndex > 0 && nIndex <= pArray->item.asArray.value->nLen )
+   if( HB_IS_ARRAY( pArray ) && nIndex > 0 && nIndex <= pArray->item.asArray.value->nLen &&
+       HB_ARRAY_WRITABLE( pArray->item.asArray.value ) )
    {
       hb_itemPutPtrGC( pArray->item.asArray.value->pItems + nIndex - 1, pValue );
       return HB_TRUE;
@@ -939,7 +990,8 @@ HB_BOOL hb_arraySetSymbol( PHB_ITEM pArray, HB_SIZE nIndex, PHB_SYMB pSymbol )
 {
    HB_TRACE( HB_TR_DEBUG, ( "hb_arraySetSymbol(%p, %" HB_PFS "u, %p)", ( void * ) pArray, nIndex, ( void * ) pSymbol ) );
 
-   if( HB_IS_ARRAY( pArray ) && nIndex > 0 && nIndex <= pArray->item.asArray.value->nLen )
+   if( HB_IS_ARRAY( pArray ) && nIndex > 0 && nIndex <= pArray->item.asArray.value->nLen &&
+       HB_ARRAY_WRITABLE( pArray->item.asArray.value ) )
    {
       hb_itemPutSymbol( pArray->item.asArray.value->pItems + nIndex - 1, pSymbol );
       return HB_TRUE;
@@ -955,8 +1007,12 @@ HB_BOOL hb_arrayLast( PHB_ITEM pArray, PHB_ITEM pResult )
    if( HB_IS_ARRAY( pArray ) )
    {
       if( pArray->item.asArray.value->nLen > 0 )
+      {
+         HB_ARRAY_UNSHARE_GET( pArray->item.asArray.value,
+                               pArray->item.asArray.value->nLen - 1 );
          hb_itemCopy( pResult, pArray->item.asArray.value->pItems +
                              ( pArray->item.asArray.value->nLen - 1 ) );
+      }
       else
          hb_itemSetNil( pResult );
 
@@ -991,6 +1047,8 @@ HB_BOOL hb_arrayFill( PHB_ITEM pArray, PHB_ITEM pValue, HB_SIZE * pnStart, HB_SI
 
          if( nCount > 0 )
          {
+            if( ! HB_ARRAY_WRITABLE( pBaseArray ) )
+               return HB_FALSE;
             do
             {
                hb_itemCopy( pBaseArray->pItems + nStart++, pValue );
@@ -1034,6 +1092,7 @@ HB_SIZE hb_arrayScanCase( PHB_ITEM pArray, PHB_ITEM pValue, HB_SIZE * pnStart, H
             if( HB_IS_BLOCK( pValue ) )
             {
                HB_STACK_TLS_PRELOAD
+               HB_ARRAY_UNSHARE( pBaseArray );
                do
                {
                   hb_vmPushEvalSym();
@@ -1215,6 +1274,7 @@ HB_SIZE hb_arrayRevScan( PHB_ITEM pArray, PHB_ITEM pValue, HB_SIZE * pnStart, HB
             if( HB_IS_BLOCK( pValue ) )
             {
                HB_STACK_TLS_PRELOAD
+               HB_ARRAY_UNSHARE( pBaseArray );
                do
                {
                   hb_vmPushEvalSym();
@@ -1389,6 +1449,7 @@ HB_BOOL hb_arrayEval( PHB_ITEM pArray, PHB_ITEM bBlock, HB_SIZE * pnStart, HB_SI
 
          if( nCount > 0 )
          {
+            HB_ARRAY_UNSHARE( pBaseArray );
             do
             {
                hb_vmPushEvalSym();
@@ -1469,6 +1530,10 @@ HB_BOOL hb_arrayCopy( PHB_ITEM pSrcArray, PHB_ITEM pDstArray, HB_SIZE * pnStart,
                if( nCount > nDstLen - nTarget )
                   nCount = nDstLen - nTarget + 1;
 
+               if( ! HB_ARRAY_WRITABLE( pDstBaseArray ) )
+                  return HB_FALSE;
+               HB_ARRAY_UNSHARE( pSrcBaseArray );
+
                for( nTarget--, nStart--; nCount > 0; nCount--, nStart++, nTarget++ )
                   hb_itemCopy( pDstBaseArray->pItems + nTarget, pSrcBaseArray->pItems + nStart );
             }
@@ -1601,6 +1666,281 @@ PHB_ITEM hb_arrayClone( PHB_ITEM pArray )
    return hb_arrayCloneTo( hb_itemNew( NULL ), pArray );
 }
 
+/* Copy-on-write clones share items with the source array until one of
+ * them is modified. Nested arrays and hashes are not cloned when the
+ * items are shared, they are replaced by copy-on-write clones when
+ * the items are made private by the first write or by extracting
+ * a nested array or hash item, so only the modified levels are copied.
+ * The source array (share owner) keeps its own nested arrays and hashes
+ * so references to them taken before cloning still point to its items,
+ * when it makes the items private the shared ones receive copy-on-write
+ * clones instead. Nested arrays and hashes modified by such references
+ * before the clone makes its items private are not protected.
+ */
+void hb_arrayUnshare( PHB_BASEARRAY pBaseArray )
+{
+   PHB_ITEM pItems = pBaseArray->pItems;
+   HB_BOOL fOwner = pBaseArray->fShareOwner;
+
+   HB_TRACE( HB_TR_DEBUG, ( "hb_arrayUnshare(%p)", ( void * ) pBaseArray ) );
+
+   /* frozen arrays have private items which cannot be modified */
+   if( pBaseArray->fFrozen )
+      return;
+
+   pBaseArray->fShared = pBaseArray->fShareOwner = HB_FALSE;
+   if( pItems && hb_xRefCount( pItems ) > 1 )
+   {
+      HB_SIZE nLen = pBaseArray->nLen, nPos;
+      PHB_ITEM pNewItems = ( PHB_ITEM ) hb_xgrab( sizeof( HB_ITEM ) * nLen );
+
+      for( nPos = 0; nPos < nLen; ++nPos )
+         ( pNewItems + nPos )->type = HB_IT_NIL;
+      if( fOwner )
+      {
+         for( nPos = 0; nPos < nLen; ++nPos )
+         {
+            hb_itemCopy( pNewItems + nPos, pItems + nPos );
+            hb_nestedCloneCOWShared( pItems + nPos );
+         }
+      }
+      else
+      {
+         for( nPos = 0; nPos < nLen; ++nPos )
+            hb_nestedCloneCOW( pNewItems + nPos, pItems + nPos );
+      }
+
+      pBaseArray->pItems = pNewItems;
+      pBaseArray->nAllocated = nLen;
+
+      /* other clones released the items in the meantime */
+      if( hb_xRefDec( pItems ) )
+      {
+         while( nLen-- )
+         {
+            if( HB_IS_COMPLEX( pItems + nLen ) )
+               hb_itemClear( pItems + nLen );
+         }
+         hb_xfree( pItems );
+      }
+   }
+}
+
+HB_BOOL hb_arrayWritable( PHB_BASEARRAY pBaseArray )
+{
+   HB_TRACE( HB_TR_DEBUG, ( "hb_arrayWritable(%p)", ( void * ) pBaseArray ) );
+
+   if( pBaseArray->fFrozen )
+   {
+      hb_errRT_BASE( EG_READONLY, 1134, NULL, HB_ERR_FUNCNAME, 0 );
+      return HB_FALSE;
+   }
+   hb_arrayUnshare( pBaseArray );
+   return HB_TRUE;
+}
+
+/* account array GC block in heap snapshot, objects are counted by class */
+HB_BOOL hb_arrayMemStat( void * pBlock, const HB_GC_FUNCS * pFuncs, PHB_MEMSNAPSHOT pSnap )
+{
+   if( pFuncs == &s_gcArrayFuncs )
+   {
+      PHB_BASEARRAY pBaseArray = ( PHB_BASEARRAY ) pBlock;
+      HB_COUNTER nShare = 1;
+      HB_SIZE nBytes, nPos;
+
+      /* items shared by copy-on-write clones are split between them */
+      if( pBaseArray->fShared && pBaseArray->pItems )
+      {
+         nShare = hb_xRefCount( pBaseArray->pItems );
+         if( nShare == 0 )
+            nShare = 1;
+      }
+      nBytes = sizeof( HB_BASEARRAY ) +
+               pBaseArray->nAllocated * sizeof( HB_ITEM ) / nShare;
+
+      if( pBaseArray->uiClass )
+      {
+         HB_SIZE nClass = pBaseArray->uiClass;
+
+         if( nClass >= pSnap->nClasses )
+         {
+            HB_SIZE nClasses = nClass + 64;
+
+            pSnap->pClasses = ( PHB_MEMCOUNT ) hb_xrealloc( pSnap->pClasses,
+                                                 nClasses * sizeof( HB_MEMCOUNT ) );
+            memset( pSnap->pClasses + pSnap->nClasses, 0,
+                    ( nClasses - pSnap->nClasses ) * sizeof( HB_MEMCOUNT ) );
+            pSnap->nClasses = nClasses;
+         }
+         pSnap->pClasses[ nClass ].nCount++;
+         pSnap->pClasses[ nClass ].nBytes += nBytes;
+         pSnap->objects.nCount++;
+         pSnap->objects.nBytes += nBytes;
+      }
+      else
+      {
+         pSnap->arrays.nCount++;
+         pSnap->arrays.nBytes += nBytes;
+      }
+
+      for( nPos = 0; nPos < pBaseArray->nLen; ++nPos )
+         hb_itemMemStat( pBaseArray->pItems + nPos, nShare, pSnap );
+
+      return HB_TRUE;
+   }
+   return HB_FALSE;
+}
+
+void hb_nestedCloneCOW( PHB_ITEM pDstItem, PHB_ITEM pSrcItem )
+{
+   /* objects are not cloned like in hb_nestedCloneDo() */
+   if( HB_IS_ARRAY( pSrcItem ) && pSrcItem->item.asArray.value->uiClass == 0 )
+      hb_arrayCloneCOWTo( pDstItem, pSrcItem );
+   else if( HB_IS_HASH( pSrcItem ) )
+      hb_hashCloneCOWTo( pDstItem, pSrcItem );
+   else
+      hb_itemCopy( pDstItem, pSrcItem );
+}
+
+/* replace nested array or hash in items shared with other clones
+ * by its copy-on-write clone when the share owner makes its items
+ * private and keeps the original one, only the base pointer is
+ * changed so other clones never see different item type
+ */
+void hb_nestedCloneCOWShared( PHB_ITEM pItem )
+{
+   if( HB_IS_ARRAY( pItem ) || HB_IS_HASH( pItem ) )
+   {
+      HB_ITEM item;
+
+      item.type = HB_IT_NIL;
+      hb_nestedCloneCOW( &item, pItem );
+      if( HB_IS_ARRAY( pItem ) )
+      {
+         PHB_BASEARRAY pBaseArray = pItem->item.asArray.value;
+
+         pItem->item.asArray.value = item.item.asArray.value;
+         item.item.asArray.value = pBaseArray;
+      }
+      else
+      {
+         PHB_BASEHASH pBaseHash = pItem->item.asHash.value;
+
+         pItem->item.asHash.value = item.item.asHash.value;
+         item.item.asHash.value = pBaseHash;
+      }
+      hb_itemClear( &item );
+   }
+}
+
+PHB_ITEM hb_arrayCloneCOWTo( PHB_ITEM pDest, PHB_ITEM pArray )
+{
+   HB_TRACE( HB_TR_DEBUG, ( "hb_arrayCloneCOWTo(%p,%p)", ( void * ) pDest, ( void * ) pArray ) );
+
+   /* object instance variables are accessed directly by class code */
+   if( HB_IS_OBJECT( pArray ) )
+      hb_arrayCloneTo( pDest, pArray );
+   /* frozen array cannot be changed so it does not need a copy */
+   else if( HB_IS_ARRAY( pArray ) && pArray->item.asArray.value->fFrozen )
+      hb_itemCopy( pDest, pArray );
+   else if( HB_IS_ARRAY( pArray ) )
+   {
+      PHB_BASEARRAY pSrcArray = pArray->item.asArray.value;
+      PHB_BASEARRAY pBaseArray = ( PHB_BASEARRAY )
+                  hb_gcAllocRaw( sizeof( HB_BASEARRAY ), &s_gcArrayFuncs );
+
+      if( pSrcArray->nLen )
+      {
+         /* the first clone of private items makes source the share owner */
+         if( hb_xRefCount( pSrcArray->pItems ) == 1 )
+            pSrcArray->fShareOwner = HB_TRUE;
+         hb_xRefInc( pSrcArray->pItems );
+         pSrcArray->fShared = HB_TRUE;
+         pBaseArray->pItems     = pSrcArray->pItems;
+         pBaseArray->nLen       = pSrcArray->nLen;
+         pBaseArray->nAllocated = pSrcArray->nAllocated;
+         pBaseArray->fShared    = HB_TRUE;
+      }
+      else
+      {
+         pBaseArray->pItems     = NULL;
+         pBaseArray->nLen       = 0;
+         pBaseArray->nAllocated = 0;
+         pBaseArray->fShared    = HB_FALSE;
+      }
+      pBaseArray->fFrozen    = HB_FALSE;
+      pBaseArray->fShareOwner = HB_FALSE;
+      pBaseArray->uiClass    = 0;
+      pBaseArray->uiPrevCls  = 0;
+
+      /* pDest can keep the last reference to source array */
+      if( HB_IS_COMPLEX( pDest ) )
+         hb_itemClear( pDest );
+      pDest->type = HB_IT_ARRAY;
+      pDest->item.asArray.value = pBaseArray;
+   }
+   return pDest;
+}
+
+PHB_ITEM hb_arrayCloneCOW( PHB_ITEM pArray )
+{
+   HB_TRACE( HB_TR_DEBUG, ( "hb_arrayCloneCOW(%p)", ( void * ) pArray ) );
+
+   return hb_arrayCloneCOWTo( hb_itemNew( NULL ), pArray );
+}
+
+/* Items are frozen in two passes. The first one (HB_FREEZE_CHECK) visits
+ * all nested arrays and hashes, makes their items private and checks if
+ * they contain only values which can be frozen. The second one commits
+ * (HB_FREEZE_COMMIT) or rolls back (HB_FREEZE_ROLLBACK) visited blocks.
+ * Objects, codeblocks, pointers and references cannot be frozen.
+ */
+HB_BOOL hb_nestedFreeze( PHB_ITEM pItem, int iMode )
+{
+   if( HB_IS_ARRAY( pItem ) )
+   {
+      PHB_BASEARRAY pBaseArray = pItem->item.asArray.value;
+      HB_SIZE nPos;
+
+      if( iMode == HB_FREEZE_CHECK )
+      {
+         if( hb_gcFreezeVisit( pBaseArray ) )
+         {
+            if( pBaseArray->uiClass )
+               return HB_FALSE;
+            HB_ARRAY_UNSHARE( pBaseArray );
+            for( nPos = 0; nPos < pBaseArray->nLen; ++nPos )
+            {
+               if( ! hb_nestedFreeze( pBaseArray->pItems + nPos, iMode ) )
+                  return HB_FALSE;
+            }
+         }
+      }
+      else if( hb_gcFreezeLeave( pBaseArray, iMode == HB_FREEZE_COMMIT ) )
+      {
+         if( iMode == HB_FREEZE_COMMIT )
+            pBaseArray->fFrozen = pBaseArray->fShared = HB_TRUE;
+         for( nPos = 0; nPos < pBaseArray->nLen; ++nPos )
+            hb_nestedFreeze( pBaseArray->pItems + nPos, iMode );
+      }
+   }
+   else if( HB_IS_HASH( pItem ) )
+      return hb_hashFreezeItems( pItem, iMode );
+   else if( HB_IS_STRING( pItem ) )
+   {
+      /* string buffers of frozen items are kept until HVM exit */
+      if( iMode == HB_FREEZE_COMMIT && pItem->item.asString.allocated )
+      {
+         hb_gcFreezeMem( pItem->item.asString.value );
+         pItem->item.asString.allocated = 0;
+      }
+   }
+   else if( HB_IS_COMPLEX( pItem ) )
+      return iMode != HB_FREEZE_CHECK;
+
+   return HB_TRUE;
+}
+
 PHB_ITEM hb_arrayFromStack( HB_USHORT uiLen )
 {
    HB_STACK_TLS_PRELOAD
@@ -117,7 +117,7 @@ HB_FUNC( AADD )
 
       if( pValue && hb_arrayAdd( pArray, pValue ) )
          hb_itemReturn( pValue );
-      else
+      else if( ! hb_itemIsFrozen( pArray ) )
          hb_errRT_BASE( EG_BOUND, 1187, NULL, HB_ERR_FUNCNAME, HB_ERR_ARGS_BASEPARAMS );
    }
    else
@@ -432,6 +432,24 @@ HB_FUNC( ACLONE )
       hb_arrayCloneTo( hb_stackReturnItem(), pSrcArray ); /* AClone() returns the new array */
 }
 
+HB_FUNC( HB_ACLONECOW )
+{
+   PHB_ITEM pSrcArray = hb_param( 1, HB_IT_ARRAY );
+
+   if( pSrcArray && ! hb_arrayIsObject( pSrcArray ) )
+      hb_arrayCloneCOWTo( hb_stackReturnItem(), pSrcArray );
+}
+
+HB_FUNC( HB_FREEZE )
+{
+   PHB_ITEM pItem = hb_param( 1, HB_IT_ANY );
+
+   if( pItem && hb_itemFreeze( pItem ) )
+      hb_itemReturn( pItem );
+   else
+      hb_errRT_BASE( EG_ARG, 1123, NULL, HB_ERR_FUNCNAME, HB_ERR_ARGS_BASEPARAMS );
+}
+
 HB_FUNC( HB_APARAMS )
 {
    hb_itemReturnRelease( hb_arrayFromParams( hb_parni( 1 ) + 1 ) );
@@ -56,6 +56,8 @@
 #include "hbapi.h"
 #include "hbapiitm.h"
 #include "hbvm.h"
+#include "hbapicdp.h"
+#include "hbset.h"
 
 static HB_BOOL hb_itemIsLess( PHB_BASEARRAY pBaseArray, PHB_ITEM pBlock,
                               HB_SIZE nItem1, HB_SIZE nItem2 )
@@ -218,7 +220,63 @@ static void hb_arraySortStart( PHB_BASEARRAY pBaseArray, PHB_ITEM pBlock,
 
 #else
 
+typedef struct
+{
+   const char * pKey;
+   HB_SIZE      nLen;
+} HB_SORTKEY, * PHB_SORTKEY;
+
+static HB_BOOL hb_sortKeyIsLess( PHB_SORTKEY pKey1, PHB_SORTKEY pKey2 )
+{
+   int i = memcmp( pKey1->pKey, pKey2->pKey,
+                   pKey1->nLen < pKey2->nLen ? pKey1->nLen : pKey2->nLen );
+
+   return i < 0 || ( i == 0 && pKey1->nLen < pKey2->nLen );
+}
+
+/* precalculate collation sort keys when all sorted items are strings
+   and codepage with custom collation is used, binary comparison of
+   such keys is much faster than hb_cdpcmp() for each pair of items */
+static char * hb_arraySortKeys( PHB_BASEARRAY pBaseArray, PHB_ITEM pBlock,
+                                HB_SIZE nStart, HB_SIZE nCount,
+                                PHB_SORTKEY * pKeysPtr )
+{
+   PHB_CODEPAGE cdp;
+   PHB_SORTKEY pKeys;
+   HB_SIZE nPos, nSize = 0;
+   char * pBuffer, * pKey;
+
+   if( pBlock || hb_setGetL( HB_SET_EXACT ) )
+      return NULL;
+
+   cdp = hb_vmCDP();
+   if( ! cdp || HB_CDP_ISBINSORT( cdp ) || hb_cdpSortKeyLen( cdp, 0 ) == 0 )
+      return NULL;
+
+   for( nPos = 0; nPos < nCount; ++nPos )
+   {
+      PHB_ITEM pItem = pBaseArray->pItems + nStart + nPos;
+      if( ! HB_IS_STRING( pItem ) )
+         return NULL;
+      nSize += hb_cdpSortKeyLen( cdp, pItem->item.asString.length );
+   }
+
+   *pKeysPtr = pKeys = ( PHB_SORTKEY ) hb_xgrab( sizeof( HB_SORTKEY ) * nCount );
+   pKey = pBuffer = ( char * ) hb_xgrab( nSize );
+   for( nPos = 0; nPos < nCount; ++nPos )
+   {
+      PHB_ITEM pItem = pBaseArray->pItems + nStart + nPos;
+      pKeys[ nPos ].pKey = pKey;
+      pKeys[ nPos ].nLen = hb_cdpSortKey( cdp, pItem->item.asString.value,
+                                          pItem->item.asString.length, pKey );
+      pKey += pKeys[ nPos ].nLen;
+   }
+
+   return pBuffer;
+}
+
 static HB_BOOL hb_arraySortDO( PHB_BASEARRAY pBaseArray, PHB_ITEM pBlock,
+                               PHB_SORTKEY pKeys,
                                HB_SIZE * pSrc, HB_SIZE * pBuf, HB_SIZE nCount )
 {
    if( nCount > 1 )
@@ -231,8 +289,8 @@ static HB_BOOL hb_arraySortDO( PHB_BASEARRAY pBaseArray, PHB_ITEM pBlock,
       pPtr1 = &pSrc[ 0 ];
       pPtr2 = &pSrc[ nCnt1 ];
 
-      fBuf1 = hb_arraySortDO( pBaseArray, pBlock, pPtr1, &pBuf[ 0 ], nCnt1 );
-      fBuf2 = hb_arraySortDO( pBaseArray, pBlock, pPtr2, &pBuf[ nCnt1 ], nCnt2 );
+      fBuf1 = hb_arraySortDO( pBaseArray, pBlock, pKeys, pPtr1, &pBuf[ 0 ], nCnt1 );
+      fBuf2 = hb_arraySortDO( pBaseArray, pBlock, pKeys, pPtr2, &pBuf[ nCnt1 ], nCnt2 );
       if( fBuf1 )
          pDst = pBuf;
       else
@@ -245,7 +303,8 @@ static HB_BOOL hb_arraySortDO( PHB_BASEARRAY pBaseArray, PHB_ITEM pBlock,
 
       while( nCnt1 > 0 && nCnt2 > 0 )
       {
-         if( hb_itemIsLess( pBaseArray, pBlock, *pPtr2, *pPtr1 ) )
+         if( pKeys ? hb_sortKeyIsLess( &pKeys[ *pPtr2 ], &pKeys[ *pPtr1 ] ) :
+                     hb_itemIsLess( pBaseArray, pBlock, *pPtr2, *pPtr1 ) )
          {
             *pDst++ = *pPtr2++;
             nCnt2--;
@@ -277,12 +336,32 @@ static void hb_arraySortStart( PHB_BASEARRAY pBaseArray, PHB_ITEM pBlock,
                                HB_SIZE nStart, HB_SIZE nCount )
 {
    HB_SIZE * pBuffer, * pDest, * pPos, nPos, nTo;
+   PHB_SORTKEY pKeys = NULL;
+   char * pKeyBuf;
+   HB_BOOL fBuf;
 
    pBuffer = ( HB_SIZE * ) hb_xgrab( sizeof( HB_SIZE ) * 2 * nCount );
-   for( nPos = 0; nPos < nCount; ++nPos )
-      pBuffer[ nPos ] = nStart + nPos;
+   pKeyBuf = hb_arraySortKeys( pBaseArray, pBlock, nStart, nCount, &pKeys );
+   if( pKeyBuf )
+   {
+      /* sort keys are indexed from 0 */
+      for( nPos = 0; nPos < nCount; ++nPos )
+         pBuffer[ nPos ] = nPos;
+      fBuf = hb_arraySortDO( pBaseArray, pBlock, pKeys, pBuffer, &pBuffer[ nCount ], nCount );
+      pDest = fBuf ? pBuffer : pBuffer + nCount;
+      for( nPos = 0; nPos < nCount; ++nPos )
+         pDest[ nPos ] += nStart;
+      hb_xfree( pKeyBuf );
+      hb_xfree( pKeys );
+   }
+   else
+   {
+      for( nPos = 0; nPos < nCount; ++nPos )
+         pBuffer[ nPos ] = nStart + nPos;
+      fBuf = hb_arraySortDO( pBaseArray, pBlock, NULL, pBuffer, &pBuffer[ nCount ], nCount );
+   }
 
-   if( hb_arraySortDO( pBaseArray, pBlock, pBuffer, &pBuffer[ nCount ], nCount ) )
+   if( fBuf )
       pPos = ( pDest = pBuffer ) + nCount;
    else
       pDest = ( pPos = pBuffer ) + nCount;
@@ -340,6 +419,9 @@ HB_BOOL hb_arraySort( PHB_ITEM pArray, HB_SIZE * pnStart, HB_SIZE * pnCount, PHB
       {
          HB_SIZE nCount;
 
+         if( ! HB_ARRAY_WRITABLE( pBaseArray ) )
+            return HB_FALSE;
+
          if( pnCount && *pnCount >= 1 && ( *pnCount <= nLen - nStart ) )
             nCount = *pnCount;
          else
@@ -2050,7 +2050,7 @@ PHB_SYMB hb_objGetMethod( PHB_ITEM pObject, PHB_SYMB pMessage,
          else if( hb_pcount() == 0 ) /* ACCESS */
          {
             PHB_ITEM pIndex = hb_itemPutCConst( hb_stackAllocItem(), pMessage->szName );
-            PHB_ITEM pValue = hb_hashGetItemPtr( pObject, pIndex, HB_HASH_AUTOADD_ACCESS );
+            PHB_ITEM pValue = hb_hashGetItemReadPtr( pObject, pIndex, HB_HASH_AUTOADD_ACCESS );
             hb_stackPop();
             if( pValue )
             {
@@ -111,6 +111,33 @@ static const HB_GC_FUNCS s_gcCodeblockFuncs =
    hb_codeblockGarbageMark,
 };
 
+/* account codeblock GC block in heap snapshot */
+HB_BOOL hb_codeblockMemStat( void * pBlock, const HB_GC_FUNCS * pFuncs, PHB_MEMSNAPSHOT pSnap )
+{
+   if( pFuncs == &s_gcCodeblockFuncs )
+   {
+      PHB_CODEBLOCK pCBlock = ( PHB_CODEBLOCK ) pBlock;
+      HB_SIZE nBytes = sizeof( HB_CODEBLOCK );
+
+      /* table of detached locals is shared by nested codeblocks */
+      if( pCBlock->pLocals )
+      {
+         HB_COUNTER nShare = hb_xRefCount( pCBlock->pLocals );
+
+         nBytes += ( pCBlock->uiLocals + 1 ) * sizeof( HB_ITEM ) /
+                   ( nShare ? nShare : 1 );
+      }
+      if( pCBlock->pCode && pCBlock->dynBuffer )
+         nBytes += hb_xsize( HB_UNCONST( pCBlock->pCode ) );
+
+      pSnap->blocks.nCount++;
+      pSnap->blocks.nBytes += nBytes;
+
+      return HB_TRUE;
+   }
+   return HB_FALSE;
+}
+
 /* Creates the codeblock structure
  *
  * pBuffer -> the buffer with pcodes (without HB_P_PUSHBLOCK)
@@ -471,6 +471,8 @@ HB_BOOL hb_dynsymIsFunction( PHB_DYNS pDynSym )
 
 HB_BOOL hb_dynsymIsMemvar( PHB_DYNS pDynSym )
 {
+   HB_STACK_TLS_PRELOAD
+
    HB_TRACE( HB_TR_DEBUG, ( "hb_dynsymIsMemvar(%p)", ( void * ) pDynSym ) );
 
    return hb_dynsymHandles( pDynSym )->pMemvar != NULL;
@@ -478,6 +480,8 @@ HB_BOOL hb_dynsymIsMemvar( PHB_DYNS pDynSym )
 
 PHB_ITEM hb_dynsymGetMemvar( PHB_DYNS pDynSym )
 {
+   HB_STACK_TLS_PRELOAD
+
    HB_TRACE( HB_TR_DEBUG, ( "hb_dynsymGetMemvar(%p)", ( void * ) pDynSym ) );
 
    return ( PHB_ITEM ) hb_dynsymHandles( pDynSym )->pMemvar;
@@ -485,6 +489,8 @@ PHB_ITEM hb_dynsymGetMemvar( PHB_DYNS pDynSym )
 
 void hb_dynsymSetMemvar( PHB_DYNS pDynSym, PHB_ITEM pMemvar )
 {
+   HB_STACK_TLS_PRELOAD
+
    HB_TRACE( HB_TR_DEBUG, ( "hb_dynsymSetMemvar(%p, %p)", ( void * ) pDynSym, ( void * ) pMemvar ) );
 
    hb_dynsymHandles( pDynSym )->pMemvar = ( void * ) pMemvar;
@@ -492,6 +498,8 @@ void hb_dynsymSetMemvar( PHB_DYNS pDynSym, PHB_ITEM pMemvar )
 
 int hb_dynsymAreaHandle( PHB_DYNS pDynSym )
 {
+   HB_STACK_TLS_PRELOAD
+
    HB_TRACE( HB_TR_DEBUG, ( "hb_dynsymAreaHandle(%p)", ( void * ) pDynSym ) );
 
    return hb_dynsymHandles( pDynSym )->uiArea;
@@ -499,6 +507,8 @@ int hb_dynsymAreaHandle( PHB_DYNS pDynSym )
 
 void hb_dynsymSetAreaHandle( PHB_DYNS pDynSym, int iArea )
 {
+   HB_STACK_TLS_PRELOAD
+
    HB_TRACE( HB_TR_DEBUG, ( "hb_dynsymSetAreaHandle(%p, %d)", ( void * ) pDynSym, iArea ) );
 
    hb_dynsymHandles( pDynSym )->uiArea = ( HB_USHORT ) iArea;
@@ -405,6 +405,7 @@ int hb_stackDynHandlesCount( void )
    return hb_stack.iDynH;
 }
 
+#undef hb_stackGetDynHandle
 PHB_DYN_HANDLES hb_stackGetDynHandle( PHB_DYNS pDynSym )
 {
    HB_STACK_TLS_PRELOAD
@@ -479,6 +480,13 @@ int hb_stackLockCount( void )
    return hb_stack.iUnlocked;
 }
 
+#undef hb_stackProfTick
+int * hb_stackProfTick( void )
+{
+   HB_STACK_TLS_PRELOAD
+   return &hb_stack.iProfTick;
+}
+
 #endif /* HB_MT_VM */
 
 #undef hb_stackKeyPolls
@@ -988,6 +996,22 @@ void * hb_stackAllocator( void )
    }
    return NULL;
 }
+
+PHB_MEMSTAT hb_stackMemStat( void )
+{
+   if( hb_stack_ready() )
+   {
+      HB_STACK_TLS_PRELOAD
+
+      return hb_stack.pMemStat;
+   }
+   return NULL;
+}
+
+const HB_MEMSTAT * hb_stackIdMemStat( void * pStackId )
+{
+   return &( ( PHB_STACK ) pStackId )->memStat;
+}
 #endif
 
 #undef hb_stackDateBuffer
@@ -1670,7 +1670,7 @@ int hb_stor( int iParam )
 
       if( HB_IS_BYREF( pItem ) )
       {
-         hb_itemClear( hb_itemUnRef( pItem ) );
+         hb_itemClear( hb_itemUnRefUpdate( pItem ) );
          return 1;
       }
    }
@@ -1695,7 +1695,7 @@ int hb_storc( const char * szText, int iParam )
 
       if( HB_IS_BYREF( pItem ) )
       {
-         hb_itemPutC( hb_itemUnRef( pItem ), szText );
+         hb_itemPutC( hb_itemUnRefUpdate( pItem ), szText );
          return 1;
       }
    }
@@ -1720,7 +1720,7 @@ int hb_storclen( const char * szText, HB_SIZE nLen, int iParam )
 
       if( HB_IS_BYREF( pItem ) )
       {
-         hb_itemPutCL( hb_itemUnRef( pItem ), szText, nLen );
+         hb_itemPutCL( hb_itemUnRefUpdate( pItem ), szText, nLen );
          return 1;
       }
    }
@@ -1745,7 +1745,7 @@ int hb_storclen_buffer( char * szText, HB_SIZE nLen, int iParam )
 
       if( HB_IS_BYREF( pItem ) )
       {
-         hb_itemPutCLPtr( hb_itemUnRef( pItem ), szText, nLen );
+         hb_itemPutCLPtr( hb_itemUnRefUpdate( pItem ), szText, nLen );
          return 1;
       }
    }
@@ -1772,7 +1772,7 @@ int hb_stords( const char * szDate, int iParam )
 
       if( HB_IS_BYREF( pItem ) )
       {
-         hb_itemPutDS( hb_itemUnRef( pItem ), szDate );
+         hb_itemPutDS( hb_itemUnRefUpdate( pItem ), szDate );
          return 1;
       }
    }
@@ -1797,7 +1797,7 @@ int hb_stordl( long lJulian, int iParam )
 
       if( HB_IS_BYREF( pItem ) )
       {
-         hb_itemPutDL( hb_itemUnRef( pItem ), lJulian );
+         hb_itemPutDL( hb_itemUnRefUpdate( pItem ), lJulian );
          return 1;
       }
    }
@@ -1822,7 +1822,7 @@ int hb_stortd( double dTimeStamp, int iParam )
 
       if( HB_IS_BYREF( pItem ) )
       {
-         hb_itemPutTD( hb_itemUnRef( pItem ), dTimeStamp );
+         hb_itemPutTD( hb_itemUnRefUpdate( pItem ), dTimeStamp );
          return 1;
       }
    }
@@ -1847,7 +1847,7 @@ int hb_stortdt( long lJulian, long lMilliSec, int iParam )
 
       if( HB_IS_BYREF( pItem ) )
       {
-         hb_itemPutTDT( hb_itemUnRef( pItem ), lJulian, lMilliSec );
+         hb_itemPutTDT( hb_itemUnRefUpdate( pItem ), lJulian, lMilliSec );
          return 1;
       }
    }
@@ -1872,7 +1872,7 @@ int hb_storl( int iLogical, int iParam )
 
       if( HB_IS_BYREF( pItem ) )
       {
-         hb_itemPutL( hb_itemUnRef( pItem ), iLogical ? HB_TRUE : HB_FALSE );
+         hb_itemPutL( hb_itemUnRefUpdate( pItem ), iLogical ? HB_TRUE : HB_FALSE );
          return 1;
       }
    }
@@ -1897,7 +1897,7 @@ int hb_storni( int iValue, int iParam )
 
       if( HB_IS_BYREF( pItem ) )
       {
-         hb_itemPutNI( hb_itemUnRef( pItem ), iValue );
+         hb_itemPutNI( hb_itemUnRefUpdate( pItem ), iValue );
          return 1;
       }
    }
@@ -1922,7 +1922,7 @@ int hb_stornl( long lValue, int iParam )
 
       if( HB_IS_BYREF( pItem ) )
       {
-         hb_itemPutNL( hb_itemUnRef( pItem ), lValue );
+         hb_itemPutNL( hb_itemUnRefUpdate( pItem ), lValue );
          return 1;
       }
    }
@@ -1947,7 +1947,7 @@ int hb_storns( HB_ISIZ nValue, int iParam )
 
       if( HB_IS_BYREF( pItem ) )
       {
-         hb_itemPutNS( hb_itemUnRef( pItem ), nValue );
+         hb_itemPutNS( hb_itemUnRefUpdate( pItem ), nValue );
          return 1;
       }
    }
@@ -1973,7 +1973,7 @@ int hb_stornll( HB_LONGLONG llValue, int iParam )
 
       if( HB_IS_BYREF( pItem ) )
       {
-         hb_itemPutNLL( hb_itemUnRef( pItem ), llValue );
+         hb_itemPutNLL( hb_itemUnRefUpdate( pItem ), llValue );
          return 1;
       }
    }
@@ -1999,7 +1999,7 @@ int hb_stornint( HB_MAXINT nValue, int iParam )
 
       if( HB_IS_BYREF( pItem ) )
       {
-         hb_itemPutNInt( hb_itemUnRef( pItem ), nValue );
+         hb_itemPutNInt( hb_itemUnRefUpdate( pItem ), nValue );
          return 1;
       }
    }
@@ -2024,7 +2024,7 @@ int hb_stornd( double dNumber, int iParam )
 
       if( HB_IS_BYREF( pItem ) )
       {
-         hb_itemPutND( hb_itemUnRef( pItem ), dNumber );
+         hb_itemPutND( hb_itemUnRefUpdate( pItem ), dNumber );
          return 1;
       }
    }
@@ -2049,7 +2049,7 @@ int hb_storptr( void * pointer, int iParam )
 
       if( HB_IS_BYREF( pItem ) )
       {
-         hb_itemPutPtr( hb_itemUnRef( pItem ), pointer );
+         hb_itemPutPtr( hb_itemUnRefUpdate( pItem ), pointer );
          return 1;
       }
    }
@@ -2074,7 +2074,7 @@ int hb_storptrGC( void * pointer, int iParam )
 
       if( HB_IS_BYREF( pItem ) )
       {
-         hb_itemPutPtrGC( hb_itemUnRef( pItem ), pointer );
+         hb_itemPutPtrGC( hb_itemUnRefUpdate( pItem ), pointer );
          return 1;
       }
    }
@@ -2098,7 +2098,7 @@ int hb_storvc( const char * szText, int iParam, ... )
       HB_BOOL bByRef = HB_IS_BYREF( pItem );
 
       if( bByRef )
-         pItem = hb_itemUnRef( pItem );
+         pItem = hb_itemUnRefUpdate( pItem );
 
       if( HB_IS_ARRAY( pItem ) )
       {
@@ -2131,7 +2131,7 @@ int hb_storvclen( const char * szText, HB_SIZE nLen, int iParam, ... )
       HB_BOOL bByRef = HB_IS_BYREF( pItem );
 
       if( bByRef )
-         pItem = hb_itemUnRef( pItem );
+         pItem = hb_itemUnRefUpdate( pItem );
 
       if( HB_IS_ARRAY( pItem ) )
       {
@@ -2164,7 +2164,7 @@ int hb_storvclen_buffer( char * szText, HB_SIZE nLen, int iParam, ... )
       HB_BOOL bByRef = HB_IS_BYREF( pItem );
 
       if( bByRef )
-         pItem = hb_itemUnRef( pItem );
+         pItem = hb_itemUnRefUpdate( pItem );
 
       if( HB_IS_ARRAY( pItem ) )
       {
@@ -2199,7 +2199,7 @@ int hb_storvds( const char * szDate, int iParam, ... )
       HB_BOOL bByRef = HB_IS_BYREF( pItem );
 
       if( bByRef )
-         pItem = hb_itemUnRef( pItem );
+         pItem = hb_itemUnRefUpdate( pItem );
 
       if( HB_IS_ARRAY( pItem ) )
       {
@@ -2232,7 +2232,7 @@ int hb_storvdl( long lJulian, int iParam, ... )
       HB_BOOL bByRef = HB_IS_BYREF( pItem );
 
       if( bByRef )
-         pItem = hb_itemUnRef( pItem );
+         pItem = hb_itemUnRefUpdate( pItem );
 
       if( HB_IS_ARRAY( pItem ) )
       {
@@ -2265,7 +2265,7 @@ int hb_storvtd( double dTimeStamp, int iParam, ... )
       HB_BOOL bByRef = HB_IS_BYREF( pItem );
 
       if( bByRef )
-         pItem = hb_itemUnRef( pItem );
+         pItem = hb_itemUnRefUpdate( pItem );
 
       if( HB_IS_ARRAY( pItem ) )
       {
@@ -2298,7 +2298,7 @@ int hb_storvtdt( long lJulian, long lMilliSec, int iParam, ... )
       HB_BOOL bByRef = HB_IS_BYREF( pItem );
 
       if( bByRef )
-         pItem = hb_itemUnRef( pItem );
+         pItem = hb_itemUnRefUpdate( pItem );
 
       if( HB_IS_ARRAY( pItem ) )
       {
@@ -2331,7 +2331,7 @@ int hb_storvl( int iLogical, int iParam, ... )
       HB_BOOL bByRef = HB_IS_BYREF( pItem );
 
       if( bByRef )
-         pItem = hb_itemUnRef( pItem );
+         pItem = hb_itemUnRefUpdate( pItem );
 
       if( HB_IS_ARRAY( pItem ) )
       {
@@ -2364,7 +2364,7 @@ int hb_storvni( int iValue, int iParam, ... )
       HB_BOOL bByRef = HB_IS_BYREF( pItem );
 
       if( bByRef )
-         pItem = hb_itemUnRef( pItem );
+         pItem = hb_itemUnRefUpdate( pItem );
 
       if( HB_IS_ARRAY( pItem ) )
       {
@@ -2397,7 +2397,7 @@ int hb_storvnl( long lValue, int iParam, ... )
       HB_BOOL bByRef = HB_IS_BYREF( pItem );
 
       if( bByRef )
-         pItem = hb_itemUnRef( pItem );
+         pItem = hb_itemUnRefUpdate( pItem );
 
       if( HB_IS_ARRAY( pItem ) )
       {
@@ -2430,7 +2430,7 @@ int hb_storvns( HB_ISIZ nValue, int iParam, ... )
       HB_BOOL bByRef = HB_IS_BYREF( pItem );
 
       if( bByRef )
-         pItem = hb_itemUnRef( pItem );
+         pItem = hb_itemUnRefUpdate( pItem );
 
       if( HB_IS_ARRAY( pItem ) )
       {
@@ -2464,7 +2464,7 @@ int hb_storvnll( HB_LONGLONG llValue, int iParam, ... )
       HB_BOOL bByRef = HB_IS_BYREF( pItem );
 
       if( bByRef )
-         pItem = hb_itemUnRef( pItem );
+         pItem = hb_itemUnRefUpdate( pItem );
 
       if( HB_IS_ARRAY( pItem ) )
       {
@@ -2498,7 +2498,7 @@ int hb_storvnint( HB_MAXINT nValue, int iParam, ... )
       HB_BOOL bByRef = HB_IS_BYREF( pItem );
 
       if( bByRef )
-         pItem = hb_itemUnRef( pItem );
+         pItem = hb_itemUnRefUpdate( pItem );
 
       if( HB_IS_ARRAY( pItem ) )
       {
@@ -2531,7 +2531,7 @@ int hb_storvnd( double dNumber, int iParam, ... )
       HB_BOOL bByRef = HB_IS_BYREF( pItem );
 
       if( bByRef )
-         pItem = hb_itemUnRef( pItem );
+         pItem = hb_itemUnRefUpdate( pItem );
 
       if( HB_IS_ARRAY( pItem ) )
       {
@@ -2564,7 +2564,7 @@ int hb_storvptr( void * pointer, int iParam, ... )
       HB_BOOL bByRef = HB_IS_BYREF( pItem );
 
       if( bByRef )
-         pItem = hb_itemUnRef( pItem );
+         pItem = hb_itemUnRefUpdate( pItem );
 
       if( HB_IS_ARRAY( pItem ) )
       {
@@ -2597,7 +2597,7 @@ int hb_storvptrGC( void * pointer, int iParam, ... )
       HB_BOOL bByRef = HB_IS_BYREF( pItem );
 
       if( bByRef )
-         pItem = hb_itemUnRef( pItem );
+         pItem = hb_itemUnRefUpdate( pItem );
 
       if( HB_IS_ARRAY( pItem ) )
       {
@@ -262,6 +262,45 @@
 
 #endif
 
+/* size of memory block reported by allocator, used by memory usage counters */
+#if defined( HB_FM_DLMT_ALLOC )
+#  define HB_FM_MSIZE( p )       mspace_usable_size( p )
+#elif defined( HB_FM_DL_ALLOC )
+#  define HB_FM_MSIZE( p )       dlmalloc_usable_size( p )
+#elif defined( HB_FM_WIN_ALLOC ) && defined( HB_OS_WIN )
+#  if defined( HB_FM_LOCALALLOC )
+#     define HB_FM_MSIZE( p )    LocalSize( ( HLOCAL ) ( p ) )
+#  else
+#     define HB_FM_MSIZE( p )    HeapSize( s_hProcessHeap, 0, ( void * ) ( p ) )
+#  endif
+#elif defined( __GLIBC__ )
+#  include <malloc.h>
+#  define HB_FM_MSIZE( p )       malloc_usable_size( p )
+#elif defined( HB_OS_DARWIN )
+#  include <malloc/malloc.h>
+#  define HB_FM_MSIZE( p )       malloc_size( p )
+#elif defined( _MSC_VER ) || defined( __MINGW32__ )
+#  include <malloc.h>
+#  define HB_FM_MSIZE( p )       _msize( p )
+#endif
+
+#if defined( HB_FM_MSIZE )
+#  define HB_FM_BLOCKBYTES( p )  ( ( HB_ISIZ ) HB_FM_MSIZE( p ) )
+#else
+#  define HB_FM_BLOCKBYTES( p )  ( ( HB_ISIZ ) 0 )
+#endif
+
+#if defined( HB_MT_VM )
+   static HB_CRITICAL_NEW( s_memStatMtx );
+#  define HB_MEMSTAT_LOCK()      hb_threadEnterCriticalSection( &s_memStatMtx )
+#  define HB_MEMSTAT_UNLOCK()    hb_threadLeaveCriticalSection( &s_memStatMtx )
+   static HB_MEMSTAT s_memStatExit;  /* counters of finished HVM threads */
+#else
+#  define HB_MEMSTAT_LOCK()
+#  define HB_MEMSTAT_UNLOCK()
+#endif
+static HB_MEMSTAT s_memStat;         /* counters of memory allocated outside HVM threads */
+
 #if defined( HB_FM_STATISTICS )
 #  if ! defined( HB_FM_NEED_INIT )
 #     define HB_FM_NEED_INIT
@@ -498,26 +537,100 @@ static void dlmalloc_destroy( void )
 
 #endif
 
+static HB_FORCEINLINE void hb_xmemstat_add( PHB_MEMSTAT pStat, int iBlocks, HB_ISIZ nBytes )
+{
+   pStat->nBlocks += iBlocks;
+   pStat->nBytes += nBytes;
+   if( iBlocks > 0 )
+      pStat->nAllocs++;
+   else if( iBlocks < 0 )
+      pStat->nFrees++;
+   if( nBytes > 0 )
+      pStat->nAllocBytes += nBytes;
+}
+
+static void hb_xmemstat_update( int iBlocks, HB_ISIZ nBytes )
+{
+#if defined( HB_MT_VM )
+   /* HVM threads update their own counters without locking */
+   PHB_MEMSTAT pStat = hb_stackMemStat();
+
+   if( pStat )
+   {
+      hb_xmemstat_add( pStat, iBlocks, nBytes );
+      return;
+   }
+#endif
+   HB_MEMSTAT_LOCK();
+   hb_xmemstat_add( &s_memStat, iBlocks, nBytes );
+   HB_MEMSTAT_UNLOCK();
+}
+
+static void * hb_fm_malloc( HB_SIZE nSize )
+{
+   void * pMem = malloc( nSize );
+
+   if( pMem )
+      hb_xmemstat_update( 1, HB_FM_BLOCKBYTES( pMem ) );
+
+   return pMem;
+}
+
+static void * hb_fm_realloc( void * pMem, HB_SIZE nSize )
+{
+   HB_ISIZ nBytes = HB_FM_BLOCKBYTES( pMem );
+
+   pMem = realloc( pMem, nSize );
+   if( pMem )
+      hb_xmemstat_update( 0, HB_FM_BLOCKBYTES( pMem ) - nBytes );
+
+   return pMem;
+}
+
+static void hb_fm_free( void * pMem )
+{
+   hb_xmemstat_update( -1, -HB_FM_BLOCKBYTES( pMem ) );
+   free( pMem );
+}
+
 void hb_xinit_thread( void )
 {
-#if defined( HB_FM_DLMT_ALLOC )
+#if defined( HB_MT_VM )
    HB_STACK_TLS_PRELOAD
 
+#if defined( HB_FM_DLMT_ALLOC )
    if( hb_stack.allocator == NULL )
    {
       HB_FM_LOCK();
       hb_stack.allocator = ( void * ) hb_mspace_alloc();
       HB_FM_UNLOCK();
    }
+#endif
+   hb_stack.pMemStat = &hb_stack.memStat;
 #endif
 }
 
 void hb_xexit_thread( void )
 {
-#if defined( HB_FM_DLMT_ALLOC )
+#if defined( HB_MT_VM )
    HB_STACK_TLS_PRELOAD
+#if defined( HB_FM_DLMT_ALLOC )
    PHB_MSPACE pm = ( PHB_MSPACE ) hb_stack.allocator;
+#endif
+
+   /* move counters of finished thread to common ones, memory
+      released later by this thread is accounted in s_memStat */
+   hb_stack.pMemStat = NULL;
+   HB_MEMSTAT_LOCK();
+   s_memStatExit.nBlocks     += hb_stack.memStat.nBlocks;
+   s_memStatExit.nBytes      += hb_stack.memStat.nBytes;
+   s_memStatExit.nAllocs     += hb_stack.memStat.nAllocs;
+   s_memStatExit.nFrees      += hb_stack.memStat.nFrees;
+   s_memStatExit.nAllocBytes += hb_stack.memStat.nAllocBytes;
+   memset( &hb_stack.memStat, 0, sizeof( hb_stack.memStat ) );
+   HB_MEMSTAT_UNLOCK();
 
+#if defined( HB_FM_DLMT_ALLOC )
    if( pm )
    {
       hb_stack.allocator = NULL;
@@ -527,6 +640,46 @@ void hb_xexit_thread( void )
       HB_FM_UNLOCK();
    }
 #endif
+#endif
+}
+
+static void hb_xmemstat_sum( void * cargo, HB_MAXINT nThreadNo, const HB_MEMSTAT * pStat )
+{
+   PHB_MEMSTAT pSum = ( PHB_MEMSTAT ) cargo;
+
+   HB_SYMBOL_UNUSED( nThreadNo );
+
+   pSum->nBlocks     += pStat->nBlocks;
+   pSum->nBytes      += pStat->nBytes;
+   pSum->nAllocs     += pStat->nAllocs;
+   pSum->nFrees      += pStat->nFrees;
+   pSum->nAllocBytes += pStat->nAllocBytes;
+}
+
+/* NOTE: counters of running threads are read without locking so
+         results are not exact when other threads allocate memory
+         in the same time. Byte counters are always 0 when allocator
+         cannot report size of memory blocks. */
+
+void hb_xmemstat( PHB_MEMSTAT pStat )
+{
+   HB_TRACE( HB_TR_DEBUG, ( "hb_xmemstat(%p)", ( void * ) pStat ) );
+
+   HB_MEMSTAT_LOCK();
+   memcpy( pStat, &s_memStat, sizeof( HB_MEMSTAT ) );
+#if defined( HB_MT_VM )
+   hb_xmemstat_sum( pStat, 0, &s_memStatExit );
+#endif
+   HB_MEMSTAT_UNLOCK();
+
+   hb_vmMemStat( hb_xmemstat_sum, pStat );
+}
+
+void hb_xmemstatThreads( PHB_MEMSTAT_FUNC pFunc, void * cargo )
+{
+   HB_TRACE( HB_TR_DEBUG, ( "hb_xmemstatThreads(%p, %p)", ( void * ) pFunc, cargo ) );
+
+   hb_vmMemStat( pFunc, cargo );
 }
 
 void hb_xclean( void )
@@ -597,7 +750,7 @@ void * hb_xalloc( HB_SIZE nSize )         /* allocates fixed memory, returns NUL
       hb_xinit();
 #endif
 
-   pMem = ( PHB_MEMINFO ) malloc( HB_ALLOC_SIZE( nSize ) );
+   pMem = ( PHB_MEMINFO ) hb_fm_malloc( HB_ALLOC_SIZE( nSize ) );
 
    if( ! pMem )
       return pMem;
@@ -659,7 +812,7 @@ void * hb_xalloc( HB_SIZE nSize )         /* allocates fixed memory, returns NUL
 
       if( s_nMemoryLimConsumed > 0 && s_nMemoryConsumed > s_nMemoryLimConsumed )
       {
-         free( pMem );
+         hb_fm_free( pMem );
          return NULL;
       }
 
@@ -690,7 +843,7 @@ void * hb_xgrab( HB_SIZE nSize )         /* allocates fixed memory, exits on fai
       hb_xinit();
 #endif
 
-   pMem = ( PHB_MEMINFO ) malloc( HB_ALLOC_SIZE( nSize ) );
+   pMem = ( PHB_MEMINFO ) hb_fm_malloc( HB_ALLOC_SIZE( nSize ) );
 
    if( ! pMem )
       hb_errInternal( HB_EI_XGRABALLOC, NULL, NULL, NULL );
@@ -812,13 +965,13 @@ void * hb_xrealloc( void * pMem, HB_SIZE nSize )       /* reallocates memory */
       HB_FM_CLRSIG( HB_MEM_PTR( pMemBlock ), nMemSize );
 
 #if defined( HB_PARANOID_MEM_CHECK ) || defined( HB_FM_FORCE_REALLOC )
-      pMem = malloc( HB_ALLOC_SIZE( nSize ) );
+      pMem = hb_fm_malloc( HB_ALLOC_SIZE( nSize ) );
 #  endif
 
       HB_FM_LOCK();
 
 #if ! ( defined( HB_PARANOID_MEM_CHECK ) || defined( HB_FM_FORCE_REALLOC ) )
-      pMem = realloc( pMemBlock, HB_ALLOC_SIZE( nSize ) );
+      pMem = hb_fm_realloc( pMemBlock, HB_ALLOC_SIZE( nSize ) );
 #endif
 
       if( pMem )
@@ -861,11 +1014,11 @@ void * hb_xrealloc( void * pMem, HB_SIZE nSize )       /* reallocates memory */
       if( nSize > nMemSize && pMem )
          memset( ( HB_BYTE * ) HB_MEM_PTR( pMem ) + nMemSize, HB_MEMFILER, nSize - nMemSize );
 #  endif
-      free( pMemBlock );
+      hb_fm_free( pMemBlock );
 #endif
    }
    else
-      pMem = realloc( HB_FM_PTR( pMem ), HB_ALLOC_SIZE( nSize ) );
+      pMem = hb_fm_realloc( HB_FM_PTR( pMem ), HB_ALLOC_SIZE( nSize ) );
 
    if( ! pMem )
       hb_errInternal( HB_EI_XREALLOC, NULL, NULL, NULL );
@@ -876,13 +1029,13 @@ void * hb_xrealloc( void * pMem, HB_SIZE nSize )       /* reallocates memory */
    {
       if( nSize == 0 )
          hb_errInternal( HB_EI_XREALLOCNULLSIZE, NULL, NULL, NULL );
-      pMem = malloc( HB_ALLOC_SIZE( nSize ) );
+      pMem = hb_fm_malloc( HB_ALLOC_SIZE( nSize ) );
       if( pMem )
          HB_ATOM_SET( HB_COUNTER_PTR( HB_MEM_PTR( pMem ) ), 1 );
    }
    else if( nSize == 0 )
    {
-      free( HB_FM_PTR( pMem ) );
+      hb_fm_free( HB_FM_PTR( pMem ) );
       return NULL;
    }
    else
@@ -890,16 +1043,16 @@ void * hb_xrealloc( void * pMem, HB_SIZE nSize )       /* reallocates memory */
 #ifdef HB_FM_FORCE_REALLOC
       PHB_MEMINFO pMemBlock = HB_FM_PTR( pMem );
 
-      pMem = realloc( pMemBlock, HB_ALLOC_SIZE( nSize ) );
+      pMem = hb_fm_realloc( pMemBlock, HB_ALLOC_SIZE( nSize ) );
       if( pMem == pMemBlock )
       {
-         pMem = malloc( HB_ALLOC_SIZE( nSize ) );
+         pMem = hb_fm_malloc( HB_ALLOC_SIZE( nSize ) );
          memcpy( pMem, pMemBlock, HB_ALLOC_SIZE( nSize ) );
          memset( pMemBlock, HB_MEMFILER, HB_ALLOC_SIZE( nSize ) );
-         free( pMemBlock );
+         hb_fm_free( pMemBlock );
       }
 #else
-      pMem = realloc( HB_FM_PTR( pMem ), HB_ALLOC_SIZE( nSize ) );
+      pMem = hb_fm_realloc( HB_FM_PTR( pMem ), HB_ALLOC_SIZE( nSize ) );
 #endif
    }
 
@@ -953,11 +1106,11 @@ void hb_xfree( void * pMem )            /* frees fixed memory */
 #endif
       }
 
-      free( pMemBlock );
+      hb_fm_free( pMemBlock );
 
 #else
 
-      free( HB_FM_PTR( pMem ) );
+      hb_fm_free( HB_FM_PTR( pMem ) );
 
 #endif
    }
@@ -994,7 +1147,7 @@ void hb_xRefFree( void * pMem )
 #else
 
    if( HB_ATOM_DEC( HB_COUNTER_PTR( pMem ) ) == 0 )
-      free( HB_FM_PTR( pMem ) );
+      hb_fm_free( HB_FM_PTR( pMem ) );
 
 #endif
 }
@@ -1032,14 +1185,14 @@ void * hb_xRefResize( void * pMem, HB_SIZE nSave, HB_SIZE nSize, HB_SIZE * pnAll
 
    if( HB_ATOM_GET( HB_COUNTER_PTR( pMem ) ) > 1 )
    {
-      void * pMemNew = malloc( HB_ALLOC_SIZE( nSize ) );
+      void * pMemNew = hb_fm_malloc( HB_ALLOC_SIZE( nSize ) );
 
       if( pMemNew )
       {
          HB_ATOM_SET( HB_COUNTER_PTR( HB_MEM_PTR( pMemNew ) ), 1 );
          memcpy( HB_MEM_PTR( pMemNew ), pMem, HB_MIN( nSave, nSize ) );
          if( HB_ATOM_DEC( HB_COUNTER_PTR( pMem ) ) == 0 )
-            free( HB_FM_PTR( pMem ) );
+            hb_fm_free( HB_FM_PTR( pMem ) );
          *pnAllocated = nSize;
          return HB_MEM_PTR( pMemNew );
       }
@@ -1049,7 +1202,7 @@ void * hb_xRefResize( void * pMem, HB_SIZE nSave, HB_SIZE nSize, HB_SIZE * pnAll
    else
    {
       *pnAllocated = nSize;
-      pMem = realloc( HB_FM_PTR( pMem ), HB_ALLOC_SIZE( nSize ) );
+      pMem = hb_fm_realloc( HB_FM_PTR( pMem ), HB_ALLOC_SIZE( nSize ) );
       if( pMem )
          return HB_MEM_PTR( pMem );
    }
@@ -1060,14 +1213,19 @@ void * hb_xRefResize( void * pMem, HB_SIZE nSave, HB_SIZE nSize, HB_SIZE * pnAll
 }
 
 /* NOTE: Debug function, it will always return 0 when HB_FM_STATISTICS is
-         not defined, don't use it for final code [vszakats] */
+         not defined and allocator cannot report size of memory blocks,
+         don't use it for final code [vszakats] */
 
 HB_SIZE hb_xsize( void * pMem ) /* returns the size of an allocated memory block */
 {
    HB_TRACE( HB_TR_DEBUG, ( "hb_xsize(%p)", pMem ) );
 
 #ifdef HB_FM_STATISTICS
-   return HB_FM_BLOCKSIZE( pMem );
+   if( s_fStatistic )
+      return HB_FM_BLOCKSIZE( pMem );
+#endif
+#if defined( HB_FM_MSIZE )
+   return HB_FM_MSIZE( HB_FM_PTR( pMem ) ) - HB_MEMINFO_SIZE;
 #else
    HB_SYMBOL_UNUSED( pMem );
 
@@ -123,6 +123,8 @@ typedef struct HB_GARBAGE_
 #define HB_GC_USED_FLAG    1  /* the bit for used/unused flag */
 #define HB_GC_DELETE       2  /* item marked to delete */
 #define HB_GC_DELETELST    4  /* item will be deleted during finalization */
+#define HB_GC_FROZEN       8  /* item is frozen and moved to permanent region */
+#define HB_GC_FREEZING    16  /* item is visited by hb_itemFreeze() */
 
 #ifdef HB_GC_AUTO
 #define HB_GC_AUTO_MAX        ( ( HB_PTRUINT ) ( -1 ) )
@@ -152,6 +154,16 @@ static PHB_GARBAGE s_pLockedBlock = NULL;
 /* pointer to memory blocks that will be deleted */
 static PHB_GARBAGE s_pDeletedBlock = NULL;
 
+/* pointer to frozen memory blocks, they are never checked by GC
+ * and released only by hb_gcReleaseAll()
+ */
+static PHB_GARBAGE s_pFrozenBlock = NULL;
+
+/* memory blocks used by frozen items, i.e. string buffers */
+static void **     s_pFrozenMem = NULL;
+static HB_SIZE     s_nFrozenMem = 0;
+static HB_SIZE     s_nFrozenMemSize = 0;
+
 /* marks if block releasing is requested during garbage collecting */
 static HB_BOOL volatile s_bCollecting = HB_FALSE;
 
@@ -239,8 +251,10 @@ void hb_gcFree( void * pBlock )
    {
       PHB_GARBAGE pAlloc = HB_GC_PTR( pBlock );
 
-      /* Don't release the block that will be deleted during finalization */
-      if( ! ( pAlloc->used & HB_GC_DELETE ) )
+      /* Don't release the block that will be deleted during finalization
+       * and frozen blocks
+       */
+      if( ! ( pAlloc->used & ( HB_GC_DELETE | HB_GC_FROZEN ) ) )
       {
          HB_GC_LOCK();
          if( pAlloc->locked )
@@ -271,7 +285,11 @@ const HB_GC_FUNCS * hb_gcFuncs( void * pBlock )
 #undef hb_gcRefInc
 void hb_gcRefInc( void * pBlock )
 {
-   hb_xRefInc( HB_GC_PTR( pBlock ) );
+   PHB_GARBAGE pAlloc = HB_GC_PTR( pBlock );
+
+   /* frozen blocks are permanent so they do not need reference counter */
+   if( ! ( pAlloc->used & HB_GC_FROZEN ) )
+      hb_xRefInc( pAlloc );
 }
 
 /* decrement reference counter and free the block when 0 reached */
@@ -282,7 +300,7 @@ void hb_gcRefFree( void * pBlock )
    {
       PHB_GARBAGE pAlloc = HB_GC_PTR( pBlock );
 
-      if( hb_xRefDec( pAlloc ) )
+      if( ! ( pAlloc->used & HB_GC_FROZEN ) && hb_xRefDec( pAlloc ) )
       {
          /* Don't release the block that will be deleted during finalization */
          if( ! ( pAlloc->used & HB_GC_DELETE ) )
@@ -394,6 +412,9 @@ void * hb_gcLock( void * pBlock )
    {
       PHB_GARBAGE pAlloc = HB_GC_PTR( pBlock );
 
+      if( pAlloc->used & HB_GC_FROZEN )
+         return pBlock;
+
       HB_GC_LOCK();
       if( ! pAlloc->locked )
       {
@@ -417,7 +438,7 @@ void * hb_gcUnlock( void * pBlock )
    {
       PHB_GARBAGE pAlloc = HB_GC_PTR( pBlock );
 
-      if( pAlloc->locked )
+      if( pAlloc->locked && ! ( pAlloc->used & HB_GC_FROZEN ) )
       {
          HB_GC_LOCK();
          if( pAlloc->locked )
@@ -441,6 +462,9 @@ void hb_gcAttach( void * pBlock )
 {
    PHB_GARBAGE pAlloc = HB_GC_PTR( pBlock );
 
+   if( pAlloc->used & HB_GC_FROZEN )
+      return;
+
    if( pAlloc->locked )
    {
       HB_GC_LOCK();
@@ -462,6 +486,74 @@ void hb_gcAttach( void * pBlock )
       hb_xRefInc( pAlloc );
 }
 
+/* Frozen blocks are moved from GC lists to separate permanent region.
+ * They can reference only other frozen blocks so GC does not have to
+ * scan them and they are never released before HVM exit. Reference
+ * counters of frozen blocks are not updated so they can be accessed
+ * by many threads without any synchronization.
+ * MTNOTE: items are frozen inside C code which does not release HVM
+ *         so GC cannot be activated before all visited blocks are
+ *         committed or rolled back by hb_gcFreezeLeave().
+ */
+HB_BOOL hb_gcFreezeVisit( void * pBlock )
+{
+   PHB_GARBAGE pAlloc = HB_GC_PTR( pBlock );
+
+   if( pAlloc->used & ( HB_GC_FROZEN | HB_GC_FREEZING ) )
+      return HB_FALSE;
+
+   pAlloc->used |= HB_GC_FREEZING;
+   return HB_TRUE;
+}
+
+HB_BOOL hb_gcFreezeLeave( void * pBlock, HB_BOOL fCommit )
+{
+   PHB_GARBAGE pAlloc = HB_GC_PTR( pBlock );
+
+   if( ! ( pAlloc->used & HB_GC_FREEZING ) )
+      return HB_FALSE;
+
+   pAlloc->used &= ~HB_GC_FREEZING;
+   if( fCommit )
+   {
+      HB_GC_LOCK();
+      if( pAlloc->locked )
+         hb_gcUnlink( &s_pLockedBlock, pAlloc );
+      else
+      {
+         hb_gcUnlink( &s_pCurrBlock, pAlloc );
+         HB_GC_AUTO_DEC();
+      }
+      hb_gcLink( &s_pFrozenBlock, pAlloc );
+      pAlloc->used |= HB_GC_FROZEN;
+      HB_GC_UNLOCK();
+   }
+   return HB_TRUE;
+}
+
+void hb_gcFreezeMem( void * pMem )
+{
+   HB_GC_LOCK();
+   if( s_nFrozenMem == s_nFrozenMemSize )
+   {
+      s_nFrozenMemSize += ( s_nFrozenMemSize >> 1 ) + 256;
+      s_pFrozenMem = ( void ** ) hb_xrealloc( s_pFrozenMem,
+                                       s_nFrozenMemSize * sizeof( void * ) );
+   }
+   s_pFrozenMem[ s_nFrozenMem++ ] = pMem;
+   HB_GC_UNLOCK();
+}
+
+HB_BOOL hb_itemIsFrozen( PHB_ITEM pItem )
+{
+   if( HB_IS_ARRAY( pItem ) )
+      return ( HB_GC_PTR( pItem->item.asArray.value )->used & HB_GC_FROZEN ) != 0;
+   else if( HB_IS_HASH( pItem ) )
+      return ( HB_GC_PTR( pItem->item.asHash.value )->used & HB_GC_FROZEN ) != 0;
+   else
+      return HB_FALSE;
+}
+
 /* mark passed memory block as used so it will be not released by the GC */
 void hb_gcMark( void * pBlock )
 {
@@ -715,6 +807,54 @@ void hb_gcCollectAll( HB_BOOL fForce )
    }
 }
 
+static void hb_gcMemSnapshotList( PHB_GARBAGE pList, PHB_MEMSNAPSHOT pSnap )
+{
+   if( pList )
+   {
+      PHB_GARBAGE pAlloc = pList;
+
+      do
+      {
+         void * pBlock = HB_BLOCK_PTR( pAlloc );
+
+         if( ! hb_arrayMemStat( pBlock, pAlloc->pFuncs, pSnap ) &&
+             ! hb_hashMemStat( pBlock, pAlloc->pFuncs, pSnap ) &&
+             ! hb_codeblockMemStat( pBlock, pAlloc->pFuncs, pSnap ) )
+         {
+            pSnap->other.nCount++;
+            pSnap->other.nBytes += hb_xsize( pAlloc );
+         }
+         pAlloc = pAlloc->pNext;
+      }
+      while( pAlloc != pList );
+   }
+}
+
+/* count all GC blocks by item type and objects by class, other threads
+ * are suspended only for the time of scanning block lists like during
+ * GC pass, pSnap has to be cleared by caller and pSnap->pClasses
+ * has to be released by hb_xfree()
+ */
+HB_BOOL hb_gcMemSnapshot( PHB_MEMSNAPSHOT pSnap )
+{
+   if( ! s_bCollecting && hb_vmSuspendThreads( HB_TRUE ) )
+   {
+      if( s_bCollecting )
+      {
+         hb_vmResumeThreads();
+         return HB_FALSE;
+      }
+
+      hb_gcMemSnapshotList( s_pCurrBlock, pSnap );
+      hb_gcMemSnapshotList( s_pLockedBlock, pSnap );
+      hb_gcMemSnapshotList( s_pFrozenBlock, pSnap );
+
+      hb_vmResumeThreads();
+      return HB_TRUE;
+   }
+   return HB_FALSE;
+}
+
 
 /* MTNOTE: It's executed at the end of HVM cleanup code just before
  *         application exit when other threads are destroyed, so it
@@ -753,6 +893,38 @@ void hb_gcReleaseAll( void )
       while( s_pCurrBlock );
    }
 
+   if( s_pFrozenBlock )
+   {
+      PHB_GARBAGE pAlloc = s_pFrozenBlock;
+
+      s_bCollecting = HB_TRUE;
+
+      do
+      {
+         s_pFrozenBlock->used |= HB_GC_DELETE | HB_GC_DELETELST;
+         s_pFrozenBlock->pFuncs->clear( HB_BLOCK_PTR( s_pFrozenBlock ) );
+         s_pFrozenBlock = s_pFrozenBlock->pNext;
+      }
+      while( pAlloc != s_pFrozenBlock );
+
+      do
+      {
+         PHB_GARBAGE pDelete = s_pFrozenBlock;
+         hb_gcUnlink( &s_pFrozenBlock, pDelete );
+         HB_GARBAGE_FREE( pDelete );
+      }
+      while( s_pFrozenBlock );
+   }
+
+   if( s_pFrozenMem )
+   {
+      while( s_nFrozenMem )
+         hb_xRefFree( s_pFrozenMem[ --s_nFrozenMem ] );
+      hb_xfree( s_pFrozenMem );
+      s_pFrozenMem = NULL;
+      s_nFrozenMemSize = 0;
+   }
+
    s_bCollecting = HB_FALSE;
 }
 
@@ -74,8 +74,18 @@ typedef struct _HB_BASEHASH
    HB_SIZE      nSize;        /* size of allocated pair array */
    HB_SIZE      nLen;         /* number of used items in pair array */
    int          iFlags;       /* hash item flags */
+   HB_BOOL      fShared;      /* pairs can be shared with copy-on-write clones or frozen */
+   HB_BOOL      fFrozen;      /* hash is frozen by hb_itemFreeze() */
+   HB_BOOL      fRefs;        /* some values were detached by item references */
+   HB_BOOL      fShareOwner;  /* nested values of shared pairs belong to this hash */
 } HB_BASEHASH, * PHB_BASEHASH;
 
+#define HB_HASH_UNSHARE( p )  do { if( ( p )->fShared ) hb_hashUnshare( p ); } while( 0 )
+#define HB_HASH_WRITABLE( p ) ( ! ( p )->fShared || hb_hashWritable( p ) )
+
+static void hb_hashUnshare( PHB_BASEHASH pBaseHash );
+static HB_BOOL hb_hashWritable( PHB_BASEHASH pBaseHash );
+
 
 /* This releases hash when called from the garbage collector */
 static HB_GARBAGE_FUNC( hb_hashGarbageRelease )
@@ -84,6 +94,21 @@ static HB_GARBAGE_FUNC( hb_hashGarbageRelease )
 
    HB_TRACE( HB_TR_INFO, ( "hb_hashGarbageRelease(%p)", ( void * ) pBaseHash ) );
 
+   if( pBaseHash->fShared )
+   {
+      pBaseHash->fShared = HB_FALSE;
+      pBaseHash->fShareOwner = HB_FALSE;
+      if( pBaseHash->pnPos )
+         hb_xRefDec( pBaseHash->pnPos );
+      /* pairs are still used by other copy-on-write clones */
+      if( ! hb_xRefDec( pBaseHash->pPairs ) )
+      {
+         pBaseHash->pPairs = NULL;
+         pBaseHash->pnPos = NULL;
+         pBaseHash->nSize = pBaseHash->nLen = 0;
+      }
+   }
+
    if( pBaseHash->nSize > 0 )
    {
       while( pBaseHash->nLen )
@@ -164,6 +189,43 @@ static const HB_GC_FUNCS s_gcHashFuncs =
    hb_hashGarbageMark
 };
 
+/* account hash GC block in heap snapshot */
+HB_BOOL hb_hashMemStat( void * pBlock, const HB_GC_FUNCS * pFuncs, PHB_MEMSNAPSHOT pSnap )
+{
+   if( pFuncs == &s_gcHashFuncs )
+   {
+      PHB_BASEHASH pBaseHash = ( PHB_BASEHASH ) pBlock;
+      HB_COUNTER nShare = 1;
+      HB_SIZE nBytes, nPos;
+
+      /* pairs shared by copy-on-write clones are split between them */
+      if( pBaseHash->fShared && pBaseHash->pPairs )
+      {
+         nShare = hb_xRefCount( pBaseHash->pPairs );
+         if( nShare == 0 )
+            nShare = 1;
+      }
+      nBytes = pBaseHash->nSize * sizeof( HB_HASHPAIR );
+      if( pBaseHash->pnPos )
+         nBytes += pBaseHash->nSize * sizeof( HB_SIZE );
+      nBytes = sizeof( HB_BASEHASH ) + nBytes / nShare;
+
+      pSnap->hashes.nCount++;
+      pSnap->hashes.nBytes += nBytes;
+
+      for( nPos = 0; nPos < pBaseHash->nLen; ++nPos )
+      {
+         hb_itemMemStat( &pBaseHash->pPairs[ nPos ].key, nShare, pSnap );
+         hb_itemMemStat( &pBaseHash->pPairs[ nPos ].value, nShare, pSnap );
+      }
+      if( pBaseHash->pDefault )
+         hb_itemMemStat( pBaseHash->pDefault, 1, pSnap );
+
+      return HB_TRUE;
+   }
+   return HB_FALSE;
+}
+
 static int hb_hashItemCmp( PHB_ITEM pKey1, PHB_ITEM pKey2, int iFlags )
 {
    if( HB_IS_STRING( pKey1 ) )
@@ -576,6 +638,10 @@ PHB_ITEM hb_hashNew( PHB_ITEM pItem )
    pBaseHash->nLen     = 0;
    pBaseHash->iFlags   = HB_HASH_FLAG_DEFAULT;
    pBaseHash->pDefault = NULL;
+   pBaseHash->fShared  = HB_FALSE;
+   pBaseHash->fFrozen  = HB_FALSE;
+   pBaseHash->fRefs    = HB_FALSE;
+   pBaseHash->fShareOwner = HB_FALSE;
 
    pItem->type = HB_IT_HASH;
    pItem->item.asHash.value = pBaseHash;
@@ -597,7 +663,7 @@ void hb_hashPreallocate( PHB_ITEM pHash, HB_SIZE nNewSize )
 {
    HB_TRACE( HB_TR_DEBUG, ( "hb_hashPreallocate(%p,%" HB_PFS "u)", ( void * ) pHash, nNewSize ) );
 
-   if( HB_IS_HASH( pHash ) )
+   if( HB_IS_HASH( pHash ) && HB_HASH_WRITABLE( pHash->item.asHash.value ) )
       hb_hashResize( pHash->item.asHash.value, nNewSize );
 }
 
@@ -605,7 +671,7 @@ HB_BOOL hb_hashAllocNewPair( PHB_ITEM pHash, PHB_ITEM * pKeyPtr, PHB_ITEM * pVal
 {
    HB_TRACE( HB_TR_DEBUG, ( "hb_hashAllocNewPair(%p,%p,%p)", ( void * ) pHash, ( void * ) pKeyPtr, ( void * ) pValPtr ) );
 
-   if( HB_IS_HASH( pHash ) )
+   if( HB_IS_HASH( pHash ) && HB_HASH_WRITABLE( pHash->item.asHash.value ) )
    {
       hb_hashNewPair( pHash->item.asHash.value, pKeyPtr, pValPtr );
       return HB_TRUE;
@@ -618,7 +684,7 @@ void hb_hashSort( PHB_ITEM pHash )
 {
    HB_TRACE( HB_TR_DEBUG, ( "hb_hashSort(%p)", ( void * ) pHash ) );
 
-   if( HB_IS_HASH( pHash ) )
+   if( HB_IS_HASH( pHash ) && HB_HASH_WRITABLE( pHash->item.asHash.value ) )
    {
       PHB_BASEHASH pBaseHash = pHash->item.asHash.value;
 
@@ -636,7 +702,32 @@ PHB_ITEM hb_hashGetItemPtr( PHB_ITEM pHash, PHB_ITEM pKey, int iFlags )
 
    if( HB_IS_HASH( pHash ) && HB_IS_HASHKEY( pKey ) )
    {
-      PHB_ITEM pDest = hb_hashValuePtr( pHash->item.asHash.value, pKey,
+      PHB_ITEM pDest;
+
+      if( pHash->item.asHash.value->fShared )
+      {
+         PHB_BASEHASH pBaseHash = pHash->item.asHash.value;
+
+         /* assignments to frozen hash items are refused, caller
+          * can use hb_itemIsFrozen() to generate proper RT error
+          */
+         if( pBaseHash->fFrozen )
+         {
+            static HB_ITEM s_NIL;
+
+            if( iFlags & HB_HASH_AUTOADD_ASSIGN )
+               return NULL;
+            pDest = hb_hashValuePtr( pBaseHash, pKey, HB_FALSE );
+            /* missing keys are not added, autoadd access returns
+             * the default value which cannot be modified
+             */
+            if( pDest == NULL && iFlags && ( pBaseHash->iFlags & iFlags ) == iFlags )
+               pDest = pBaseHash->pDefault ? pBaseHash->pDefault : &s_NIL;
+            return pDest;
+         }
+         hb_hashUnshare( pBaseHash );
+      }
+      pDest = hb_hashValuePtr( pHash->item.asHash.value, pKey,
          iFlags && ( pHash->item.asHash.value->iFlags & iFlags ) == iFlags );
       if( pDest )
          return HB_IS_BYREF( pDest ) ? hb_itemUnRef( pDest ) : pDest;
@@ -645,6 +736,36 @@ PHB_ITEM hb_hashGetItemPtr( PHB_ITEM pHash, PHB_ITEM pKey, int iFlags )
    return NULL;
 }
 
+/* the same as hb_hashGetItemPtr() but it does not make copy-on-write
+ * pairs private when the value is not array or hash and no new key is
+ * added, returned item cannot be modified
+ */
+PHB_ITEM hb_hashGetItemReadPtr( PHB_ITEM pHash, PHB_ITEM pKey, int iFlags )
+{
+   HB_TRACE( HB_TR_DEBUG, ( "hb_hashGetItemReadPtr(%p,%p,%d)", ( void * ) pHash, ( void * ) pKey, iFlags ) );
+
+   if( HB_IS_HASH( pHash ) && HB_IS_HASHKEY( pKey ) &&
+       pHash->item.asHash.value->fShared )
+   {
+      PHB_BASEHASH pBaseHash = pHash->item.asHash.value;
+      HB_SIZE nPos;
+
+      if( hb_hashFind( pBaseHash, pKey, &nPos ) )
+      {
+         PHB_ITEM pDest = &pBaseHash->pPairs[ nPos ].value;
+
+         if( HB_IS_BYREF( pDest ) )
+            pDest = hb_itemUnRef( pDest );
+         if( ! HB_IS_ARRAY( pDest ) && ! HB_IS_HASH( pDest ) )
+            return pDest;
+      }
+      else if( ! iFlags || ( pBaseHash->iFlags & iFlags ) != iFlags )
+         return NULL;
+   }
+
+   return hb_hashGetItemPtr( pHash, pKey, iFlags );
+}
+
 PHB_ITEM hb_hashGetCItemPtr( PHB_ITEM pHash, const char * pszKey )
 {
    HB_TRACE( HB_TR_DEBUG, ( "hb_hashGetCItemPtr(%p,%s)", ( void * ) pHash, pszKey ) );
@@ -656,7 +777,10 @@ PHB_ITEM hb_hashGetCItemPtr( PHB_ITEM pHash, const char * pszKey )
        * safe to use hb_itemPutCConst()
        */
       PHB_ITEM pKey = hb_itemPutCConst( hb_stackAllocItem(), pszKey );
-      PHB_ITEM pDest = hb_hashValuePtr( pHash->item.asHash.value, pKey, HB_FALSE );
+      PHB_ITEM pDest;
+
+      HB_HASH_UNSHARE( pHash->item.asHash.value );
+      pDest = hb_hashValuePtr( pHash->item.asHash.value, pKey, HB_FALSE );
       hb_stackPop();
       if( pDest )
          return HB_IS_BYREF( pDest ) ? hb_itemUnRef( pDest ) : pDest;
@@ -695,13 +819,21 @@ PHB_ITEM hb_hashGetItemRefPtr( PHB_ITEM pHash, PHB_ITEM pKey )
 
    if( HB_IS_HASH( pHash ) && HB_IS_HASHKEY( pKey ) )
    {
-      PHB_ITEM pDest = hb_hashValuePtr( pHash->item.asHash.value, pKey,
+      PHB_ITEM pDest;
+
+      if( pHash->item.asHash.value->fFrozen )
+         return NULL;
+      HB_HASH_UNSHARE( pHash->item.asHash.value );
+      pDest = hb_hashValuePtr( pHash->item.asHash.value, pKey,
             ( pHash->item.asHash.value->iFlags & HB_HASH_AUTOADD_REFERENCE ) ==
             HB_HASH_AUTOADD_REFERENCE );
       if( pDest )
       {
          if( ! HB_IS_BYREF( pDest ) )
+         {
             pDest = hb_memvarDetachLocal( pDest );
+            pHash->item.asHash.value->fRefs = HB_TRUE;
+         }
          return pDest;
       }
    }
@@ -781,6 +913,8 @@ HB_BOOL hb_hashClear( PHB_ITEM pHash )
 
    if( HB_IS_HASH( pHash ) )
    {
+      if( ! HB_HASH_WRITABLE( pHash->item.asHash.value ) )
+         return HB_FALSE;
       if( pHash->item.asHash.value->nSize )
       {
          while( pHash->item.asHash.value->nLen )
@@ -822,7 +956,7 @@ HB_BOOL hb_hashDel( PHB_ITEM pHash, PHB_ITEM pKey )
       PHB_BASEHASH pBaseHash = pHash->item.asHash.value;
       HB_SIZE nPos;
 
-      if( hb_hashFind( pBaseHash, pKey, &nPos ) )
+      if( hb_hashFind( pBaseHash, pKey, &nPos ) && HB_HASH_WRITABLE( pBaseHash ) )
       {
          hb_hashDelPair( pBaseHash, nPos );
          return HB_TRUE;
@@ -871,7 +1005,8 @@ HB_BOOL hb_hashAdd( PHB_ITEM pHash, PHB_ITEM pKey, PHB_ITEM pValue )
 {
    HB_TRACE( HB_TR_DEBUG, ( "hb_hashAdd(%p,%p,%p)", ( void * ) pHash, ( void * ) pKey, ( void * ) pValue ) );
 
-   if( HB_IS_HASH( pHash ) && HB_IS_HASHKEY( pKey ) )
+   if( HB_IS_HASH( pHash ) && HB_IS_HASHKEY( pKey ) &&
+       HB_HASH_WRITABLE( pHash->item.asHash.value ) )
    {
       PHB_ITEM pDest = hb_hashValuePtr( pHash->item.asHash.value, pKey, HB_TRUE );
       if( pDest )
@@ -893,7 +1028,8 @@ HB_BOOL hb_hashAddNew( PHB_ITEM pHash, PHB_ITEM pKey, PHB_ITEM pValue )
 {
    HB_TRACE( HB_TR_DEBUG, ( "hb_hashAddNew(%p,%p,%p)", ( void * ) pHash, ( void * ) pKey, ( void * ) pValue ) );
 
-   if( HB_IS_HASH( pHash ) && HB_IS_HASHKEY( pKey ) )
+   if( HB_IS_HASH( pHash ) && HB_IS_HASHKEY( pKey ) &&
+       HB_HASH_WRITABLE( pHash->item.asHash.value ) )
       return hb_hashNewValue( pHash->item.asHash.value, pKey, pValue );
    else
       return HB_FALSE;
@@ -915,7 +1051,10 @@ PHB_ITEM hb_hashGetValueAt( PHB_ITEM pHash, HB_SIZE nPos )
 
    if( HB_IS_HASH( pHash ) && nPos > 0 && nPos <= pHash->item.asHash.value->nLen )
    {
-      PHB_ITEM pValue = &pHash->item.asHash.value->pPairs[ nPos - 1 ].value;
+      PHB_ITEM pValue;
+
+      HB_HASH_UNSHARE( pHash->item.asHash.value );
+      pValue = &pHash->item.asHash.value->pPairs[ nPos - 1 ].value;
       return HB_IS_BYREF( pValue ) ? hb_itemUnRef( pValue ) : pValue;
    }
    else
@@ -926,7 +1065,8 @@ HB_BOOL hb_hashDelAt( PHB_ITEM pHash, HB_SIZE nPos )
 {
    HB_TRACE( HB_TR_DEBUG, ( "hb_hashDelAt(%p,%" HB_PFS "u)", ( void * ) pHash, nPos ) );
 
-   if( HB_IS_HASH( pHash ) && nPos > 0 && nPos <= pHash->item.asHash.value->nLen )
+   if( HB_IS_HASH( pHash ) && nPos > 0 && nPos <= pHash->item.asHash.value->nLen &&
+       HB_HASH_WRITABLE( pHash->item.asHash.value ) )
    {
       hb_hashDelPair( pHash->item.asHash.value, nPos - 1 );
       return HB_TRUE;
@@ -1000,15 +1140,230 @@ PHB_ITEM hb_hashClone( PHB_ITEM pHash )
    return hb_hashCloneTo( hb_itemNew( NULL ), pHash );
 }
 
+/* copy-on-write hash clones share pairs and order index with source
+ * hash, see hb_arrayUnshare() for details
+ */
+static void hb_hashUnshare( PHB_BASEHASH pBaseHash )
+{
+   PHB_HASHPAIR pPairs = pBaseHash->pPairs;
+   HB_BOOL fOwner = pBaseHash->fShareOwner;
+
+   HB_TRACE( HB_TR_DEBUG, ( "hb_hashUnshare(%p)", ( void * ) pBaseHash ) );
+
+   /* frozen hashes have private pairs which cannot be modified */
+   if( pBaseHash->fFrozen )
+      return;
+
+   pBaseHash->fShared = pBaseHash->fShareOwner = HB_FALSE;
+   if( pPairs && hb_xRefCount( pPairs ) > 1 )
+   {
+      HB_SIZE * pnPos = pBaseHash->pnPos;
+      HB_SIZE nLen = pBaseHash->nLen, nPos;
+
+      pBaseHash->pPairs = ( PHB_HASHPAIR ) hb_xgrab( nLen * sizeof( HB_HASHPAIR ) );
+      pBaseHash->nSize = nLen;
+      pBaseHash->nLen = 0;
+      if( pnPos )
+      {
+         pBaseHash->pnPos = ( HB_SIZE * ) hb_xgrab( nLen * sizeof( HB_SIZE ) );
+         memcpy( pBaseHash->pnPos, pnPos, nLen * sizeof( HB_SIZE ) );
+      }
+      for( nPos = 0; nPos < nLen; ++nPos )
+      {
+         pBaseHash->pPairs[ nPos ].key.type = HB_IT_NIL;
+         pBaseHash->pPairs[ nPos ].value.type = HB_IT_NIL;
+      }
+      if( fOwner )
+      {
+         for( nPos = 0; nPos < nLen; ++nPos )
+         {
+            hb_itemCopy( &pBaseHash->pPairs[ nPos ].key, &pPairs[ nPos ].key );
+            hb_itemCopy( &pBaseHash->pPairs[ nPos ].value, &pPairs[ nPos ].value );
+            pBaseHash->nLen++;
+            hb_nestedCloneCOWShared( &pPairs[ nPos ].value );
+         }
+      }
+      else
+      {
+         /* values are copied dereferenced */
+         pBaseHash->fRefs = HB_FALSE;
+         for( nPos = 0; nPos < nLen; ++nPos )
+         {
+            PHB_ITEM pValue = &pPairs[ nPos ].value;
+            if( HB_IS_BYREF( pValue ) )
+               pValue = hb_itemUnRef( pValue );
+            hb_itemCopy( &pBaseHash->pPairs[ nPos ].key, &pPairs[ nPos ].key );
+            pBaseHash->nLen++;
+            hb_nestedCloneCOW( &pBaseHash->pPairs[ nPos ].value, pValue );
+         }
+      }
+
+      /* other clones released the pairs in the meantime */
+      if( pnPos && hb_xRefDec( pnPos ) )
+         hb_xfree( pnPos );
+      if( hb_xRefDec( pPairs ) )
+      {
+         while( nLen-- )
+         {
+            if( HB_IS_COMPLEX( &pPairs[ nLen ].key ) )
+               hb_itemClear( &pPairs[ nLen ].key );
+            if( HB_IS_COMPLEX( &pPairs[ nLen ].value ) )
+               hb_itemClear( &pPairs[ nLen ].value );
+         }
+         hb_xfree( pPairs );
+      }
+   }
+}
+
+PHB_ITEM hb_hashCloneCOWTo( PHB_ITEM pDest, PHB_ITEM pHash )
+{
+   HB_TRACE( HB_TR_DEBUG, ( "hb_hashCloneCOWTo(%p,%p)", ( void * ) pDest, ( void * ) pHash ) );
+
+   /* frozen hash cannot be changed so it does not need a copy */
+   if( HB_IS_HASH( pHash ) && pHash->item.asHash.value->fFrozen )
+      hb_itemCopy( pDest, pHash );
+   else if( HB_IS_HASH( pHash ) )
+   {
+      PHB_BASEHASH pSrcHash = pHash->item.asHash.value;
+      PHB_BASEHASH pBaseHash = ( PHB_BASEHASH )
+                  hb_gcAllocRaw( sizeof( HB_BASEHASH ), &s_gcHashFuncs );
+      HB_BOOL fRefs;
+
+      /* shared pairs cannot be resorted later */
+      if( pSrcHash->iFlags & HB_HASH_RESORT )
+      {
+         HB_HASH_UNSHARE( pSrcHash );
+         hb_hashSortDo( pSrcHash );
+      }
+
+      if( pSrcHash->nLen )
+      {
+         /* the first clone of private pairs makes source the share owner */
+         if( hb_xRefCount( pSrcHash->pPairs ) == 1 )
+            pSrcHash->fShareOwner = HB_TRUE;
+         hb_xRefInc( pSrcHash->pPairs );
+         if( pSrcHash->pnPos )
+            hb_xRefInc( pSrcHash->pnPos );
+         pSrcHash->fShared = HB_TRUE;
+         pBaseHash->pPairs  = pSrcHash->pPairs;
+         pBaseHash->pnPos   = pSrcHash->pnPos;
+         pBaseHash->nSize   = pSrcHash->nSize;
+         pBaseHash->nLen    = pSrcHash->nLen;
+         pBaseHash->fShared = HB_TRUE;
+      }
+      else
+      {
+         pBaseHash->pPairs  = NULL;
+         pBaseHash->pnPos   = NULL;
+         pBaseHash->nSize   = 0;
+         pBaseHash->nLen    = 0;
+         pBaseHash->fShared = HB_FALSE;
+      }
+      pBaseHash->fFrozen  = HB_FALSE;
+      pBaseHash->fRefs    = HB_FALSE;
+      pBaseHash->fShareOwner = HB_FALSE;
+      pBaseHash->iFlags   = pSrcHash->iFlags;
+      pBaseHash->pDefault = NULL;
+      if( pSrcHash->pDefault )
+      {
+         pBaseHash->pDefault = hb_itemNew( pSrcHash->pDefault );
+         hb_gcUnlock( pBaseHash->pDefault );
+      }
+
+      /* values detached by references can be changed without
+         touching the hash so they cannot be shared */
+      fRefs = pSrcHash->fRefs;
+
+      /* pDest can keep the last reference to source hash */
+      if( HB_IS_COMPLEX( pDest ) )
+         hb_itemClear( pDest );
+      pDest->type = HB_IT_HASH;
+      pDest->item.asHash.value = pBaseHash;
+
+      if( fRefs && pBaseHash->fShared )
+         hb_hashUnshare( pBaseHash );
+   }
+
+   return pDest;
+}
+
+PHB_ITEM hb_hashCloneCOW( PHB_ITEM pHash )
+{
+   HB_TRACE( HB_TR_DEBUG, ( "hb_hashCloneCOW(%p)", ( void * ) pHash ) );
+
+   return hb_hashCloneCOWTo( hb_itemNew( NULL ), pHash );
+}
+
+static HB_BOOL hb_hashWritable( PHB_BASEHASH pBaseHash )
+{
+   if( pBaseHash->fFrozen )
+   {
+      hb_errRT_BASE( EG_READONLY, 1134, NULL, HB_ERR_FUNCNAME, 0 );
+      return HB_FALSE;
+   }
+   hb_hashUnshare( pBaseHash );
+   return HB_TRUE;
+}
+
+/* freeze hash pairs and default value, see hb_nestedFreeze() */
+HB_BOOL hb_hashFreezeItems( PHB_ITEM pHash, int iMode )
+{
+   PHB_BASEHASH pBaseHash = pHash->item.asHash.value;
+   HB_SIZE nPos;
+
+   HB_TRACE( HB_TR_DEBUG, ( "hb_hashFreezeItems(%p,%d)", ( void * ) pHash, iMode ) );
+
+   if( iMode == HB_FREEZE_CHECK )
+   {
+      if( hb_gcFreezeVisit( pBaseHash ) )
+      {
+         /* key lookup cannot resort frozen pairs */
+         HB_HASH_UNSHARE( pBaseHash );
+         if( pBaseHash->iFlags & HB_HASH_RESORT )
+            hb_hashSortDo( pBaseHash );
+
+         if( pBaseHash->pDefault && hb_gcFreezeVisit( pBaseHash->pDefault ) &&
+             ! hb_nestedFreeze( pBaseHash->pDefault, iMode ) )
+            return HB_FALSE;
+
+         for( nPos = 0; nPos < pBaseHash->nLen; ++nPos )
+         {
+            if( ! hb_nestedFreeze( &pBaseHash->pPairs[ nPos ].key, iMode ) ||
+                ! hb_nestedFreeze( &pBaseHash->pPairs[ nPos ].value, iMode ) )
+               return HB_FALSE;
+         }
+      }
+   }
+   else if( hb_gcFreezeLeave( pBaseHash, iMode == HB_FREEZE_COMMIT ) )
+   {
+      if( iMode == HB_FREEZE_COMMIT )
+         pBaseHash->fFrozen = pBaseHash->fShared = HB_TRUE;
+      if( pBaseHash->pDefault &&
+          hb_gcFreezeLeave( pBaseHash->pDefault, iMode == HB_FREEZE_COMMIT ) )
+         hb_nestedFreeze( pBaseHash->pDefault, iMode );
+      for( nPos = 0; nPos < pBaseHash->nLen; ++nPos )
+      {
+         hb_nestedFreeze( &pBaseHash->pPairs[ nPos ].key, iMode );
+         hb_nestedFreeze( &pBaseHash->pPairs[ nPos ].value, iMode );
+      }
+   }
+
+   return HB_TRUE;
+}
+
 void hb_hashJoin( PHB_ITEM pDest, PHB_ITEM pSource, int iType )
 {
    HB_TRACE( HB_TR_DEBUG, ( "hb_hashJoin(%p,%p,%d)", ( void * ) pDest, ( void * ) pSource, iType ) );
 
-   if( HB_IS_HASH( pDest ) && HB_IS_HASH( pSource ) )
+   if( HB_IS_HASH( pDest ) && HB_IS_HASH( pSource ) &&
+       HB_HASH_WRITABLE( pDest->item.asHash.value ) )
    {
       PHB_BASEHASH pBaseHash;
       HB_SIZE nPos;
 
+      /* values are copied from source and modified in destination */
+      HB_HASH_UNSHARE( pSource->item.asHash.value );
+
       switch( iType )
       {
          case HB_HASH_UNION:        /* OR */
@@ -1129,7 +1484,7 @@ void hb_hashSetDefault( PHB_ITEM pHash, PHB_ITEM pValue )
 {
    HB_TRACE( HB_TR_DEBUG, ( "hb_hashSetDefault(%p,%p)", ( void * ) pHash, ( void * ) pValue ) );
 
-   if( HB_IS_HASH( pHash ) )
+   if( HB_IS_HASH( pHash ) && HB_HASH_WRITABLE( pHash->item.asHash.value ) )
    {
       if( pHash->item.asHash.value->pDefault )
       {
@@ -1162,12 +1517,23 @@ void hb_hashSetFlags( PHB_ITEM pHash, int iFlags )
 
    if( HB_IS_HASH( pHash ) )
    {
+      /* frozen hash flags cannot be changed, they define the sort order */
+      if( pHash->item.asHash.value->fFrozen )
+      {
+         hb_hashWritable( pHash->item.asHash.value );
+         return;
+      }
+      if( iFlags & HB_HASH_RESORT )
+         HB_HASH_UNSHARE( pHash->item.asHash.value );
       pHash->item.asHash.value->iFlags |= iFlags;
       if( pHash->item.asHash.value->pnPos == NULL &&
           pHash->item.asHash.value->nSize &&
           ( pHash->item.asHash.value->iFlags & HB_HASH_KEEPORDER ) != 0 )
       {
-         HB_SIZE n = pHash->item.asHash.value->nSize;
+         HB_SIZE n;
+
+         HB_HASH_UNSHARE( pHash->item.asHash.value );
+         n = pHash->item.asHash.value->nSize;
 
          pHash->item.asHash.value->pnPos = ( HB_SIZE * )
                                              hb_xgrab( n * sizeof( HB_SIZE ) );
@@ -1185,12 +1551,13 @@ void hb_hashClearFlags( PHB_ITEM pHash, int iFlags )
 {
    HB_TRACE( HB_TR_DEBUG, ( "hb_hashClearFlags(%p,%d)", ( void * ) pHash, iFlags ) );
 
-   if( HB_IS_HASH( pHash ) )
+   if( HB_IS_HASH( pHash ) && HB_HASH_WRITABLE( pHash->item.asHash.value ) )
    {
       pHash->item.asHash.value->iFlags &= ~iFlags;
       if( pHash->item.asHash.value->pnPos != NULL &&
           ( pHash->item.asHash.value->iFlags & HB_HASH_KEEPORDER ) == 0 )
       {
+         HB_HASH_UNSHARE( pHash->item.asHash.value );
          hb_hashResort( pHash->item.asHash.value );
          hb_xfree( pHash->item.asHash.value->pnPos );
          pHash->item.asHash.value->pnPos = NULL;
@@ -115,7 +115,7 @@ HB_FUNC( HB_HGET )
 
    if( pHash && pKey )
    {
-      PHB_ITEM pDest = hb_hashGetItemPtr( pHash, pKey, HB_HASH_AUTOADD_ACCESS );
+      PHB_ITEM pDest = hb_hashGetItemReadPtr( pHash, pKey, HB_HASH_AUTOADD_ACCESS );
       if( pDest )
          hb_itemReturn( pDest );
       else
@@ -132,7 +132,7 @@ HB_FUNC( HB_HGETDEF )
 
    if( pHash && pKey )
    {
-      PHB_ITEM pDest = hb_hashGetItemPtr( pHash, pKey, HB_HASH_AUTOADD_ACCESS );
+      PHB_ITEM pDest = hb_hashGetItemReadPtr( pHash, pKey, HB_HASH_AUTOADD_ACCESS );
       if( pDest )
          hb_itemReturn( pDest );
       else
@@ -153,7 +153,7 @@ HB_FUNC( HB_HGETREF )
 
    if( pHash && pKey )
    {
-      PHB_ITEM pDest = hb_hashGetItemPtr( pHash, pKey, HB_HASH_AUTOADD_ACCESS );
+      PHB_ITEM pDest = hb_hashGetItemReadPtr( pHash, pKey, HB_HASH_AUTOADD_ACCESS );
       hb_itemParamStore( 3, pDest );
       hb_retl( pDest != NULL );
    }
@@ -218,7 +218,12 @@ HB_FUNC( HB_HVALUEAT )
       PHB_ITEM pItem = hb_hashGetValueAt( pHash, hb_itemGetNS( pPos ) );
       if( pItem )
       {
-         if( pValue )
+         if( pValue && hb_itemIsFrozen( pHash ) )
+         {
+            hb_errRT_BASE( EG_READONLY, 1134, NULL, HB_ERR_FUNCNAME, HB_ERR_ARGS_BASEPARAMS );
+            return;
+         }
+         else if( pValue )
             hb_itemCopy( pItem, pValue );
          else
             pValue = pItem;
@@ -273,7 +278,7 @@ HB_FUNC( HB_HDELAT )
    {
       if( hb_hashDelAt( pHash, hb_itemGetNS( pPos ) ) )
          hb_itemReturn( pHash );
-      else
+      else if( ! hb_itemIsFrozen( pHash ) )
          hb_errRT_BASE( EG_BOUND, 1133, NULL, hb_langDGetErrorDesc( EG_ARRASSIGN ), 2, pHash, pPos );
    }
    else
@@ -319,7 +324,9 @@ HB_FUNC( HB_HFILL )
    PHB_ITEM pHash = hb_param( 1, HB_IT_HASH );
    PHB_ITEM pValue = hb_param( 2, HB_IT_ANY );
 
-   if( pHash && pValue )
+   if( pHash && pValue && hb_itemIsFrozen( pHash ) )
+      hb_errRT_BASE( EG_READONLY, 1134, NULL, HB_ERR_FUNCNAME, HB_ERR_ARGS_BASEPARAMS );
+   else if( pHash && pValue )
    {
       PHB_ITEM pDest;
       HB_SIZE nPos = 0;
@@ -343,6 +350,16 @@ HB_FUNC( HB_HCLONE )
       hb_errRT_BASE( EG_ARG, 1123, NULL, HB_ERR_FUNCNAME, HB_ERR_ARGS_BASEPARAMS );
 }
 
+HB_FUNC( HB_HCLONECOW )
+{
+   PHB_ITEM pHash = hb_param( 1, HB_IT_HASH );
+
+   if( pHash )
+      hb_hashCloneCOWTo( hb_stackReturnItem(), pHash );
+   else
+      hb_errRT_BASE( EG_ARG, 1123, NULL, HB_ERR_FUNCNAME, HB_ERR_ARGS_BASEPARAMS );
+}
+
 HB_FUNC( HB_HCOPY )
 {
    PHB_ITEM pSource = hb_param( 1, HB_IT_HASH );
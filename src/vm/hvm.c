@@ -479,14 +479,52 @@ static HB_THREAD_NO s_threadNo = 0;
 
 #  define HB_THREQUEST_STOP   1
 #  define HB_THREQUEST_QUIT   2
+#  define HB_THREQUEST_SAMPLE 4
+
+/* sampling profiler request number */
+static int volatile s_iSampleTick = 0;
+/* number of running threads which have not served sampling request yet */
+static int s_iSamplePending = 0;
 
 #  define HB_VM_LOCK()    hb_threadEnterCriticalSection( &s_vmMtx )
 #  define HB_VM_UNLOCK()  hb_threadLeaveCriticalSection( &s_vmMtx )
 
 HB_BOOL hb_vmIsMt( void ) { return HB_TRUE; }
 
+/* thread stops executing PRG code and will not serve pending sampling
+ * request, should be called with HB_VM_LOCK
+ */
+static void hb_vmSampleSkip( int * piTick )
+{
+   if( *piTick != s_iSampleTick )
+   {
+      *piTick = s_iSampleTick;
+      if( ( hb_vmThreadRequest & HB_THREQUEST_SAMPLE ) &&
+          --s_iSamplePending <= 0 )
+         hb_vmThreadRequest &= ~HB_THREQUEST_SAMPLE;
+   }
+}
+
 static void hb_vmRequestTest( void )
 {
+   if( hb_vmThreadRequest & HB_THREQUEST_SAMPLE )
+   {
+      HB_STACK_TLS_PRELOAD
+      int iTick = s_iSampleTick;
+
+      if( *hb_stackProfTick() != iTick )
+      {
+         *hb_stackProfTick() = iTick;
+         hb_profSampleThread();
+         HB_VM_LOCK();
+         if( iTick == s_iSampleTick && --s_iSamplePending <= 0 )
+            hb_vmThreadRequest &= ~HB_THREQUEST_SAMPLE;
+         HB_VM_UNLOCK();
+      }
+      if( ( hb_vmThreadRequest & ~HB_THREQUEST_SAMPLE ) == 0 )
+         return;
+   }
+
    HB_VM_LOCK();
 
    s_iRunningCount--;
@@ -529,6 +567,8 @@ void hb_vmUnlock( void )
             s_iRunningCount--;
             if( hb_vmThreadRequest )
             {
+               /* threads which do not execute PRG code are not sampled */
+               hb_vmSampleSkip( hb_stackProfTick() );
                if( hb_vmThreadRequest & HB_THREQUEST_QUIT )
                {
                   if( ! hb_stackQuitState() )
@@ -574,6 +614,7 @@ void hb_vmLock( void )
                else
                   break;
             }
+            *hb_stackProfTick() = s_iSampleTick;
             s_iRunningCount++;
             HB_VM_UNLOCK();
          }
@@ -600,6 +641,7 @@ void hb_vmLockForce( void )
                   hb_stackSetActionRequest( HB_QUIT_REQUESTED );
                }
             }
+            *hb_stackProfTick() = s_iSampleTick;
             s_iRunningCount++;
             HB_VM_UNLOCK();
          }
@@ -607,6 +649,35 @@ void hb_vmLockForce( void )
    }
 }
 
+/* request call stack sample from all running HVM threads,
+ * used by sampling profiler
+ */
+void hb_vmSampleRequest( void )
+{
+   HB_VM_LOCK();
+
+   if( s_fHVMActive && s_iRunningCount > 0 &&
+       ( hb_vmThreadRequest & HB_THREQUEST_QUIT ) == 0 )
+   {
+      s_iSampleTick++;
+      s_iSamplePending = s_iRunningCount;
+      hb_vmThreadRequest |= HB_THREQUEST_SAMPLE;
+   }
+
+   HB_VM_UNLOCK();
+}
+
+/* drop pending sampling request when profiler is stopped */
+void hb_vmSampleCancel( void )
+{
+   HB_VM_LOCK();
+
+   s_iSamplePending = 0;
+   hb_vmThreadRequest &= ~HB_THREQUEST_SAMPLE;
+
+   HB_VM_UNLOCK();
+}
+
 /* (try to) stop all threads except current one */
 HB_BOOL hb_vmSuspendThreads( HB_BOOL fWait )
 {
@@ -661,9 +732,11 @@ void hb_vmTerminateThreads( void )
 
       hb_vmThreadRequest |= HB_THREQUEST_QUIT;
       --s_iRunningCount;
+      hb_vmSampleSkip( hb_stackProfTick() );
 
       hb_threadMutexUnlockAll();
       hb_threadMutexUnsubscribeAll();
+      hb_threadPoolWakeAll();
 
       hb_threadCondBroadcast( &s_vmCond );
 
@@ -692,6 +765,7 @@ void hb_vmWaitForThreads( void )
       HB_VM_LOCK();
 
       --s_iRunningCount;
+      hb_vmSampleSkip( hb_stackProfTick() );
       if( hb_vmThreadRequest )
          hb_threadCondBroadcast( &s_vmCond );
 
@@ -810,12 +884,14 @@ static void hb_vmStackRelease( void )
    HB_STACK_TLS_PRELOAD
    HB_BOOL fLocked;
    PHB_ITEM pThItm;
+   int iTick;
 
    HB_TRACE( HB_TR_DEBUG, ( "hb_vmStackRelease()" ) );
 
    HB_VM_LOCK();
 
    fLocked = hb_stackUnlock() == 1;
+   iTick = *hb_stackProfTick();
    pThItm = hb_vmStackDel( ( PHB_THREADSTATE ) hb_stackList(), HB_FALSE );
 
    HB_VM_UNLOCK();
@@ -835,7 +911,10 @@ static void hb_vmStackRelease( void )
    HB_VM_LOCK();
 
    if( fLocked )
+   {
       s_iRunningCount--;
+      hb_vmSampleSkip( &iTick );
+   }
 
    s_iStackCount--;
    hb_threadCondBroadcast( &s_vmCond );
@@ -1405,7 +1484,7 @@ void hb_vmExecute( const HB_BYTE * pCode, PHB_SYMB pSymbols )
          case HB_P_PLUSEQ:
             {
                PHB_ITEM pResult, pValue;
-               pResult = hb_itemUnRef( hb_stackItemFromTop( -2 ) );
+               pResult = hb_itemUnRefUpdate( hb_stackItemFromTop( -2 ) );
                pValue = hb_stackItemFromTop( -1 );
                hb_vmPlus( pResult, pResult, pValue );
                hb_itemCopy( pValue, pResult );
@@ -1418,7 +1497,7 @@ void hb_vmExecute( const HB_BYTE * pCode, PHB_SYMB pSymbols )
          case HB_P_PLUSEQPOP:
             {
                PHB_ITEM pResult;
-               pResult = hb_itemUnRef( hb_stackItemFromTop( -2 ) );
+               pResult = hb_itemUnRefUpdate( hb_stackItemFromTop( -2 ) );
                hb_vmPlus( pResult, pResult, hb_stackItemFromTop( -1 ) );
                hb_stackPop();
                hb_stackPop();
@@ -1435,7 +1514,7 @@ void hb_vmExecute( const HB_BYTE * pCode, PHB_SYMB pSymbols )
          case HB_P_MINUSEQ:
             {
                PHB_ITEM pResult, pValue;
-               pResult = hb_itemUnRef( hb_stackItemFromTop( -2 ) );
+               pResult = hb_itemUnRefUpdate( hb_stackItemFromTop( -2 ) );
                pValue = hb_stackItemFromTop( -1 );
                hb_vmMinus( pResult, pResult, pValue );
                hb_itemCopy( pValue, pResult );
@@ -1448,7 +1527,7 @@ void hb_vmExecute( const HB_BYTE * pCode, PHB_SYMB pSymbols )
          case HB_P_MINUSEQPOP:
             {
                PHB_ITEM pResult;
-               pResult = hb_itemUnRef( hb_stackItemFromTop( -2 ) );
+               pResult = hb_itemUnRefUpdate( hb_stackItemFromTop( -2 ) );
                hb_vmMinus( pResult, pResult, hb_stackItemFromTop( -1 ) );
                hb_stackPop();
                hb_stackPop();
@@ -1465,7 +1544,7 @@ void hb_vmExecute( const HB_BYTE * pCode, PHB_SYMB pSymbols )
          case HB_P_MULTEQ:
             {
                PHB_ITEM pResult, pValue;
-               pResult = hb_itemUnRef( hb_stackItemFromTop( -2 ) );
+               pResult = hb_itemUnRefUpdate( hb_stackItemFromTop( -2 ) );
                pValue = hb_stackItemFromTop( -1 );
                hb_vmMult( pResult, pResult, pValue );
                hb_itemCopy( pValue, pResult );
@@ -1478,7 +1557,7 @@ void hb_vmExecute( const HB_BYTE * pCode, PHB_SYMB pSymbols )
          case HB_P_MULTEQPOP:
             {
                PHB_ITEM pResult;
-               pResult = hb_itemUnRef( hb_stackItemFromTop( -2 ) );
+               pResult = hb_itemUnRefUpdate( hb_stackItemFromTop( -2 ) );
                hb_vmMult( pResult, pResult, hb_stackItemFromTop( -1 ) );
                hb_stackPop();
                hb_stackPop();
@@ -1495,7 +1574,7 @@ void hb_vmExecute( const HB_BYTE * pCode, PHB_SYMB pSymbols )
          case HB_P_DIVEQ:
             {
                PHB_ITEM pResult, pValue;
-               pResult = hb_itemUnRef( hb_stackItemFromTop( -2 ) );
+               pResult = hb_itemUnRefUpdate( hb_stackItemFromTop( -2 ) );
                pValue = hb_stackItemFromTop( -1 );
                hb_vmDivide( pResult, pResult, pValue );
                hb_itemCopy( pValue, pResult );
@@ -1508,7 +1587,7 @@ void hb_vmExecute( const HB_BYTE * pCode, PHB_SYMB pSymbols )
          case HB_P_DIVEQPOP:
             {
                PHB_ITEM pResult;
-               pResult = hb_itemUnRef( hb_stackItemFromTop( -2 ) );
+               pResult = hb_itemUnRefUpdate( hb_stackItemFromTop( -2 ) );
                hb_vmDivide( pResult, pResult, hb_stackItemFromTop( -1 ) );
                hb_stackPop();
                hb_stackPop();
@@ -1525,7 +1604,7 @@ void hb_vmExecute( const HB_BYTE * pCode, PHB_SYMB pSymbols )
          case HB_P_MODEQ:
             {
                PHB_ITEM pResult, pValue;
-               pResult = hb_itemUnRef( hb_stackItemFromTop( -2 ) );
+               pResult = hb_itemUnRefUpdate( hb_stackItemFromTop( -2 ) );
                pValue = hb_stackItemFromTop( -1 );
                hb_vmModulus( pResult, pResult, pValue );
                hb_itemCopy( pValue, pResult );
@@ -1538,7 +1617,7 @@ void hb_vmExecute( const HB_BYTE * pCode, PHB_SYMB pSymbols )
          case HB_P_MODEQPOP:
             {
                PHB_ITEM pResult;
-               pResult = hb_itemUnRef( hb_stackItemFromTop( -2 ) );
+               pResult = hb_itemUnRefUpdate( hb_stackItemFromTop( -2 ) );
                hb_vmModulus( pResult, pResult, hb_stackItemFromTop( -1 ) );
                hb_stackPop();
                hb_stackPop();
@@ -1555,7 +1634,7 @@ void hb_vmExecute( const HB_BYTE * pCode, PHB_SYMB pSymbols )
          case HB_P_EXPEQ:
             {
                PHB_ITEM pResult, pValue;
-               pResult = hb_itemUnRef( hb_stackItemFromTop( -2 ) );
+               pResult = hb_itemUnRefUpdate( hb_stackItemFromTop( -2 ) );
                pValue = hb_stackItemFromTop( -1 );
                hb_vmPower( pResult, pResult, pValue );
                hb_itemCopy( pValue, pResult );
@@ -1568,7 +1647,7 @@ void hb_vmExecute( const HB_BYTE * pCode, PHB_SYMB pSymbols )
          case HB_P_EXPEQPOP:
             {
                PHB_ITEM pResult;
-               pResult = hb_itemUnRef( hb_stackItemFromTop( -2 ) );
+               pResult = hb_itemUnRefUpdate( hb_stackItemFromTop( -2 ) );
                hb_vmPower( pResult, pResult, hb_stackItemFromTop( -1 ) );
                hb_stackPop();
                hb_stackPop();
@@ -1585,7 +1664,7 @@ void hb_vmExecute( const HB_BYTE * pCode, PHB_SYMB pSymbols )
             {
                PHB_ITEM pResult, pValue, pTemp;
                pResult = hb_stackItemFromTop( -1 );
-               pValue = hb_itemUnRef( pResult );
+               pValue = hb_itemUnRefUpdate( pResult );
                hb_vmInc( pValue );
                pTemp = hb_stackAllocItem();
                hb_itemCopy( pTemp, pValue );
@@ -1596,7 +1675,7 @@ void hb_vmExecute( const HB_BYTE * pCode, PHB_SYMB pSymbols )
             break;
 
          case HB_P_INCEQPOP:
-            hb_vmInc( hb_itemUnRef( hb_stackItemFromTop( -1 ) ) );
+            hb_vmInc( hb_itemUnRefUpdate( hb_stackItemFromTop( -1 ) ) );
             hb_stackPop();
             pCode++;
             break;
@@ -1610,7 +1689,7 @@ void hb_vmExecute( const HB_BYTE * pCode, PHB_SYMB pSymbols )
             {
                PHB_ITEM pResult, pValue, pTemp;
                pResult = hb_stackItemFromTop( -1 );
-               pValue = hb_itemUnRef( pResult );
+               pValue = hb_itemUnRefUpdate( pResult );
                hb_vmDec( pValue );
                pTemp = hb_stackAllocItem();
                hb_itemCopy( pTemp, pValue );
@@ -1621,7 +1700,7 @@ void hb_vmExecute( const HB_BYTE * pCode, PHB_SYMB pSymbols )
             break;
 
          case HB_P_DECEQPOP:
-            hb_vmDec( hb_itemUnRef( hb_stackItemFromTop( -1 ) ) );
+            hb_vmDec( hb_itemUnRefUpdate( hb_stackItemFromTop( -1 ) ) );
             hb_stackPop();
             pCode++;
             break;
@@ -2893,7 +2972,7 @@ void hb_vmExecute( const HB_BYTE * pCode, PHB_SYMB pSymbols )
          {
             int      iLocal = HB_PCODE_MKUSHORT( &pCode[ 1 ] );
             PHB_ITEM pLocal = hb_stackLocalVariable( iLocal );
-            hb_vmInc( HB_IS_BYREF( pLocal ) ? hb_itemUnRef( pLocal ) : pLocal );
+            hb_vmInc( HB_IS_BYREF( pLocal ) ? hb_itemUnRefUpdate( pLocal ) : pLocal );
             pCode += 3;
             break;
          }
@@ -2902,7 +2981,7 @@ void hb_vmExecute( const HB_BYTE * pCode, PHB_SYMB pSymbols )
          {
             int iLocal = HB_PCODE_MKUSHORT( &pCode[ 1 ] );
             PHB_ITEM pLocal = hb_stackLocalVariable( iLocal );
-            hb_vmDec( HB_IS_BYREF( pLocal ) ? hb_itemUnRef( pLocal ) : pLocal );
+            hb_vmDec( HB_IS_BYREF( pLocal ) ? hb_itemUnRefUpdate( pLocal ) : pLocal );
             pCode += 3;
             break;
          }
@@ -2912,7 +2991,7 @@ void hb_vmExecute( const HB_BYTE * pCode, PHB_SYMB pSymbols )
             int iLocal = HB_PCODE_MKUSHORT( &pCode[ 1 ] );
             PHB_ITEM pLocal = hb_stackLocalVariable( iLocal );
             if( HB_IS_BYREF( pLocal ) )
-               pLocal = hb_itemUnRef( pLocal );
+               pLocal = hb_itemUnRefUpdate( pLocal );
             hb_vmInc( pLocal );
             hb_itemCopy( hb_stackAllocItem(), pLocal );
             pCode += 3;
@@ -3093,7 +3172,7 @@ static void hb_vmAddInt( PHB_ITEM pResult, HB_LONG lAdd )
 
    if( HB_IS_BYREF( pResult ) )
    {
-      pResult = hb_itemUnRef( pResult );
+      pResult = hb_itemUnRefUpdate( pResult );
    }
 
    if( HB_IS_NUMINT( pResult ) )
@@ -5213,7 +5292,7 @@ static void hb_vmArrayPush( void )
 
    if( HB_IS_HASH( pArray ) && HB_IS_HASHKEY( pIndex ) )
    {
-      PHB_ITEM pValue = hb_hashGetItemPtr( pArray, pIndex, HB_HASH_AUTOADD_ACCESS );
+      PHB_ITEM pValue = hb_hashGetItemReadPtr( pArray, pIndex, HB_HASH_AUTOADD_ACCESS );
       if( pValue )
       {
          hb_itemCopy( pIndex, pValue );
@@ -5260,6 +5339,7 @@ static void hb_vmArrayPush( void )
 
       if( HB_IS_VALID_INDEX( nIndex, pArray->item.asArray.value->nLen ) )
       {
+         HB_ARRAY_UNSHARE_GET( pArray->item.asArray.value, nIndex - 1 );
          hb_itemCopy( pIndex, pArray->item.asArray.value->pItems + nIndex - 1 );
          hb_itemMove( pArray, pIndex );
          hb_stackDec();
@@ -5311,6 +5391,8 @@ static void hb_vmArrayPushRef( void )
          hb_stackPop();
          return;
       }
+      else if( hb_itemIsFrozen( pArray ) )
+         hb_errRT_BASE( EG_READONLY, 1134, NULL, hb_langDGetErrorDesc( EG_ARRASSIGN ), 2, pArray, pIndex );
       else
          hb_errRT_BASE( EG_BOUND, 1132, NULL, hb_langDGetErrorDesc( EG_ARRACCESS ), 2, pArray, pIndex );
       return;
@@ -5352,6 +5434,11 @@ static void hb_vmArrayPushRef( void )
       }
       else if( HB_IS_VALID_INDEX( nIndex, pArray->item.asArray.value->nLen ) )
       {
+         if( pArray->item.asArray.value->fFrozen )
+         {
+            hb_errRT_BASE( EG_READONLY, 1134, NULL, hb_langDGetErrorDesc( EG_ARRASSIGN ), 2, pArray, pIndex );
+            return;
+         }
          /* This function is safe for overwriting passed array, [druzus] */
          hb_arrayGetItemRef( pArray, nIndex, pRefer );
          hb_stackDec();
@@ -5415,6 +5502,8 @@ static void hb_vmArrayPop( void )
          hb_stackPop();
          hb_stackPop();
       }
+      else if( hb_itemIsFrozen( pArray ) )
+         hb_errRT_BASE( EG_READONLY, 1134, NULL, hb_langDGetErrorDesc( EG_ARRASSIGN ), 3, pArray, pIndex, pValue );
       else
          hb_errRT_BASE( EG_BOUND, 1133, NULL, hb_langDGetErrorDesc( EG_ARRASSIGN ), 3, pArray, pIndex, pValue );
       return;
@@ -5451,6 +5540,15 @@ static void hb_vmArrayPop( void )
 
       if( HB_IS_VALID_INDEX( nIndex, pArray->item.asArray.value->nLen ) )
       {
+         if( pArray->item.asArray.value->fShared )
+         {
+            if( pArray->item.asArray.value->fFrozen )
+            {
+               hb_errRT_BASE( EG_READONLY, 1134, NULL, hb_langDGetErrorDesc( EG_ARRASSIGN ), 3, pArray, pIndex, pValue );
+               return;
+            }
+            hb_arrayUnshare( pArray->item.asArray.value );
+         }
          pValue->type &= ~( HB_IT_MEMOFLAG | HB_IT_DEFAULT );
          hb_itemMoveRef( pArray->item.asArray.value->pItems + nIndex - 1, pValue );
          hb_stackPop();
@@ -5785,6 +5883,8 @@ static void hb_vmPushAParams( void )
       {
          PHB_ITEM pCount;
          HB_SIZE nPos;
+
+         HB_ARRAY_UNSHARE( pArray->item.asArray.value );
          for( nPos = 1; nPos < nLen; ++nPos )
             hb_vmPush( pArray->item.asArray.value->pItems + nPos );
          pCount = hb_stackAllocItem();
@@ -9040,6 +9140,8 @@ HB_BOOL hb_vmRequestReenterExt( void )
 
       if( hb_stackId() == NULL )
       {
+         int iTick;
+
          uiAction = HB_VMSTACK_REQUESTED;
 
          /* protection against executing hb_threadStateNew() during GC pass */
@@ -9052,6 +9154,7 @@ HB_BOOL hb_vmRequestReenterExt( void )
                break;
          }
          s_iRunningCount++;
+         iTick = s_iSampleTick;
          HB_VM_UNLOCK();
 
          hb_vmThreadInit( NULL );
@@ -9059,6 +9162,7 @@ HB_BOOL hb_vmRequestReenterExt( void )
 
          HB_VM_LOCK();
          s_iRunningCount--;
+         hb_vmSampleSkip( &iTick );
          hb_threadCondBroadcast( &s_vmCond );
          HB_VM_UNLOCK();
       }
@@ -10024,7 +10128,7 @@ void hb_xvmLocalSetInt( int iLocal, HB_LONG lValue )
       /* local variable or local parameter */
       pLocal = hb_stackLocalVariable( iLocal );
       if( HB_IS_BYREF( pLocal ) )
-         pLocal = hb_itemUnRef( pLocal );
+         pLocal = hb_itemUnRefUpdate( pLocal );
    }
    else
    {
@@ -10066,7 +10170,7 @@ HB_BOOL hb_xvmLocalInc( int iLocal )
    HB_TRACE( HB_TR_DEBUG, ( "hb_xvmLocalInc(%d)", iLocal ) );
 
    pLocal = hb_stackLocalVariable( iLocal );
-   hb_vmInc( HB_IS_BYREF( pLocal ) ? hb_itemUnRef( pLocal ) : pLocal );
+   hb_vmInc( HB_IS_BYREF( pLocal ) ? hb_itemUnRefUpdate( pLocal ) : pLocal );
 
    HB_XVM_RETURN
 }
@@ -10079,7 +10183,7 @@ HB_BOOL hb_xvmLocalDec( int iLocal )
    HB_TRACE( HB_TR_DEBUG, ( "hb_xvmLocalDec(%d)", iLocal ) );
 
    pLocal = hb_stackLocalVariable( iLocal );
-   hb_vmDec( HB_IS_BYREF( pLocal ) ? hb_itemUnRef( pLocal ) : pLocal );
+   hb_vmDec( HB_IS_BYREF( pLocal ) ? hb_itemUnRefUpdate( pLocal ) : pLocal );
 
    HB_XVM_RETURN
 }
@@ -10093,7 +10197,7 @@ HB_BOOL hb_xvmLocalIncPush( int iLocal )
 
    pLocal = hb_stackLocalVariable( iLocal );
    if( HB_IS_BYREF( pLocal ) )
-      pLocal = hb_itemUnRef( pLocal );
+      pLocal = hb_itemUnRefUpdate( pLocal );
    hb_vmInc( pLocal );
    hb_itemCopy( hb_stackAllocItem(), pLocal );
 
@@ -10109,7 +10213,7 @@ HB_BOOL hb_xvmLocalAdd( int iLocal )
 
    pLocal = hb_stackLocalVariable( iLocal );
    if( HB_IS_BYREF( pLocal ) )
-      pLocal = hb_itemUnRef( pLocal );
+      pLocal = hb_itemUnRefUpdate( pLocal );
    hb_vmPlus( pLocal, hb_stackItemFromTop( -2 ), hb_stackItemFromTop( -1 ) );
    hb_stackPop();
    hb_stackPop();
@@ -10126,7 +10230,7 @@ HB_BOOL hb_xvmStaticAdd( HB_USHORT uiStatic )
 
    pStatic = ( ( PHB_ITEM ) hb_stackGetStaticsBase() )->item.asArray.value->pItems + uiStatic - 1;
    if( HB_IS_BYREF( pStatic ) )
-      pStatic = hb_itemUnRef( pStatic );
+      pStatic = hb_itemUnRefUpdate( pStatic );
    hb_vmPlus( pStatic, hb_stackItemFromTop( -2 ), hb_stackItemFromTop( -1 ) );
    hb_stackPop();
    hb_stackPop();
@@ -11040,7 +11144,7 @@ HB_BOOL hb_xvmPlusEq( void )
 
    HB_TRACE( HB_TR_DEBUG, ( "hb_xvmPlusEq()" ) );
 
-   pResult = hb_itemUnRef( hb_stackItemFromTop( -2 ) );
+   pResult = hb_itemUnRefUpdate( hb_stackItemFromTop( -2 ) );
    pValue = hb_stackItemFromTop( -1 );
    hb_vmPlus( pResult, pResult, pValue );
    hb_itemCopy( pValue, pResult );
@@ -11057,7 +11161,7 @@ HB_BOOL hb_xvmPlusEqPop( void )
 
    HB_TRACE( HB_TR_DEBUG, ( "hb_xvmPlusEqPop()" ) );
 
-   pResult = hb_itemUnRef( hb_stackItemFromTop( -2 ) );
+   pResult = hb_itemUnRefUpdate( hb_stackItemFromTop( -2 ) );
    hb_vmPlus( pResult, pResult, hb_stackItemFromTop( -1 ) );
    hb_stackPop();
    hb_stackPop();
@@ -11085,7 +11189,7 @@ HB_BOOL hb_xvmMinusEq( void )
 
    HB_TRACE( HB_TR_DEBUG, ( "hb_xvmMinusEq()" ) );
 
-   pResult = hb_itemUnRef( hb_stackItemFromTop( -2 ) );
+   pResult = hb_itemUnRefUpdate( hb_stackItemFromTop( -2 ) );
    pValue = hb_stackItemFromTop( -1 );
    hb_vmMinus( pResult, pResult, pValue );
    hb_itemCopy( pValue, pResult );
@@ -11102,7 +11206,7 @@ HB_BOOL hb_xvmMinusEqPop( void )
 
    HB_TRACE( HB_TR_DEBUG, ( "hb_xvmMinusEqPop()" ) );
 
-   pResult = hb_itemUnRef( hb_stackItemFromTop( -2 ) );
+   pResult = hb_itemUnRefUpdate( hb_stackItemFromTop( -2 ) );
    hb_vmMinus( pResult, pResult, hb_stackItemFromTop( -1 ) );
    hb_stackPop();
    hb_stackPop();
@@ -11171,7 +11275,7 @@ HB_BOOL hb_xvmMultEq( void )
 
    HB_TRACE( HB_TR_DEBUG, ( "hb_xvmMultEq()" ) );
 
-   pResult = hb_itemUnRef( hb_stackItemFromTop( -2 ) );
+   pResult = hb_itemUnRefUpdate( hb_stackItemFromTop( -2 ) );
    pValue = hb_stackItemFromTop( -1 );
    hb_vmMult( pResult, pResult, pValue );
    hb_itemCopy( pValue, pResult );
@@ -11188,7 +11292,7 @@ HB_BOOL hb_xvmMultEqPop( void )
 
    HB_TRACE( HB_TR_DEBUG, ( "hb_xvmMultEqPop()" ) );
 
-   pResult = hb_itemUnRef( hb_stackItemFromTop( -2 ) );
+   pResult = hb_itemUnRefUpdate( hb_stackItemFromTop( -2 ) );
    hb_vmMult( pResult, pResult, hb_stackItemFromTop( -1 ) );
    hb_stackPop();
    hb_stackPop();
@@ -11324,7 +11428,7 @@ HB_BOOL hb_xvmDivEq( void )
 
    HB_TRACE( HB_TR_DEBUG, ( "hb_xvmDivEq()" ) );
 
-   pResult = hb_itemUnRef( hb_stackItemFromTop( -2 ) );
+   pResult = hb_itemUnRefUpdate( hb_stackItemFromTop( -2 ) );
    pValue = hb_stackItemFromTop( -1 );
    hb_vmDivide( pResult, pResult, pValue );
    hb_itemCopy( pValue, pResult );
@@ -11341,7 +11445,7 @@ HB_BOOL hb_xvmDivEqPop( void )
 
    HB_TRACE( HB_TR_DEBUG, ( "hb_xvmDivEqPop()" ) );
 
-   pResult = hb_itemUnRef( hb_stackItemFromTop( -2 ) );
+   pResult = hb_itemUnRefUpdate( hb_stackItemFromTop( -2 ) );
    hb_vmDivide( pResult, pResult, hb_stackItemFromTop( -1 ) );
    hb_stackPop();
    hb_stackPop();
@@ -11368,7 +11472,7 @@ HB_BOOL hb_xvmModEq( void )
 
    HB_TRACE( HB_TR_DEBUG, ( "hb_xvmModEq()" ) );
 
-   pResult = hb_itemUnRef( hb_stackItemFromTop( -2 ) );
+   pResult = hb_itemUnRefUpdate( hb_stackItemFromTop( -2 ) );
    pValue = hb_stackItemFromTop( -1 );
    hb_vmModulus( pResult, pResult, pValue );
    hb_itemCopy( pValue, pResult );
@@ -11385,7 +11489,7 @@ HB_BOOL hb_xvmModEqPop( void )
 
    HB_TRACE( HB_TR_DEBUG, ( "hb_xvmModEqPop()" ) );
 
-   pResult = hb_itemUnRef( hb_stackItemFromTop( -2 ) );
+   pResult = hb_itemUnRefUpdate( hb_stackItemFromTop( -2 ) );
    hb_vmModulus( pResult, pResult, hb_stackItemFromTop( -1 ) );
    hb_stackPop();
    hb_stackPop();
@@ -11411,7 +11515,7 @@ HB_BOOL hb_xvmExpEq( void )
 
    HB_TRACE( HB_TR_DEBUG, ( "hb_xvmExpEq()" ) );
 
-   pResult = hb_itemUnRef( hb_stackItemFromTop( -2 ) );
+   pResult = hb_itemUnRefUpdate( hb_stackItemFromTop( -2 ) );
    pValue = hb_stackItemFromTop( -1 );
    hb_vmPower( pResult, pResult, pValue );
    hb_itemCopy( pValue, pResult );
@@ -11428,7 +11532,7 @@ HB_BOOL hb_xvmExpEqPop( void )
 
    HB_TRACE( HB_TR_DEBUG, ( "hb_xvmExpEqPop()" ) );
 
-   pResult = hb_itemUnRef( hb_stackItemFromTop( -2 ) );
+   pResult = hb_itemUnRefUpdate( hb_stackItemFromTop( -2 ) );
    hb_vmPower( pResult, pResult, hb_stackItemFromTop( -1 ) );
    hb_stackPop();
    hb_stackPop();
@@ -11454,7 +11558,7 @@ HB_BOOL hb_xvmIncEq( void )
    HB_TRACE( HB_TR_DEBUG, ( "hb_xvmIncEq()" ) );
 
    pResult = hb_stackItemFromTop( -1 );
-   pValue = hb_itemUnRef( pResult );
+   pValue = hb_itemUnRefUpdate( pResult );
    hb_vmInc( pValue );
    pTemp = hb_stackAllocItem();
    hb_itemCopy( pTemp, pValue );
@@ -11470,7 +11574,7 @@ HB_BOOL hb_xvmIncEqPop( void )
 
    HB_TRACE( HB_TR_DEBUG, ( "hb_xvmIncEqPop()" ) );
 
-   hb_vmInc( hb_itemUnRef( hb_stackItemFromTop( -1 ) ) );
+   hb_vmInc( hb_itemUnRefUpdate( hb_stackItemFromTop( -1 ) ) );
    hb_stackPop();
 
    HB_XVM_RETURN
@@ -11495,7 +11599,7 @@ HB_BOOL hb_xvmDecEq( void )
    HB_TRACE( HB_TR_DEBUG, ( "hb_xvmDecEq()" ) );
 
    pResult = hb_stackItemFromTop( -1 );
-   pValue = hb_itemUnRef( pResult );
+   pValue = hb_itemUnRefUpdate( pResult );
    hb_vmDec( pValue );
    pTemp = hb_stackAllocItem();
    hb_itemCopy( pTemp, pValue );
@@ -11511,7 +11615,7 @@ HB_BOOL hb_xvmDecEqPop( void )
 
    HB_TRACE( HB_TR_DEBUG, ( "hb_xvmDecEqPop()" ) );
 
-   hb_vmDec( hb_itemUnRef( hb_stackItemFromTop( -1 ) ) );
+   hb_vmDec( hb_itemUnRefUpdate( hb_stackItemFromTop( -1 ) ) );
    hb_stackPop();
 
    HB_XVM_RETURN
@@ -11562,6 +11666,7 @@ static void hb_vmArrayItemPush( HB_SIZE nIndex )
       {
          PHB_ITEM pItem = hb_stackAllocItem();
 
+         HB_ARRAY_UNSHARE_GET( pArray->item.asArray.value, nIndex - 1 );
          hb_itemCopy( pItem, pArray->item.asArray.value->pItems + nIndex - 1 );
          hb_itemMove( pArray, pItem );
          hb_stackDec();
@@ -11588,7 +11693,7 @@ static void hb_vmArrayItemPush( HB_SIZE nIndex )
 
       hb_vmPushNumInt( nIndex );
       pIndex = hb_stackItemFromTop( -1 );
-      pValue = hb_hashGetItemPtr( pArray, pIndex, HB_HASH_AUTOADD_ACCESS );
+      pValue = hb_hashGetItemReadPtr( pArray, pIndex, HB_HASH_AUTOADD_ACCESS );
 
       if( pValue )
       {
@@ -11642,6 +11747,17 @@ static void hb_vmArrayItemPop( HB_SIZE nIndex )
 
       if( HB_IS_VALID_INDEX( nIndex, pArray->item.asArray.value->nLen ) )
       {
+         if( pArray->item.asArray.value->fShared )
+         {
+            if( pArray->item.asArray.value->fFrozen )
+            {
+               hb_vmPushNumInt( nIndex );
+               hb_errRT_BASE( EG_READONLY, 1134, NULL, hb_langDGetErrorDesc( EG_ARRASSIGN ),
+                              3, pArray, hb_stackItemFromTop( -1 ), pValue );
+               return;
+            }
+            hb_arrayUnshare( pArray->item.asArray.value );
+         }
          pValue->type &= ~( HB_IT_MEMOFLAG | HB_IT_DEFAULT );
          hb_itemMoveRef( pArray->item.asArray.value->pItems + nIndex - 1, pValue );
          hb_stackPop();
@@ -11689,6 +11805,8 @@ static void hb_vmArrayItemPop( HB_SIZE nIndex )
          hb_stackPop();
          hb_stackPop();
       }
+      else if( hb_itemIsFrozen( pArray ) )
+         hb_errRT_BASE( EG_READONLY, 1134, NULL, hb_langDGetErrorDesc( EG_ARRASSIGN ), 3, pArray, hb_stackItemFromTop( -1 ), pValue );
       else
          hb_errRT_BASE( EG_BOUND, 1133, NULL, hb_langDGetErrorDesc( EG_ARRASSIGN ), 3, pArray, hb_stackItemFromTop( -1 ), pValue );
    }
@@ -12309,6 +12427,31 @@ void hb_vmUpdateAllocator( PHB_ALLOCUPDT_FUNC pFunc, int iCount )
 #endif /* HB_MT_VM */
 }
 
+void hb_vmMemStat( PHB_MEMSTAT_FUNC pFunc, void * cargo )
+{
+   HB_TRACE( HB_TR_DEBUG, ( "hb_vmMemStat(%p, %p)", ( void * ) pFunc, cargo ) );
+
+#if defined( HB_MT_VM )
+   HB_VM_LOCK();
+   if( s_vmStackLst )
+   {
+      PHB_THREADSTATE pStack = s_vmStackLst;
+      do
+      {
+         if( pStack->pStackId )
+            pFunc( cargo, ( HB_MAXINT ) pStack->th_no,
+                   hb_stackIdMemStat( pStack->pStackId ) );
+         pStack = pStack->pNext;
+      }
+      while( pStack != s_vmStackLst );
+   }
+   HB_VM_UNLOCK();
+#else
+   HB_SYMBOL_UNUSED( pFunc );
+   HB_SYMBOL_UNUSED( cargo );
+#endif /* HB_MT_VM */
+}
+
 /* ------------------------------------------------------------------------ */
 
 /*
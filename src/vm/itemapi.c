@@ -1814,6 +1814,40 @@ void hb_itemSwap( PHB_ITEM pItem1, PHB_ITEM pItem2 )
 /* Internal API, not standard Clipper */
 /* De-references item passed by the reference */
 
+/* enumerated value of FOR EACH control variable */
+static PHB_ITEM hb_itemEnumBase( PHB_ITEM pEnum )
+{
+   return HB_IS_BYREF( pEnum->item.asEnum.basePtr ) ?
+          hb_itemUnRef( pEnum->item.asEnum.basePtr ) :
+                        pEnum->item.asEnum.basePtr;
+}
+
+static void hb_itemEnumScratchRelease( void * Cargo )
+{
+   PHB_ITEM pItem = *( PHB_ITEM * ) Cargo;
+
+   if( pItem )
+      hb_itemRelease( pItem );
+}
+
+static HB_TSD_NEW( s_enumScratch, sizeof( PHB_ITEM ), NULL, hb_itemEnumScratchRelease );
+
+/* FOR EACH control variable of frozen array or hash cannot be modified,
+   generate RT error and return thread local scratch copy of the current
+   item which can be changed by the caller without any visible effect */
+static PHB_ITEM hb_itemEnumFrozen( PHB_ITEM pEnum )
+{
+   PHB_ITEM * pScratch;
+
+   hb_errRT_BASE( EG_READONLY, 1134, NULL, hb_langDGetErrorDesc( EG_ARRASSIGN ),
+                  1, hb_itemEnumBase( pEnum ) );
+   pScratch = ( PHB_ITEM * ) hb_stackGetTSD( &s_enumScratch );
+   if( *pScratch == NULL )
+      *pScratch = hb_itemNew( NULL );
+   hb_itemCopy( *pScratch, hb_itemUnRefOnce( pEnum ) );
+   return *pScratch;
+}
+
 PHB_ITEM hb_itemUnRefOnce( PHB_ITEM pItem )
 {
    HB_TRACE( HB_TR_DEBUG, ( "hb_itemUnRefOnce(%p)", ( void * ) pItem ) );
@@ -1831,9 +1865,8 @@ PHB_ITEM hb_itemUnRefOnce( PHB_ITEM pItem )
             return pItem->item.asEnum.valuePtr;
          else
          {
-            PHB_ITEM pBase = HB_IS_BYREF( pItem->item.asEnum.basePtr ) ?
-                            hb_itemUnRef( pItem->item.asEnum.basePtr ) :
-                                          pItem->item.asEnum.basePtr;
+            PHB_ITEM pBase = hb_itemEnumBase( pItem );
+
             if( HB_IS_ARRAY( pBase ) )
             {
                pBase = hb_arrayGetItemPtr( pBase, pItem->item.asEnum.offset );
@@ -1885,6 +1918,7 @@ PHB_ITEM hb_itemUnRefOnce( PHB_ITEM pItem )
                if( ( HB_SIZE ) pItem->item.asRefer.value <
                    pItem->item.asRefer.BasePtr.array->nLen )
                {
+                  HB_ARRAY_UNSHARE( pItem->item.asRefer.BasePtr.array );
                   pItem = pItem->item.asRefer.BasePtr.array->pItems +
                           pItem->item.asRefer.value;
                }
@@ -1902,6 +1936,7 @@ PHB_ITEM hb_itemUnRefOnce( PHB_ITEM pItem )
                   if( ( HB_SIZE ) pItem->item.asRefer.value <
                       pItem->item.asRefer.BasePtr.array->nLen )
                   {
+                     HB_ARRAY_UNSHARE( pItem->item.asRefer.BasePtr.array );
                      pItem = pItem->item.asRefer.BasePtr.array->pItems +
                              pItem->item.asRefer.value;
                   }
@@ -1957,12 +1992,20 @@ PHB_ITEM hb_itemUnRef( PHB_ITEM pItem )
  */
 PHB_ITEM hb_itemUnRefWrite( PHB_ITEM pItem, PHB_ITEM pSource )
 {
+   PHB_ITEM pEnum;
+
    HB_TRACE( HB_TR_DEBUG, ( "hb_itemUnRefWrite(%p,%p)", ( void * ) pItem, ( void * ) pSource ) );
 
    if( HB_IS_EXTREF( pItem ) )
    {
       pItem = pItem->item.asExtRef.func->write( pItem, pSource );
    }
+   else if( HB_IS_ENUM( pEnum = hb_itemUnRefRefer( pItem ) ) &&
+            hb_itemIsFrozen( hb_itemEnumBase( pEnum ) ) )
+   {
+      /* FOR EACH control variable of frozen array or hash */
+      pItem = hb_itemEnumFrozen( pEnum );
+   }
    else if( HB_IS_STRING( pSource ) &&
        pSource->item.asString.length == 1 )
    {
@@ -1991,6 +2034,22 @@ PHB_ITEM hb_itemUnRefWrite( PHB_ITEM pItem, PHB_ITEM pSource )
    return pItem;
 }
 
+/* Unreference passed variable for in-place modification
+ * FOR EACH control variables of frozen arrays and hashes are refused
+ */
+PHB_ITEM hb_itemUnRefUpdate( PHB_ITEM pItem )
+{
+   PHB_ITEM pEnum;
+
+   HB_TRACE( HB_TR_DEBUG, ( "hb_itemUnRefUpdate(%p)", ( void * ) pItem ) );
+
+   pEnum = hb_itemUnRefRefer( pItem );
+   if( HB_IS_ENUM( pEnum ) && hb_itemIsFrozen( hb_itemEnumBase( pEnum ) ) )
+      return hb_itemEnumFrozen( pEnum );
+
+   return hb_itemUnRef( pEnum );
+}
+
 /* Unreference passed variable
  * Do not unreference the last reference stored
  */
@@ -2139,6 +2198,44 @@ void hb_itemCloneTo( PHB_ITEM pDest, PHB_ITEM pSource )
       hb_itemCopy( pDest, pSource );
 }
 
+/* make array or hash and all nested items immutable, frozen items are
+ * never released by GC and can be accessed by many threads without
+ * reference counting, see hb_nestedFreeze() for details
+ */
+HB_BOOL hb_itemFreeze( PHB_ITEM pItem )
+{
+   HB_BOOL fResult;
+
+   HB_TRACE( HB_TR_DEBUG, ( "hb_itemFreeze(%p)", ( void * ) pItem ) );
+
+   if( HB_IS_BYREF( pItem ) )
+      pItem = hb_itemUnRef( pItem );
+
+   if( ! HB_IS_ARRAY( pItem ) && ! HB_IS_HASH( pItem ) )
+      return HB_IS_STRING( pItem ) || ! HB_IS_COMPLEX( pItem );
+
+   fResult = hb_nestedFreeze( pItem, HB_FREEZE_CHECK );
+   hb_nestedFreeze( pItem, fResult ? HB_FREEZE_COMMIT : HB_FREEZE_ROLLBACK );
+
+   return fResult;
+}
+
+/* account string buffer in heap snapshot, buffers shared by many
+ * items or by nShare copy-on-write clones are split between them
+ */
+void hb_itemMemStat( PHB_ITEM pItem, HB_COUNTER nShare, PHB_MEMSNAPSHOT pSnap )
+{
+   if( HB_IS_STRING( pItem ) && pItem->item.asString.allocated )
+   {
+      HB_COUNTER nRef = hb_xRefCount( pItem->item.asString.value );
+
+      if( nRef > 1 )
+         nShare *= nRef;
+      pSnap->strings.nCount++;
+      pSnap->strings.nBytes += pItem->item.asString.allocated / nShare;
+   }
+}
+
 
 /* Check whether two items are exactly equal */
 HB_BOOL hb_itemEqual( PHB_ITEM pItem1, PHB_ITEM pItem2 )
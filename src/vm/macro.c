@@ -149,6 +149,240 @@ void hb_macroDelete( PHB_MACRO pMacro )
    hb_xfree( pMacro );
 }
 
+/* - */
+
+/* Cache of recently compiled macro expressions.
+ * Compiled pcode does not depend on the state of memvars, fields or
+ * work areas - variables are bound to dynamic symbols and resolved at
+ * runtime (HB_P_MPUSHVARIABLE, HB_P_MPUSHFIELD, ...) so it's enough to
+ * use the expanded macro text, compiler flags and generated code type
+ * as cache key. Type() compiles pcode which depends on existence of
+ * symbols so it does not use cache.
+ */
+
+/* default number of compiled macro expressions kept in cache */
+#ifndef HB_MACRO_CACHE_SIZE
+#  define HB_MACRO_CACHE_SIZE    256
+#endif
+
+/* number of hash buckets, must be power of 2 */
+#define HB_MACRO_CACHE_HASH      512
+
+typedef struct _HB_MACRO_CACHE
+{
+   struct _HB_MACRO_CACHE * pNext;     /* next entry in hash bucket */
+   struct _HB_MACRO_CACHE * pPrev;     /* previous (more recently used) entry */
+   struct _HB_MACRO_CACHE * pOlder;    /* next (less recently used) entry */
+   char *      szText;
+   HB_SIZE     nLen;
+   int         iSupported;
+   int         iFlags;
+   HB_U32      uiHash;
+   HB_BYTE *   pCode;
+   HB_SIZE     nPCodeSize;
+   HB_USHORT   uiListElements;
+   int         exprType;
+} HB_MACRO_CACHE, * PHB_MACRO_CACHE;
+
+#if defined( HB_MT_VM )
+   static HB_CRITICAL_NEW( s_macroCacheMtx );
+#  define HB_MACRO_CACHE_LOCK()     hb_threadEnterCriticalSection( &s_macroCacheMtx )
+#  define HB_MACRO_CACHE_UNLOCK()   hb_threadLeaveCriticalSection( &s_macroCacheMtx )
+#else
+#  define HB_MACRO_CACHE_LOCK()     do {} while( 0 )
+#  define HB_MACRO_CACHE_UNLOCK()   do {} while( 0 )
+#endif
+
+static PHB_MACRO_CACHE * s_macroCache = NULL;   /* hash table */
+static PHB_MACRO_CACHE   s_macroCacheNewest = NULL;
+static PHB_MACRO_CACHE   s_macroCacheOldest = NULL;
+static HB_SIZE    s_nMacroCacheMax = HB_MACRO_CACHE_SIZE;
+static HB_SIZE    s_nMacroCacheCount = 0;
+static HB_MAXUINT s_nMacroCacheHits = 0;
+static HB_MAXUINT s_nMacroCacheMisses = 0;
+
+/* remove entry from hash table and LRU list and free it,
+   must be called with s_macroCacheMtx locked */
+static void hb_macroCacheDel( PHB_MACRO_CACHE pEntry )
+{
+   PHB_MACRO_CACHE * pEntryPtr = &s_macroCache[ pEntry->uiHash & ( HB_MACRO_CACHE_HASH - 1 ) ];
+
+   while( *pEntryPtr != pEntry )
+      pEntryPtr = &( *pEntryPtr )->pNext;
+   *pEntryPtr = pEntry->pNext;
+
+   if( pEntry->pPrev )
+      pEntry->pPrev->pOlder = pEntry->pOlder;
+   else
+      s_macroCacheNewest = pEntry->pOlder;
+   if( pEntry->pOlder )
+      pEntry->pOlder->pPrev = pEntry->pPrev;
+   else
+      s_macroCacheOldest = pEntry->pPrev;
+
+   --s_nMacroCacheCount;
+   hb_xfree( pEntry );
+}
+
+/* must be called with s_macroCacheMtx locked */
+static void hb_macroCacheTrim( HB_SIZE nMax )
+{
+   while( s_nMacroCacheCount > nMax )
+      hb_macroCacheDel( s_macroCacheOldest );
+}
+
+static void hb_macroCacheRelease( void * cargo )
+{
+   HB_SYMBOL_UNUSED( cargo );
+
+   HB_MACRO_CACHE_LOCK();
+   hb_macroCacheTrim( 0 );
+   if( s_macroCache )
+   {
+      hb_xfree( s_macroCache );
+      s_macroCache = NULL;
+   }
+   HB_MACRO_CACHE_UNLOCK();
+}
+
+/* find entry in cache and move it to the head of LRU list,
+   must be called with s_macroCacheMtx locked */
+static PHB_MACRO_CACHE hb_macroCacheFind( PHB_MACRO pMacro, HB_U32 uiHash )
+{
+   PHB_MACRO_CACHE pEntry = s_macroCache ?
+                            s_macroCache[ uiHash & ( HB_MACRO_CACHE_HASH - 1 ) ] : NULL;
+
+   while( pEntry )
+   {
+      if( pEntry->uiHash == uiHash && pEntry->nLen == pMacro->length &&
+          pEntry->iSupported == pMacro->supported &&
+          pEntry->iFlags == pMacro->Flags &&
+          memcmp( pEntry->szText, pMacro->string, pMacro->length ) == 0 )
+      {
+         if( pEntry->pPrev )
+         {
+            pEntry->pPrev->pOlder = pEntry->pOlder;
+            if( pEntry->pOlder )
+               pEntry->pOlder->pPrev = pEntry->pPrev;
+            else
+               s_macroCacheOldest = pEntry->pPrev;
+            pEntry->pPrev = NULL;
+            pEntry->pOlder = s_macroCacheNewest;
+            s_macroCacheNewest->pPrev = pEntry;
+            s_macroCacheNewest = pEntry;
+         }
+         break;
+      }
+      pEntry = pEntry->pNext;
+   }
+
+   return pEntry;
+}
+
+/* compile macro expression or take its pcode from cache, the result
+ * is the same as from hb_macroParse() so the pcode buffer is always
+ * owned by 'pMacro' and has to be released by hb_macroClear()
+ */
+static int hb_macroParseCached( PHB_MACRO pMacro )
+{
+   HB_U32 uiHash = 2166136261U;
+   PHB_MACRO_CACHE pEntry;
+   HB_SIZE n;
+   int iStatus;
+
+   if( s_nMacroCacheMax == 0 || ( pMacro->Flags & HB_MACRO_GEN_TYPE ) != 0 )
+      return hb_macroParse( pMacro );
+
+   for( n = 0; n < pMacro->length; ++n )
+      uiHash = ( uiHash ^ ( HB_UCHAR ) pMacro->string[ n ] ) * 16777619U;
+   uiHash ^= ( HB_U32 ) pMacro->Flags * 16777619U;
+
+   HB_MACRO_CACHE_LOCK();
+   pEntry = hb_macroCacheFind( pMacro, uiHash );
+   if( pEntry )
+   {
+      ++s_nMacroCacheHits;
+      pMacro->pCodeInfo = &pMacro->pCodeInfoBuffer;
+      pMacro->pCodeInfo->nPCodeSize = pEntry->nPCodeSize;
+      pMacro->pCodeInfo->nPCodePos  = pEntry->nPCodeSize;
+      pMacro->pCodeInfo->fVParams   = HB_FALSE;
+      pMacro->pCodeInfo->pLocals    = NULL;
+      pMacro->pCodeInfo->pPrev      = NULL;
+      pMacro->pCodeInfo->pCode      = ( HB_BYTE * ) hb_xgrab( pEntry->nPCodeSize );
+      memcpy( pMacro->pCodeInfo->pCode, pEntry->pCode, pEntry->nPCodeSize );
+      pMacro->pError = NULL;
+      pMacro->uiListElements = pEntry->uiListElements;
+      pMacro->exprType = pEntry->exprType;
+   }
+   else
+      ++s_nMacroCacheMisses;
+   HB_MACRO_CACHE_UNLOCK();
+
+   if( pEntry )
+      return HB_MACRO_OK;
+
+   /* compile outside of lock, nested macros can be compiled
+      and executed during compilation */
+   iStatus = hb_macroParse( pMacro );
+
+   if( iStatus == HB_MACRO_OK && ( pMacro->status & HB_MACRO_CONT ) &&
+       pMacro->pError == NULL )
+   {
+      HB_SIZE nPCodeSize = pMacro->pCodeInfo->nPCodePos;
+
+      HB_MACRO_CACHE_LOCK();
+      if( s_nMacroCacheMax > 0 && hb_macroCacheFind( pMacro, uiHash ) == NULL )
+      {
+         PHB_MACRO_CACHE * pBucket;
+
+         if( s_macroCache == NULL )
+         {
+            static HB_BOOL s_fInit = HB_FALSE;
+
+            if( ! s_fInit )
+            {
+               s_fInit = HB_TRUE;
+               hb_vmAtQuit( hb_macroCacheRelease, NULL );
+            }
+            s_macroCache = ( PHB_MACRO_CACHE * )
+                  hb_xgrabz( HB_MACRO_CACHE_HASH * sizeof( PHB_MACRO_CACHE ) );
+         }
+         else
+            hb_macroCacheTrim( s_nMacroCacheMax - 1 );
+
+         /* text and pcode are stored in the same memory block */
+         pEntry = ( PHB_MACRO_CACHE ) hb_xgrab( sizeof( HB_MACRO_CACHE ) +
+                                                pMacro->length + nPCodeSize );
+         pEntry->szText = ( char * ) ( pEntry + 1 );
+         pEntry->pCode = ( HB_BYTE * ) pEntry->szText + pMacro->length;
+         memcpy( pEntry->szText, pMacro->string, pMacro->length );
+         memcpy( pEntry->pCode, pMacro->pCodeInfo->pCode, nPCodeSize );
+         pEntry->nLen = pMacro->length;
+         pEntry->nPCodeSize = nPCodeSize;
+         pEntry->iSupported = pMacro->supported;
+         pEntry->iFlags = pMacro->Flags;
+         pEntry->uiHash = uiHash;
+         pEntry->uiListElements = pMacro->uiListElements;
+         pEntry->exprType = pMacro->exprType;
+
+         pBucket = &s_macroCache[ uiHash & ( HB_MACRO_CACHE_HASH - 1 ) ];
+         pEntry->pNext = *pBucket;
+         *pBucket = pEntry;
+         pEntry->pPrev = NULL;
+         pEntry->pOlder = s_macroCacheNewest;
+         if( s_macroCacheNewest )
+            s_macroCacheNewest->pPrev = pEntry;
+         else
+            s_macroCacheOldest = pEntry;
+         s_macroCacheNewest = pEntry;
+         ++s_nMacroCacheCount;
+      }
+      HB_MACRO_CACHE_UNLOCK();
+   }
+
+   return iStatus;
+}
+
 /* checks if a correct ITEM was passed from the virtual machine eval stack
  */
 static HB_BOOL hb_macroCheckParam( PHB_ITEM pItem )
@@ -472,7 +706,7 @@ void hb_macroGetValue( PHB_ITEM pItem, int iContext, int flags )
          }
       }
 
-      iStatus = hb_macroParse( &struMacro );
+      iStatus = hb_macroParseCached( &struMacro );
 
       if( iStatus == HB_MACRO_OK && ( struMacro.status & HB_MACRO_CONT ) )
       {
@@ -521,7 +755,7 @@ void hb_macroSetValue( PHB_ITEM pItem, int flags )
       struMacro.string    = pItem->item.asString.value;
       struMacro.length    = pItem->item.asString.length;
 
-      iStatus = hb_macroParse( &struMacro );
+      iStatus = hb_macroParseCached( &struMacro );
 
       if( iStatus == HB_MACRO_OK && ( struMacro.status & HB_MACRO_CONT ) )
       {
@@ -564,7 +798,7 @@ void hb_macroPushReference( PHB_ITEM pItem )
       struMacro.string    = pItem->item.asString.value;
       struMacro.length    = pItem->item.asString.length;
 
-      iStatus = hb_macroParse( &struMacro );
+      iStatus = hb_macroParseCached( &struMacro );
 
       if( iStatus == HB_MACRO_OK && ( struMacro.status & HB_MACRO_CONT ) )
       {
@@ -620,7 +854,7 @@ static void hb_macroUseAliased( PHB_ITEM pAlias, PHB_ITEM pVar, int iFlag, int i
       struMacro.string    = szString;
       struMacro.length    = nLen;
 
-      iStatus = hb_macroParse( &struMacro );
+      iStatus = hb_macroParseCached( &struMacro );
 
       hb_stackPop();    /* remove compiled variable name */
       hb_stackPop();    /* remove compiled alias */
@@ -655,7 +889,7 @@ static void hb_macroUseAliased( PHB_ITEM pAlias, PHB_ITEM pVar, int iFlag, int i
       struMacro.string    = pVar->item.asString.value;
       struMacro.length    = pVar->item.asString.length;
 
-      iStatus = hb_macroParse( &struMacro );
+      iStatus = hb_macroParseCached( &struMacro );
 
       if( iStatus == HB_MACRO_OK && ( struMacro.status & HB_MACRO_CONT ) )
       {
@@ -803,7 +1037,7 @@ PHB_MACRO hb_macroCompile( const char * szString )
    pMacro->string    = szString;
    pMacro->length    = strlen( szString );
 
-   iStatus = hb_macroParse( pMacro );
+   iStatus = hb_macroParseCached( pMacro );
    if( ! ( iStatus == HB_MACRO_OK && ( pMacro->status & HB_MACRO_CONT ) ) )
    {
       hb_macroDelete( pMacro );
@@ -1238,6 +1472,44 @@ HB_FUNC( HB_SETMACRO )
       hb_ret();    /* return NIL */
 }
 
+/* hb_macroCache( [ <nMaxEntries> ] ) -> <nPrevMaxEntries>
+ * Set maximum number of compiled expressions kept in macro cache,
+ * 0 disables the cache and releases all cached expressions
+ */
+HB_FUNC( HB_MACROCACHE )
+{
+   HB_STACK_TLS_PRELOAD
+
+   hb_retns( s_nMacroCacheMax );
+
+   if( HB_ISNUM( 1 ) )
+   {
+      HB_ISIZ nMax = hb_parns( 1 );
+
+      HB_MACRO_CACHE_LOCK();
+      s_nMacroCacheMax = nMax > 0 ? ( HB_SIZE ) nMax : 0;
+      hb_macroCacheTrim( s_nMacroCacheMax );
+      HB_MACRO_CACHE_UNLOCK();
+   }
+}
+
+/* hb_macroCacheStats( [ <lReset> ] ) -> { <nHits>, <nMisses>, <nEntries> } */
+HB_FUNC( HB_MACROCACHESTATS )
+{
+   HB_STACK_TLS_PRELOAD
+   PHB_ITEM pReturn = hb_stackReturnItem();
+
+   hb_arrayNew( pReturn, 3 );
+
+   HB_MACRO_CACHE_LOCK();
+   hb_arraySetNInt( pReturn, 1, s_nMacroCacheHits );
+   hb_arraySetNInt( pReturn, 2, s_nMacroCacheMisses );
+   hb_arraySetNS( pReturn, 3, s_nMacroCacheCount );
+   if( hb_parl( 1 ) )
+      s_nMacroCacheHits = s_nMacroCacheMisses = 0;
+   HB_MACRO_CACHE_UNLOCK();
+}
+
 /* - */
 
 /* returns the order + 1 of a variable if defined or zero */
@@ -0,0 +1,397 @@
+/*
+ * Memory usage statistics and heap snapshots
+ *
+ * Copyright 2026 {list of individual authors and e-mail addresses}
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file LICENSE.txt.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA (or visit https://www.gnu.org/licenses/).
+ *
+ * As a special exception, the Harbour Project gives permission for
+ * additional uses of the text contained in its release of Harbour.
+ *
+ * The exception is that, if you link the Harbour libraries with other
+ * files to produce an executable, this does not by itself cause the
+ * resulting executable to be covered by the GNU General Public License.
+ * Your use of that executable is in no way restricted on account of
+ * linking the Harbour library code into it.
+ *
+ * This exception does not however invalidate any other reasons why
+ * the executable file might be covered by the GNU General Public License.
+ *
+ * This exception applies only to the code released by the Harbour
+ * Project under the name Harbour.  If you copy code from other
+ * Harbour Project or Free Software Foundation releases into a copy of
+ * Harbour, as the General Public License permits, the exception does
+ * not apply to the code that you add in this way.  To avoid misleading
+ * anyone as to the status of such modified files, you must delete
+ * this exception notice from them.
+ *
+ * If you write modifications of your own for Harbour, it is your choice
+ * whether to permit this exception to apply to your modifications.
+ * If you do not wish that, delete this exception notice.
+ *
+ */
+
+/* Memory usage counters are updated by FM module on each allocation
+ * and release. HVM threads update their own counters kept in HVM stack
+ * so no locks are used. Memory allocated outside HVM threads and by
+ * finished threads is accounted in common counters. Counters of each
+ * thread are net values: memory released by other thread than the one
+ * which allocated it is subtracted from counters of releasing thread.
+ *
+ * Item types and objects by class are not counted on each allocation
+ * but by heap snapshot which scans all GC blocks when other threads
+ * are suspended for a while, like during GC pass.
+ */
+
+#include "hbvmint.h"
+#include "hbapi.h"
+#include "hbapiitm.h"
+#include "hbapicls.h"
+#include "hbapifs.h"
+#include "hbdate.h"
+
+typedef struct
+{
+   char *   pBuf;
+   HB_SIZE  nLen;
+   HB_SIZE  nSize;
+} HB_MEMBUF, * PHB_MEMBUF;
+
+static void hb_memBufAdd( PHB_MEMBUF pBuf, const char * szText )
+{
+   HB_SIZE nLen = strlen( szText );
+
+   if( pBuf->nLen + nLen > pBuf->nSize )
+   {
+      pBuf->nSize = ( pBuf->nLen + nLen ) << 1;
+      if( pBuf->nSize < 1024 )
+         pBuf->nSize = 1024;
+      pBuf->pBuf = ( char * ) hb_xrealloc( pBuf->pBuf, pBuf->nSize );
+   }
+   memcpy( pBuf->pBuf + pBuf->nLen, szText, nLen );
+   pBuf->nLen += nLen;
+}
+
+static PHB_ITEM hb_memStatArray( PHB_ITEM pArray, HB_SIZE nIndex, const HB_MEMSTAT * pStat )
+{
+   hb_arraySetNS( pArray, nIndex++, pStat->nBlocks );
+   hb_arraySetNS( pArray, nIndex++, pStat->nBytes );
+   hb_arraySetNS( pArray, nIndex++, ( HB_ISIZ ) pStat->nAllocs );
+   hb_arraySetNS( pArray, nIndex++, ( HB_ISIZ ) pStat->nFrees );
+   hb_arraySetNS( pArray, nIndex, ( HB_ISIZ ) pStat->nAllocBytes );
+
+   return pArray;
+}
+
+typedef struct
+{
+   HB_MAXINT * pThreads;
+   PHB_MEMSTAT pStats;
+   int         iCount;
+   int         iSize;
+} HB_MEMTHREADS, * PHB_MEMTHREADS;
+
+/* called with locked HVM thread list so it only copies counters */
+static void hb_memStatThread( void * cargo, HB_MAXINT nThreadNo, const HB_MEMSTAT * pStat )
+{
+   PHB_MEMTHREADS pThreads = ( PHB_MEMTHREADS ) cargo;
+
+   if( pThreads->iCount == pThreads->iSize )
+   {
+      pThreads->iSize += 16;
+      pThreads->pThreads = ( HB_MAXINT * ) hb_xrealloc( pThreads->pThreads,
+                                       pThreads->iSize * sizeof( HB_MAXINT ) );
+      pThreads->pStats = ( PHB_MEMSTAT ) hb_xrealloc( pThreads->pStats,
+                                       pThreads->iSize * sizeof( HB_MEMSTAT ) );
+   }
+   pThreads->pThreads[ pThreads->iCount ] = nThreadNo;
+   memcpy( &pThreads->pStats[ pThreads->iCount ], pStat, sizeof( HB_MEMSTAT ) );
+   pThreads->iCount++;
+}
+
+static void hb_memStatThreads( PHB_MEMTHREADS pThreads )
+{
+   memset( pThreads, 0, sizeof( HB_MEMTHREADS ) );
+   hb_xmemstatThreads( hb_memStatThread, pThreads );
+}
+
+static void hb_memStatThreadsFree( PHB_MEMTHREADS pThreads )
+{
+   if( pThreads->pThreads )
+   {
+      hb_xfree( pThreads->pThreads );
+      hb_xfree( pThreads->pStats );
+   }
+}
+
+/* indexes of classes in snapshot sorted by used memory */
+static HB_SIZE * hb_memClassOrder( PHB_MEMSNAPSHOT pSnap, HB_SIZE * pnCount )
+{
+   HB_SIZE * pOrder = NULL, nCount = 0, n, i;
+
+   for( n = 1; n < pSnap->nClasses; ++n )
+   {
+      if( pSnap->pClasses[ n ].nCount )
+         ++nCount;
+   }
+   if( nCount )
+   {
+      pOrder = ( HB_SIZE * ) hb_xgrab( nCount * sizeof( HB_SIZE ) );
+      nCount = 0;
+      for( n = 1; n < pSnap->nClasses; ++n )
+      {
+         if( pSnap->pClasses[ n ].nCount )
+         {
+            /* insertion sort, number of used classes is small */
+            for( i = nCount; i > 0 &&
+                 pSnap->pClasses[ pOrder[ i - 1 ] ].nBytes < pSnap->pClasses[ n ].nBytes; --i )
+               pOrder[ i ] = pOrder[ i - 1 ];
+            pOrder[ i ] = n;
+            ++nCount;
+         }
+      }
+   }
+   *pnCount = nCount;
+
+   return pOrder;
+}
+
+static HB_BOOL hb_memSnapshot( PHB_MEMSNAPSHOT pSnap )
+{
+   memset( pSnap, 0, sizeof( HB_MEMSNAPSHOT ) );
+   return hb_gcMemSnapshot( pSnap );
+}
+
+static void hb_memSnapshotFree( PHB_MEMSNAPSHOT pSnap )
+{
+   if( pSnap->pClasses )
+      hb_xfree( pSnap->pClasses );
+}
+
+static const char * hb_memClassName( HB_SIZE nClass )
+{
+   const char * szName = hb_clsName( ( HB_USHORT ) nClass );
+
+   return szName ? szName : "?";
+}
+
+/* hb_memStats() -> { <nBlocks>, <nBytes>, <nAllocs>, <nFrees>, <nAllocBytes>, <aThreads> }
+ * returns process wide memory usage counters and counters of each
+ * running HVM thread (MT HVM only):
+ *    <aThreads> = { { <nThread>, <nBlocks>, <nBytes>, <nAllocs>, <nFrees>, <nAllocBytes> }, ... }
+ * <nBlocks> and <nBytes> are allocated and not released memory blocks
+ * and their size, <nAllocs>, <nFrees> and <nAllocBytes> are totals
+ * since application start. Byte counters are 0 when memory allocator
+ * cannot report size of memory blocks.
+ */
+HB_FUNC( HB_MEMSTATS )
+{
+   PHB_ITEM pStats = hb_itemArrayNew( 6 ), pThreads;
+   HB_MEMTHREADS threads;
+   HB_MEMSTAT stat;
+   int i;
+
+   hb_memStatThreads( &threads );
+   hb_xmemstat( &stat );
+
+   hb_memStatArray( pStats, 1, &stat );
+   pThreads = hb_arrayGetItemPtr( pStats, 6 );
+   hb_arrayNew( pThreads, threads.iCount );
+   for( i = 0; i < threads.iCount; ++i )
+   {
+      PHB_ITEM pThread = hb_arrayGetItemPtr( pThreads, i + 1 );
+
+      hb_arrayNew( pThread, 6 );
+      hb_arraySetNInt( pThread, 1, threads.pThreads[ i ] );
+      hb_memStatArray( pThread, 2, &threads.pStats[ i ] );
+   }
+   hb_memStatThreadsFree( &threads );
+
+   hb_itemReturnRelease( pStats );
+}
+
+/* hb_memHeapStats( [ @<aClasses> ] ) -> <aTypes>
+ * scans all GC blocks and returns number and size of items by type:
+ *    <aTypes> = { { <cType>, <nCount>, <nBytes> }, ... }
+ * where <cType> is "STRING", "ARRAY", "OBJECT", "HASH", "BLOCK"
+ * or "OTHER" (pointers, memvars, threads, mutexes, ...).
+ * Only strings stored in arrays, objects and hashes are counted.
+ * <aClasses> receives class histogram sorted by used memory:
+ *    <aClasses> = { { <cClassName>, <nCount>, <nBytes> }, ... }
+ * Other threads are suspended for the time of scanning like during
+ * GC pass. Empty array is returned when snapshot cannot be done
+ * because GC pass is in progress.
+ */
+HB_FUNC( HB_MEMHEAPSTATS )
+{
+   PHB_ITEM pTypes = hb_itemArrayNew( 0 );
+   HB_MEMSNAPSHOT snap;
+
+   if( hb_memSnapshot( &snap ) )
+   {
+      static const char * s_szTypes[] =
+         { "STRING", "ARRAY", "OBJECT", "HASH", "BLOCK", "OTHER" };
+      PHB_MEMCOUNT pCounts[ 6 ];
+      int i;
+
+      pCounts[ 0 ] = &snap.strings;
+      pCounts[ 1 ] = &snap.arrays;
+      pCounts[ 2 ] = &snap.objects;
+      pCounts[ 3 ] = &snap.hashes;
+      pCounts[ 4 ] = &snap.blocks;
+      pCounts[ 5 ] = &snap.other;
+
+      hb_arraySize( pTypes, HB_SIZEOFARRAY( s_szTypes ) );
+      for( i = 0; i < ( int ) HB_SIZEOFARRAY( s_szTypes ); ++i )
+      {
+         PHB_ITEM pType = hb_arrayGetItemPtr( pTypes, i + 1 );
+
+         hb_arrayNew( pType, 3 );
+         hb_arraySetC( pType, 1, s_szTypes[ i ] );
+         hb_arraySetNS( pType, 2, pCounts[ i ]->nCount );
+         hb_arraySetNS( pType, 3, pCounts[ i ]->nBytes );
+      }
+
+      if( HB_ISBYREF( 1 ) )
+      {
+         PHB_ITEM pClasses = hb_itemArrayNew( 0 );
+         HB_SIZE * pOrder, nCount, n;
+
+         pOrder = hb_memClassOrder( &snap, &nCount );
+         hb_arraySize( pClasses, nCount );
+         for( n = 0; n < nCount; ++n )
+         {
+            PHB_ITEM pClass = hb_arrayGetItemPtr( pClasses, n + 1 );
+            PHB_MEMCOUNT pCount = &snap.pClasses[ pOrder[ n ] ];
+
+            hb_arrayNew( pClass, 3 );
+            hb_arraySetC( pClass, 1, hb_memClassName( pOrder[ n ] ) );
+            hb_arraySetNS( pClass, 2, pCount->nCount );
+            hb_arraySetNS( pClass, 3, pCount->nBytes );
+         }
+         if( pOrder )
+            hb_xfree( pOrder );
+         hb_itemParamStoreRelease( 1, pClasses );
+      }
+      hb_memSnapshotFree( &snap );
+   }
+
+   hb_itemReturnRelease( pTypes );
+}
+
+/* hb_memSnapshot( [ <cFileName> ] ) -> <cReport>
+ * returns text report with memory usage counters of process and
+ * running threads, item types and class histogram. When <cFileName>
+ * is given the report is also appended to this file so it can be
+ * called periodically, i.e. from background thread, to trace memory
+ * usage of long running applications.
+ */
+HB_FUNC( HB_MEMSNAPSHOT )
+{
+   HB_MEMBUF buf;
+   HB_MEMTHREADS threads;
+   HB_MEMSNAPSHOT snap;
+   HB_MEMSTAT stat;
+   char szLine[ HB_SYMBOL_NAME_LEN + 128 ];
+   int iYear, iMonth, iDay, iHour, iMinute, iSecond, iMSec, i;
+
+   memset( &buf, 0, sizeof( buf ) );
+
+   hb_timeStampGetLocal( &iYear, &iMonth, &iDay,
+                         &iHour, &iMinute, &iSecond, &iMSec );
+   hb_snprintf( szLine, sizeof( szLine ),
+                "Memory snapshot %04d-%02d-%02d %02d:%02d:%02d.%03d\n",
+                iYear, iMonth, iDay, iHour, iMinute, iSecond, iMSec );
+   hb_memBufAdd( &buf, szLine );
+
+   hb_memStatThreads( &threads );
+   hb_xmemstat( &stat );
+
+   hb_memBufAdd( &buf, "\n" "thread          blocks           bytes         allocs          frees      allocbytes\n" );
+   hb_snprintf( szLine, sizeof( szLine ),
+                "%-8s %13" HB_PFS "d %15" HB_PFS "d %14" HB_PFS "u %14" HB_PFS "u %15" HB_PFS "u\n",
+                "total", stat.nBlocks, stat.nBytes,
+                stat.nAllocs, stat.nFrees, stat.nAllocBytes );
+   hb_memBufAdd( &buf, szLine );
+   for( i = 0; i < threads.iCount; ++i )
+   {
+      PHB_MEMSTAT pStat = &threads.pStats[ i ];
+
+      hb_snprintf( szLine, sizeof( szLine ),
+                   "%-8" PFHL "d %13" HB_PFS "d %15" HB_PFS "d %14" HB_PFS "u %14" HB_PFS "u %15" HB_PFS "u\n",
+                   threads.pThreads[ i ], pStat->nBlocks, pStat->nBytes,
+                   pStat->nAllocs, pStat->nFrees, pStat->nAllocBytes );
+      hb_memBufAdd( &buf, szLine );
+   }
+   hb_memStatThreadsFree( &threads );
+
+   if( hb_memSnapshot( &snap ) )
+   {
+      HB_SIZE * pOrder, nCount, n;
+
+      hb_memBufAdd( &buf, "\n" "type                     count           bytes\n" );
+      hb_snprintf( szLine, sizeof( szLine ),
+                   "STRING       %15" HB_PFS "u %15" HB_PFS "u\n"
+                   "ARRAY        %15" HB_PFS "u %15" HB_PFS "u\n"
+                   "OBJECT       %15" HB_PFS "u %15" HB_PFS "u\n",
+                   snap.strings.nCount, snap.strings.nBytes,
+                   snap.arrays.nCount, snap.arrays.nBytes,
+                   snap.objects.nCount, snap.objects.nBytes );
+      hb_memBufAdd( &buf, szLine );
+      hb_snprintf( szLine, sizeof( szLine ),
+                   "HASH         %15" HB_PFS "u %15" HB_PFS "u\n"
+                   "BLOCK        %15" HB_PFS "u %15" HB_PFS "u\n"
+                   "OTHER        %15" HB_PFS "u %15" HB_PFS "u\n",
+                   snap.hashes.nCount, snap.hashes.nBytes,
+                   snap.blocks.nCount, snap.blocks.nBytes,
+                   snap.other.nCount, snap.other.nBytes );
+      hb_memBufAdd( &buf, szLine );
+
+      pOrder = hb_memClassOrder( &snap, &nCount );
+      if( nCount )
+      {
+         hb_memBufAdd( &buf, "\n" "class                    count           bytes\n" );
+         for( n = 0; n < nCount; ++n )
+         {
+            PHB_MEMCOUNT pCount = &snap.pClasses[ pOrder[ n ] ];
+
+            hb_snprintf( szLine, sizeof( szLine ),
+                         "%-12s %15" HB_PFS "u %15" HB_PFS "u\n",
+                         hb_memClassName( pOrder[ n ] ),
+                         pCount->nCount, pCount->nBytes );
+            hb_memBufAdd( &buf, szLine );
+         }
+         hb_xfree( pOrder );
+      }
+      hb_memSnapshotFree( &snap );
+   }
+   hb_memBufAdd( &buf, "\n" );
+
+   if( HB_ISCHAR( 1 ) )
+   {
+      PHB_FILE pFile = hb_fileExtOpen( hb_parc( 1 ), NULL,
+                                       FO_WRITE | FO_DENYNONE | FXO_APPEND |
+                                       FXO_SHARELOCK, NULL, NULL );
+      if( pFile )
+      {
+         hb_fileWriteAt( pFile, buf.pBuf, buf.nLen, hb_fileSize( pFile ) );
+         hb_fileClose( pFile );
+      }
+   }
+
+   hb_retclen( buf.pBuf, buf.nLen );
+   hb_xfree( buf.pBuf );
+}
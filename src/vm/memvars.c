@@ -67,6 +67,21 @@
 #define TABLE_INITHB_VALUE    100
 #define TABLE_EXPANDHB_VALUE  50
 
+/* Cache of dynamic symbols found by memvar name used by __mv*() functions
+ * and other by name accesses. Dynamic symbols are never released so only
+ * existing symbols are cached and entries do not need invalidation.
+ * In MT mode each thread has its own cache and does not use any locks.
+ */
+#define HB_MEMVAR_NAMECACHE   256   /* must be power of 2 */
+
+#if defined( HB_MT_VM )
+   static HB_TSD_NEW( s_memvarNameCache, HB_MEMVAR_NAMECACHE * sizeof( PHB_DYNS ), NULL, NULL );
+#  define hb_memvarNameCache()   ( ( PHB_DYNS * ) hb_stackGetTSD( &s_memvarNameCache ) )
+#else
+   static PHB_DYNS s_memvarNameCache[ HB_MEMVAR_NAMECACHE ];
+#  define hb_memvarNameCache()   s_memvarNameCache
+#endif
+
 struct mv_PUBLIC_var_info
 {
    int      iPos;
@@ -158,7 +173,16 @@ PHB_ITEM hb_memvarDetachLocal( PHB_ITEM pLocal )
                PHB_ITEM pBase = HB_IS_BYREF( pLocal->item.asEnum.basePtr ) ?
                                hb_itemUnRef( pLocal->item.asEnum.basePtr ) :
                                              pLocal->item.asEnum.basePtr;
-               if( HB_IS_ARRAY( pBase ) )
+               /* frozen items cannot be detached, use private copy */
+               if( hb_itemIsFrozen( pBase ) )
+               {
+                  PHB_ITEM pItem = hb_itemUnRefOnce( pLocal );
+                  if( ! pLocal->item.asEnum.valuePtr )
+                     pLocal->item.asEnum.valuePtr = hb_itemNew( pItem );
+                  pLocal = pLocal->item.asEnum.valuePtr;
+                  break;
+               }
+               else if( HB_IS_ARRAY( pBase ) )
                {
                   PHB_ITEM pItem = hb_itemNew( NULL );
                   hb_arrayGetItemRef( pBase, pLocal->item.asEnum.offset, pItem );
@@ -531,15 +555,16 @@ void hb_memvarNewParameter( PHB_SYMB pSymbol, PHB_ITEM pValue )
    hb_memvarCreateFromDynSymbol( pSymbol->pDynSym, HB_VSCOMP_PRIVATE, pValue );
 }
 
-static PHB_DYNS hb_memvarFindSymbol( const char * szArg, HB_SIZE nLen )
+static PHB_DYNS hb_memvarLookupSymbol( const char * szArg, HB_SIZE nLen, HB_BOOL fCreate )
 {
    PHB_DYNS pDynSym = NULL;
 
-   HB_TRACE( HB_TR_DEBUG, ( "hb_memvarFindSymbol(%p,%" HB_PFS "u)", ( const void * ) szArg, nLen ) );
+   HB_TRACE( HB_TR_DEBUG, ( "hb_memvarLookupSymbol(%p,%" HB_PFS "u,%d)", ( const void * ) szArg, nLen, fCreate ) );
 
    if( nLen && szArg && *szArg )
    {
       char szUprName[ HB_SYMBOL_NAME_LEN + 1 ];
+      HB_U32 uiHash = 2166136261U;
       int iSize = 0;
 
       do
@@ -547,28 +572,68 @@ static PHB_DYNS hb_memvarFindSymbol( const char * szArg, HB_SIZE nLen )
          char cChar = *szArg++;
 
          if( cChar >= 'a' && cChar <= 'z' )
-            szUprName[ iSize++ ] = cChar - ( 'a' - 'A' );
+            cChar -= 'a' - 'A';
          else if( cChar == ' ' || cChar == '\t' || cChar == '\n' )
          {
             if( iSize )
                break;
+            continue;
          }
          else if( ! cChar )
             break;
-         else
-            szUprName[ iSize++ ] = cChar;
+         szUprName[ iSize++ ] = cChar;
+         uiHash = ( uiHash ^ ( HB_UCHAR ) cChar ) * 16777619U;
       }
       while( --nLen && iSize < HB_SYMBOL_NAME_LEN );
 
       if( iSize )
       {
+         PHB_DYNS * pCache = &hb_memvarNameCache()[ uiHash & ( HB_MEMVAR_NAMECACHE - 1 ) ];
+
          szUprName[ iSize ] = '\0';
-         pDynSym = hb_dynsymFind( szUprName );
+         pDynSym = *pCache;
+         if( pDynSym == NULL || strcmp( pDynSym->pSymbol->szName, szUprName ) != 0 )
+         {
+            pDynSym = fCreate ? hb_dynsymGetCase( szUprName ) :
+                                hb_dynsymFind( szUprName );
+            if( pDynSym )
+               *pCache = pDynSym;
+         }
       }
    }
    return pDynSym;
 }
 
+#define hb_memvarFindSymbol( szArg, nLen )  hb_memvarLookupSymbol( szArg, nLen, HB_FALSE )
+
+/* Returns dynamic symbol for memvar name or memvar handle returned by
+ * __mvHandle() (or any other symbol item)
+ */
+static PHB_DYNS hb_memvarParamSymbol( PHB_ITEM pName )
+{
+   if( HB_IS_SYMBOL( pName ) )
+   {
+      PHB_SYMB pSymbol = pName->item.asSymbol.value;
+
+      return pSymbol->pDynSym ? pSymbol->pDynSym : hb_dynsymGet( pSymbol->szName );
+   }
+   return hb_memvarFindSymbol( pName->item.asString.value,
+                               pName->item.asString.length );
+}
+
+/* Returns dynamic symbol which can be used as a handle to access memvar
+ * by name without repeated name lookups, i.e.:
+ *    hb_memvarGet( pItem, hb_dynsymSymbol( hb_memvarHandle( "CVAR", 4 ) ) )
+ * The symbol is created if it does not exist yet. Leading blanks are
+ * skipped and names which are empty after it give NULL.
+ */
+PHB_DYNS hb_memvarHandle( const char * szVarName, HB_SIZE nLength )
+{
+   HB_TRACE( HB_TR_DEBUG, ( "hb_memvarHandle(%s, %" HB_PFS "u)", szVarName, nLength ) );
+
+   return hb_memvarLookupSymbol( szVarName, nLength, HB_TRUE );
+}
+
 char * hb_memvarGetStrValuePtr( char * szVarName, HB_SIZE * pnLen )
 {
    PHB_DYNS pDynVar;
@@ -1206,11 +1271,14 @@ HB_FUNC( __MVSCOPE )
 
    if( hb_pcount() )
    {
-      PHB_ITEM pVarName = hb_param( 1, HB_IT_STRING );
+      PHB_ITEM pVarName = hb_param( 1, HB_IT_STRING | HB_IT_SYMBOL );
 
       if( pVarName )
-         iMemvar = hb_memvarScope( pVarName->item.asString.value,
-                                   pVarName->item.asString.length );
+      {
+         PHB_DYNS pDynVar = hb_memvarParamSymbol( pVarName );
+
+         iMemvar = pDynVar ? hb_memvarScopeGet( pDynVar ) : HB_MV_NOT_FOUND;
+      }
    }
 
    hb_retni( iMemvar );
@@ -1252,21 +1320,31 @@ HB_FUNC( __MVDBGINFO )
 HB_FUNC( __MVEXIST )
 {
    HB_STACK_TLS_PRELOAD
-   PHB_DYNS pDyn;
+   PHB_ITEM pName = hb_param( 1, HB_IT_STRING | HB_IT_SYMBOL );
+   PHB_DYNS pDyn = pName ? hb_memvarParamSymbol( pName ) : NULL;
 
-   pDyn = hb_memvarFindSymbol( hb_parc( 1 ), hb_parclen( 1 ) );
    hb_retl( pDyn && hb_dynsymGetMemvar( pDyn ) );
 }
 
+HB_FUNC( __MVHANDLE )
+{
+   HB_STACK_TLS_PRELOAD
+   PHB_DYNS pDyn = hb_memvarHandle( hb_parc( 1 ), hb_parclen( 1 ) );
+
+   if( pDyn )
+      hb_itemPutSymbol( hb_stackReturnItem(), pDyn->pSymbol );
+   else
+      hb_errRT_BASE_SubstR( EG_ARG, 3009, NULL, HB_ERR_FUNCNAME, HB_ERR_ARGS_BASEPARAMS );
+}
+
 HB_FUNC( __MVGET )
 {
-   PHB_ITEM pName = hb_param( 1, HB_IT_STRING );
+   PHB_ITEM pName = hb_param( 1, HB_IT_STRING | HB_IT_SYMBOL );
 
    if( pName )
    {
       HB_STACK_TLS_PRELOAD
-      PHB_DYNS pDynVar = hb_memvarFindSymbol( pName->item.asString.value,
-                                              pName->item.asString.length );
+      PHB_DYNS pDynVar = hb_memvarParamSymbol( pName );
 
       if( pDynVar )
       {
@@ -1315,15 +1393,15 @@ HB_FUNC( __MVGET )
 
 HB_FUNC( __MVPUT )
 {
-   PHB_ITEM pName = hb_param( 1, HB_IT_STRING );
+   PHB_ITEM pName = hb_param( 1, HB_IT_STRING | HB_IT_SYMBOL );
    PHB_ITEM pValue = hb_paramError( 2 );
 
    if( pName )
    {
       /* the first parameter is a string with not empty variable name
+       * or memvar handle
        */
-      PHB_DYNS pDynVar = hb_memvarFindSymbol( pName->item.asString.value,
-                                              pName->item.asString.length );
+      PHB_DYNS pDynVar = hb_memvarParamSymbol( pName );
       if( pDynVar )
       {
          /* variable was declared somewhere - assign a new value
@@ -0,0 +1,783 @@
+/*
+ * Sampling profiler
+ *
+ * Copyright 2026 {list of individual authors and e-mail addresses}
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file LICENSE.txt.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA (or visit https://www.gnu.org/licenses/).
+ *
+ * As a special exception, the Harbour Project gives permission for
+ * additional uses of the text contained in its release of Harbour.
+ *
+ * The exception is that, if you link the Harbour libraries with other
+ * files to produce an executable, this does not by itself cause the
+ * resulting executable to be covered by the GNU General Public License.
+ * Your use of that executable is in no way restricted on account of
+ * linking the Harbour library code into it.
+ *
+ * This exception does not however invalidate any other reasons why
+ * the executable file might be covered by the GNU General Public License.
+ *
+ * This exception applies only to the code released by the Harbour
+ * Project under the name Harbour.  If you copy code from other
+ * Harbour Project or Free Software Foundation releases into a copy of
+ * Harbour, as the General Public License permits, the exception does
+ * not apply to the code that you add in this way.  To avoid misleading
+ * anyone as to the status of such modified files, you must delete
+ * this exception notice from them.
+ *
+ * If you write modifications of your own for Harbour, it is your choice
+ * whether to permit this exception to apply to your modifications.
+ * If you do not wish that, delete this exception notice.
+ *
+ */
+
+/* The profiler thread periodically sets sampling request in HVM.
+ * Each running HVM thread serves this request at the nearest opcode
+ * boundary by registering its own call stack, so no foreign stacks
+ * are accessed and there is no profiling code executed between
+ * samples. Threads which do not execute PRG code (i.e. are waiting
+ * for IO or mutex) are not sampled. Samples are aggregated by thread
+ * and call stack, call stack frames are (function, line) pairs.
+ * Sampling is supported only by MT HVM.
+ */
+
+#include "hbvmint.h"
+#include "hbapi.h"
+#include "hbapiitm.h"
+#include "hbstack.h"
+#include "hbvm.h"
+#include "hbthread.h"
+
+/* default sampling interval in milliseconds */
+#ifndef HB_PROFSAMPLE_INTERVAL
+#  define HB_PROFSAMPLE_INTERVAL    10
+#endif
+
+/* maximal number of registered call stack levels */
+#ifndef HB_PROFSAMPLE_DEPTH
+#  define HB_PROFSAMPLE_DEPTH       128
+#endif
+
+#define HB_PROFSAMPLE_HASH          4096     /* must be power of 2 */
+
+typedef struct _HB_PROFFUNC
+{
+   struct _HB_PROFFUNC * pNext;
+   HB_U32      uiHash;
+   HB_SIZE     nId;
+   char *      szName;
+   char *      szModule;
+} HB_PROFFUNC, * PHB_PROFFUNC;
+
+typedef struct _HB_PROFFRAME
+{
+   struct _HB_PROFFRAME * pNext;
+   HB_U32         uiHash;
+   HB_SIZE        nId;
+   PHB_PROFFUNC   pFunc;
+   HB_USHORT      uiLine;
+   HB_SIZE        nSelf;      /* used by reports */
+   HB_SIZE        nTotal;
+   HB_SIZE        nStamp;
+} HB_PROFFRAME, * PHB_PROFFRAME;
+
+typedef struct _HB_PROFSTACK
+{
+   struct _HB_PROFSTACK * pNext;
+   HB_U32         uiHash;
+   HB_THREAD_NO   th_no;
+   HB_SIZE        nCount;
+   int            iFrames;
+   PHB_PROFFRAME  pFrames[ 1 ];  /* from caller to called function */
+} HB_PROFSTACK, * PHB_PROFSTACK;
+
+typedef struct
+{
+   char *   pBuf;
+   HB_SIZE  nLen;
+   HB_SIZE  nSize;
+} HB_PROFBUF, * PHB_PROFBUF;
+
+static HB_CRITICAL_NEW( s_profMtx );
+static HB_COND_NEW( s_profCond );
+
+static PHB_PROFFUNC *  s_pFuncHash  = NULL;
+static PHB_PROFFRAME * s_pFrameHash = NULL;
+static PHB_PROFSTACK * s_pStackHash = NULL;
+static PHB_PROFFRAME * s_pFrames    = NULL;   /* frames indexed by nId */
+static HB_SIZE         s_nFrames    = 0;
+static HB_SIZE         s_nFuncs     = 0;
+static HB_SIZE         s_nSamples   = 0;
+static HB_SIZE         s_nTicks     = 0;
+static HB_ULONG        s_ulInterval = HB_PROFSAMPLE_INTERVAL;
+static HB_BOOL         s_fActive    = HB_FALSE;
+#if defined( HB_MT_VM )
+static HB_BOOL         s_fInit      = HB_FALSE;
+static HB_THREAD_HANDLE s_th_h;
+#endif
+
+static HB_U32 hb_profHash( HB_U32 uiHash, const void * pData, HB_SIZE nLen )
+{
+   const HB_UCHAR * ptr = ( const HB_UCHAR * ) pData;
+
+   while( nLen-- )
+      uiHash = ( uiHash ^ *ptr++ ) * 16777619U;
+
+   return uiHash;
+}
+
+/* must be called with s_profMtx locked */
+static PHB_PROFFUNC hb_profFuncGet( const char * szName, const char * szModule )
+{
+   HB_U32 uiHash = hb_profHash( 2166136261U, szName, strlen( szName ) + 1 );
+   PHB_PROFFUNC pFunc;
+
+   uiHash = hb_profHash( uiHash, szModule, strlen( szModule ) );
+   pFunc = s_pFuncHash[ uiHash & ( HB_PROFSAMPLE_HASH - 1 ) ];
+   while( pFunc )
+   {
+      if( pFunc->uiHash == uiHash && strcmp( pFunc->szName, szName ) == 0 &&
+          strcmp( pFunc->szModule, szModule ) == 0 )
+         return pFunc;
+      pFunc = pFunc->pNext;
+   }
+
+   pFunc = ( PHB_PROFFUNC ) hb_xgrab( sizeof( HB_PROFFUNC ) );
+   pFunc->uiHash = uiHash;
+   pFunc->nId = ++s_nFuncs;
+   pFunc->szName = hb_strdup( szName );
+   pFunc->szModule = hb_strdup( szModule );
+   pFunc->pNext = s_pFuncHash[ uiHash & ( HB_PROFSAMPLE_HASH - 1 ) ];
+   s_pFuncHash[ uiHash & ( HB_PROFSAMPLE_HASH - 1 ) ] = pFunc;
+
+   return pFunc;
+}
+
+/* must be called with s_profMtx locked */
+static PHB_PROFFRAME hb_profFrameGet( const char * szName, const char * szModule,
+                                      HB_USHORT uiLine )
+{
+   PHB_PROFFUNC pFunc = hb_profFuncGet( szName, szModule );
+   HB_U32 uiHash = hb_profHash( pFunc->uiHash, &uiLine, sizeof( uiLine ) );
+   PHB_PROFFRAME pFrame = s_pFrameHash[ uiHash & ( HB_PROFSAMPLE_HASH - 1 ) ];
+
+   while( pFrame )
+   {
+      if( pFrame->pFunc == pFunc && pFrame->uiLine == uiLine )
+         return pFrame;
+      pFrame = pFrame->pNext;
+   }
+
+   pFrame = ( PHB_PROFFRAME ) hb_xgrabz( sizeof( HB_PROFFRAME ) );
+   pFrame->uiHash = uiHash;
+   pFrame->pFunc = pFunc;
+   pFrame->uiLine = uiLine;
+   pFrame->nId = s_nFrames;
+   if( ( s_nFrames & 0xFF ) == 0 )
+      s_pFrames = ( PHB_PROFFRAME * ) hb_xrealloc( s_pFrames,
+                           ( s_nFrames + 0x100 ) * sizeof( PHB_PROFFRAME ) );
+   s_pFrames[ s_nFrames++ ] = pFrame;
+   pFrame->pNext = s_pFrameHash[ uiHash & ( HB_PROFSAMPLE_HASH - 1 ) ];
+   s_pFrameHash[ uiHash & ( HB_PROFSAMPLE_HASH - 1 ) ] = pFrame;
+
+   return pFrame;
+}
+
+/* free all collected samples, must be called with s_profMtx locked */
+static void hb_profClear( void )
+{
+   if( s_pStackHash )
+   {
+      int i;
+
+      for( i = 0; i < HB_PROFSAMPLE_HASH; ++i )
+      {
+         while( s_pStackHash[ i ] )
+         {
+            PHB_PROFSTACK pStack = s_pStackHash[ i ];
+            s_pStackHash[ i ] = pStack->pNext;
+            hb_xfree( pStack );
+         }
+         while( s_pFrameHash[ i ] )
+         {
+            PHB_PROFFRAME pFrame = s_pFrameHash[ i ];
+            s_pFrameHash[ i ] = pFrame->pNext;
+            hb_xfree( pFrame );
+         }
+         while( s_pFuncHash[ i ] )
+         {
+            PHB_PROFFUNC pFunc = s_pFuncHash[ i ];
+            s_pFuncHash[ i ] = pFunc->pNext;
+            hb_xfree( pFunc->szName );
+            hb_xfree( pFunc->szModule );
+            hb_xfree( pFunc );
+         }
+      }
+      hb_xfree( s_pStackHash );
+      hb_xfree( s_pFrameHash );
+      hb_xfree( s_pFuncHash );
+      s_pStackHash = NULL;
+      s_pFrameHash = NULL;
+      s_pFuncHash = NULL;
+   }
+   if( s_pFrames )
+   {
+      hb_xfree( s_pFrames );
+      s_pFrames = NULL;
+   }
+   s_nFrames = s_nFuncs = s_nSamples = s_nTicks = 0;
+}
+
+/* register call stack of current thread, called by HVM when sampling
+ * was requested by hb_vmSampleRequest()
+ */
+void hb_profSampleThread( void )
+{
+   char szName[ HB_SYMBOL_NAME_LEN + HB_SYMBOL_NAME_LEN + 5 ];
+   char szModule[ HB_PATH_MAX ];
+   PHB_PROFFRAME pFrames[ HB_PROFSAMPLE_DEPTH ];
+   HB_USHORT uiLine;
+   HB_THREAD_NO th_no = hb_threadNO();
+   int iFrames = 0, iLevel = 0;
+
+   hb_threadEnterCriticalSection( &s_profMtx );
+   if( s_fActive )
+   {
+      PHB_PROFSTACK pStack;
+      HB_U32 uiHash;
+      int i;
+
+      if( s_pStackHash == NULL )
+      {
+         s_pStackHash = ( PHB_PROFSTACK * ) hb_xgrabz( HB_PROFSAMPLE_HASH * sizeof( PHB_PROFSTACK ) );
+         s_pFrameHash = ( PHB_PROFFRAME * ) hb_xgrabz( HB_PROFSAMPLE_HASH * sizeof( PHB_PROFFRAME ) );
+         s_pFuncHash = ( PHB_PROFFUNC * ) hb_xgrabz( HB_PROFSAMPLE_HASH * sizeof( PHB_PROFFUNC ) );
+      }
+
+      /* frames are collected from the called function to the caller,
+         the deepest frames are cut when stack is too deep */
+      while( hb_procinfo( iLevel++, szName, &uiLine, szModule ) )
+      {
+         if( iFrames == HB_PROFSAMPLE_DEPTH )
+         {
+            memmove( pFrames, pFrames + 1, ( iFrames - 1 ) * sizeof( PHB_PROFFRAME ) );
+            --iFrames;
+         }
+         pFrames[ iFrames++ ] = hb_profFrameGet( szName, szModule, uiLine );
+      }
+
+      uiHash = hb_profHash( 2166136261U, &th_no, sizeof( th_no ) );
+      uiHash = hb_profHash( uiHash, pFrames, iFrames * sizeof( PHB_PROFFRAME ) );
+      pStack = s_pStackHash[ uiHash & ( HB_PROFSAMPLE_HASH - 1 ) ];
+      while( pStack )
+      {
+         if( pStack->uiHash == uiHash && pStack->th_no == th_no &&
+             pStack->iFrames == iFrames )
+         {
+            for( i = 0; i < iFrames; ++i )
+            {
+               if( pStack->pFrames[ i ] != pFrames[ iFrames - i - 1 ] )
+                  break;
+            }
+            if( i == iFrames )
+               break;
+         }
+         pStack = pStack->pNext;
+      }
+      if( pStack == NULL )
+      {
+         pStack = ( PHB_PROFSTACK ) hb_xgrab( sizeof( HB_PROFSTACK ) +
+                                 iFrames * sizeof( PHB_PROFFRAME ) );
+         pStack->uiHash = uiHash;
+         pStack->th_no = th_no;
+         pStack->nCount = 0;
+         pStack->iFrames = iFrames;
+         for( i = 0; i < iFrames; ++i )
+            pStack->pFrames[ i ] = pFrames[ iFrames - i - 1 ];
+         pStack->pNext = s_pStackHash[ uiHash & ( HB_PROFSAMPLE_HASH - 1 ) ];
+         s_pStackHash[ uiHash & ( HB_PROFSAMPLE_HASH - 1 ) ] = pStack;
+      }
+      pStack->nCount++;
+      s_nSamples++;
+   }
+   hb_threadLeaveCriticalSection( &s_profMtx );
+}
+
+#if defined( HB_MT_VM )
+
+static HB_THREAD_STARTFUNC( hb_profSampler )
+{
+   HB_SYMBOL_UNUSED( Cargo );
+
+   hb_threadEnterCriticalSection( &s_profMtx );
+   while( s_fActive )
+   {
+      hb_threadCondTimedWait( &s_profCond, &s_profMtx, s_ulInterval );
+      if( s_fActive )
+      {
+         s_nTicks++;
+         hb_threadLeaveCriticalSection( &s_profMtx );
+         hb_vmSampleRequest();
+         hb_threadEnterCriticalSection( &s_profMtx );
+      }
+   }
+   hb_threadLeaveCriticalSection( &s_profMtx );
+
+   HB_THREAD_END
+}
+
+#endif
+
+static HB_BOOL hb_profSampleStop( void )
+{
+   HB_BOOL fActive;
+
+   hb_threadEnterCriticalSection( &s_profMtx );
+   fActive = s_fActive;
+   s_fActive = HB_FALSE;
+   hb_threadCondSignal( &s_profCond );
+   hb_threadLeaveCriticalSection( &s_profMtx );
+
+#if defined( HB_MT_VM )
+   if( fActive )
+   {
+      hb_vmUnlock();
+      hb_threadJoin( s_th_h );
+      hb_vmLock();
+      hb_vmSampleCancel();
+   }
+#endif
+
+   return fActive;
+}
+
+#if defined( HB_MT_VM )
+
+static void hb_profSampleRelease( void * cargo )
+{
+   HB_SYMBOL_UNUSED( cargo );
+
+   hb_profSampleStop();
+
+   hb_threadEnterCriticalSection( &s_profMtx );
+   hb_profClear();
+   s_fInit = HB_FALSE;
+   hb_threadLeaveCriticalSection( &s_profMtx );
+}
+
+#endif
+
+static void hb_profBufAdd( PHB_PROFBUF pBuf, const void * pData, HB_SIZE nLen )
+{
+   if( pBuf->nLen + nLen > pBuf->nSize )
+   {
+      pBuf->nSize = ( pBuf->nLen + nLen ) << 1;
+      if( pBuf->nSize < 256 )
+         pBuf->nSize = 256;
+      pBuf->pBuf = ( char * ) hb_xrealloc( pBuf->pBuf, pBuf->nSize );
+   }
+   memcpy( pBuf->pBuf + pBuf->nLen, pData, nLen );
+   pBuf->nLen += nLen;
+}
+
+static void hb_profBufAddStr( PHB_PROFBUF pBuf, const char * szText )
+{
+   hb_profBufAdd( pBuf, szText, strlen( szText ) );
+}
+
+/* check if given stack should be included in report */
+static HB_BOOL hb_profStackUsed( PHB_PROFSTACK pStack, HB_THREAD_NO th_no )
+{
+   return th_no == 0 || pStack->th_no == th_no;
+}
+
+/* protocol buffers encoding used by pprof profile.proto */
+
+static void hb_pbVarInt( PHB_PROFBUF pBuf, HB_MAXUINT nValue )
+{
+   char buffer[ 10 ];
+   int i = 0;
+
+   while( nValue >= 0x80 )
+   {
+      buffer[ i++ ] = ( char ) ( ( nValue & 0x7F ) | 0x80 );
+      nValue >>= 7;
+   }
+   buffer[ i++ ] = ( char ) nValue;
+   hb_profBufAdd( pBuf, buffer, i );
+}
+
+static void hb_pbInt( PHB_PROFBUF pBuf, int iField, HB_MAXUINT nValue )
+{
+   hb_pbVarInt( pBuf, ( HB_MAXUINT ) ( iField << 3 ) );
+   hb_pbVarInt( pBuf, nValue );
+}
+
+static void hb_pbBytes( PHB_PROFBUF pBuf, int iField, const void * pData, HB_SIZE nLen )
+{
+   hb_pbVarInt( pBuf, ( HB_MAXUINT ) ( ( iField << 3 ) | 2 ) );
+   hb_pbVarInt( pBuf, nLen );
+   hb_profBufAdd( pBuf, pData, nLen );
+}
+
+/* add submessage stored in pMsg and clear it */
+static void hb_pbMessage( PHB_PROFBUF pBuf, int iField, PHB_PROFBUF pMsg )
+{
+   hb_pbBytes( pBuf, iField, pMsg->pBuf, pMsg->nLen );
+   pMsg->nLen = 0;
+}
+
+static void hb_pbValueType( PHB_PROFBUF pBuf, int iField, PHB_PROFBUF pMsg,
+                            HB_SIZE nType, HB_SIZE nUnit )
+{
+   hb_pbInt( pMsg, 1, nType );
+   hb_pbInt( pMsg, 2, nUnit );
+   hb_pbMessage( pBuf, iField, pMsg );
+}
+
+/* strings in profile string table:
+   0 - "", 1 - "samples", 2 - "count", 3 - "cpu", 4 - "nanoseconds",
+   5 - "thread", then function name and module for each function */
+#define HB_PPROF_STR_FUNC     6
+
+static void hb_profPProf( PHB_PROFBUF pBuf, HB_THREAD_NO th_no )
+{
+   static const char * s_szStrings[] = { "", "samples", "count", "cpu", "nanoseconds", "thread" };
+   HB_PROFBUF msg, sub;
+   HB_MAXUINT nPeriod = ( HB_MAXUINT ) s_ulInterval * 1000000;
+   HB_SIZE n;
+   int i;
+
+   memset( &msg, 0, sizeof( msg ) );
+   memset( &sub, 0, sizeof( sub ) );
+
+   hb_pbValueType( pBuf, 1, &msg, 1, 2 );    /* sample_type samples/count */
+   hb_pbValueType( pBuf, 1, &msg, 3, 4 );    /* sample_type cpu/nanoseconds */
+
+   if( s_pStackHash )
+   {
+      for( i = 0; i < HB_PROFSAMPLE_HASH; ++i )
+      {
+         PHB_PROFSTACK pStack;
+
+         for( pStack = s_pStackHash[ i ]; pStack; pStack = pStack->pNext )
+         {
+            if( hb_profStackUsed( pStack, th_no ) )
+            {
+               int iFrame = pStack->iFrames;
+
+               /* sample locations start from the called function */
+               while( --iFrame >= 0 )
+                  hb_pbInt( &msg, 1, pStack->pFrames[ iFrame ]->nId + 1 );
+               hb_pbInt( &msg, 2, pStack->nCount );
+               hb_pbInt( &msg, 2, pStack->nCount * nPeriod );
+               /* label thread=<th_no> */
+               hb_pbInt( &sub, 1, 5 );
+               hb_pbInt( &sub, 3, pStack->th_no );
+               hb_pbMessage( &msg, 3, &sub );
+               hb_pbMessage( pBuf, 2, &msg );
+            }
+         }
+      }
+   }
+
+   /* locations, one for each (function, line) pair */
+   for( n = 0; n < s_nFrames; ++n )
+   {
+      hb_pbInt( &msg, 1, n + 1 );
+      hb_pbInt( &sub, 1, s_pFrames[ n ]->pFunc->nId );
+      hb_pbInt( &sub, 2, s_pFrames[ n ]->uiLine );
+      hb_pbMessage( &msg, 4, &sub );
+      hb_pbMessage( pBuf, 4, &msg );
+   }
+
+   /* functions */
+   if( s_pFuncHash )
+   {
+      for( i = 0; i < HB_PROFSAMPLE_HASH; ++i )
+      {
+         PHB_PROFFUNC pFunc;
+
+         for( pFunc = s_pFuncHash[ i ]; pFunc; pFunc = pFunc->pNext )
+         {
+            HB_SIZE nName = HB_PPROF_STR_FUNC + ( pFunc->nId - 1 ) * 2;
+
+            hb_pbInt( &msg, 1, pFunc->nId );
+            hb_pbInt( &msg, 2, nName );
+            hb_pbInt( &msg, 3, nName );
+            hb_pbInt( &msg, 4, nName + 1 );
+            hb_pbMessage( pBuf, 5, &msg );
+         }
+      }
+   }
+
+   /* string table, function names and modules are ordered by nId */
+   for( i = 0; i < ( int ) HB_SIZEOFARRAY( s_szStrings ); ++i )
+      hb_pbBytes( pBuf, 6, s_szStrings[ i ], strlen( s_szStrings[ i ] ) );
+   if( s_nFuncs )
+   {
+      PHB_PROFFUNC * pFuncs = ( PHB_PROFFUNC * ) hb_xgrab( s_nFuncs * sizeof( PHB_PROFFUNC ) );
+
+      for( i = 0; i < HB_PROFSAMPLE_HASH; ++i )
+      {
+         PHB_PROFFUNC pFunc;
+
+         for( pFunc = s_pFuncHash[ i ]; pFunc; pFunc = pFunc->pNext )
+            pFuncs[ pFunc->nId - 1 ] = pFunc;
+      }
+      for( n = 0; n < s_nFuncs; ++n )
+      {
+         hb_pbBytes( pBuf, 6, pFuncs[ n ]->szName, strlen( pFuncs[ n ]->szName ) );
+         hb_pbBytes( pBuf, 6, pFuncs[ n ]->szModule, strlen( pFuncs[ n ]->szModule ) );
+      }
+      hb_xfree( pFuncs );
+   }
+
+   hb_pbInt( pBuf, 10, ( HB_MAXUINT ) s_nTicks * nPeriod );   /* duration_nanos */
+   hb_pbValueType( pBuf, 11, &msg, 3, 4 );                     /* period_type cpu/nanoseconds */
+   hb_pbInt( pBuf, 12, nPeriod );                              /* period */
+
+   if( msg.pBuf )
+      hb_xfree( msg.pBuf );
+   if( sub.pBuf )
+      hb_xfree( sub.pBuf );
+}
+
+/* text in format used by flamegraph.pl and other tools, one line
+   for each call stack: "frame;frame;...;frame <count>" */
+static void hb_profCollapsed( PHB_PROFBUF pBuf, HB_THREAD_NO th_no, HB_BOOL fThreads )
+{
+   char buffer[ 32 ];
+   int i;
+
+   if( s_pStackHash == NULL )
+      return;
+
+   for( i = 0; i < HB_PROFSAMPLE_HASH; ++i )
+   {
+      PHB_PROFSTACK pStack;
+
+      for( pStack = s_pStackHash[ i ]; pStack; pStack = pStack->pNext )
+      {
+         if( hb_profStackUsed( pStack, th_no ) )
+         {
+            int iFrame;
+
+            if( fThreads )
+            {
+               hb_snprintf( buffer, sizeof( buffer ), "thread %d", ( int ) pStack->th_no );
+               hb_profBufAddStr( pBuf, buffer );
+            }
+            for( iFrame = 0; iFrame < pStack->iFrames; ++iFrame )
+            {
+               PHB_PROFFRAME pFrame = pStack->pFrames[ iFrame ];
+
+               if( iFrame > 0 || fThreads )
+                  hb_profBufAdd( pBuf, ";", 1 );
+               hb_profBufAddStr( pBuf, pFrame->pFunc->szName );
+               if( pFrame->pFunc->szModule[ 0 ] )
+               {
+                  hb_snprintf( buffer, sizeof( buffer ), ":%d", ( int ) pFrame->uiLine );
+                  hb_profBufAdd( pBuf, " (", 2 );
+                  hb_profBufAddStr( pBuf, pFrame->pFunc->szModule );
+                  hb_profBufAddStr( pBuf, buffer );
+                  hb_profBufAdd( pBuf, ")", 1 );
+               }
+            }
+            hb_snprintf( buffer, sizeof( buffer ), " %" HB_PFS "u\n", pStack->nCount );
+            hb_profBufAddStr( pBuf, buffer );
+         }
+      }
+   }
+}
+
+static void hb_profReturnBuf( PHB_PROFBUF pBuf )
+{
+   if( pBuf->pBuf )
+      hb_retclen_buffer( pBuf->pBuf, pBuf->nLen );
+   else
+      hb_retc_null();
+}
+
+/* hb_profSampleStart( [ <nIntervalMS> ] ) -> <lStarted>
+ * start sampling profiler, returns .F. if profiler is already active
+ * or sampling is not supported (ST HVM)
+ */
+HB_FUNC( HB_PROFSAMPLESTART )
+{
+   HB_BOOL fStarted = HB_FALSE;
+
+#if defined( HB_MT_VM )
+   HB_THREAD_ID th_id;
+
+   hb_threadEnterCriticalSection( &s_profMtx );
+   if( ! s_fActive )
+   {
+      if( ! s_fInit )
+      {
+         s_fInit = HB_TRUE;
+         hb_vmAtQuit( hb_profSampleRelease, NULL );
+      }
+      s_ulInterval = hb_parnldef( 1, HB_PROFSAMPLE_INTERVAL );
+      if( s_ulInterval == 0 )
+         s_ulInterval = 1;
+      s_fActive = HB_TRUE;
+      s_th_h = hb_threadCreate( &th_id, hb_profSampler, NULL );
+      if( s_th_h == ( HB_THREAD_HANDLE ) 0 )
+         s_fActive = HB_FALSE;
+      else
+         fStarted = HB_TRUE;
+   }
+   hb_threadLeaveCriticalSection( &s_profMtx );
+#endif
+
+   hb_retl( fStarted );
+}
+
+/* hb_profSampleStop() -> <lWasActive> */
+HB_FUNC( HB_PROFSAMPLESTOP )
+{
+   hb_retl( hb_profSampleStop() );
+}
+
+/* hb_profSampleReset() -> NIL
+ * remove all collected samples
+ */
+HB_FUNC( HB_PROFSAMPLERESET )
+{
+   hb_threadEnterCriticalSection( &s_profMtx );
+   hb_profClear();
+   hb_threadLeaveCriticalSection( &s_profMtx );
+}
+
+/* hb_profSampleInfo() -> { <lActive>, <nIntervalMS>, <nTicks>, <nSamples> } */
+HB_FUNC( HB_PROFSAMPLEINFO )
+{
+   PHB_ITEM pInfo = hb_itemArrayNew( 4 );
+
+   hb_threadEnterCriticalSection( &s_profMtx );
+   hb_arraySetL( pInfo, 1, s_fActive );
+   hb_arraySetNL( pInfo, 2, ( long ) s_ulInterval );
+   hb_arraySetNS( pInfo, 3, s_nTicks );
+   hb_arraySetNS( pInfo, 4, s_nSamples );
+   hb_threadLeaveCriticalSection( &s_profMtx );
+
+   hb_itemReturnRelease( pInfo );
+}
+
+/* hb_profSampleLines( [ <nThread> ] ) -> <aLines>
+ * returns array with (function, line) counters:
+ *    { { <cFunction>, <cModule>, <nLine>, <nSelf>, <nTotal> }, ... }
+ * <nSelf> is number of samples taken in this line, <nTotal> also
+ * includes samples taken in functions called from this line.
+ * If <nThread> is given then only samples of this thread are counted.
+ */
+HB_FUNC( HB_PROFSAMPLELINES )
+{
+   HB_THREAD_NO th_no = ( HB_THREAD_NO ) hb_parnl( 1 );
+   PHB_ITEM pLines = hb_itemArrayNew( 0 );
+   HB_SIZE n, nStamp = 0;
+   int i;
+
+   hb_threadEnterCriticalSection( &s_profMtx );
+   for( n = 0; n < s_nFrames; ++n )
+      s_pFrames[ n ]->nSelf = s_pFrames[ n ]->nTotal = s_pFrames[ n ]->nStamp = 0;
+
+   if( s_pStackHash )
+   {
+      for( i = 0; i < HB_PROFSAMPLE_HASH; ++i )
+      {
+         PHB_PROFSTACK pStack;
+
+         for( pStack = s_pStackHash[ i ]; pStack; pStack = pStack->pNext )
+         {
+            if( hb_profStackUsed( pStack, th_no ) && pStack->iFrames > 0 )
+            {
+               int iFrame;
+
+               /* recursive calls are counted only once */
+               ++nStamp;
+               for( iFrame = 0; iFrame < pStack->iFrames; ++iFrame )
+               {
+                  PHB_PROFFRAME pFrame = pStack->pFrames[ iFrame ];
+                  if( pFrame->nStamp != nStamp )
+                  {
+                     pFrame->nStamp = nStamp;
+                     pFrame->nTotal += pStack->nCount;
+                  }
+               }
+               pStack->pFrames[ pStack->iFrames - 1 ]->nSelf += pStack->nCount;
+            }
+         }
+      }
+   }
+
+   for( n = 0; n < s_nFrames; ++n )
+   {
+      PHB_PROFFRAME pFrame = s_pFrames[ n ];
+
+      if( pFrame->nTotal )
+      {
+         PHB_ITEM pLine = hb_itemArrayNew( 5 );
+
+         hb_arraySetC( pLine, 1, pFrame->pFunc->szName );
+         hb_arraySetC( pLine, 2, pFrame->pFunc->szModule );
+         hb_arraySetNI( pLine, 3, pFrame->uiLine );
+         hb_arraySetNS( pLine, 4, pFrame->nSelf );
+         hb_arraySetNS( pLine, 5, pFrame->nTotal );
+         hb_arrayAddForward( pLines, pLine );
+         hb_itemRelease( pLine );
+      }
+   }
+   hb_threadLeaveCriticalSection( &s_profMtx );
+
+   hb_itemReturnRelease( pLines );
+}
+
+/* hb_profSampleCollapsed( [ <lPerThread> ], [ <nThread> ] ) -> <cText>
+ * returns collected samples in collapsed stack format accepted by
+ * flamegraph tools, if <lPerThread> is .T. then thread number is
+ * added as the root frame of each stack
+ */
+HB_FUNC( HB_PROFSAMPLECOLLAPSED )
+{
+   HB_PROFBUF buf;
+
+   memset( &buf, 0, sizeof( buf ) );
+
+   hb_threadEnterCriticalSection( &s_profMtx );
+   hb_profCollapsed( &buf, ( HB_THREAD_NO ) hb_parnl( 2 ), hb_parl( 1 ) );
+   hb_threadLeaveCriticalSection( &s_profMtx );
+
+   hb_profReturnBuf( &buf );
+}
+
+/* hb_profSamplePProf( [ <nThread> ] ) -> <cProfile>
+ * returns collected samples as (uncompressed) protocol buffer
+ * in pprof profile.proto format, samples are labeled with thread number
+ */
+HB_FUNC( HB_PROFSAMPLEPPROF )
+{
+   HB_PROFBUF buf;
+
+   memset( &buf, 0, sizeof( buf ) );
+
+   hb_threadEnterCriticalSection( &s_profMtx );
+   hb_profPProf( &buf, ( HB_THREAD_NO ) hb_parnl( 1 ) );
+   hb_threadLeaveCriticalSection( &s_profMtx );
+
+   hb_profReturnBuf( &buf );
+}
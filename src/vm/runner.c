@@ -56,15 +56,49 @@
 #include "hbpcode.h"
 #include "hbset.h"
 #include "hb_io.h"
+#include "hbthread.h"
 #include "hbhrb.ch"
 
+#if defined( HB_OS_UNIX )
+#  include <sys/types.h>
+#  include <sys/stat.h>
+#  define HB_HRB_USE_CACHE
+   /* modification time with nanoseconds to detect fast rewrites */
+#  if defined( HB_OS_LINUX ) && \
+      defined( __GLIBC__ ) && defined( __GLIBC_MINOR__ ) && \
+      ( __GLIBC__ > 2 || ( __GLIBC__ == 2 && __GLIBC_MINOR__ >= 12 ) ) && \
+      ( defined( _DEFAULT_SOURCE ) || defined( _BSD_SOURCE ) || \
+        defined( _SVID_SOURCE ) || \
+        ( defined( _POSIX_C_SOURCE ) && _POSIX_C_SOURCE >= 200809L ) )
+#     define HB_HRB_MTIME( st )  ( ( HB_MAXINT ) ( st ).st_mtime * 1000000000 + \
+                                   ( st ).st_mtim.tv_nsec )
+#  else
+#     define HB_HRB_MTIME( st )  ( ( HB_MAXINT ) ( st ).st_mtime )
+#  endif
+#endif
+
 typedef struct
 {
    char *        szName;                        /* Name of the function */
    HB_PCODEFUNC  pcodeFunc;                     /* Dynamic function info */
-   HB_BYTE *     pCode;                         /* P-code */
+   HB_BYTE *     pCode;                         /* P-code, NULL if it is not a private copy */
 } HB_DYNF, * PHB_DYNF;
 
+/* .hrb file body shared by all modules loaded with HB_HRB_LOAD_SHARED
+   flag from the same unchanged file, function pcode is not copied
+   but executed directly from this private read only buffer */
+typedef struct _HRB_FILE
+{
+   struct _HRB_FILE * pNext;
+   char *      szFileName;                      /* file name passed to hb_hrbLoad() */
+   HB_FOFFSET  nSize;                           /* file size */
+   HB_MAXINT   nTime;                           /* modification time */
+   HB_MAXUINT  nInode;                          /* file serial number */
+   HB_MAXUINT  nDevice;                         /* device containing the file */
+   HB_BYTE *   pBody;                           /* file body */
+   int         iRefs;                           /* number of references */
+} HRB_FILE, * PHRB_FILE;
+
 typedef struct
 {
    HB_ULONG    ulSymbols;                       /* Number of symbols */
@@ -75,6 +109,7 @@ typedef struct
    PHB_SYMB    pSymRead;                        /* Symbols read */
    PHB_DYNF    pDynFunc;                        /* Functions read */
    PHB_SYMBOLS pModuleSymbols;
+   PHRB_FILE   pHrbFile;                        /* shared .hrb file body */
 } HRB_BODY, * PHRB_BODY;
 
 static const char s_szHead[ 4 ] = { '\xC0', 'H', 'R', 'B' };
@@ -128,8 +163,9 @@ static HB_BOOL hb_hrbReadValue( const char * szBody, HB_SIZE nBodySize, HB_SIZE
 }
 
 /* ReadId
-   Read the next (zero terminated) identifier */
-static char * hb_hrbReadId( const char * szBody, HB_SIZE nBodySize, HB_SIZE * pnBodyOffset )
+   Read the next (zero terminated) identifier, if fCopy is not set
+   then returns pointer to identifier in passed body */
+static char * hb_hrbReadId( const char * szBody, HB_SIZE nBodySize, HB_SIZE * pnBodyOffset, HB_BOOL fCopy )
 {
    const char * szIdx;
 
@@ -139,22 +175,26 @@ static char * hb_hrbReadId( const char * szBody, HB_SIZE nBodySize, HB_SIZE * pn
 
    do
    {
-      if( *pnBodyOffset > nBodySize )
+      if( *pnBodyOffset >= nBodySize )
          return NULL;
    }
    while( szBody[ ( *pnBodyOffset )++ ] );
 
-   return hb_strdup( szIdx );
+   return fCopy ? hb_strdup( szIdx ) : ( char * ) HB_UNCONST( szIdx );
 }
 
-static HB_ULONG hb_hrbFindSymbol( const char * szName, PHB_DYNF pDynFunc, HB_ULONG ulLoaded )
+/* functions are stored in the same order as their symbols so the search
+   starts from the position next to the previously found one */
+static HB_ULONG hb_hrbFindSymbol( const char * szName, PHB_DYNF pDynFunc, HB_ULONG ulLoaded, HB_ULONG ulStart )
 {
-   HB_ULONG ulRet;
+   HB_ULONG ulRet, ul;
 
-   HB_TRACE( HB_TR_DEBUG, ( "hb_hrbFindSymbol(%s, %p, %lu)", szName, ( void * ) pDynFunc, ulLoaded ) );
+   HB_TRACE( HB_TR_DEBUG, ( "hb_hrbFindSymbol(%s, %p, %lu, %lu)", szName, ( void * ) pDynFunc, ulLoaded, ulStart ) );
 
-   for( ulRet = 0; ulRet < ulLoaded; ++ulRet )
+   for( ul = 0, ulRet = ulStart; ul < ulLoaded; ++ul, ++ulRet )
    {
+      if( ulRet >= ulLoaded )
+         ulRet = 0;
       if( ! strcmp( szName, pDynFunc[ ulRet ].szName ) )
          return ulRet;
    }
@@ -267,6 +307,139 @@ static void hb_hrbExit( PHRB_BODY pHrbBody )
    }
 }
 
+#if defined( HB_MT_VM )
+   static HB_CRITICAL_NEW( s_hrbFileMtx );
+#  define HB_HRBFILE_LOCK()     hb_threadEnterCriticalSection( &s_hrbFileMtx )
+#  define HB_HRBFILE_UNLOCK()   hb_threadLeaveCriticalSection( &s_hrbFileMtx )
+#else
+#  define HB_HRBFILE_LOCK()     do {} while( 0 )
+#  define HB_HRBFILE_UNLOCK()   do {} while( 0 )
+#endif
+
+static PHRB_FILE s_pHrbFiles = NULL;     /* cache of shared .hrb files */
+static HB_BOOL   s_fHrbFilesInit = HB_FALSE;
+
+/* must be called with s_hrbFileMtx locked */
+static void hb_hrbFileRelease( PHRB_FILE pHrbFile )
+{
+   if( --pHrbFile->iRefs == 0 )
+   {
+      hb_xfree( pHrbFile->pBody );
+      hb_xfree( pHrbFile->szFileName );
+      hb_xfree( pHrbFile );
+   }
+}
+
+static void hb_hrbFileUnRef( PHRB_FILE pHrbFile )
+{
+   HB_HRBFILE_LOCK();
+   hb_hrbFileRelease( pHrbFile );
+   HB_HRBFILE_UNLOCK();
+}
+
+static void hb_hrbFileCacheRelease( void * cargo )
+{
+   HB_SYMBOL_UNUSED( cargo );
+
+   HB_HRBFILE_LOCK();
+   while( s_pHrbFiles )
+   {
+      PHRB_FILE pHrbFile = s_pHrbFiles;
+
+      s_pHrbFiles = pHrbFile->pNext;
+      hb_hrbFileRelease( pHrbFile );
+   }
+   s_fHrbFilesInit = HB_FALSE;
+   HB_HRBFILE_UNLOCK();
+}
+
+/* Return shared body of opened .hrb file. Bodies are read into memory
+   and cached by file name, size, modification time, device and serial
+   number so reloading unchanged file does not need any IO operations
+   and later rewrites of the file cannot change already loaded pcode.
+   Returns NULL if file cannot be shared, i.e. it is not a local file
+   or it was changed while being read. */
+static PHRB_FILE hb_hrbFileGet( PHB_FILE pFile, const char * szFileName )
+{
+   PHRB_FILE pHrbFile = NULL;
+
+#if defined( HB_HRB_USE_CACHE )
+   HB_FHANDLE hFile = hb_fileHandle( pFile );
+   struct stat st;
+
+   if( hFile != FS_ERROR && fstat( hFile, &st ) == 0 && S_ISREG( st.st_mode ) &&
+       st.st_size > 0 && ( HB_MAXUINT ) st.st_size <= ( HB_MAXUINT ) HB_SIZE_MAX )
+   {
+      PHRB_FILE * pHrbFilePtr;
+      HB_BYTE * pBody;
+      struct stat st2;
+
+      HB_HRBFILE_LOCK();
+      pHrbFilePtr = &s_pHrbFiles;
+      while( *pHrbFilePtr )
+      {
+         pHrbFile = *pHrbFilePtr;
+         if( strcmp( pHrbFile->szFileName, szFileName ) == 0 )
+         {
+            if( pHrbFile->nSize == ( HB_FOFFSET ) st.st_size &&
+                pHrbFile->nTime == HB_HRB_MTIME( st ) &&
+                pHrbFile->nInode == ( HB_MAXUINT ) st.st_ino &&
+                pHrbFile->nDevice == ( HB_MAXUINT ) st.st_dev )
+            {
+               pHrbFile->iRefs++;
+               break;
+            }
+            /* file has been changed, remove old body from cache */
+            *pHrbFilePtr = pHrbFile->pNext;
+            hb_hrbFileRelease( pHrbFile );
+         }
+         else
+            pHrbFilePtr = &pHrbFile->pNext;
+         pHrbFile = NULL;
+      }
+      HB_HRBFILE_UNLOCK();
+
+      if( pHrbFile )
+         return pHrbFile;
+
+      pBody = ( HB_BYTE * ) hb_xgrab( ( HB_SIZE ) st.st_size );
+      /* do not cache body of file changed while it was read */
+      if( hb_fileReadAt( pFile, pBody, ( HB_SIZE ) st.st_size, 0 ) != ( HB_SIZE ) st.st_size ||
+          fstat( hFile, &st2 ) != 0 || st2.st_size != st.st_size ||
+          HB_HRB_MTIME( st2 ) != HB_HRB_MTIME( st ) || st2.st_ino != st.st_ino ||
+          st2.st_dev != st.st_dev )
+      {
+         hb_xfree( pBody );
+         return NULL;
+      }
+
+      pHrbFile = ( PHRB_FILE ) hb_xgrab( sizeof( HRB_FILE ) );
+      pHrbFile->szFileName = hb_strdup( szFileName );
+      pHrbFile->nSize = ( HB_FOFFSET ) st.st_size;
+      pHrbFile->nTime = HB_HRB_MTIME( st );
+      pHrbFile->nInode = ( HB_MAXUINT ) st.st_ino;
+      pHrbFile->nDevice = ( HB_MAXUINT ) st.st_dev;
+      pHrbFile->pBody = pBody;
+      pHrbFile->iRefs = 2;   /* cache and caller references */
+
+      HB_HRBFILE_LOCK();
+      if( ! s_fHrbFilesInit )
+      {
+         s_fHrbFilesInit = HB_TRUE;
+         hb_vmAtQuit( hb_hrbFileCacheRelease, NULL );
+      }
+      pHrbFile->pNext = s_pHrbFiles;
+      s_pHrbFiles = pHrbFile;
+      HB_HRBFILE_UNLOCK();
+   }
+#else
+   HB_SYMBOL_UNUSED( pFile );
+   HB_SYMBOL_UNUSED( szFileName );
+#endif
+
+   return pHrbFile;
+}
+
 static void hb_hrbUnLoad( PHRB_BODY pHrbBody )
 {
    hb_hrbExit( pHrbBody );
@@ -292,17 +465,21 @@ static void hb_hrbUnLoad( PHRB_BODY pHrbBody )
          }
          if( pHrbBody->pDynFunc[ ul ].pCode )
             hb_xfree( pHrbBody->pDynFunc[ ul ].pCode );
-         if( pHrbBody->pDynFunc[ ul ].szName )
+         if( pHrbBody->pDynFunc[ ul ].szName && ! pHrbBody->pHrbFile )
             hb_xfree( pHrbBody->pDynFunc[ ul ].szName );
       }
 
       hb_xfree( pHrbBody->pDynFunc );
    }
 
+   if( pHrbBody->pHrbFile )
+      hb_hrbFileUnRef( pHrbBody->pHrbFile );
+
    hb_xfree( pHrbBody );
 }
 
-static PHRB_BODY hb_hrbLoad( const char * szHrbBody, HB_SIZE nBodySize, HB_USHORT usMode, const char * szFileName )
+static PHRB_BODY hb_hrbLoad( const char * szHrbBody, HB_SIZE nBodySize, HB_USHORT usMode,
+                             const char * szFileName, PHRB_FILE pHrbFile )
 {
    PHRB_BODY pHrbBody = NULL;
 
@@ -311,7 +488,7 @@ static PHRB_BODY hb_hrbLoad( const char * szHrbBody, HB_SIZE nBodySize, HB_USHOR
       HB_SIZE nBodyOffset = 0;
       HB_SIZE nSize;               /* Size of function */
       HB_SIZE nPos;
-      HB_ULONG ul;
+      HB_ULONG ul, ulFunc;
       char * buffer, ch;
       HB_USHORT usBind = ( usMode & HB_HRB_BIND_MODEMASK );
 
@@ -336,6 +513,13 @@ static PHRB_BODY hb_hrbLoad( const char * szHrbBody, HB_SIZE nBodySize, HB_USHOR
       pHrbBody->pSymRead = NULL;
       pHrbBody->pDynFunc = NULL;
       pHrbBody->pModuleSymbols = NULL;
+      pHrbBody->pHrbFile = pHrbFile;
+      if( pHrbFile )
+      {
+         HB_HRBFILE_LOCK();
+         pHrbFile->iRefs++;
+         HB_HRBFILE_UNLOCK();
+      }
       if( ! hb_hrbReadValue( szHrbBody, nBodySize, &nBodyOffset, &pHrbBody->ulSymbols ) ||
             pHrbBody->ulSymbols == 0 )
       {
@@ -411,7 +595,7 @@ static PHRB_BODY hb_hrbLoad( const char * szHrbBody, HB_SIZE nBodySize, HB_USHOR
             HB_ULONG ulValue;
 
             /* Read name of function */
-            pDynFunc[ ul ].szName = hb_hrbReadId( szHrbBody, nBodySize, &nBodyOffset );
+            pDynFunc[ ul ].szName = hb_hrbReadId( szHrbBody, nBodySize, &nBodyOffset, pHrbFile == NULL );
             if( pDynFunc[ ul ].szName == NULL )
                break;
 
@@ -424,12 +608,18 @@ static PHRB_BODY hb_hrbLoad( const char * szHrbBody, HB_SIZE nBodySize, HB_USHOR
             if( nBodyOffset + nSize > nBodySize )
                break;
 
-            /* Copy function body */
-            pDynFunc[ ul ].pCode = ( HB_BYTE * ) hb_xgrab( nSize );
-            memcpy( ( char * ) pDynFunc[ ul ].pCode, szHrbBody + nBodyOffset, nSize );
+            if( pHrbFile )
+               /* execute function body directly from shared buffer */
+               pDynFunc[ ul ].pcodeFunc.pCode = ( HB_BYTE * ) HB_UNCONST( szHrbBody + nBodyOffset );
+            else
+            {
+               /* Copy function body */
+               pDynFunc[ ul ].pCode = ( HB_BYTE * ) hb_xgrab( nSize );
+               memcpy( ( char * ) pDynFunc[ ul ].pCode, szHrbBody + nBodyOffset, nSize );
+               pDynFunc[ ul ].pcodeFunc.pCode = pDynFunc[ ul ].pCode;
+            }
             nBodyOffset += nSize;
 
-            pDynFunc[ ul ].pcodeFunc.pCode    = pDynFunc[ ul ].pCode;
             pDynFunc[ ul ].pcodeFunc.pSymbols = pSymRead;
          }
 
@@ -443,11 +633,12 @@ static PHRB_BODY hb_hrbLoad( const char * szHrbBody, HB_SIZE nBodySize, HB_USHOR
       }
 
       /* End of PCODE loading, now linking */
+      ulFunc = 0;
       for( ul = 0; ul < pHrbBody->ulSymbols; ul++ )
       {
          if( pSymRead[ ul ].value.pCodeFunc == ( PHB_PCODEFUNC ) SYM_FUNC )
          {
-            nPos = hb_hrbFindSymbol( pSymRead[ ul ].szName, pHrbBody->pDynFunc, pHrbBody->ulFuncs );
+            nPos = hb_hrbFindSymbol( pSymRead[ ul ].szName, pHrbBody->pDynFunc, pHrbBody->ulFuncs, ulFunc );
 
             if( nPos == SYM_NOT_FOUND )
             {
@@ -455,6 +646,7 @@ static PHRB_BODY hb_hrbLoad( const char * szHrbBody, HB_SIZE nBodySize, HB_USHOR
             }
             else
             {
+               ulFunc = ( HB_ULONG ) nPos + 1;
                pSymRead[ ul ].value.pCodeFunc = &pHrbBody->pDynFunc[ nPos ].pcodeFunc;
                pSymRead[ ul ].scope.value |= HB_FS_PCODEFUNC | HB_FS_LOCAL |
                   ( usBind == HB_HRB_BIND_FORCELOCAL ? HB_FS_STATIC : 0 );
@@ -582,18 +774,31 @@ static PHRB_BODY hb_hrbLoadFromFile( const char * szHrb, HB_USHORT usMode )
 
    if( pFile != NULL )
    {
-      HB_SIZE nBodySize;
-      HB_BYTE * pBuffer = hb_fileLoadData( pFile, 0, &nBodySize );
+      PHRB_FILE pHrbFile = ( usMode & HB_HRB_LOAD_SHARED ) != 0 ?
+                           hb_hrbFileGet( pFile, szHrb ) : NULL;
 
-      hb_fileClose( pFile );
-
-      if( pBuffer )
+      if( pHrbFile )
       {
-         pHrbBody = hb_hrbLoad( ( const char * ) pBuffer, nBodySize, usMode, szHrb );
-         hb_xfree( pBuffer );
+         hb_fileClose( pFile );
+         pHrbBody = hb_hrbLoad( ( const char * ) pHrbFile->pBody, ( HB_SIZE ) pHrbFile->nSize,
+                                usMode, szHrb, pHrbFile );
+         hb_hrbFileUnRef( pHrbFile );
       }
       else
-         hb_errRT_BASE( EG_CORRUPTION, 9998, NULL, HB_ERR_FUNCNAME, 0 );
+      {
+         HB_SIZE nBodySize;
+         HB_BYTE * pBuffer = hb_fileLoadData( pFile, 0, &nBodySize );
+
+         hb_fileClose( pFile );
+
+         if( pBuffer )
+         {
+            pHrbBody = hb_hrbLoad( ( const char * ) pBuffer, nBodySize, usMode, szHrb, NULL );
+            hb_xfree( pBuffer );
+         }
+         else
+            hb_errRT_BASE( EG_CORRUPTION, 9998, NULL, HB_ERR_FUNCNAME, 0 );
+      }
    }
 
    return pHrbBody;
@@ -689,7 +894,7 @@ HB_FUNC( HB_HRBRUN )
       PHRB_BODY pHrbBody;
 
       if( hb_hrbCheckSig( fileOrBody, nLen ) != 0 )
-         pHrbBody = hb_hrbLoad( fileOrBody, nLen, usMode, NULL );
+         pHrbBody = hb_hrbLoad( fileOrBody, nLen, usMode, NULL, NULL );
       else
          pHrbBody = hb_hrbLoadFromFile( fileOrBody, usMode );
 
@@ -740,7 +945,7 @@ HB_FUNC( HB_HRBLOAD )
       PHRB_BODY pHrbBody;
 
       if( hb_hrbCheckSig( fileOrBody, nLen ) != 0 )
-         pHrbBody = hb_hrbLoad( fileOrBody, nLen, usMode, NULL );
+         pHrbBody = hb_hrbLoad( fileOrBody, nLen, usMode, NULL, NULL );
       else
          pHrbBody = hb_hrbLoadFromFile( fileOrBody, usMode );
 
@@ -63,12 +63,25 @@
   hb_mutexExists( <pMtx> ) --> <lExists>
   hb_mutexLock( <pMtx> [, <nTimeOut> ] ) --> <lLocked>
   hb_mutexUnlock( <pMtx> ) --> <lOK>
-  hb_mutexNotify( <pMtx> [, <xVal>] ) --> NIL
+  hb_mutexNotify( <pMtx> [, <xVal>] [, <nTimeOut> ] ) --> <lQueued>
   hb_mutexNotifyAll( <pMtx> [, <xVal>] ) --> NIL
   hb_mutexSubscribe( <pMtx>, [ <nTimeOut> ] [, @<xSubscribed> ] ) --> <lSubscribed>
   hb_mutexSubscribeNow( <pMtx>, [ <nTimeOut> ] [, @<xSubscribed> ] ) --> <lSubscribed>
+  hb_mutexSubscribeBatch( <pMtx>, [ <nTimeOut> ] [, <nMax> ] ) --> <aSubscribed>
   hb_mutexEval( <pMtx>, <bCode> | <@sFunc()> [, <params,...> ] ) --> <xCodeResult>
-** hb_mutexQueueInfo( <pMtx>, [ @<nWaitersCount> ], [ @<nQueueLength> ] ) --> .T.
+  hb_mutexQueueLimit( <pMtx> [, <nMaxLength> ] ) --> <nPrevMaxLength>
+** hb_mutexQueueInfo( <pMtx>, [ @<nWaitersCount> ], [ @<nQueueLength> ], [ @<nMaxLength> ] ) --> .T.
+  hb_threadPoolCreate( [ <nThreads> ] [, <nThreadAttrs> ] ) --> <pPool>
+  hb_threadPoolSubmit( <pPool>, <bCode> | <@sFunc()> | <cFunc> [, <params,...> ] ) --> <pFuture>
+  hb_threadPoolClose( <pPool> [, <lCancel> ] ) --> NIL
+  hb_threadPoolCanceled() --> <lCancelRequested>
+** hb_threadPoolInfo( <pPool>, [ @<nThreads> ], [ @<nIdle> ], [ @<nQueued> ] ) --> <lOpen>
+  hb_futureState( <pFuture> ) --> <nState>
+  hb_futureWait( <pFuture> [, <nTimeOut> ] ) --> <lFinished>
+  hb_futureGet( <pFuture> [, <nTimeOut> ] [, @<nState> ] ) --> <xResult>
+  hb_futureCancel( <pFuture> ) --> <lCanceled>
+  hb_futureAll( <apFuture> [, <nTimeOut> ] ) --> <lAllFinished>
+  hb_futureAny( <apFuture> [, <nTimeOut> ] ) --> <nFinished> | 0
   hb_mtvm() --> <lMultiThreadVM>
 
   * - this function call can be ignored by the destination thread in some
@@ -129,6 +142,8 @@
 
    static int s_waiting_for_threads = 0;
 
+   static int s_waiting_for_pool = 0;
+
 #  if defined( HB_PTHREAD_API )
    static void hb_threadTimeInit( struct timespec * ts, HB_ULONG ulMilliSec )
    {
@@ -151,6 +166,7 @@
    static HB_RAWCRITICAL_T s_once_mtx;
    static HB_RAWCRITICAL_T s_thread_mtx;
    static HB_RAWCRITICAL_T s_mutexlst_mtx;
+   static HB_RAWCRITICAL_T s_pool_mtx;
    static void hb_threadCriticalInit( HB_CRITICAL_T * critical )
    {
       if( ! s_fThreadInit )
@@ -171,10 +187,12 @@
       static HB_CRITICAL_NEW( s_once_mtx );
       static HB_CRITICAL_NEW( s_thread_mtx );
       static HB_CRITICAL_NEW( s_mutexlst_mtx );
+      static HB_CRITICAL_NEW( s_pool_mtx );
 #  endif
 
 #  if defined( HB_COND_NEED_INIT )
       static HB_RAWCOND_T s_thread_cond;
+      static HB_RAWCOND_T s_pool_cond;
       static void hb_threadCondInit( HB_COND_T * cond )
       {
          if( ! s_fThreadInit )
@@ -194,6 +212,7 @@
       }
 #  else
       static HB_COND_NEW( s_thread_cond );
+      static HB_COND_NEW( s_pool_cond );
 #  endif
 
 #endif /* HB_MT_VM */
@@ -211,9 +230,11 @@ void hb_threadInit( void )
       HB_CRITICAL_INIT( s_once_mtx );
       HB_CRITICAL_INIT( s_thread_mtx );
       HB_CRITICAL_INIT( s_mutexlst_mtx );
+      HB_CRITICAL_INIT( s_pool_mtx );
 #  endif
 #  if defined( HB_COND_NEED_INIT )
       HB_COND_INIT( s_thread_cond );
+      HB_COND_INIT( s_pool_cond );
 #  endif
 #if defined( HB_TASK_THREAD )
       hb_taskInit();
@@ -1683,17 +1704,34 @@ HB_FUNC( HB_THREADONCEINIT )
 
 /* II. MUTEXES */
 
+/* queue of notified events, in MT HVM it can be modified only
+   when both mutex and HVM are locked */
+typedef struct
+{
+   PHB_ITEM    pItems;              /* ring buffer with events */
+   HB_SIZE     nSize;               /* ring buffer size (power of 2) */
+   HB_SIZE     nFirst;              /* index of the oldest event */
+   HB_SIZE     nCount;              /* number of queued events */
+}
+HB_MUTEX_EVENTS, * PHB_MUTEX_EVENTS;
+
+#define HB_MUTEX_EVENTS_INIT  16
+#define HB_MUTEX_EVENTS_KEEP  1024  /* maximum size of kept empty buffer */
+
 typedef struct _HB_MUTEX
 {
    int                lock_count;
    int                lockers;
    int                waiters;
+   int                producers;
    int                syncsignals;
-   PHB_ITEM           events;
+   HB_MUTEX_EVENTS    events;
+   HB_SIZE            nLimit;      /* maximum number of queued events or 0 */
    HB_THREAD_ID       owner;
    HB_RAWCRITICAL_T   mutex;
    HB_RAWCOND_T       cond_l;
    HB_RAWCOND_T       cond_w;
+   HB_RAWCOND_T       cond_f;
    struct _HB_MUTEX * pNext;
    struct _HB_MUTEX * pPrev;
 }
@@ -1728,6 +1766,71 @@ static void hb_mutexUnlink( PHB_MUTEX * pList, PHB_MUTEX pItem )
    }
 }
 
+static void hb_mutexEventPush( PHB_MUTEX_EVENTS pEvents, PHB_ITEM pValue )
+{
+   PHB_ITEM pItem;
+
+   if( pEvents->nCount == pEvents->nSize )
+   {
+      HB_SIZE nSize = pEvents->nSize ? pEvents->nSize << 1 : HB_MUTEX_EVENTS_INIT;
+      PHB_ITEM pItems = ( PHB_ITEM ) hb_xgrab( nSize * sizeof( HB_ITEM ) );
+
+      if( pEvents->nCount )
+      {
+         HB_SIZE nTail = pEvents->nSize - pEvents->nFirst;
+
+         memcpy( pItems, pEvents->pItems + pEvents->nFirst,
+                 nTail * sizeof( HB_ITEM ) );
+         memcpy( pItems + nTail, pEvents->pItems,
+                 pEvents->nFirst * sizeof( HB_ITEM ) );
+      }
+      if( pEvents->pItems )
+         hb_xfree( pEvents->pItems );
+      pEvents->pItems = pItems;
+      pEvents->nSize = nSize;
+      pEvents->nFirst = 0;
+   }
+
+   pItem = pEvents->pItems + ( ( pEvents->nFirst + pEvents->nCount ) &
+                               ( pEvents->nSize - 1 ) );
+   pItem->type = HB_IT_NIL;
+   if( pValue )
+      hb_itemCopy( pItem, pValue );
+   pEvents->nCount++;
+}
+
+static void hb_mutexEventPop( PHB_MUTEX_EVENTS pEvents, PHB_ITEM pDest )
+{
+   hb_itemMove( pDest, pEvents->pItems + pEvents->nFirst );
+   pEvents->nFirst = ( pEvents->nFirst + 1 ) & ( pEvents->nSize - 1 );
+   if( --pEvents->nCount == 0 )
+   {
+      pEvents->nFirst = 0;
+      if( pEvents->nSize > HB_MUTEX_EVENTS_KEEP )
+      {
+         hb_xfree( pEvents->pItems );
+         pEvents->pItems = NULL;
+         pEvents->nSize = 0;
+      }
+   }
+}
+
+static void hb_mutexEventFree( PHB_MUTEX_EVENTS pEvents )
+{
+   if( pEvents->pItems )
+   {
+      while( pEvents->nCount )
+      {
+         hb_itemClear( pEvents->pItems + pEvents->nFirst );
+         pEvents->nFirst = ( pEvents->nFirst + 1 ) & ( pEvents->nSize - 1 );
+         pEvents->nCount--;
+      }
+      hb_xfree( pEvents->pItems );
+      pEvents->pItems = NULL;
+   }
+   pEvents->nSize = pEvents->nFirst = 0;
+}
+
 #if defined( HB_MT_VM )
 void hb_threadMutexUnlockAll( void )
 {
@@ -1764,11 +1867,13 @@ void hb_threadMutexUnsubscribeAll( void )
       PHB_MUTEX pMutex = s_pMutexList;
       do
       {
-         if( pMutex->waiters )
+         if( pMutex->waiters || pMutex->producers )
          {
             HB_CRITICAL_LOCK( pMutex->mutex );
             if( pMutex->waiters )
                HB_COND_SIGNALN( pMutex->cond_w, pMutex->waiters );
+            if( pMutex->producers )
+               HB_COND_SIGNALN( pMutex->cond_f, pMutex->producers );
             HB_CRITICAL_UNLOCK( pMutex->mutex );
          }
          pMutex = pMutex->pNext;
@@ -1791,11 +1896,7 @@ static HB_GARBAGE_FUNC( hb_mutexDestructor )
    hb_mutexUnlink( &s_pMutexList, pMutex );
 #endif
 
-   if( pMutex->events )
-   {
-      hb_itemRelease( pMutex->events );
-      pMutex->events = NULL;
-   }
+   hb_mutexEventFree( &pMutex->events );
 
 #if ! defined( HB_MT_VM )
    /* nothing */
@@ -1804,6 +1905,7 @@ static HB_GARBAGE_FUNC( hb_mutexDestructor )
 #  if ! defined( HB_COND_HARBOUR_SUPPORT )
    HB_COND_DESTROY( pMutex->cond_l );
    HB_COND_DESTROY( pMutex->cond_w );
+   HB_COND_DESTROY( pMutex->cond_f );
 #  endif
 #endif
 }
@@ -1811,9 +1913,13 @@ static HB_GARBAGE_FUNC( hb_mutexDestructor )
 static HB_GARBAGE_FUNC( hb_mutexMark )
 {
    PHB_MUTEX pMutex = ( PHB_MUTEX ) Cargo;
+   HB_SIZE nCount = pMutex->events.nCount, nPos = pMutex->events.nFirst;
 
-   if( pMutex->events )
-      hb_gcMark( pMutex->events );
+   while( nCount-- )
+   {
+      hb_gcItemRef( pMutex->events.pItems + nPos );
+      nPos = ( nPos + 1 ) & ( pMutex->events.nSize - 1 );
+   }
 }
 
 static const HB_GC_FUNCS s_gcMutexFuncs =
@@ -1855,6 +1961,7 @@ PHB_ITEM hb_threadMutexCreate( void )
 #  if ! defined( HB_COND_HARBOUR_SUPPORT )
    HB_COND_INIT( pMutex->cond_l );
    HB_COND_INIT( pMutex->cond_w );
+   HB_COND_INIT( pMutex->cond_f );
 #  endif
 #endif
 
@@ -2202,133 +2309,206 @@ HB_BOOL hb_threadMutexTimedLock( PHB_ITEM pItem, HB_ULONG ulMilliSec )
 }
 
 #if defined( HB_MT_VM )
-static void hb_thredMutexEventInit( PHB_MUTEX pMutex )
+/* wait until there is free place in the event queue with size limit,
+   mutex have to be locked */
+static void hb_mutexWaitQueue( PHB_MUTEX pMutex, HB_ULONG ulMilliSec )
 {
-   PHB_ITEM pEvents;
-
-   HB_CRITICAL_UNLOCK( pMutex->mutex );
-   hb_vmLock();
-   pEvents = hb_itemArrayNew( 0 );
-   hb_vmUnlock();
-   HB_CRITICAL_LOCK( pMutex->mutex );
-   if( pMutex->events == NULL )
+   pMutex->producers++;
+   if( ulMilliSec == HB_THREAD_INFINITE_WAIT )
    {
-      hb_vmLockForce();
-      pMutex->events = pEvents;
-      hb_gcUnlock( pMutex->events );
-      hb_vmUnlock();
+      while( pMutex->nLimit && pMutex->events.nCount >= pMutex->nLimit &&
+             hb_vmRequestQuery() == 0 )
+      {
+#  if defined( HB_PTHREAD_API )
+         pthread_cond_wait( &pMutex->cond_f, &pMutex->mutex );
+#  elif defined( HB_TASK_THREAD )
+         hb_taskWait( &pMutex->cond_f, &pMutex->mutex, HB_TASK_INFINITE_WAIT );
+#  elif defined( HB_COND_HARBOUR_SUPPORT )
+         _hb_thread_cond_wait( &pMutex->cond_f, &pMutex->mutex, HB_THREAD_INFINITE_WAIT );
+#  else
+         HB_CRITICAL_UNLOCK( pMutex->mutex );
+         ( void ) HB_COND_WAIT( pMutex->cond_f );
+         HB_CRITICAL_LOCK( pMutex->mutex );
+#  endif
+      }
    }
    else
    {
-      HB_CRITICAL_UNLOCK( pMutex->mutex );
-      hb_vmLock();
-      hb_itemRelease( pEvents );
-      hb_vmUnlock();
-      HB_CRITICAL_LOCK( pMutex->mutex );
+#  if defined( HB_PTHREAD_API )
+      struct timespec ts;
+
+      hb_threadTimeInit( &ts, ulMilliSec );
+      while( pMutex->nLimit && pMutex->events.nCount >= pMutex->nLimit &&
+             hb_vmRequestQuery() == 0 )
+      {
+         if( pthread_cond_timedwait( &pMutex->cond_f, &pMutex->mutex, &ts ) != 0 )
+            break;
+      }
+#  else
+      HB_MAXUINT timer = hb_timerGet() + ulMilliSec;
+
+      /* wake up can be spurious or other producer may fill the queue
+         before us so check the condition again and wait for the rest
+         of timeout */
+      while( pMutex->nLimit && pMutex->events.nCount >= pMutex->nLimit &&
+             hb_vmRequestQuery() == 0 )
+      {
+         HB_MAXUINT curr;
+
+#     if defined( HB_TASK_THREAD )
+         hb_taskWait( &pMutex->cond_f, &pMutex->mutex, ulMilliSec );
+#     elif defined( HB_COND_HARBOUR_SUPPORT )
+         _hb_thread_cond_wait( &pMutex->cond_f, &pMutex->mutex, ulMilliSec );
+#     else
+         HB_CRITICAL_UNLOCK( pMutex->mutex );
+         ( void ) HB_COND_TIMEDWAIT( pMutex->cond_f, ulMilliSec );
+         HB_CRITICAL_LOCK( pMutex->mutex );
+#     endif
+         curr = hb_timerGet();
+         if( timer <= curr )
+            break;
+         ulMilliSec = ( HB_ULONG ) ( timer - curr );
+      }
+#  endif
+   }
+   pMutex->producers--;
+}
+
+/* wake up producers waiting for free place in the event queue */
+static void hb_mutexWakeProducers( PHB_MUTEX pMutex )
+{
+   if( pMutex->producers && pMutex->events.nCount < pMutex->nLimit )
+   {
+      HB_SIZE nFree = pMutex->nLimit - pMutex->events.nCount;
+
+      if( nFree == 1 || pMutex->producers == 1 )
+         HB_COND_SIGNAL( pMutex->cond_f );
+      else
+         HB_COND_SIGNALN( pMutex->cond_f, ( int ) HB_MIN( nFree, ( HB_SIZE ) pMutex->producers ) );
    }
 }
+
+/* remove queued events releasing them outside mutex lock */
+static void hb_mutexEventClear( PHB_MUTEX pMutex )
+{
+   HB_MUTEX_EVENTS events;
+
+   hb_vmLockForce();
+   events = pMutex->events;
+   memset( &pMutex->events, 0, sizeof( pMutex->events ) );
+   if( pMutex->producers && pMutex->nLimit )
+      HB_COND_SIGNALN( pMutex->cond_f, pMutex->producers );
+   HB_CRITICAL_UNLOCK( pMutex->mutex );
+   hb_mutexEventFree( &events );
+   hb_vmUnlock();
+   HB_CRITICAL_LOCK( pMutex->mutex );
+}
 #endif
 
-void hb_threadMutexNotify( PHB_ITEM pItem, PHB_ITEM pNotifier, HB_BOOL fWaiting )
+static HB_BOOL hb_mutexNotify( PHB_MUTEX pMutex, PHB_ITEM pNotifier,
+                               HB_BOOL fWaiting, HB_ULONG ulMilliSec )
 {
-   PHB_MUTEX pMutex = hb_mutexPtr( pItem );
+   HB_BOOL fResult = HB_FALSE;
 
-   if( pMutex )
-   {
 #if ! defined( HB_MT_VM )
-      if( ! fWaiting )
+   HB_SYMBOL_UNUSED( ulMilliSec );
+
+   if( ! fWaiting )
+   {
+      if( ! pMutex->nLimit || pMutex->events.nCount < pMutex->nLimit )
       {
-         if( ! pMutex->events )
-         {
-            pMutex->events = hb_itemArrayNew( 1 );
-            hb_gcUnlock( pMutex->events );
-            if( pNotifier && ! HB_IS_NIL( pNotifier ) )
-               hb_arraySet( pMutex->events, 1, pNotifier );
-         }
-         else if( pNotifier )
-            hb_arrayAdd( pMutex->events, pNotifier );
-         else
-            hb_arraySize( pMutex->events, hb_arrayLen( pMutex->events ) + 1 );
+         hb_mutexEventPush( &pMutex->events, pNotifier );
+         fResult = HB_TRUE;
+      }
+   }
+   else if( pMutex->waiters )
+   {
+      int iCount = pMutex->waiters - ( int ) pMutex->events.nCount;
+
+      while( iCount-- > 0 )
+         hb_mutexEventPush( &pMutex->events, pNotifier );
+      fResult = HB_TRUE;
+   }
+#else
+   hb_vmUnlock();
+   HB_CRITICAL_LOCK( pMutex->mutex );
+
+   if( ! fWaiting )
+   {
+      if( pMutex->nLimit && pMutex->events.nCount >= pMutex->nLimit && ulMilliSec )
+         hb_mutexWaitQueue( pMutex, ulMilliSec );
+
+      if( ! pMutex->nLimit || pMutex->events.nCount < pMutex->nLimit )
+      {
+         hb_vmLockForce();
+         hb_mutexEventPush( &pMutex->events, pNotifier );
+         hb_vmUnlock();
+         if( pMutex->waiters )
+            HB_COND_SIGNAL( pMutex->cond_w );
+         fResult = HB_TRUE;
       }
-      else if( pMutex->waiters )
+   }
+   else if( pMutex->waiters )
+   {
+      int iCount = pMutex->waiters - ( int ) pMutex->events.nCount;
+
+      if( iCount > 0 )
       {
-         int iCount = pMutex->waiters;
-         HB_ULONG ulLen;
+         int iSet = iCount;
 
-         if( pMutex->events )
+         hb_vmLockForce();
+         do
          {
-            ulLen = ( HB_ULONG ) hb_arrayLen( pMutex->events );
-            iCount -= ulLen;
-            if( iCount > 0 )
-               hb_arraySize( pMutex->events, ulLen + iCount );
+            hb_mutexEventPush( &pMutex->events, pNotifier );
          }
+         while( --iSet );
+         hb_vmUnlock();
+         if( iCount == 1 )
+            HB_COND_SIGNAL( pMutex->cond_w );
          else
-         {
-            ulLen = 0;
-            pMutex->events = hb_itemArrayNew( iCount );
-            hb_gcUnlock( pMutex->events );
-         }
-         if( iCount > 0 )
-         {
-            if( pNotifier && ! HB_IS_NIL( pNotifier ) )
-            {
-               int iSet = iCount;
-               do
-               {
-                  hb_arraySet( pMutex->events, ++ulLen, pNotifier );
-               }
-               while( --iSet );
-            }
-         }
+            HB_COND_SIGNALN( pMutex->cond_w, iCount );
       }
-#else
-      hb_vmUnlock();
-      HB_CRITICAL_LOCK( pMutex->mutex );
+      fResult = HB_TRUE;
+   }
+   HB_CRITICAL_UNLOCK( pMutex->mutex );
+   hb_vmLock();
+#endif
 
-      if( ! fWaiting || pMutex->waiters )
-      {
-         if( ! pMutex->events )
-            hb_thredMutexEventInit( pMutex );
+   return fResult;
+}
 
-         if( ! fWaiting )
-         {
-            hb_vmLockForce();
-            if( pNotifier )
-               hb_arrayAdd( pMutex->events, pNotifier );
-            else
-               hb_arraySize( pMutex->events, hb_arrayLen( pMutex->events ) + 1 );
-            hb_vmUnlock();
-            if( pMutex->waiters )
-               HB_COND_SIGNAL( pMutex->cond_w );
-         }
-         else if( pMutex->waiters )
-         {
-            int iLen = ( int ) hb_arrayLen( pMutex->events );
-            int iCount = pMutex->waiters - iLen;
+void hb_threadMutexNotify( PHB_ITEM pItem, PHB_ITEM pNotifier, HB_BOOL fWaiting )
+{
+   PHB_MUTEX pMutex = hb_mutexPtr( pItem );
 
-            if( iCount > 0 )
-            {
-               hb_vmLockForce();
-               hb_arraySize( pMutex->events, iLen + iCount );
-               if( pNotifier && ! HB_IS_NIL( pNotifier ) )
-               {
-                  int iSet = iCount;
-                  do
-                  {
-                     hb_arraySet( pMutex->events, ++iLen, pNotifier );
-                  }
-                  while( --iSet );
-               }
-               hb_vmUnlock();
-               if( iCount == 1 )
-                  HB_COND_SIGNAL( pMutex->cond_w );
-               else
-                  HB_COND_SIGNALN( pMutex->cond_w, iCount );
-            }
-         }
-      }
-      HB_CRITICAL_UNLOCK( pMutex->mutex );
-      hb_vmLock();
+   if( pMutex )
+      hb_mutexNotify( pMutex, pNotifier, fWaiting, HB_THREAD_INFINITE_WAIT );
+}
+
+HB_BOOL hb_threadMutexTimedNotify( PHB_ITEM pItem, PHB_ITEM pNotifier, HB_ULONG ulMilliSec )
+{
+   PHB_MUTEX pMutex = hb_mutexPtr( pItem );
+
+   return pMutex && hb_mutexNotify( pMutex, pNotifier, HB_FALSE, ulMilliSec );
+}
+
+/* move up to nMax events to pArray, pArray has to be on HVM stack
+   in MT mode and mutex have to be locked */
+static void hb_mutexEventPopArray( PHB_MUTEX pMutex, PHB_ITEM pArray, HB_SIZE nMax )
+{
+   if( pMutex->events.nCount > 0 && nMax > 0 )
+   {
+      HB_SIZE nLen = hb_arrayLen( pArray ), nCount = HB_MIN( nMax, pMutex->events.nCount );
+
+#if defined( HB_MT_VM )
+      hb_vmLockForce();
+#endif
+      hb_arraySize( pArray, nLen + nCount );
+      while( nCount-- )
+         hb_mutexEventPop( &pMutex->events, hb_arrayGetItemPtr( pArray, ++nLen ) );
+#if defined( HB_MT_VM )
+      hb_vmUnlock();
+      hb_mutexWakeProducers( pMutex );
 #endif
    }
 }
@@ -2341,16 +2521,14 @@ PHB_ITEM hb_threadMutexSubscribe( PHB_ITEM pItem, HB_BOOL fClear )
    if( pMutex )
    {
 #if ! defined( HB_MT_VM )
-      if( pMutex->events && hb_arrayLen( pMutex->events ) > 0 )
+      if( pMutex->events.nCount > 0 )
       {
-         if( fClear && pMutex->events )
-            hb_arraySize( pMutex->events, 0 );
+         if( fClear )
+            hb_mutexEventFree( &pMutex->events );
          else
          {
             pResult = hb_itemNew( NULL );
-            hb_arrayGet( pMutex->events, 1, pResult );
-            hb_arrayDel( pMutex->events, 1 );
-            hb_arraySize( pMutex->events, hb_arrayLen( pMutex->events ) - 1 );
+            hb_mutexEventPop( &pMutex->events, pResult );
          }
       }
 #else
@@ -2360,16 +2538,8 @@ PHB_ITEM hb_threadMutexSubscribe( PHB_ITEM pItem, HB_BOOL fClear )
       hb_vmUnlock();
       HB_CRITICAL_LOCK( pMutex->mutex );
 
-      if( fClear && pMutex->events )
-      {
-         hb_vmLockForce();
-         hb_itemMove( hb_stackAllocItem(), pMutex->events );
-         pMutex->events = NULL;
-         HB_CRITICAL_UNLOCK( pMutex->mutex );
-         hb_stackPop();
-         hb_vmUnlock();
-         HB_CRITICAL_LOCK( pMutex->mutex );
-      }
+      if( fClear && pMutex->events.nCount > 0 )
+         hb_mutexEventClear( pMutex );
 
       /* release own lock from this mutex */
       if( HB_THREAD_EQUAL( pMutex->owner, HB_THREAD_SELF() ) )
@@ -2381,8 +2551,7 @@ PHB_ITEM hb_threadMutexSubscribe( PHB_ITEM pItem, HB_BOOL fClear )
             HB_COND_SIGNAL( pMutex->cond_l );
       }
 
-      while( ( ! pMutex->events || hb_arrayLen( pMutex->events ) == 0 ) &&
-             hb_vmRequestQuery() == 0 )
+      while( pMutex->events.nCount == 0 && hb_vmRequestQuery() == 0 )
       {
          pMutex->waiters++;
 #  if defined( HB_PTHREAD_API )
@@ -2399,14 +2568,13 @@ PHB_ITEM hb_threadMutexSubscribe( PHB_ITEM pItem, HB_BOOL fClear )
          pMutex->waiters--;
       }
 
-      if( pMutex->events && hb_arrayLen( pMutex->events ) > 0 )
+      if( pMutex->events.nCount > 0 )
       {
          hb_vmLockForce();
          pResult = hb_stackAllocItem();
-         hb_arrayGet( pMutex->events, 1, pResult );
-         hb_arrayDel( pMutex->events, 1 );
-         hb_arraySize( pMutex->events, hb_arrayLen( pMutex->events ) - 1 );
+         hb_mutexEventPop( &pMutex->events, pResult );
          hb_vmUnlock();
+         hb_mutexWakeProducers( pMutex );
       }
 
       /* restore the own lock on this mutex if necessary */
@@ -2458,16 +2626,14 @@ PHB_ITEM hb_threadMutexTimedSubscribe( PHB_ITEM pItem, HB_ULONG ulMilliSec, HB_B
 #if ! defined( HB_MT_VM )
       HB_SYMBOL_UNUSED( ulMilliSec );
 
-      if( pMutex->events && hb_arrayLen( pMutex->events ) > 0 )
+      if( pMutex->events.nCount > 0 )
       {
-         if( fClear && pMutex->events )
-            hb_arraySize( pMutex->events, 0 );
+         if( fClear )
+            hb_mutexEventFree( &pMutex->events );
          else
          {
             pResult = hb_itemNew( NULL );
-            hb_arrayGet( pMutex->events, 1, pResult );
-            hb_arrayDel( pMutex->events, 1 );
-            hb_arraySize( pMutex->events, hb_arrayLen( pMutex->events ) - 1 );
+            hb_mutexEventPop( &pMutex->events, pResult );
          }
       }
 #else
@@ -2477,18 +2643,10 @@ PHB_ITEM hb_threadMutexTimedSubscribe( PHB_ITEM pItem, HB_ULONG ulMilliSec, HB_B
       hb_vmUnlock();
       HB_CRITICAL_LOCK( pMutex->mutex );
 
-      if( fClear && pMutex->events )
-      {
-         hb_vmLockForce();
-         hb_itemMove( hb_stackAllocItem(), pMutex->events );
-         pMutex->events = NULL;
-         HB_CRITICAL_UNLOCK( pMutex->mutex );
-         hb_stackPop();
-         hb_vmUnlock();
-         HB_CRITICAL_LOCK( pMutex->mutex );
-      }
+      if( fClear && pMutex->events.nCount > 0 )
+         hb_mutexEventClear( pMutex );
 
-      if( ulMilliSec && ! ( pMutex->events && hb_arrayLen( pMutex->events ) > 0 ) )
+      if( ulMilliSec && pMutex->events.nCount == 0 )
       {
          /* release own lock from this mutex */
          if( HB_THREAD_EQUAL( pMutex->owner, HB_THREAD_SELF() ) )
@@ -2506,8 +2664,7 @@ PHB_ITEM hb_threadMutexTimedSubscribe( PHB_ITEM pItem, HB_ULONG ulMilliSec, HB_B
             struct timespec ts;
 
             hb_threadTimeInit( &ts, ulMilliSec );
-            while( ( ! pMutex->events || hb_arrayLen( pMutex->events ) == 0 ) &&
-                   hb_vmRequestQuery() == 0 )
+            while( pMutex->events.nCount == 0 && hb_vmRequestQuery() == 0 )
             {
                if( pthread_cond_timedwait( &pMutex->cond_w, &pMutex->mutex, &ts ) != 0 )
                   break;
@@ -2533,14 +2690,13 @@ PHB_ITEM hb_threadMutexTimedSubscribe( PHB_ITEM pItem, HB_ULONG ulMilliSec, HB_B
          pMutex->waiters--;
       }
 
-      if( pMutex->events && hb_arrayLen( pMutex->events ) > 0 )
+      if( pMutex->events.nCount > 0 )
       {
          hb_vmLockForce();
          pResult = hb_stackAllocItem();
-         hb_arrayGet( pMutex->events, 1, pResult );
-         hb_arrayDel( pMutex->events, 1 );
-         hb_arraySize( pMutex->events, hb_arrayLen( pMutex->events ) - 1 );
+         hb_mutexEventPop( &pMutex->events, pResult );
          hb_vmUnlock();
+         hb_mutexWakeProducers( pMutex );
       }
 
       /* restore the own lock on this mutex if necessary */
@@ -2582,6 +2738,25 @@ PHB_ITEM hb_threadMutexTimedSubscribe( PHB_ITEM pItem, HB_ULONG ulMilliSec, HB_B
    return pResult;
 }
 
+/* move up to nMax next queued events to pArray */
+static void hb_threadMutexPopArray( PHB_ITEM pItem, PHB_ITEM pArray, HB_SIZE nMax )
+{
+   PHB_MUTEX pMutex = hb_mutexPtr( pItem );
+
+   if( pMutex )
+   {
+#if defined( HB_MT_VM )
+      hb_vmUnlock();
+      HB_CRITICAL_LOCK( pMutex->mutex );
+#endif
+      hb_mutexEventPopArray( pMutex, pArray, nMax );
+#if defined( HB_MT_VM )
+      HB_CRITICAL_UNLOCK( pMutex->mutex );
+      hb_vmLock();
+#endif
+   }
+}
+
 HB_FUNC( HB_MUTEXEXISTS )
 {
    HB_STACK_TLS_PRELOAD
@@ -2629,7 +2804,18 @@ HB_FUNC( HB_MUTEXNOTIFY )
    PHB_ITEM pItem = hb_mutexParam( 1 );
 
    if( pItem )
-      hb_threadMutexNotify( pItem, hb_param( 2, HB_IT_ANY ), HB_FALSE );
+   {
+      HB_STACK_TLS_PRELOAD
+      HB_ULONG ulMilliSec = HB_THREAD_INFINITE_WAIT;
+
+      /* timeout is used only when the queue size is limited */
+      if( HB_ISNUM( 3 ) )
+      {
+         double dTimeOut = hb_parnd( 3 );
+         ulMilliSec = dTimeOut > 0 ? ( HB_ULONG ) ( dTimeOut * 1000 ) : 0;
+      }
+      hb_retl( hb_threadMutexTimedNotify( pItem, hb_param( 2, HB_IT_ANY ), ulMilliSec ) );
+   }
 }
 
 HB_FUNC( HB_MUTEXNOTIFYALL )
@@ -2702,35 +2888,39 @@ HB_FUNC( HB_MUTEXSUBSCRIBENOW )
    }
 }
 
-HB_FUNC( HB_MUTEXEVAL )
+HB_FUNC( HB_MUTEXSUBSCRIBEBATCH )
 {
    PHB_ITEM pItem = hb_mutexParam( 1 );
 
    if( pItem )
    {
-      PHB_ITEM pEval = hb_param( 2, HB_IT_EVALITEM );
+      HB_STACK_TLS_PRELOAD
+      PHB_ITEM pResult, pArray = hb_stackReturnItem();
+      HB_SIZE nMax = hb_parns( 3 );
 
-      if( pEval )
+      hb_arrayNew( pArray, 0 );
+      if( HB_ISNUM( 2 ) )
       {
-         HB_STACK_TLS_PRELOAD
-         int iPCount = hb_pcount(), iParam;
-
-         if( hb_threadMutexLock( pItem ) )
-         {
-            hb_vmPushEvalSym();
-            hb_vmPush( pEval );
-            for( iParam = 3; iParam <= iPCount; iParam++ )
-               hb_vmPush( hb_stackItemFromBase( iParam ) );
-            hb_vmSend( ( HB_USHORT ) ( iPCount - 2 ) );
-            hb_threadMutexUnlock( pItem );
-         }
+         HB_ULONG ulMilliSec = 0;
+         double dTimeOut = hb_parnd( 2 );
+         if( dTimeOut > 0 )
+            ulMilliSec = ( HB_ULONG ) ( dTimeOut * 1000 );
+         pResult = hb_threadMutexTimedSubscribe( pItem, ulMilliSec, HB_FALSE );
       }
       else
-         hb_errRT_BASE_SubstR( EG_ARG, 3012, NULL, HB_ERR_FUNCNAME, HB_ERR_ARGS_BASEPARAMS );
+         pResult = hb_threadMutexSubscribe( pItem, HB_FALSE );
+
+      if( pResult )
+      {
+         hb_arrayAddForward( pArray, pResult );
+         hb_itemRelease( pResult );
+         if( nMax != 1 )
+            hb_threadMutexPopArray( pItem, pArray, nMax > 1 ? nMax - 1 : HB_SIZE_MAX );
+      }
    }
 }
 
-HB_FUNC( HB_MUTEXQUEUEINFO )
+HB_FUNC( HB_MUTEXQUEUELIMIT )
 {
    PHB_ITEM pItem = hb_mutexParam( 1 );
 
@@ -2741,11 +2931,1014 @@ HB_FUNC( HB_MUTEXQUEUEINFO )
       if( pMutex )
       {
          HB_STACK_TLS_PRELOAD
-         hb_storni( pMutex->waiters, 2 );
-         hb_storns( pMutex->events ? hb_arrayLen( pMutex->events ) : 0, 3 );
-         hb_retl( HB_TRUE );
-      }
-   }
+
+         hb_retns( pMutex->nLimit );
+         if( HB_ISNUM( 2 ) )
+         {
+            HB_ISIZ nLimit = hb_parns( 2 );
+
+#if defined( HB_MT_VM )
+            hb_vmUnlock();
+            HB_CRITICAL_LOCK( pMutex->mutex );
+#endif
+            pMutex->nLimit = nLimit > 0 ? ( HB_SIZE ) nLimit : 0;
+#if defined( HB_MT_VM )
+            if( pMutex->producers )
+               HB_COND_SIGNALN( pMutex->cond_f, pMutex->producers );
+            HB_CRITICAL_UNLOCK( pMutex->mutex );
+            hb_vmLock();
+#endif
+         }
+      }
+   }
+}
+
+HB_FUNC( HB_MUTEXEVAL )
+{
+   PHB_ITEM pItem = hb_mutexParam( 1 );
+
+   if( pItem )
+   {
+      PHB_ITEM pEval = hb_param( 2, HB_IT_EVALITEM );
+
+      if( pEval )
+      {
+         HB_STACK_TLS_PRELOAD
+         int iPCount = hb_pcount(), iParam;
+
+         if( hb_threadMutexLock( pItem ) )
+         {
+            hb_vmPushEvalSym();
+            hb_vmPush( pEval );
+            for( iParam = 3; iParam <= iPCount; iParam++ )
+               hb_vmPush( hb_stackItemFromBase( iParam ) );
+            hb_vmSend( ( HB_USHORT ) ( iPCount - 2 ) );
+            hb_threadMutexUnlock( pItem );
+         }
+      }
+      else
+         hb_errRT_BASE_SubstR( EG_ARG, 3012, NULL, HB_ERR_FUNCNAME, HB_ERR_ARGS_BASEPARAMS );
+   }
+}
+
+HB_FUNC( HB_MUTEXQUEUEINFO )
+{
+   PHB_ITEM pItem = hb_mutexParam( 1 );
+
+   if( pItem )
+   {
+      PHB_MUTEX pMutex = hb_mutexPtr( pItem );
+
+      if( pMutex )
+      {
+         HB_STACK_TLS_PRELOAD
+         hb_storni( pMutex->waiters, 2 );
+         hb_storns( pMutex->events.nCount, 3 );
+         hb_storns( pMutex->nLimit, 4 );
+         hb_retl( HB_TRUE );
+      }
+   }
+}
+
+/* III. THREAD POOLS */
+
+/* Thread pool keeps started HVM threads which execute submitted tasks.
+ * Tasks submitted by pool threads are added to the submitting thread
+ * queue and executed by it in LIFO order, tasks submitted by other
+ * threads are added to shared FIFO queue. Idle pool threads steal
+ * the oldest tasks from queues of other pool threads. Pool thread
+ * waiting for a future which is still pending in the same pool
+ * executes the task itself so nested tasks cannot block all pool
+ * threads. Pool and task structures are protected by s_pool_mtx,
+ * HVM items are created and released only when HVM is locked and
+ * s_pool_mtx is unlocked.
+ */
+
+#ifndef HB_THPOOL_DEFAULT_THREADS
+#  define HB_THPOOL_DEFAULT_THREADS    4
+#endif
+
+#if defined( HB_MT_VM )
+#  define HB_POOL_LOCK()      HB_CRITICAL_LOCK( s_pool_mtx )
+#  define HB_POOL_UNLOCK()    HB_CRITICAL_UNLOCK( s_pool_mtx )
+#else
+#  define HB_POOL_LOCK()      do {} while( 0 )
+#  define HB_POOL_UNLOCK()    do {} while( 0 )
+#endif
+
+typedef struct _HB_POOLTASK
+{
+   struct _HB_POOLTASK *   pNext;
+   struct _HB_POOLTASK *   pPrev;
+   struct _HB_POOLQUEUE *  pQueue;     /* queue with pending task */
+   struct _HB_THPOOL *     pPool;      /* NULL for finished tasks */
+   PHB_ITEM                pParams;    /* { <xStart>, <params,...> } */
+   PHB_ITEM                pResult;    /* return or BREAK value */
+   int                     iState;
+   int                     iRefs;      /* future handle and task queue */
+   HB_BOOL                 fCancel;
+   HB_BOOL                 fQuit;      /* QUIT executed by the task */
+}
+HB_POOLTASK, * PHB_POOLTASK;
+
+typedef struct _HB_POOLQUEUE
+{
+   PHB_POOLTASK   pFirst;
+   PHB_POOLTASK   pLast;
+}
+HB_POOLQUEUE, * PHB_POOLQUEUE;
+
+typedef struct
+{
+   struct _HB_THPOOL *  pPool;
+   void *               pStackId;      /* HVM stack of running thread */
+   PHB_POOLTASK         pTask;         /* currently executed task */
+   HB_POOLQUEUE         queue;         /* tasks submitted by this thread */
+}
+HB_POOLWORKER, * PHB_POOLWORKER;
+
+typedef struct _HB_THPOOL
+{
+   HB_POOLQUEUE         queue;         /* tasks submitted by other threads */
+   PHB_POOLWORKER       pWorkers;
+   int                  iWorkers;      /* number of started threads */
+   int                  iRunning;      /* number of running threads */
+   int                  iIdle;         /* threads waiting for new tasks */
+   int                  iSteal;        /* next thread to steal task from */
+   int                  iRefs;         /* pool handle and running threads */
+   HB_SIZE              nQueued;
+   HB_BOOL              fClosed;
+   HB_RAWCOND_T         cond;          /* new task or pool closed */
+   struct _HB_THPOOL *  pNext;
+   struct _HB_THPOOL *  pPrev;
+}
+HB_THPOOL, * PHB_THPOOL;
+
+static PHB_THPOOL s_pPoolList = NULL;
+
+static void hb_poolQueueAdd( PHB_POOLQUEUE pQueue, PHB_POOLTASK pTask )
+{
+   pTask->pQueue = pQueue;
+   pTask->pNext = NULL;
+   pTask->pPrev = pQueue->pLast;
+   if( pQueue->pLast )
+      pQueue->pLast->pNext = pTask;
+   else
+      pQueue->pFirst = pTask;
+   pQueue->pLast = pTask;
+   pTask->pPool->nQueued++;
+}
+
+static void hb_poolQueueDel( PHB_POOLTASK pTask )
+{
+   PHB_POOLQUEUE pQueue = pTask->pQueue;
+
+   if( pTask->pPrev )
+      pTask->pPrev->pNext = pTask->pNext;
+   else
+      pQueue->pFirst = pTask->pNext;
+   if( pTask->pNext )
+      pTask->pNext->pPrev = pTask->pPrev;
+   else
+      pQueue->pLast = pTask->pPrev;
+   pTask->pNext = pTask->pPrev = NULL;
+   pTask->pQueue = NULL;
+   pTask->pPool->nQueued--;
+}
+
+/* remove pending tasks from the queue, returns list of tasks to free */
+static PHB_POOLTASK hb_poolQueueCancel( PHB_POOLQUEUE pQueue, PHB_POOLTASK pFree )
+{
+   while( pQueue->pFirst )
+   {
+      PHB_POOLTASK pTask = pQueue->pFirst;
+
+      hb_poolQueueDel( pTask );
+      pTask->iState = HB_FUTURE_CANCELED;
+      pTask->pPool = NULL;
+      if( --pTask->iRefs == 0 )
+      {
+         pTask->pNext = pFree;
+         pFree = pTask;
+      }
+   }
+   return pFree;
+}
+
+static void hb_poolTaskFree( PHB_POOLTASK pTask )
+{
+   while( pTask )
+   {
+      PHB_POOLTASK pNext = pTask->pNext;
+
+      if( pTask->pParams )
+         hb_itemRelease( pTask->pParams );
+      if( pTask->pResult )
+         hb_itemRelease( pTask->pResult );
+      hb_xfree( pTask );
+      pTask = pNext;
+   }
+}
+
+static void hb_poolFree( PHB_THPOOL pPool )
+{
+#if defined( HB_MT_VM ) && ! defined( HB_COND_HARBOUR_SUPPORT )
+   HB_COND_DESTROY( pPool->cond );
+#endif
+   if( pPool->pWorkers )
+      hb_xfree( pPool->pWorkers );
+   hb_xfree( pPool );
+}
+
+/* release pool reference, s_pool_mtx have to be locked */
+static HB_BOOL hb_poolRelease( PHB_THPOOL pPool )
+{
+   if( --pPool->iRefs == 0 )
+   {
+      if( pPool->pNext )
+      {
+         pPool->pPrev->pNext = pPool->pNext;
+         pPool->pNext->pPrev = pPool->pPrev;
+         if( s_pPoolList == pPool )
+            s_pPoolList = pPool->pNext == pPool ? NULL : pPool->pNext;
+      }
+      return HB_TRUE;
+   }
+   return HB_FALSE;
+}
+
+/* find pool thread structure of current thread */
+static PHB_POOLWORKER hb_poolWorkerSelf( PHB_THPOOL pPool )
+{
+#if defined( HB_MT_VM )
+   if( pPool && pPool->iRunning )
+   {
+      void * pStackId = hb_stackId();
+      int i;
+
+      for( i = 0; i < pPool->iWorkers; ++i )
+      {
+         if( pPool->pWorkers[ i ].pStackId == pStackId )
+            return &pPool->pWorkers[ i ];
+      }
+   }
+#else
+   HB_SYMBOL_UNUSED( pPool );
+#endif
+   return NULL;
+}
+
+static void hb_poolSignalFinished( void )
+{
+#if defined( HB_MT_VM )
+   if( s_waiting_for_pool )
+   {
+      HB_COND_SIGNALN( s_pool_cond, s_waiting_for_pool );
+      s_waiting_for_pool = 0;
+   }
+#endif
+}
+
+#if defined( HB_MT_VM )
+/* wait for the condition, s_pool_mtx have to be locked and HVM unlocked,
+   returns HB_FALSE if the timeout already expired */
+static HB_BOOL hb_poolWait( HB_RAWCOND_T * cond, HB_MAXUINT timer )
+{
+   HB_ULONG ulMilliSec = HB_THREAD_INFINITE_WAIT;
+
+   if( timer )
+   {
+      HB_MAXUINT curr = hb_timerGet();
+
+      if( timer <= curr )
+         return HB_FALSE;
+      ulMilliSec = ( HB_ULONG ) ( timer - curr );
+   }
+
+#  if defined( HB_PTHREAD_API )
+   if( ulMilliSec == HB_THREAD_INFINITE_WAIT )
+      pthread_cond_wait( cond, &s_pool_mtx );
+   else
+   {
+      struct timespec ts;
+
+      hb_threadTimeInit( &ts, ulMilliSec );
+      pthread_cond_timedwait( cond, &s_pool_mtx, &ts );
+   }
+#  elif defined( HB_TASK_THREAD )
+   hb_taskWait( cond, &s_pool_mtx, ulMilliSec );
+#  elif defined( HB_COND_HARBOUR_SUPPORT )
+   _hb_thread_cond_wait( cond, &s_pool_mtx, ulMilliSec );
+#  else
+   HB_CRITICAL_UNLOCK( s_pool_mtx );
+   if( ulMilliSec == HB_THREAD_INFINITE_WAIT )
+      ( void ) HB_COND_WAIT( *cond );
+   else
+      ( void ) HB_COND_TIMEDWAIT( *cond, ulMilliSec );
+   HB_CRITICAL_LOCK( s_pool_mtx );
+#  endif
+   return HB_TRUE;
+}
+#endif
+
+#if defined( HB_MT_VM )
+/* next task for pool thread, s_pool_mtx have to be locked */
+static PHB_POOLTASK hb_poolTaskGet( PHB_THPOOL pPool, PHB_POOLWORKER pWorker )
+{
+   PHB_POOLTASK pTask = pWorker->queue.pLast;
+
+   if( ! pTask )
+      pTask = pPool->queue.pFirst;
+   if( ! pTask && pPool->nQueued )
+   {
+      int i;
+
+      for( i = 0; i < pPool->iWorkers && ! pTask; ++i )
+      {
+         pTask = pPool->pWorkers[ pPool->iSteal ].queue.pFirst;
+         if( ++pPool->iSteal == pPool->iWorkers )
+            pPool->iSteal = 0;
+      }
+   }
+   if( pTask )
+      hb_poolQueueDel( pTask );
+
+   return pTask;
+}
+#endif
+
+HB_FUNC_STATIC( THREADPOOLTASK );
+
+static HB_SYMB s_symPoolTask = { "HB_THREADPOOLTASK", { HB_FS_STATIC }, { HB_FUNCNAME( THREADPOOLTASK ) }, NULL };
+
+HB_FUNC_STATIC( THREADPOOLTASK )
+{
+   PHB_POOLTASK pTask = ( PHB_POOLTASK ) hb_parptr( 1 );
+   PHB_ITEM pStart = pTask ? hb_arrayGetItemPtr( pTask->pParams, 1 ) : NULL;
+
+   if( pStart )
+   {
+      HB_SIZE nPCount = hb_arrayLen( pTask->pParams ), nParam;
+      HB_BOOL fSend = HB_IS_BLOCK( pStart );
+
+      if( fSend )
+      {
+         hb_vmPushEvalSym();
+         hb_vmPush( pStart );
+      }
+      else
+      {
+         hb_vmPush( pStart );
+         hb_vmPushNil();
+      }
+      for( nParam = 2; nParam <= nPCount; ++nParam )
+         hb_vmPush( hb_arrayGetItemPtr( pTask->pParams, nParam ) );
+
+      if( fSend )
+         hb_vmSend( ( HB_USHORT ) ( nPCount - 1 ) );
+      else
+         hb_vmProc( ( HB_USHORT ) ( nPCount - 1 ) );
+
+      /* hb_vmTryEval() clears QUIT request */
+      pTask->fQuit = hb_vmRequestQuery() == HB_QUIT_REQUESTED;
+   }
+}
+
+/* execute the task, s_pool_mtx have to be locked and HVM unlocked */
+static void hb_poolTaskRun( PHB_POOLWORKER pWorker, PHB_POOLTASK pTask )
+{
+   PHB_POOLTASK pPrevTask = NULL;
+   HB_ITEM itmStart, itmTask;
+   HB_BOOL fResult;
+
+   pTask->iState = HB_FUTURE_RUNNING;
+   if( pWorker )
+   {
+      pPrevTask = pWorker->pTask;
+      pWorker->pTask = pTask;
+   }
+   HB_POOL_UNLOCK();
+   hb_vmLock();
+
+   itmStart.type = itmTask.type = HB_IT_NIL;
+   hb_itemPutSymbol( &itmStart, &s_symPoolTask );
+   hb_itemPutPtr( &itmTask, pTask );
+   fResult = hb_vmTryEval( &pTask->pResult, &itmStart, 1, &itmTask );
+   hb_itemRelease( pTask->pParams );
+   pTask->pParams = NULL;
+   if( pTask->fQuit )
+      hb_vmRequestQuit();
+
+   hb_vmUnlock();
+   HB_POOL_LOCK();
+   if( pWorker )
+      pWorker->pTask = pPrevTask;
+   pTask->iState = fResult ? HB_FUTURE_DONE : HB_FUTURE_FAILED;
+   pTask->pPool = NULL;
+   hb_poolSignalFinished();
+   if( --pTask->iRefs == 0 )
+   {
+      HB_POOL_UNLOCK();
+      hb_vmLock();
+      hb_poolTaskFree( pTask );
+      hb_vmUnlock();
+      HB_POOL_LOCK();
+   }
+}
+
+#if defined( HB_MT_VM )
+static HB_CARGO_FUNC( hb_poolWorkerThread )
+{
+   PHB_POOLWORKER pWorker = ( PHB_POOLWORKER ) cargo;
+   PHB_THPOOL pPool = pWorker->pPool;
+   PHB_POOLTASK pTask, pFree = NULL;
+   HB_BOOL fFree;
+
+   hb_vmUnlock();
+   HB_POOL_LOCK();
+   pWorker->pStackId = hb_stackId();
+   for( ;; )
+   {
+      pTask = hb_poolTaskGet( pPool, pWorker );
+      if( pTask )
+         hb_poolTaskRun( pWorker, pTask );
+      else if( pPool->fClosed || hb_vmRequestQuery() != 0 )
+         break;
+      else
+      {
+         pPool->iIdle++;
+         hb_poolWait( &pPool->cond, 0 );
+         pPool->iIdle--;
+      }
+   }
+   pWorker->pStackId = NULL;
+
+   /* pass not executed tasks to other threads */
+   while( ( pTask = pWorker->queue.pFirst ) != NULL )
+   {
+      hb_poolQueueDel( pTask );
+      hb_poolQueueAdd( &pPool->queue, pTask );
+   }
+   if( --pPool->iRunning == 0 )
+      pFree = hb_poolQueueCancel( &pPool->queue, NULL );
+   else if( pPool->queue.pFirst && pPool->iIdle )
+      HB_COND_SIGNALN( pPool->cond, pPool->iIdle );
+   hb_poolSignalFinished();
+   fFree = hb_poolRelease( pPool );
+   HB_POOL_UNLOCK();
+   hb_vmLock();
+
+   hb_poolTaskFree( pFree );
+   if( fFree )
+      hb_poolFree( pPool );
+}
+
+/* wake up pool threads and waiting for futures on HVM exit */
+void hb_threadPoolWakeAll( void )
+{
+   HB_CRITICAL_LOCK( s_pool_mtx );
+   if( s_pPoolList )
+   {
+      PHB_THPOOL pPool = s_pPoolList;
+      do
+      {
+         if( pPool->iIdle )
+            HB_COND_SIGNALN( pPool->cond, pPool->iIdle );
+         pPool = pPool->pNext;
+      }
+      while( pPool != s_pPoolList );
+   }
+   hb_poolSignalFinished();
+   HB_CRITICAL_UNLOCK( s_pool_mtx );
+}
+#endif
+
+/* wait for tasks, returns number of finished tasks or
+   index of the first finished task if fAll is not set */
+static int hb_poolTaskWait( PHB_POOLTASK * pTasks, int iTasks,
+                            HB_BOOL fAll, HB_ULONG ulMilliSec )
+{
+   int i, iFinished, iResult = 0;
+#if defined( HB_MT_VM )
+   HB_MAXUINT timer = 0;
+
+   if( ulMilliSec != HB_THREAD_INFINITE_WAIT && ulMilliSec != 0 )
+      timer = hb_timerGet() + ulMilliSec;
+#endif
+
+   hb_vmUnlock();
+   HB_POOL_LOCK();
+   for( ;; )
+   {
+      PHB_POOLWORKER pWorker = NULL;
+      PHB_POOLTASK pRun = NULL;
+
+      for( i = iFinished = 0; i < iTasks; ++i )
+      {
+         if( pTasks[ i ]->iState >= HB_FUTURE_DONE )
+         {
+            iFinished++;
+            if( ! fAll )
+            {
+               iResult = i + 1;
+               break;
+            }
+         }
+         else if( ! pRun && pTasks[ i ]->iState == HB_FUTURE_PENDING )
+         {
+            pWorker = hb_poolWorkerSelf( pTasks[ i ]->pPool );
+            if( pWorker )
+               pRun = pTasks[ i ];
+         }
+      }
+      if( iTasks == 0 || iFinished >= ( fAll ? iTasks : 1 ) )
+         break;
+
+      if( pRun )
+      {
+         /* execute pending task of our own pool instead of waiting */
+         hb_poolQueueDel( pRun );
+         hb_poolTaskRun( pWorker, pRun );
+         continue;
+      }
+
+#if defined( HB_MT_VM )
+      if( ulMilliSec == 0 || hb_vmRequestQuery() != 0 )
+         break;
+
+      s_waiting_for_pool++;
+      if( ! hb_poolWait( &s_pool_cond, timer ) )
+         break;
+#else
+      HB_SYMBOL_UNUSED( ulMilliSec );
+      break;
+#endif
+   }
+   HB_POOL_UNLOCK();
+   hb_vmLock();
+
+   return fAll ? iFinished : iResult;
+}
+
+static HB_GARBAGE_FUNC( hb_poolDestructor )
+{
+   PHB_THPOOL * pPoolPtr = ( PHB_THPOOL * ) Cargo;
+   PHB_THPOOL pPool = *pPoolPtr;
+
+   if( pPool )
+   {
+      HB_BOOL fFree;
+
+      *pPoolPtr = NULL;
+      HB_POOL_LOCK();
+      /* pool threads finish queued tasks and exit */
+      pPool->fClosed = HB_TRUE;
+#if defined( HB_MT_VM )
+      if( pPool->iIdle )
+         HB_COND_SIGNALN( pPool->cond, pPool->iIdle );
+#endif
+      fFree = hb_poolRelease( pPool );
+      HB_POOL_UNLOCK();
+      if( fFree )
+         hb_poolFree( pPool );
+   }
+}
+
+static const HB_GC_FUNCS s_gcPoolFuncs =
+{
+   hb_poolDestructor,
+   hb_gcDummyMark
+};
+
+static HB_GARBAGE_FUNC( hb_futureDestructor )
+{
+   PHB_POOLTASK * pTaskPtr = ( PHB_POOLTASK * ) Cargo;
+   PHB_POOLTASK pTask = *pTaskPtr;
+
+   if( pTask )
+   {
+      HB_BOOL fFree;
+
+      *pTaskPtr = NULL;
+      HB_POOL_LOCK();
+      fFree = --pTask->iRefs == 0;
+      HB_POOL_UNLOCK();
+      if( fFree )
+         hb_poolTaskFree( pTask );
+   }
+}
+
+static const HB_GC_FUNCS s_gcFutureFuncs =
+{
+   hb_futureDestructor,
+   hb_gcDummyMark
+};
+
+static PHB_THPOOL hb_poolParam( int iParam )
+{
+   PHB_THPOOL * pPoolPtr = ( PHB_THPOOL * ) hb_parptrGC( &s_gcPoolFuncs, iParam );
+
+   if( pPoolPtr && *pPoolPtr )
+      return *pPoolPtr;
+
+   hb_errRT_BASE_SubstR( EG_ARG, 3012, NULL, HB_ERR_FUNCNAME, HB_ERR_ARGS_BASEPARAMS );
+   return NULL;
+}
+
+static PHB_POOLTASK hb_futureParam( int iParam, int iPos )
+{
+   PHB_POOLTASK * pTaskPtr = ( PHB_POOLTASK * )
+                             hb_parvptrGC( &s_gcFutureFuncs, iParam, iPos );
+
+   if( pTaskPtr && *pTaskPtr )
+      return *pTaskPtr;
+
+   hb_errRT_BASE_SubstR( EG_ARG, 3012, NULL, HB_ERR_FUNCNAME, HB_ERR_ARGS_BASEPARAMS );
+   return NULL;
+}
+
+static HB_ULONG hb_poolTimeOut( int iParam )
+{
+   HB_STACK_TLS_PRELOAD
+
+   if( HB_ISNUM( iParam ) )
+   {
+      double dTimeOut = hb_parnd( iParam );
+      return dTimeOut > 0 ? ( HB_ULONG ) ( dTimeOut * 1000 ) : 0;
+   }
+   return HB_THREAD_INFINITE_WAIT;
+}
+
+HB_FUNC( HB_THREADPOOLCREATE )
+{
+   HB_STACK_TLS_PRELOAD
+   PHB_THPOOL * pPoolPtr;
+   PHB_THPOOL pPool;
+   int iThreads = hb_parni( 1 );
+
+   if( iThreads <= 0 )
+      iThreads = HB_THPOOL_DEFAULT_THREADS;
+
+   pPool = ( PHB_THPOOL ) hb_xgrabz( sizeof( HB_THPOOL ) );
+   pPool->iRefs = 1;
+
+#if defined( HB_MT_VM )
+   {
+      HB_ULONG ulAttr = ( HB_ULONG ) hb_parnl( 2 );
+      int i;
+
+#  if ! defined( HB_COND_HARBOUR_SUPPORT )
+      HB_COND_INIT( pPool->cond );
+#  endif
+      pPool->pWorkers = ( PHB_POOLWORKER )
+                        hb_xgrabz( sizeof( HB_POOLWORKER ) * iThreads );
+
+      hb_vmUnlock();
+      HB_POOL_LOCK();
+      if( s_pPoolList )
+      {
+         pPool->pNext = s_pPoolList;
+         pPool->pPrev = s_pPoolList->pPrev;
+         pPool->pPrev->pNext = pPool;
+         s_pPoolList->pPrev = pPool;
+      }
+      else
+         s_pPoolList = pPool->pNext = pPool->pPrev = pPool;
+      HB_POOL_UNLOCK();
+      hb_vmLock();
+
+      for( i = 0; i < iThreads; ++i )
+      {
+         PHB_POOLWORKER pWorker = &pPool->pWorkers[ i ];
+         PHB_ITEM pThItm;
+
+         pWorker->pPool = pPool;
+         hb_vmUnlock();
+         HB_POOL_LOCK();
+         pPool->iWorkers++;
+         pPool->iRunning++;
+         pPool->iRefs++;
+         HB_POOL_UNLOCK();
+         hb_vmLock();
+
+         pThItm = hb_threadStart( ulAttr, hb_poolWorkerThread, pWorker );
+         if( pThItm )
+            hb_itemRelease( pThItm );
+         else
+         {
+            hb_vmUnlock();
+            HB_POOL_LOCK();
+            pPool->iWorkers--;
+            pPool->iRunning--;
+            pPool->iRefs--;
+            HB_POOL_UNLOCK();
+            hb_vmLock();
+            break;
+         }
+      }
+   }
+#endif
+
+   pPoolPtr = ( PHB_THPOOL * ) hb_gcAllocate( sizeof( PHB_THPOOL ), &s_gcPoolFuncs );
+   *pPoolPtr = pPool;
+   hb_retptrGC( pPoolPtr );
+}
+
+HB_FUNC( HB_THREADPOOLSUBMIT )
+{
+   PHB_THPOOL pPool = hb_poolParam( 1 );
+
+   if( pPool )
+   {
+      PHB_ITEM pStart = hb_param( 2, HB_IT_ANY );
+      const char * szFuncName = NULL;
+      PHB_SYMB pSymbol = NULL;
+
+      if( pStart )
+      {
+         if( HB_IS_STRING( pStart ) )
+         {
+            PHB_DYNS pDynSym;
+            szFuncName = hb_itemGetCPtr( pStart );
+            pDynSym = hb_dynsymFindName( szFuncName );
+            if( pDynSym )
+               pSymbol = pDynSym->pSymbol;
+            if( ! pSymbol || ! pSymbol->value.pFunPtr )
+               pStart = NULL;
+         }
+         else if( HB_IS_SYMBOL( pStart ) )
+         {
+            pSymbol = hb_itemGetSymbol( pStart );
+            if( ! pSymbol->value.pFunPtr )
+            {
+               szFuncName = pSymbol->szName;
+               pStart = NULL;
+            }
+         }
+         else if( ! HB_IS_BLOCK( pStart ) )
+            pStart = NULL;
+      }
+
+      if( pStart )
+      {
+         HB_STACK_TLS_PRELOAD
+         PHB_POOLTASK * pTaskPtr, pTask;
+         int iPCount = hb_pcount(), iParam;
+
+         pTask = ( PHB_POOLTASK ) hb_xgrabz( sizeof( HB_POOLTASK ) );
+         pTask->pParams = hb_itemArrayNew( iPCount - 1 );
+         if( pSymbol )
+            hb_itemPutSymbol( hb_arrayGetItemPtr( pTask->pParams, 1 ), pSymbol );
+         else
+            hb_arraySet( pTask->pParams, 1, pStart );
+         /* parameters are passed by value */
+         for( iParam = 3; iParam <= iPCount; ++iParam )
+            hb_arraySet( pTask->pParams, iParam - 1, hb_param( iParam, HB_IT_ANY ) );
+         pTask->iState = HB_FUTURE_PENDING;
+         pTask->iRefs = 2;
+
+         pTaskPtr = ( PHB_POOLTASK * ) hb_gcAllocate( sizeof( PHB_POOLTASK ), &s_gcFutureFuncs );
+         *pTaskPtr = pTask;
+         hb_retptrGC( pTaskPtr );
+
+         hb_vmUnlock();
+         HB_POOL_LOCK();
+         if( pPool->fClosed )
+         {
+            pTask->iState = HB_FUTURE_CANCELED;
+            pTask->iRefs--;
+         }
+         else if( pPool->iRunning == 0 )
+         {
+            /* no pool threads, execute the task immediately */
+            hb_poolTaskRun( NULL, pTask );
+         }
+         else
+         {
+            PHB_POOLWORKER pWorker = hb_poolWorkerSelf( pPool );
+
+            pTask->pPool = pPool;
+            hb_poolQueueAdd( pWorker ? &pWorker->queue : &pPool->queue, pTask );
+#if defined( HB_MT_VM )
+            if( pPool->iIdle )
+               HB_COND_SIGNAL( pPool->cond );
+#endif
+         }
+         HB_POOL_UNLOCK();
+         hb_vmLock();
+      }
+      else if( szFuncName )
+         hb_errRT_BASE_SubstR( EG_NOFUNC, 1001, NULL, szFuncName, 0 );
+      else
+         hb_errRT_BASE_SubstR( EG_ARG, 3012, NULL, HB_ERR_FUNCNAME, HB_ERR_ARGS_BASEPARAMS );
+   }
+}
+
+HB_FUNC( HB_THREADPOOLCLOSE )
+{
+   PHB_THPOOL pPool = hb_poolParam( 1 );
+
+   if( pPool )
+   {
+      PHB_POOLTASK pFree = NULL;
+      HB_BOOL fCancel = hb_parl( 2 );
+
+      hb_vmUnlock();
+      HB_POOL_LOCK();
+      pPool->fClosed = HB_TRUE;
+      if( fCancel )
+      {
+         int i;
+
+         pFree = hb_poolQueueCancel( &pPool->queue, pFree );
+         for( i = 0; i < pPool->iWorkers; ++i )
+            pFree = hb_poolQueueCancel( &pPool->pWorkers[ i ].queue, pFree );
+         hb_poolSignalFinished();
+      }
+#if defined( HB_MT_VM )
+      if( pPool->iIdle )
+         HB_COND_SIGNALN( pPool->cond, pPool->iIdle );
+
+      /* wait for pool threads, pool thread does not wait for itself */
+      {
+         int iSelf = hb_poolWorkerSelf( pPool ) ? 1 : 0;
+
+         while( pPool->iRunning > iSelf && hb_vmRequestQuery() == 0 )
+         {
+            s_waiting_for_pool++;
+            hb_poolWait( &s_pool_cond, 0 );
+         }
+      }
+#endif
+      HB_POOL_UNLOCK();
+      hb_vmLock();
+
+      hb_poolTaskFree( pFree );
+   }
+}
+
+HB_FUNC( HB_THREADPOOLINFO )
+{
+   PHB_THPOOL pPool = hb_poolParam( 1 );
+
+   if( pPool )
+   {
+      HB_STACK_TLS_PRELOAD
+      hb_storni( pPool->iRunning, 2 );
+      hb_storni( pPool->iIdle, 3 );
+      hb_storns( pPool->nQueued, 4 );
+      hb_retl( ! pPool->fClosed );
+   }
+}
+
+HB_FUNC( HB_THREADPOOLCANCELED )
+{
+   HB_STACK_TLS_PRELOAD
+   HB_BOOL fCancel = HB_FALSE;
+
+#if defined( HB_MT_VM )
+   hb_vmUnlock();
+   HB_POOL_LOCK();
+   if( s_pPoolList )
+   {
+      PHB_THPOOL pPool = s_pPoolList;
+      do
+      {
+         PHB_POOLWORKER pWorker = hb_poolWorkerSelf( pPool );
+
+         if( pWorker )
+         {
+            fCancel = pWorker->pTask && pWorker->pTask->fCancel;
+            break;
+         }
+         pPool = pPool->pNext;
+      }
+      while( pPool != s_pPoolList );
+   }
+   HB_POOL_UNLOCK();
+   hb_vmLock();
+#endif
+
+   hb_retl( fCancel );
+}
+
+HB_FUNC( HB_FUTURESTATE )
+{
+   PHB_POOLTASK pTask = hb_futureParam( 1, 0 );
+
+   if( pTask )
+   {
+      HB_STACK_TLS_PRELOAD
+      hb_retni( pTask->iState );
+   }
+}
+
+HB_FUNC( HB_FUTUREWAIT )
+{
+   PHB_POOLTASK pTask = hb_futureParam( 1, 0 );
+
+   if( pTask )
+   {
+      HB_STACK_TLS_PRELOAD
+      hb_retl( hb_poolTaskWait( &pTask, 1, HB_TRUE, hb_poolTimeOut( 2 ) ) != 0 );
+   }
+}
+
+HB_FUNC( HB_FUTUREGET )
+{
+   PHB_POOLTASK pTask = hb_futureParam( 1, 0 );
+
+   if( pTask )
+   {
+      HB_STACK_TLS_PRELOAD
+
+      hb_poolTaskWait( &pTask, 1, HB_TRUE, hb_poolTimeOut( 2 ) );
+      /* result is not changed after the task is finished */
+      if( pTask->iState >= HB_FUTURE_DONE && pTask->pResult )
+         hb_itemReturn( pTask->pResult );
+      hb_storni( pTask->iState, 3 );
+   }
+}
+
+HB_FUNC( HB_FUTURECANCEL )
+{
+   PHB_POOLTASK pTask = hb_futureParam( 1, 0 );
+
+   if( pTask )
+   {
+      HB_STACK_TLS_PRELOAD
+      HB_BOOL fCanceled = HB_FALSE;
+
+      hb_vmUnlock();
+      HB_POOL_LOCK();
+      if( pTask->iState == HB_FUTURE_PENDING && pTask->pQueue )
+      {
+         hb_poolQueueDel( pTask );
+         pTask->iState = HB_FUTURE_CANCELED;
+         pTask->pPool = NULL;
+         pTask->iRefs--;
+         hb_poolSignalFinished();
+         fCanceled = HB_TRUE;
+      }
+      else if( pTask->iState == HB_FUTURE_RUNNING )
+         /* running task can check it by hb_threadPoolCanceled() */
+         pTask->fCancel = HB_TRUE;
+      HB_POOL_UNLOCK();
+      hb_vmLock();
+
+      hb_retl( fCanceled );
+   }
+}
+
+static void hb_futureWaitArray( HB_BOOL fAll )
+{
+#  define HB_FUTURE_WAIT_ALLOC  16
+   PHB_ITEM pArray = hb_param( 1, HB_IT_ARRAY );
+
+   if( pArray )
+   {
+      HB_STACK_TLS_PRELOAD
+      PHB_POOLTASK * pTasks, pAlloc[ HB_FUTURE_WAIT_ALLOC ];
+      int iLen = ( int ) hb_arrayLen( pArray ), iTasks, i;
+
+      pTasks = iLen > HB_FUTURE_WAIT_ALLOC ? ( PHB_POOLTASK * )
+               hb_xgrab( sizeof( PHB_POOLTASK ) * iLen ) : pAlloc;
+      for( i = iTasks = 0; i < iLen; ++i )
+      {
+         PHB_POOLTASK pTask = hb_futureParam( 1, i + 1 );
+         if( ! pTask )
+         {
+            iTasks = -1;
+            break;
+         }
+         pTasks[ iTasks++ ] = pTask;
+      }
+
+      if( iTasks >= 0 )
+      {
+         int iResult = hb_poolTaskWait( pTasks, iTasks, fAll, hb_poolTimeOut( 2 ) );
+
+         if( fAll )
+            hb_retl( iResult == iTasks );
+         else
+            hb_retni( iResult );
+      }
+
+      if( pTasks != pAlloc )
+         hb_xfree( pTasks );
+   }
+   else
+      hb_errRT_BASE_SubstR( EG_ARG, 3012, NULL, HB_ERR_FUNCNAME, HB_ERR_ARGS_BASEPARAMS );
+}
+
+HB_FUNC( HB_FUTUREALL )
+{
+   hb_futureWaitArray( HB_TRUE );
+}
+
+HB_FUNC( HB_FUTUREANY )
+{
+   hb_futureWaitArray( HB_FALSE );
 }
 
 HB_FUNC( HB_MTVM )